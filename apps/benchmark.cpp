@@ -21,10 +21,12 @@
 #include "BenchmarkOpt.hpp"
 #include "VecField.hpp"
 #include "CLAIRE.hpp"
+#include "interp3.hpp"
 
 PetscErrorCode RunForwardSolverBenchmark(reg::BenchmarkOpt*);
 PetscErrorCode RunGradientBenchmark(reg::BenchmarkOpt*);
 PetscErrorCode RunHessianMatvecBenchmark(reg::BenchmarkOpt*);
+PetscErrorCode RunInterpolationBenchmark(reg::BenchmarkOpt*);
 
 PetscErrorCode ComputeErrorForwardSolver(reg::BenchmarkOpt*);
 
@@ -75,6 +77,9 @@ int main(int argc, char **argv) {
         case 3:
             ierr = ComputeErrorForwardSolver(opt); CHKERRQ(ierr);
             break;
+        case 4:
+            ierr = RunInterpolationBenchmark(opt); CHKERRQ(ierr);
+            break;
         default:
             ierr = reg::ThrowError("benchmark not defined"); CHKERRQ(ierr);
             break;
@@ -291,6 +296,223 @@ PetscErrorCode RunHessianMatvecBenchmark(reg::BenchmarkOpt *opt) {
 
 
 
+/********************************************************************
+ * @brief micro-benchmark for the semi-lagrangian interpolation; the
+ * scatter of the query points (what SemiLagrangian::CommunicateCoord
+ * does), the ghost exchange, the local kernel and the gather of the
+ * interpolated values are timed separately for 1, 3 and nc fields;
+ * timings are the max across ranks, the load is reported per rank
+ * (the b-spline prefilter is not included in the timings)
+ *******************************************************************/
+PetscErrorCode RunInterpolationBenchmark(reg::BenchmarkOpt *opt) {
+    PetscErrorCode ierr = 0;
+    Vec m = NULL;
+    reg::VecField* v = NULL;
+    Interp3_Plan* plan = NULL;
+    ScalarType *p_m = NULL, *p_v1 = NULL, *p_v2 = NULL, *p_v3 = NULL,
+               *p_x = NULL, *p_fields = NULL, *p_values = NULL, *p_ghost = NULL;
+    ScalarType hx[3], x1, x2, x3, vmag;
+    int nx[3], isize[3], istart[3], isize_g[3], istart_g[3], c_dims[2],
+        nghost, dofs[3], ndofs, nfmax, kbegin, kend, rank, nproc;
+    IntType nl, ng, nc, nalloc, nlghost, i, n;
+    double tphase[4], tmax[4], tscatter[NINTERPTIMERS], tinterp[NINTERPTIMERS],
+           load[2], loadmax[2], loadavg[2], t, ttotal;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_size(PETSC_COMM_WORLD, &nproc);
+
+    nl = opt->m_Domain.nl;
+    ng = opt->m_Domain.ng;
+    nc = opt->m_Domain.nc;
+    n  = opt->NumRepeats();
+    vmag = opt->VelocityMagnitude();
+
+    for (int j = 0; j < 3; ++j) {
+        hx[j]     = opt->m_Domain.hx[j];
+        nx[j]     = static_cast<int>(opt->m_Domain.nx[j]);
+        isize[j]  = static_cast<int>(opt->m_Domain.isize[j]);
+        istart[j] = static_cast<int>(opt->m_Domain.istart[j]);
+    }
+    c_dims[0] = opt->m_CartGridDims[0];
+    c_dims[1] = opt->m_CartGridDims[1];
+
+    ierr = ComputeSyntheticData(m, opt); CHKERRQ(ierr);
+    ierr = ComputeSyntheticData(v, opt); CHKERRQ(ierr);
+
+    // fields to be interpolated (1, 3 and nc fields)
+    dofs[0] = 1; dofs[1] = 3; dofs[2] = static_cast<int>(nc);
+    ndofs = (nc == 1 || nc == 3) ? 2 : 3;
+    nfmax = std::max(3, static_cast<int>(nc));
+
+    try {p_x = new ScalarType[3*nl];}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    try {p_fields = new ScalarType[nfmax*nl];}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    try {p_values = new ScalarType[nfmax*nl];}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+
+    ierr = VecGetArray(m, &p_m); CHKERRQ(ierr);
+    for (int k = 0; k < nfmax; ++k) {
+        for (i = 0; i < nl; ++i) {
+            p_fields[k*nl + i] = p_m[i];
+        }
+    }
+    ierr = VecRestoreArray(m, &p_m); CHKERRQ(ierr);
+
+    // query points X = x - vmag*h*v (normalized to [0,1)); the synthetic
+    // velocity is bounded by one, so vmag is the max displacement in cells
+    ierr = VecGetArray(v->m_X1, &p_v1); CHKERRQ(ierr);
+    ierr = VecGetArray(v->m_X2, &p_v2); CHKERRQ(ierr);
+    ierr = VecGetArray(v->m_X3, &p_v3); CHKERRQ(ierr);
+    for (IntType i1 = 0; i1 < opt->m_Domain.isize[0]; ++i1) {  // x1
+        for (IntType i2 = 0; i2 < opt->m_Domain.isize[1]; ++i2) {  // x2
+            for (IntType i3 = 0; i3 < opt->m_Domain.isize[2]; ++i3) {  // x3
+                x1 = hx[0]*static_cast<ScalarType>(i1 + opt->m_Domain.istart[0]);
+                x2 = hx[1]*static_cast<ScalarType>(i2 + opt->m_Domain.istart[1]);
+                x3 = hx[2]*static_cast<ScalarType>(i3 + opt->m_Domain.istart[2]);
+
+                i = reg::GetLinearIndex(i1, i2, i3, opt->m_Domain.isize);
+
+                p_x[i*3+0] = (x1 - vmag*hx[0]*p_v1[i])/(2.0*PETSC_PI);
+                p_x[i*3+1] = (x2 - vmag*hx[1]*p_v2[i])/(2.0*PETSC_PI);
+                p_x[i*3+2] = (x3 - vmag*hx[2]*p_v3[i])/(2.0*PETSC_PI);
+            }  // i1
+        }  // i2
+    }  // i3
+    ierr = VecRestoreArray(v->m_X1, &p_v1); CHKERRQ(ierr);
+    ierr = VecRestoreArray(v->m_X2, &p_v2); CHKERRQ(ierr);
+    ierr = VecRestoreArray(v->m_X3, &p_v3); CHKERRQ(ierr);
+
+    ss << "run interpolation benchmark (" << (sizeof(ScalarType) == 4 ? "single" : "double")
+       << " precision; max displacement " << vmag << " cells)";
+    ierr = reg::DbgMsg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+
+    ss << std::left << std::setw(9) << "kernel" << std::right
+       << std::setw(4) << "nf"
+       << std::setw(12) << "scatter" << std::setw(12) << "ghost"
+       << std::setw(12) << "kernel" << std::setw(12) << "gather"
+       << std::setw(12) << "points/s"
+       << std::setw(12) << "q/rank max" << std::setw(12) << "q/rank avg"
+       << std::setw(12) << "B/rank max" << std::setw(12) << "B/rank avg";
+    ierr = reg::Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+
+    if (opt->InterpSweep()) {
+        kbegin = 0; kend = INTERP3_NKERNELS;
+    } else {
+        kbegin = opt->m_PDESolver.ipkernel; kend = kbegin + 1;
+    }
+
+    for (int kernel = kbegin; kernel < kend; ++kernel) {
+        nghost = interp3_kernel_ghost_size(kernel);
+        nalloc = accfft_ghost_xyz_local_size_dft_r2c(opt->m_FFT.plan, nghost, isize_g, istart_g);
+        nlghost = 1;
+        for (int j = 0; j < 3; ++j) {
+            nlghost *= static_cast<IntType>(isize_g[j]);
+        }
+        p_ghost = reinterpret_cast<ScalarType*>(accfft_alloc(nfmax*nalloc));
+
+        for (int d = 0; d < ndofs; ++d) {
+            try {plan = new Interp3_Plan();}
+            catch (std::bad_alloc& err) {
+                ierr = reg::ThrowError(err); CHKERRQ(ierr);
+            }
+            plan->allocate(nl, &dofs[d], 1);
+            plan->kernel = kernel;
+            plan->compress_bits = opt->m_PDESolver.ipcompress;
+            plan->query_sort = opt->m_PDESolver.ipsort;
+
+            for (int j = 0; j < NINTERPTIMERS; ++j) {
+                tscatter[j] = 0.0; tinterp[j] = 0.0;
+            }
+            for (int j = 0; j < 4; ++j) tphase[j] = 0.0;
+
+            // warm start (first touch of all buffers)
+            plan->scatter(nx, isize, istart, nl, nghost, p_x, c_dims,
+                          opt->m_FFT.mpicomm, tscatter);
+            for (int k = 0; k < dofs[d]; ++k) {
+                accfft_get_ghost_xyz(opt->m_FFT.plan, nghost, isize_g,
+                                     &p_fields[k*nl], &p_ghost[k*nlghost]);
+            }
+            plan->interpolate(p_ghost, nx, isize, istart, nl, nghost, p_values,
+                              c_dims, opt->m_FFT.mpicomm, tinterp, 0);
+            for (int j = 0; j < NINTERPTIMERS; ++j) {
+                tscatter[j] = 0.0; tinterp[j] = 0.0;
+            }
+
+            for (IntType r = 0; r < n; ++r) {
+                t = -MPI_Wtime();
+                plan->scatter(nx, isize, istart, nl, nghost, p_x, c_dims,
+                              opt->m_FFT.mpicomm, tscatter);
+                tphase[0] += t + MPI_Wtime();
+
+                t = -MPI_Wtime();
+                for (int k = 0; k < dofs[d]; ++k) {
+                    accfft_get_ghost_xyz(opt->m_FFT.plan, nghost, isize_g,
+                                         &p_fields[k*nl], &p_ghost[k*nlghost]);
+                }
+                tphase[1] += t + MPI_Wtime();
+
+                plan->interpolate(p_ghost, nx, isize, istart, nl, nghost, p_values,
+                                  c_dims, opt->m_FFT.mpicomm, tinterp, 0);
+            }
+            tphase[2] = tinterp[INTERP3_EXEC];
+            tphase[3] = tinterp[INTERP3_COMM];
+
+            // load per rank and call
+            load[0] = tinterp[INTERP3_NQUERIES]/static_cast<double>(n);
+            load[1] = (tscatter[INTERP3_NBYTES] + tinterp[INTERP3_NBYTES])/static_cast<double>(n);
+
+            MPI_Reduce(tphase, tmax, 4, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD);
+            MPI_Reduce(load, loadmax, 2, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD);
+            MPI_Reduce(load, loadavg, 2, MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+
+            if (rank == 0) {
+                ttotal = tmax[0] + tmax[1] + tmax[2] + tmax[3];
+                ss << std::left << std::setw(9) << interp3_kernel_name(kernel) << std::right
+                   << std::setw(4) << dofs[d] << std::scientific << std::setprecision(3)
+                   << std::setw(12) << tmax[0]/static_cast<double>(n)
+                   << std::setw(12) << tmax[1]/static_cast<double>(n)
+                   << std::setw(12) << tmax[2]/static_cast<double>(n)
+                   << std::setw(12) << tmax[3]/static_cast<double>(n)
+                   << std::setw(12) << (ttotal > 0.0 ? static_cast<double>(ng*dofs[d]*n)/ttotal : 0.0)
+                   << std::setw(12) << loadmax[0]
+                   << std::setw(12) << loadavg[0]/static_cast<double>(nproc)
+                   << std::setw(12) << loadmax[1]
+                   << std::setw(12) << loadavg[1]/static_cast<double>(nproc);
+            }
+            ierr = reg::Msg(ss.str()); CHKERRQ(ierr);
+            ss.str(std::string()); ss.clear();
+
+            // feed the log (phases are also logged as interpolation timers)
+            opt->IncreaseInterpTimers(tinterp);
+
+            delete plan; plan = NULL;
+        }
+        accfft_free(p_ghost); p_ghost = NULL;
+    }
+
+    if (p_x != NULL) {delete [] p_x; p_x = NULL;}
+    if (p_fields != NULL) {delete [] p_fields; p_fields = NULL;}
+    if (p_values != NULL) {delete [] p_values; p_values = NULL;}
+    if (m != NULL) {ierr = VecDestroy(&m); CHKERRQ(ierr); m = NULL;}
+    if (v != NULL) {delete v; v = NULL;}
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief perform benchmark for forward solver
  *******************************************************************/
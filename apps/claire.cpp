@@ -22,6 +22,7 @@
 #include "CLAIREUtils.hpp"
 #include "ReadWriteReg.hpp"
 #include "CLAIREInterface.hpp"
+#include "ResourcePlanner.hpp"
 
 
 
@@ -37,6 +38,7 @@ int main(int argc, char **argv) {
     reg::RegOpt* regopt = NULL;
     reg::ReadWriteReg* readwrite = NULL;
     reg::CLAIREInterface* registration = NULL;
+    reg::ResourcePlanner* planner = NULL;
     std::stringstream ss;
 
     // initialize petsc (user is not allowed to set petsc options)
@@ -64,6 +66,27 @@ int main(int argc, char **argv) {
         ierr = reg::ThrowError(err); CHKERRQ(ierr);
     }
 
+    // estimate memory footprint and runtime and exit (we only read
+    // the grid size from the image header; nothing is allocated)
+    if (regopt->m_Plan.enabled) {
+        if (regopt->m_ReadWriteFlags.readfiles) {
+            ierr = readwrite->ReadGridSize(regopt->m_FileNames.mr[0], regopt->m_Domain.nx); CHKERRQ(ierr);
+        }
+        try {planner = new reg::ResourcePlanner(regopt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+        ierr = planner->Run(); CHKERRQ(ierr);
+
+        if (planner != NULL) {delete planner; planner = NULL;}
+        if (readwrite != NULL) {delete readwrite; readwrite = NULL;}
+        if (regopt != NULL) {delete regopt; regopt = NULL;}
+
+        ierr = reg::Finalize(); CHKERRQ(ierr);
+
+        return 0;
+    }
+
     // allocate class for io
     try {registration = new reg::CLAIREInterface(regopt);}
     catch (std::bad_alloc& err) {
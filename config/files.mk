@@ -15,8 +15,13 @@ CPPFILES=$(SRCDIR)/RegOpt.cpp \
 		$(SRCDIR)/DistanceMeasureSL2.cpp \
 		$(SRCDIR)/DistanceMeasureSL2aux.cpp \
 		$(SRCDIR)/SemiLagrangian.cpp \
+		$(SRCDIR)/TimeHistory.cpp \
+		$(SRCDIR)/WorkSpace.cpp \
+		$(SRCDIR)/Redistribution.cpp \
+		$(SRCDIR)/ResourcePlanner.cpp \
 		$(SRCDIR)/Optimizer.cpp \
 		$(SRCDIR)/KrylovInterface.cpp \
+		$(SRCDIR)/KrylovRecycler.cpp \
 		$(SRCDIR)/TaoInterface.cpp \
 		$(SRCDIR)/CLAIREInterface.cpp \
 		$(SRCDIR)/MultiLevelPyramid.cpp \
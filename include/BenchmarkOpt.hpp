@@ -44,6 +44,9 @@ class BenchmarkOpt : public RegOpt {
     inline int Benchmark() const {return this->m_BenchmarkID;};
     inline int NumRepeats() const {return this->m_NumRepeats;};
 
+    inline ScalarType VelocityMagnitude() const {return this->m_VelocityMagnitude;};
+    inline bool InterpSweep() const {return this->m_InterpSweep;};
+
     inline double GetRunTime() const {return this->m_RunTime;};
     inline void SetRunTime(double value){this->m_RunTime = value;};
 
@@ -57,6 +60,8 @@ class BenchmarkOpt : public RegOpt {
     int m_BenchmarkID;
     int m_NumRepeats;
     double m_RunTime;
+    ScalarType m_VelocityMagnitude;  ///< max displacement (in grid cells) for interpolation benchmark
+    bool m_InterpSweep;              ///< run interpolation benchmark for all kernels
 };
 
 
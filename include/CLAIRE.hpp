@@ -25,6 +25,8 @@
 #include "RegOpt.hpp"
 #include "CLAIREUtils.hpp"
 #include "CLAIREBase.hpp"
+#include "TimeHistory.hpp"
+#include "WorkSpace.hpp"
 
 
 
@@ -60,6 +62,10 @@ class CLAIRE : public CLAIREBase {
         of lagrangian with respect to control variable(s) */
     PetscErrorCode HessianMatVec(Vec, Vec, bool scale = true);
 
+    /*! apply hessian to a block of vectors (shares the transport
+        of the incremental equations across the block) */
+    PetscErrorCode HessianMatVecBlock(Vec*, Vec*, IntType, bool scale = true);
+
     /*! get state variable */
     PetscErrorCode GetStateVariable(Vec&);
 
@@ -90,6 +96,12 @@ class CLAIRE : public CLAIREBase {
     /*! allocate all the memory we need */
     PetscErrorCode InitializeSolver();
 
+    /*! pre processing before krylov solve (selects fidelity of hessian matvecs) */
+    PetscErrorCode PreKrylovSolve(Vec, Vec);
+
+    /*! post processing after krylov solve */
+    PetscErrorCode PostKrylovSolve(Vec, Vec);
+
 
  protected:
     /*! init class variables (called by constructor) */
@@ -167,15 +179,38 @@ class CLAIRE : public CLAIREBase {
     /*! sl solver for inc adjoint equation */
     PetscErrorCode SolveIncAdjointEquationFNSL();
 
+    /*! sl solver for a block of inc state equations */
+    PetscErrorCode SolveIncStateEquationBlockSL(Vec, Vec, Vec, IntType);
+
+    /*! sl solver for a block of inc adjoint equations (gauss--newton approximation) */
+    PetscErrorCode SolveIncAdjointEquationBlockGNSL(Vec, Vec, IntType);
+
     /*! apply the projection operator to the
         body force and the incremental body force */
     virtual PetscErrorCode ApplyProjection();
 
+    /*! allocate state variable (and compressed time history) */
+    PetscErrorCode AllocateStateVariable();
+
+    /*! get component of state variable at given time point */
+    PetscErrorCode GetStateTimePoint(ScalarType*&, ScalarType*, IntType, IntType);
+
+    /*! start to load state variable at given time point (out-of-core time history) */
+    PetscErrorCode PrefetchStateTimePoint(IntType);
+
+    /*! select time grid for hessian matvecs (multi-fidelity) */
+    PetscErrorCode SetHessianFidelity(Vec);
+
     Vec m_StateVariable;        ///< time dependent state variable m(x,t)
     Vec m_AdjointVariable;      ///< time dependent adjoint variable \lambda(x,t)
     Vec m_IncStateVariable;     ///< time dependent incremental state variable \tilde{m}(x,t)
     Vec m_IncAdjointVariable;   ///< time dependent incremental adjoint variable \tilde{\lambda}(x,t)
 
+    TimeHistory* m_StateHistory;  ///< compressed/out-of-core time history of m (m_StateVariable only holds m(t=1))
+
+    IntType m_TimeStride;                               ///< stride of time points in hessian matvecs (1: full time grid)
+    SemiLagrangianType* m_CoarseTimeSemiLagrangian;     ///< trajectories on coarse time grid (hessian matvecs)
+
  private:
     /*! compute the initial guess for the velocity field */
     PetscErrorCode ComputeInitialVelocity(void);
@@ -20,8 +20,10 @@
 #ifndef _REGISTRATIONINTERFACE_H_
 #define _REGISTRATIONINTERFACE_H_
 
+#include <map>
 #include "RegOpt.hpp"
 #include "CLAIREUtils.hpp"
+#include "Redistribution.hpp"
 #include "ReadWriteReg.hpp"
 #include "Optimizer.hpp"
 #include "Preconditioner.hpp"
@@ -93,8 +95,40 @@ class CLAIREInterface {
     PetscErrorCode RunSolverRegParaContReductSearch();
     PetscErrorCode RunSolverRegParaContReduction();
 
+    PetscErrorCode RunParaContProbes(const std::vector<ScalarType>&, std::vector<bool>&, std::vector<bool>&);
+    PetscErrorCode GetParaContInitialGuess(VecField*&, ScalarType);
+    PetscErrorCode StoreParaContSolution(ScalarType, int);
+    PetscErrorCode ClearParaContSolutions();
+    PetscErrorCode SetupParaContGroups();
+    PetscErrorCode SetupParaContRedistribution();
+    PetscErrorCode DistributeParaContImage(Vec&, Vec);
+    PetscErrorCode ExchangeParaContSolutions(bool);
+    PetscErrorCode ClearParaContGroups();
+
     PetscErrorCode ProlongVelocityField(VecField*&, int);
 
+    /* group of mpi tasks that solves the registration problem for one
+       of the regularization parameters of a batch (binary search) */
+    struct ParaContGroup {
+        RegOpt* m_Opt;                        ///< registration options (on task group)
+        RegProblemType* m_RegProblem;         ///< registration problem (on task group)
+        OptimizerType* m_Optimizer;           ///< optimizer (on task group)
+        Preconditioner* m_Precond;            ///< preconditioner (on task group)
+        PreProcType* m_PreProc;               ///< preprocessing (on task group)
+        Vec m_ReferenceImage;                 ///< reference image (layout of task group)
+        Vec m_TemplateImage;                  ///< template image (layout of task group)
+        Vec m_Mask;                           ///< mask (layout of task group)
+        VecField* m_Solution;                 ///< initial guess and solution (layout of task group)
+
+        MPI_Comm m_Comm;                      ///< communicator of task group
+        MPI_Comm m_WorldComm;                 ///< communicator of all tasks (communicator of the options)
+        int m_NumGroups;                      ///< number of task groups
+        int m_GroupSize;                      ///< number of tasks per group (groups are contiguous in rank)
+        int m_Group;                          ///< index of task group of this task
+
+        Redistribution m_Redistribution;      ///< layout of all tasks (source) -> layout of task groups (target)
+    };
+
     RegOpt* m_Opt;
     PreProcType* m_PreProc;
     Preconditioner* m_Precond;
@@ -116,6 +150,10 @@ class CLAIREInterface {
     bool m_IsReferenceSet;  ///< flag: delete the reference image (allocated locally)
     bool m_IsMaskSet;       ///< flag: delete the mask image (allocated locally)
     bool m_DeleteSolution;  ///< flag: delete the solution vector (allocated locally)
+
+    ParaContGroup* m_ParaContGroup;                         ///< task groups for binary search (NULL: probe on all tasks)
+    std::vector<VecField*> m_ParaContProbes;                ///< solutions of the last batch of probes (one per group)
+    std::map<ScalarType, VecField*> m_ParaContSolutions;    ///< accepted solutions of the parameter continuation (by beta)
 };
 
 
@@ -25,6 +25,7 @@
 
 // global includes
 #include <fstream>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 #include <omp.h>
@@ -102,8 +103,21 @@ PetscErrorCode WrngMsg(std::string);
 PetscErrorCode DbgMsg(std::string);
 
 /*! interface to create a vector (essentially simplifies
- * the petsc vector creation) */
-PetscErrorCode VecCreate(Vec&, IntType, IntType);
+ * the petsc vector creation); last argument is the number of
+ * components/time points stored in the vector */
+PetscErrorCode VecCreate(Vec&, IntType, IntType, IntType nblocks = 1);
+
+/*! create a vector on the tasks of the given communicator */
+PetscErrorCode VecCreate(MPI_Comm, Vec&, IntType, IntType, IntType nblocks = 1);
+
+/*! set placement policy for field data (first touch, huge pages) */
+PetscErrorCode SetMemoryPolicy(bool, bool);
+
+/*! first touch buffer/vector with static omp schedule (per block) */
+PetscErrorCode FirstTouch(ScalarType*, IntType, IntType nblocks = 1);
+
+/*! hint for transparent huge pages (before first touch) */
+PetscErrorCode AdviseHugePages(void*, size_t);
 
 /*! display scalar field */
 PetscErrorCode VecView(Vec);
@@ -114,6 +128,12 @@ PetscErrorCode VecNorm(Vec, IntType);
 /*! compute norm of vector field */
 PetscErrorCode ShowValues(Vec, IntType nc = 1);
 
+/*! inner product (accumulated in double precision) */
+PetscErrorCode VecInnerProduct(Vec, Vec, ScalarType*);
+
+/*! l2 norm (accumulated in double precision) */
+PetscErrorCode VecNormL2(Vec, ScalarType*);
+
 /*! rescale vector field to given bounds [xmin,xmax] */
 PetscErrorCode Rescale(Vec, ScalarType, ScalarType, IntType nc = 1);
 
@@ -136,7 +156,11 @@ PetscErrorCode GetFileName(std::string&, std::string&, std::string&, std::string
 std::vector<int> String2Vec(const std::string&);
 std::vector<int> String2Vec(const std::string&, std::string);
 
-PetscErrorCode InitializeDataDistribution(int, int*, MPI_Comm&, bool);
+PetscErrorCode InitializeDataDistribution(int, int*, MPI_Comm&, bool, bool pinthreads = false,
+                                          MPI_Comm comm = PETSC_COMM_WORLD);
+
+/*! bind openmp threads to cores */
+PetscErrorCode PinThreads(int, MPI_Comm);
 
 PetscErrorCode Finalize();
 
@@ -82,6 +82,9 @@ class DistanceMeasure {
     PetscErrorCode Initialize();
     PetscErrorCode ClearMemory();
 
+    /*! offset of m(t=1) in state variable */
+    PetscErrorCode GetFinalStateOffset(IntType&);
+
     Vec m_Mask;
     Vec m_ReferenceImage;
     Vec m_TemplateImage;
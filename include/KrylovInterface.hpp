@@ -41,11 +41,18 @@ PetscErrorCode DispKSPConvReason(KSPConvergedReason);
 PetscErrorCode InvertPrecondKrylovMonitor(KSP,PetscInt,PetscReal,void*);
 PetscErrorCode InvertPrecondMatVec(Mat,Vec,Vec);
 PetscErrorCode InvertPrecondPreKrylovSolve(KSP,Vec,Vec,void*);
+PetscErrorCode SmootherMatVec(Mat,Vec,Vec);
 
 PetscErrorCode ProjectGradient(KSP,Vec,void*);
 PetscErrorCode PreKrylovSolve(KSP,Vec,Vec,void*);
 PetscErrorCode PostKrylovSolve(KSP,Vec,Vec,void*);
 
+// recycling of krylov subspace (context is the recycler)
+PetscErrorCode RecycledPreKrylovSolve(KSP,Vec,Vec,void*);
+PetscErrorCode RecycledPostKrylovSolve(KSP,Vec,Vec,void*);
+PetscErrorCode RecycledHessianMatVec(Mat,Vec,Vec);
+PetscErrorCode RecycledPrecondMatVec(PC,Vec,Vec);
+
 
 
 
@@ -0,0 +1,127 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _KRYLOVRECYCLER_HPP_
+#define _KRYLOVRECYCLER_HPP_
+
+#include "RegOpt.hpp"
+#include "CLAIREUtils.hpp"
+#include "OptimizationProblem.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+class Preconditioner;
+
+
+
+
+/********************************************************************
+ * @brief recycles a small subspace between the hessian solves of
+ * consecutive newton iterations (deflated pcg); during a solve the
+ * hessian matvecs are recorded; afterwards, the recorded vectors and
+ * the recycled vectors are combined into approximate eigenvectors of
+ * the preconditioned hessian that belong to the smallest eigenvalues
+ * (ritz vectors); in the next solve, these modes are removed from
+ * the initial residual and from every preconditioned residual
+ * (adapted deflation preconditioner); the initial guess can also
+ * be set to the solution of the previous solve (warm start)
+ *******************************************************************/
+class KrylovRecycler {
+ public:
+    typedef KrylovRecycler Self;
+    typedef OptimizationProblem OptProbType;
+
+    KrylovRecycler();
+    KrylovRecycler(RegOpt*);
+    virtual ~KrylovRecycler();
+
+    /*! set optimization problem (hessian) */
+    PetscErrorCode SetProblem(OptProbType*);
+
+    /*! set preconditioner (NULL: none) */
+    PetscErrorCode SetPreconditioner(Preconditioner*);
+
+    /*! get optimization problem */
+    inline OptProbType* GetProblem() {return this->m_OptimizationProblem;};
+
+    /*! set initial guess and deflate it (before krylov solve) */
+    PetscErrorCode PreSolve(Vec, Vec);
+
+    /*! store solution and update recycled space (after krylov solve) */
+    PetscErrorCode PostSolve(Vec);
+
+    /*! apply hessian (recorded during solve) */
+    PetscErrorCode HessianMatVec(Vec, Vec);
+
+    /*! apply deflated preconditioner */
+    PetscErrorCode PrecondMatVec(Vec, Vec);
+
+    /*! drop recycled space and stored solution */
+    PetscErrorCode Reset();
+
+ protected:
+    PetscErrorCode Initialize();
+    PetscErrorCode ClearMemory();
+
+    PetscErrorCode ComputeRitzVectors();
+    PetscErrorCode ApplyCoarseCorrection(Vec, Vec, Vec);
+    PetscErrorCode GetVector(Vec&, Vec);
+    PetscErrorCode ReturnVector(Vec&);
+
+    static PetscErrorCode Cholesky(std::vector<double>&, int, bool&);
+    static PetscErrorCode CholeskySolve(const std::vector<double>&, std::vector<double>&, int);
+    static PetscErrorCode SymmetricEigen(std::vector<double>&, std::vector<double>&, std::vector<double>&, int);
+
+    int m_NumVectors;               ///< max number of recycled vectors
+    int m_MaxRecord;                ///< max number of recorded matvecs per solve
+
+    std::vector<Vec> m_W;           ///< recycled vectors
+    std::vector<Vec> m_AW;          ///< hessian applied to recycled vectors (current operator)
+    std::vector<Vec> m_V;           ///< recorded input of hessian matvecs
+    std::vector<Vec> m_AV;          ///< recorded output of hessian matvecs
+    std::vector<Vec> m_Pool;        ///< unused vectors
+    std::vector<double> m_E;        ///< cholesky factor of W^T A W
+    std::vector<ScalarType> m_Coeff;    ///< work array (inner products)
+
+    bool m_Recording;               ///< flag: record hessian matvecs
+    bool m_Deflate;                 ///< flag: deflation is active (E has been factorized)
+
+    Vec m_Solution;                 ///< solution of last solve (warm start)
+    Vec m_WorkVec;                  ///< temporary vector
+
+    RegOpt* m_Opt;
+    OptProbType* m_OptimizationProblem;
+    Preconditioner* m_Precond;
+};
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _KRYLOVRECYCLER_HPP_
@@ -63,6 +63,9 @@ class OptimizationProblem {
     /*! apply Hessian matvec H\tilde{\vect{x}} */
     virtual PetscErrorCode HessianMatVec(Vec, Vec, bool scale = true) = 0;
 
+    /*! apply Hessian to a block of vectors (default: one at a time) */
+    virtual PetscErrorCode HessianMatVecBlock(Vec*, Vec*, IntType, bool scale = true);
+
     /*! evaluate regularization functional for given control variable */
     virtual PetscErrorCode EvaluateRegularizationFunctional(ScalarType*, VecField*) = 0;
 
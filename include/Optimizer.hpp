@@ -27,6 +27,7 @@
 #include "Preconditioner.hpp"
 #include "Preprocessing.hpp"
 #include "OptimizationProblem.hpp"
+#include "KrylovRecycler.hpp"
 
 namespace reg {
 
@@ -53,8 +54,13 @@ class Optimizer {
     PetscErrorCode Initialize(void);
     PetscErrorCode ClearMemory(void);
     PetscErrorCode SetupTao(void);
+    PetscErrorCode SetupKrylovMethod(void);
     PetscErrorCode SetInitialGuess(void);
 
+    /* native inexact newton-krylov driver (bypasses tao) */
+    PetscErrorCode SetupNewtonKrylov(void);
+    PetscErrorCode RunNewtonKrylov(ScalarType, IntType);
+
     RegOpt* m_Opt;
     OptProbType* m_OptimizationProblem;
 
@@ -63,9 +69,15 @@ class Optimizer {
     KSP m_KrylovMethod; ///< KSP object
 //    PC m_KrylovMethodPC; ///< KSP preconditioner object
     Preconditioner* m_Precond;
+    KrylovRecycler* m_Recycler; ///< recycling of krylov subspace between newton iterations
     Preprocessing* m_PreProc;
     Mat m_MatVec;
     Vec m_Solution; ///< solution vector
+
+    Vec m_Gradient; ///< gradient (native newton-krylov driver)
+    Vec m_Step;     ///< search direction (native newton-krylov driver)
+    Vec m_Trial;    ///< trial point of line search (native newton-krylov driver)
+    TaoConvergedReason m_ConvergedReason; ///< termination reason of native driver
 };
 
 
@@ -22,6 +22,8 @@
 
 #include "RegOpt.hpp"
 #include "CLAIREUtils.hpp"
+#include "WorkSpace.hpp"
+#include "Redistribution.hpp"
 #include "KrylovInterface.hpp"
 #include "OptimizationProblem.hpp"
 #include "CLAIRE.hpp"
@@ -65,9 +67,18 @@ class Preconditioner {
     /*! apply hessian (for inversion) */
     PetscErrorCode HessianMatVec(Vec, Vec);
 
+    /*! apply hessian on the grid of the preconditioner (smoother) */
+    PetscErrorCode LevelHessianMatVec(Vec, Vec);
+
     /*! estimate eigenvalues */
     PetscErrorCode EstimateEigenValues();
 
+    /*! record secant pair (s, Hs) for quasi-newton update */
+    PetscErrorCode AddSecantPair(Vec, Vec);
+
+    /*! activate secant pairs recorded during last hessian solve */
+    PetscErrorCode UpdateSecantPairs();
+
  protected:
     /*! init class variables (called by constructor) */
     PetscErrorCode Initialize(void);
@@ -79,6 +90,23 @@ class Preconditioner {
     /*! setup two level preconditioner */
     PetscErrorCode ApplyRestriction();
     PetscErrorCode SetupCoarseGrid();
+    PetscErrorCode AllocateCoarseGrid();
+
+    /*! communicator and redistribution for coarse grid solve */
+    PetscErrorCode SetupCoarseGridComm();
+    PetscErrorCode SetupRedistribution();
+
+    /*! transfer scalar field between fine grid and coarse grid solve */
+    PetscErrorCode RestrictToCoarseGrid(ScalarType*, Vec);
+    PetscErrorCode ProlongFromCoarseGrid(Vec, const ScalarType*);
+
+    /*! solve on coarse grid (krylov method or cycle over coarser levels) */
+    PetscErrorCode SolveCoarseGrid();
+
+    /*! multilevel preconditioner (levels below the coarse grid) */
+    PetscErrorCode SetupCoarseLevel();
+    PetscErrorCode SetupSmoother();
+    PetscErrorCode ApplyCycle(Vec, Vec);
 
     /*! setup krylov method for inversion of preconditioner */
     PetscErrorCode SetupKrylovMethod(IntType, IntType);
@@ -86,12 +114,39 @@ class Preconditioner {
     /*! setup krylov method for estimating eigenvalues */
     PetscErrorCode SetupKrylovMethodEigEst();
 
+    /*! cached eigenvalue estimates (lanczos estimator) */
+    struct EigEstimate;
+    PetscErrorCode ComputeEigSignature(EigEstimate&);
+    PetscErrorCode ApplyPowerIterations(Vec, ScalarType&, int);
+    PetscErrorCode ReadEigEstimates();
+    PetscErrorCode WriteEigEstimate(const EigEstimate&);
+    PetscErrorCode ClearEigEstimates();
+
     /*! apply inverse regularization operator as preconditioner */
     PetscErrorCode ApplySpectralPrecond(Vec, Vec);
 
     /*! apply 2Level PC as preconditioner */
     PetscErrorCode Apply2LevelPrecond(Vec, Vec);
 
+    /*! apply inverse regularization operator with lbfgs update */
+    PetscErrorCode ApplyLBFGSPrecond(Vec, Vec);
+
+    /*! release secant pairs */
+    PetscErrorCode ClearSecantPairs();
+
+    struct SecantPairs {
+        std::vector<Vec> s;             ///< steps (active pairs; oldest first)
+        std::vector<Vec> y;             ///< hessian applied to steps (active pairs)
+        std::vector<ScalarType> rho;    ///< 1/(s^T y) (active pairs)
+        std::vector<Vec> stageds;       ///< steps recorded during current hessian solve
+        std::vector<Vec> stagedy;       ///< hessian applied to recorded steps
+        std::vector<Vec> pool;          ///< unused vectors
+        std::vector<ScalarType> alpha;  ///< coefficients of two-loop recursion
+        Vec q;                          ///< work vector of two-loop recursion
+        int stride;                     ///< sampling stride for recorded matvecs
+        int nseen;                      ///< number of matvecs seen during current hessian solve
+    };
+
     struct CoarseGrid {
         RegOpt* m_Opt;                        ///< registration options (on coarse grid)
         OptProbType* m_OptimizationProblem;   ///< pointer to optimization problem (on coarse level)
@@ -102,16 +157,45 @@ class Preconditioner {
         Vec m_ReferenceImage;                 ///< pointer to adjoint variable (on coarse level)
         Vec m_Mask;                           ///< on coarse level
         VecField* m_ControlVariable;          ///< pointer to velocity field (on coarse level)
-        VecField* m_IncControlVariable;       ///< pointer to velocity field (on coarse level)
-        Vec m_WorkScaField1;                  ///< temporary scalar field
-        Vec m_WorkScaField2;                  ///< temprary scalar field
+        IntType nx[3];                        ///< grid size (on coarse level)
+
+        Preconditioner* m_Precond;            ///< preconditioner on coarse level (multilevel; NULL: coarsest level)
+        Preprocessing* m_PreProc;             ///< grid transfer from coarse level to next coarser level (multilevel)
+
+        Vec m_ReferenceSource;                ///< fine grid reference image that has been restricted
+        Vec m_MaskSource;                     ///< fine grid mask that has been restricted
+        long m_Version;                       ///< outer iteration at which state, adjoint and velocity have been restricted (-1: none)
+
+        MPI_Comm m_Comm;                      ///< communicator of coarse grid solve (MPI_COMM_NULL on idle tasks)
+        MPI_Comm m_WorldComm;                 ///< communicator of fine grid (communicator of the options)
+        bool m_Reduced;                       ///< flag: coarse grid solve runs on a subset of the tasks
+        bool m_Active;                        ///< flag: task takes part in coarse grid solve
+        Vec m_Buffer;                         ///< scalar field on coarse grid in data layout of fine grid tasks
+
+        Redistribution m_Redistribution;      ///< fine grid layout (source) -> layout of coarse grid solve (target)
 
         inline IntType nl(){return this->m_Opt->m_Domain.nl;};
         inline IntType ng(){return this->m_Opt->m_Domain.ng;};
         bool setupdone;
     };
 
+    /* eigenvalue estimate of the hessian on the coarse grid and the
+       signature of the problem it has been computed for */
+    struct EigEstimate {
+        IntType nx[3];                  ///< grid size
+        int regnorm;                    ///< regularization norm
+        ScalarType beta[2];             ///< regularization weights
+        ScalarType rnorm;               ///< rms of reference image
+        ScalarType tnorm;               ///< rms of template image
+        ScalarType emin;                ///< smallest eigenvalue
+        ScalarType emax;                ///< largest eigenvalue
+        Vec v;                          ///< eigenvector of largest eigenvalue (NULL: read from file)
+    };
+
     CoarseGrid* m_CoarseGrid;
+    std::vector<EigEstimate> m_EigEstimates;    ///< cached eigenvalue estimates
+    bool m_EigEstimatesRead;                    ///< flag: estimates in file have been read
+    SecantPairs m_SecantPairs;              ///< secant pairs of quasi-newton preconditioner
 
     RegOpt* m_Opt;                          ///< registration options
     OptProbType* m_OptimizationProblem;     ///< pointer to optimization problem
@@ -121,8 +205,6 @@ class Preconditioner {
 
     Vec m_Mask;                             ///< mask (objective masking)
     Vec m_ReferenceImage;                   ///< reference image
-    Vec m_WorkScaField1;                    ///< temporary scalar field
-    Vec m_WorkScaField2;                    ///< temprary scalar field
     VecField* m_WorkVecField;               ///< temporary vector field
 
     Mat m_MatVec;                           ///< mat vec object (PETSc)
@@ -134,6 +216,10 @@ class Preconditioner {
     PetscRandom m_RandomNumGen;             ///< random number generated
     KSP m_KrylovMethodEigEst;
 
+    KSP m_Smoother;                         ///< chebyshev smoother (intermediate level of multilevel preconditioner)
+    Mat m_MatVecSmoother;                   ///< mat vec object of smoother (hessian on grid of preconditioner)
+    Vec m_Residual;                         ///< residual on grid of preconditioner (multilevel)
+
 };
 
 
@@ -76,6 +76,9 @@ class ReadWriteReg {
     PetscErrorCode Read(Vec*, std::string);
     PetscErrorCode Read(VecField*, std::string, std::string, std::string);
 
+    /*! read grid size from image header (does not read the data) */
+    PetscErrorCode ReadGridSize(std::string, IntType*);
+
     /*! write reference image */
     PetscErrorCode WriteR(Vec, std::string, bool multicomponent = false);
 
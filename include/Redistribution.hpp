@@ -0,0 +1,83 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _REDISTRIBUTION_HPP_
+#define _REDISTRIBUTION_HPP_
+
+#include "CLAIREUtils.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief redistribution of scalar fields between two data layouts of
+ * the same grid (source and target layout); each task owns a box of
+ * the grid in either layout (the box may be empty); the values in the
+ * intersection of two boxes are packed in lexicographic order (which
+ * is the same on the sending and the receiving task); the tasks can
+ * be split into groups of equal size that each hold their own copy
+ * of the field in the target layout (the source side then holds one
+ * field per group)
+ *******************************************************************/
+class Redistribution {
+ public:
+    typedef Redistribution Self;
+
+    Redistribution();
+    ~Redistribution();
+
+    /*! compute communication pattern (collective on communicator) */
+    PetscErrorCode Setup(MPI_Comm, const IntType*, const IntType*);
+
+    /*! source layout -> target layout */
+    PetscErrorCode Scatter(ScalarType*, const ScalarType* const*, int nfields = 1);
+
+    /*! target layout -> source layout */
+    PetscErrorCode Gather(ScalarType* const*, const ScalarType*, int nfields = 1);
+
+    /*! release communication pattern */
+    PetscErrorCode ClearMemory();
+
+ private:
+    MPI_Comm m_Comm;                      ///< communicator of all tasks that take part
+
+    std::vector<int> m_SendCount;         ///< values sent to each task (source layout -> target layout)
+    std::vector<int> m_SendOffset;        ///< offsets of sent values
+    std::vector<int> m_RecvCount;         ///< values received from each task
+    std::vector<int> m_RecvOffset;        ///< offsets of received values
+    std::vector<IntType> m_SendIndex;     ///< local indices of sent values (source layout)
+    std::vector<IntType> m_RecvIndex;     ///< local indices of received values (target layout)
+    std::vector<ScalarType> m_SendBuffer; ///< packed values (source layout)
+    std::vector<ScalarType> m_RecvBuffer; ///< packed values (target layout)
+};
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _REDISTRIBUTION_HPP_
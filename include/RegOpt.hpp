@@ -22,6 +22,7 @@
 
 // local includes
 #include "CLAIREUtils.hpp"
+#include "interp3_common.hpp"
 
 
 
@@ -31,6 +32,11 @@ namespace reg {
 
 
 
+class WorkSpace;
+
+
+
+
 // flags for hyperbolic PDE solvers
 enum PDESolverType {
     RK2,   ///< flag for RK2 solver
@@ -120,6 +126,7 @@ enum PrecondMeth {
     INVREG,    ///< inverse regularization operator
     TWOLEVEL,  ///< 2 level preconditioner
     NOPC,      ///< no preconditioner
+    INVREGLBFGS,  ///< inverse regularization operator with limited-memory bfgs update
 };
 
 
@@ -262,6 +269,8 @@ struct FileNames {
     std::string isc;                    ///< filename for input scalar field
     std::string xsc;                    ///< filename for output scalar field
     std::string extension;              ///< identifier for file extension
+    std::string histdir;                ///< node-local folder for out-of-core storage of time history
+    std::string pceigfile;              ///< file to store (and reuse) eigenvalue estimates of preconditioner
 };
 
 
@@ -295,6 +304,7 @@ struct Optimization {
     ScalarType presolvetol[3];   ///< tolerances for presolve
     int presolvemaxit;           ///< maximal iterations for presolve
     bool usezeroinitialguess;    ///< use zero initial guess for computing the initial gradient
+    bool nativenewton;           ///< use native newton-krylov driver (instead of tao)
     int solutionstatus;
 
     // debug
@@ -323,12 +333,23 @@ struct KrylovMethod {
     bool pcsetupdone;               ///< flag to indicate if setup of preconditioner is done
     ScalarType pctolscale;          ///< tolerance scaling for preconditioner; default: 1E-1
     ScalarType pcgridscale;         ///< this is for the two level preconditioner; defines scale for grid size change; default: 2
+    Interp3_Kernel pcipkernel;      ///< interpolation kernel used on the coarse grid of the two level preconditioner
+    int pcnprocs;                   ///< number of mpi tasks for the coarse grid solve of the two level preconditioner (0: all)
+    int pcnlevels;                  ///< number of levels of the multilevel preconditioner (2: two level preconditioner)
+    int pccycle;                    ///< number of coarse grid corrections per level (1: v-cycle; 2: w-cycle)
+    int pcsmooth;                   ///< number of chebyshev smoothing steps on intermediate levels
     bool usepetsceigest;            ///< in cheb method we need to estimate eigenvalues; use petsc implementation
     int reesteigvals;               ///< flag to reestimate eigenvalues every Krylov(i=1)- or Newton(i=2)-iteration (default: 0)
     bool monitorpcsolver;           ///< flag to monitor PC solver
     bool eigvalsestimated;          ///< flag if eigenvalues have already been estimated
     bool checkhesssymmetry;         ///< check symmetry of hessian operator
     ScalarType hessshift;           ///< perturbation to hessian operator
+    int nrecycle;                   ///< number of ritz vectors recycled between newton iterations (deflation; 0: off)
+    bool warmstart;                 ///< flag: initial guess of hessian solve is solution of previous solve
+    int pclbfgsmem;                 ///< number of secant pairs of quasi-newton preconditioner
+    int hesscoarsent;               ///< coarsening factor of time grid for hessian matvecs (multi-fidelity; 1: off)
+    ScalarType hessfidelitytol;     ///< relative gradient norm below which hessian matvecs use the full time grid
+    int hessblock;                  ///< max number of hessian matvecs that share the transport of the incremental equations
 };
 
 
@@ -346,6 +367,7 @@ struct ParCont {
     ScalarType targetbeta;                              ///< target regularization parameter
     ScalarType beta0;                                   ///< initial regularization parameter
     ScalarType stepsize;
+    int ngroups;                                        ///< number of task groups that probe beta concurrently (binary search)
 };
 
 
@@ -440,13 +462,36 @@ struct PDESolver {
     PDESolverType type;
     PDEType pdetype;
     int rkorder;
-    int iporder;
+    Interp3_Kernel ipkernel;     ///< interpolation kernel for semi-lagrangian method (defines ghost width)
+    int ipcompress;              ///< bits per coordinate for compressed scatter of query points (0: off; 16 or 21)
+    int ipvariant;               ///< implementation of the cubic kernel (Interp3_Variant; -1: compiled default)
+    bool iptune;                 ///< autotune ipvariant at the first interpolation
+    bool iptuned;                ///< ipvariant has been determined by the autotuner
+    int ipsort;                  ///< morton order of query points (-1: if stencils are scattered; 0: off; 1: on)
+    ScalarType histtol;          ///< absolute error bound for lossy compression of the time history of m (0: off)
+    bool mixedprecision;         ///< store time history of m in single precision (optimizer stays in PetscReal)
     ScalarType cflnumber;
     bool monitorcflnumber;
     bool adapttimestep;
 };
 
 
+/*! parameters for planning a run (memory footprint and runtime) */
+struct ResourcePlan {
+    bool enabled;         ///< flag: estimate resources and exit (do not run the registration)
+    int nprocs;           ///< number of mpi tasks to plan for (0: size of communicator)
+    ScalarType memory;    ///< available memory per mpi task in GB (0: physical memory of node / tasks per node)
+};
+
+
+/*! placement of field data and threads (numa) */
+struct MemoryPolicy {
+    bool firsttouch;      ///< flag: first touch fields with the static omp schedule of the compute loops
+    bool hugepages;       ///< flag: hint for transparent huge pages (time histories and ghost buffers)
+    bool pinthreads;      ///< flag: pin omp threads to cores
+};
+
+
 /*! parameter for grid continuation */
 struct Logger {
     enum TimerValue {LOG = 0, MIN, MAX, AVG, NVALTYPES};
@@ -466,7 +511,7 @@ struct Logger {
     bool timerruns[NTIMERS];
     unsigned int counter[NCOUNTERS];
     double ffttimers[NFFTTIMERS][NVALTYPES];
-    double iptimers[4][NVALTYPES];
+    double iptimers[NINTERPTIMERS][NVALTYPES];
 };
 
 
@@ -512,11 +557,17 @@ class RegOpt {
             this->m_FFTTimers[i][LOG] += timers[i];
         }
     }
-    inline void IncreaseInterpTimers(const double timers[4]) {
-        for (int i = 0; i < 4; ++i) {
+    inline void IncreaseInterpTimers(const double timers[NINTERPTIMERS]) {
+        for (int i = 0; i < NINTERPTIMERS; ++i) {
             this->m_InterpTimers[i][LOG] += timers[i];
         }
     }
+    /* load imbalance (max/avg across ranks) of an interpolation timer or
+       counter; only valid on rank 0 after ProcessTimers */
+    inline double GetInterpImbalance(const int i) {
+        return this->m_InterpTimers[i][AVG] > 0.0 ?
+               this->m_InterpTimers[i][MAX]/this->m_InterpTimers[i][AVG] : 1.0;
+    }
 
     inline void LogKSPResidual(const int i, const ScalarType value){
         this->m_Log.krylovresidual.push_back(value);
@@ -540,6 +591,7 @@ class RegOpt {
     PetscErrorCode ResetTimer(TimerType);
     PetscErrorCode ResetCounters(void);
     PetscErrorCode ResetCounter(CounterType);
+    PetscErrorCode AddTimersAndCounters(RegOpt*);
     PetscErrorCode ProcessTimers(void);
 
     PetscScalar m_GPUtime = 0;
@@ -585,6 +637,8 @@ class RegOpt {
     ParCont m_ParaCont {};               ///< flags for parameter continuation
     SolveType m_SolveType {};            ///< solver
     FileNames m_FileNames {};            ///< file names for input/output
+    ResourcePlan m_Plan {};              ///< parameters for planning a run
+    MemoryPolicy m_MemoryPolicy {};      ///< placement of field data and threads
     Logger m_Log {};                     ///< log
     ScalarType m_Sigma[3];               ///< standard deviation for gaussian smoothing
 
@@ -600,6 +654,10 @@ class RegOpt {
     std::vector<int> m_LabelIDs;       ///< label ids
     std::string m_PostFix;
 
+    MPI_Comm m_Comm;                    ///< communicator of the problem (subset of the tasks for coarse grid and continuation solves)
+    WorkSpace* m_WorkSpace = NULL;      ///< pool for work fields (shared with copies of the options)
+    bool m_WorkSpaceOwner = false;      ///< flag: pool is deleted with the options
+
 
  protected:
     virtual PetscErrorCode Initialize(void);
@@ -626,7 +684,7 @@ class RegOpt {
     unsigned int m_Counter[NCOUNTERS];
     double m_FFTTimers[NFFTTIMERS][NVALTYPES];
     double m_FFTAccumTime;
-    double m_InterpTimers[4][NVALTYPES];
+    double m_InterpTimers[NINTERPTIMERS][NVALTYPES];
     double m_IPAccumTime;
     double m_IPSlowest;
     double m_TTSSlowest;
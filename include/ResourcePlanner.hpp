@@ -0,0 +1,121 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _RESOURCEPLANNER_HPP_
+#define _RESOURCEPLANNER_HPP_
+
+#include "RegOpt.hpp"
+#include "CLAIREUtils.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief estimates the memory footprint (per mpi task) and the
+ * runtime of a registration from the options alone (nothing is
+ * allocated); the memory model lists the persistent buffers of the
+ * solver (time histories, work fields, fft and ghost buffers,
+ * interpolation plans, image pyramid, coarse grids of the two-level
+ * or multilevel preconditioner); the runtime model counts ffts and interpolations
+ * and prices them with nominal rates; the planner picks the process
+ * grid and the storage mode for the time history of the state
+ * variable that fit into the available memory
+ *******************************************************************/
+class ResourcePlanner {
+ public:
+    typedef ResourcePlanner Self;
+
+    ResourcePlanner();
+    ResourcePlanner(RegOpt*);
+    virtual ~ResourcePlanner();
+
+    /*! estimate resources and display plan */
+    PetscErrorCode Run();
+
+ protected:
+    PetscErrorCode Initialize();
+    PetscErrorCode ClearMemory();
+
+    /* storage of the time history of the state variable */
+    enum StorageMode {INMEMORY = 0, COMPRESSED, OUTOFCORE, NSTORAGEMODES};
+
+    /* estimated runtimes */
+    enum RuntimeType {FWDSOLVE = 0, GRADIENT, HESSMATVEC, NEWTONITER, NRUNTIMES};
+
+    /* persistent buffer (per mpi task) */
+    struct Buffer {
+        std::string name;   ///< name of buffer
+        double bytes;       ///< size in bytes
+    };
+
+    /* data distribution of a grid for a given process grid */
+    struct Layout {
+        IntType nx[3];      ///< grid size
+        IntType isize[3];   ///< local size in spatial domain
+        double nl;          ///< number of local grid points
+        double ng;          ///< number of grid points
+        double nalloc;      ///< size of fft buffer (bytes)
+        double nghost;      ///< size of scalar field with ghost layers (bytes)
+        int order;          ///< order of interpolation kernel
+        int cgrid[2];       ///< process grid
+    };
+
+    PetscErrorCode ComputeLayout(Layout&, const IntType*, const int*, Interp3_Kernel);
+    PetscErrorCode GetCoarseGridSize(IntType*, int);
+    PetscErrorCode GetCoarseProcessGrid(int*, const int*);
+    PetscErrorCode EstimateMemory(std::vector<Buffer>&, const int*, StorageMode);
+    PetscErrorCode AddSolverBuffers(std::vector<Buffer>&, const Layout&, StorageMode, std::string);
+    PetscErrorCode EstimateRuntime(double*, const int*);
+    PetscErrorCode EstimateSolverCosts(double*, double&, const Layout&);
+    PetscErrorCode SelectProcessGrid(int*, StorageMode&, bool&, int);
+    PetscErrorCode GetMinNumProcs(int&, bool);
+    PetscErrorCode GetAvailableMemory();
+    PetscErrorCode GetPeakMemory(double&, const int*, StorageMode);
+
+    bool IsFeasible(const int*);
+    bool IsAvailable(StorageMode);
+    int GetNumKrylovVectors(KrylovMethodType);
+
+    static constexpr double FFTRATE = 1E9;      ///< nominal flop rate of fft per thread (flop/s)
+    static constexpr double IPRATE = 1E9;       ///< nominal flop rate of interpolation per thread (flop/s)
+    static constexpr double NETRATE = 1E9;      ///< nominal network bandwidth per mpi task (byte/s)
+    static constexpr double MEMFRACTION = 0.85; ///< fraction of memory available to the solver (mpi, petsc, os)
+    static const int NUMMATVECS = 10;           ///< assumed number of hessian matvecs per newton iteration
+    static const int NUMSTAGED = 5;             ///< staged and buffered time points of out-of-core history
+
+    int m_NumProcs;             ///< number of mpi tasks to plan for
+    double m_AvailableMemory;   ///< available memory per mpi task (bytes)
+
+    RegOpt* m_Opt;
+};
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _RESOURCEPLANNER_HPP_
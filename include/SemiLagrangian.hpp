@@ -51,6 +51,9 @@ class SemiLagrangian {
     /*! interpolate scalar field */
     virtual PetscErrorCode Interpolate(ScalarType*, ScalarType*, std::string);
 
+    /*! interpolate a stack of scalar fields (all image components, or blocks of fields) at once */
+    virtual PetscErrorCode Interpolate(ScalarType*, ScalarType*, IntType, std::string);
+
     /*! interpolate vector field */
     virtual PetscErrorCode Interpolate(ScalarType*, ScalarType*, ScalarType*,
                                        ScalarType*, ScalarType*, ScalarType*,
@@ -64,11 +67,24 @@ class SemiLagrangian {
     PetscErrorCode SetReadWrite(ReadWriteReg*);
     PetscErrorCode SetWorkVecField(VecField*);
 
+    /*! set time step size of trajectory (default: time step size of options) */
+    PetscErrorCode SetTimeStepSize(ScalarType);
+
  protected:
     PetscErrorCode Initialize();
     PetscErrorCode ClearMemory();
 
     virtual PetscErrorCode CommunicateCoord(std::string);
+
+    /*! set dofs of the plan versions */
+    PetscErrorCode SetPlanDofs();
+
+    /*! compute cubic b-spline coefficients of a scalar field (spectral prefilter) */
+    PetscErrorCode ApplyBSplinePrefilter(ScalarType*, ScalarType*);
+
+    /*! select the fastest implementation of the cubic kernel (autotuning) */
+    PetscErrorCode TuneInterpolation(Interp3_Plan*, ScalarType*);
+
     PetscErrorCode ComputeTrajectoryRK2(VecField*, std::string);
     PetscErrorCode ComputeTrajectoryRK4(VecField*, std::string);
 
@@ -83,8 +99,15 @@ class SemiLagrangian {
     ScalarType* m_X;
     ScalarType* m_ScaFieldGhost;
     ScalarType* m_VecFieldGhost;
-
-    int m_Dofs[2];
+    ScalarType* m_MultiFieldGhost;  ///< multi-component scalar field with ghost points
+    ScalarType* m_ScaFieldCoeff;    ///< b-spline coefficients of scalar field (prefiltered input)
+    ComplexType* m_xhat;            ///< spectral work array for b-spline prefilter
+
+    /*! dofs of the plan versions (scalar field, vector field, all image components,
+        block of image components, block of vector fields) */
+    int m_Dofs[5];
+    int m_NumPlanVersions;      ///< number of plan versions (blocks only if hessian matvecs are batched)
+    ScalarType m_TimeStepSize;  ///< time step size of trajectory (0: use time step size of options)
 
     struct GhostPoints {
         int isize[3];
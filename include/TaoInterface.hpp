@@ -45,10 +45,15 @@ PetscErrorCode HessianMatVec(Mat, Vec, Vec);
 PetscErrorCode PrecondMatVec(PC, Vec, Vec);
 
 PetscErrorCode CheckConvergenceGrad(Tao, void*);
+PetscErrorCode CheckConvergenceGrad(OptimizationProblem*, IntType, IntType,
+                                    ScalarType, ScalarType, ScalarType,
+                                    ScalarType, ScalarType, TaoConvergedReason&);
 PetscErrorCode CheckConvergenceGradObj(Tao, void*);
 PetscErrorCode CheckConvergenceGradObjHess(Tao, void*);
 
 PetscErrorCode OptimizationMonitor(Tao, void*);
+PetscErrorCode OptimizationMonitor(OptimizationProblem*, Vec, IntType,
+                                   ScalarType, ScalarType, ScalarType, TaoConvergedReason);
 PetscErrorCode GetLineSearchStatus(Tao, void*);
 PetscErrorCode GetSolverStatus(TaoConvergedReason, std::string&);
 
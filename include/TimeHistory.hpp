@@ -0,0 +1,137 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _TIMEHISTORY_HPP_
+#define _TIMEHISTORY_HPP_
+
+#include <future>
+#include "RegOpt.hpp"
+#include "CLAIREUtils.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief container for the time history of a (multi-component)
+ * scalar field with lossy compression; every component at every
+ * time point is split into blocks of BLOCKSIZE values; each block
+ * is quantized with a fixed step size (twice the error bound) with
+ * 0, 8, or 16 bit per value, depending on the range of the values
+ * in the block (blocks that do not fit into 16 bit are stored in
+ * full precision); the absolute error of the decompressed values
+ * is bounded by the tolerance; in single precision mode, "full
+ * precision" blocks are stored as float (the solver converts at
+ * the interface of the container); if a scratch folder is set, the
+ * time points are written to a (node-local) file instead of being
+ * kept in memory; writes are asynchronous and double buffered, and
+ * reads can be prefetched (NSLOTS time points are staged in memory)
+ *******************************************************************/
+class TimeHistory {
+ public:
+    typedef TimeHistory Self;
+
+    TimeHistory();
+    TimeHistory(RegOpt*);
+    virtual ~TimeHistory();
+
+    /*! allocate storage for nt+1 time points of nc components */
+    PetscErrorCode SetSizes(IntType, IntType, IntType);
+
+    /*! set absolute error bound for compression (0: lossless) */
+    PetscErrorCode SetTolerance(ScalarType);
+
+    /*! store uncompressed blocks in single precision */
+    PetscErrorCode SetSinglePrecision(bool);
+
+    /*! store time history out-of-core (in given folder) */
+    PetscErrorCode SetScratchFolder(std::string);
+
+    /*! compress and store all components at given time point */
+    PetscErrorCode SetTimePoint(const ScalarType*, IntType);
+
+    /*! decompress component at given time point (into internal buffer) */
+    PetscErrorCode GetTimePoint(ScalarType*&, IntType, IntType);
+
+    /*! asynchronously load time point (out-of-core storage only) */
+    PetscErrorCode Prefetch(IntType);
+
+    /*! compute ratio between uncompressed and compressed size (all ranks) */
+    PetscErrorCode GetCompressionRatio(ScalarType&);
+
+ protected:
+    PetscErrorCode Initialize();
+    PetscErrorCode ClearMemory();
+
+    PetscErrorCode EncodeComponent(const ScalarType*, std::vector<unsigned char>&, IntType, std::vector<IntType>&);
+    PetscErrorCode DecodeComponent(ScalarType*, const unsigned char*, const std::vector<IntType>&);
+
+    PetscErrorCode OpenScratchFile();
+    PetscErrorCode WaitForWrites();
+    PetscErrorCode GetSlot(int&, IntType);
+
+    static const IntType BLOCKSIZE = 256;  ///< number of values per block
+    static const int NSLOTS = 3;           ///< number of staged time points (out-of-core)
+
+    /* time point staged in memory (out-of-core storage) */
+    struct Slot {
+        IntType timepoint;                  ///< index of time point (-1: empty)
+        std::vector<unsigned char> data;    ///< compressed time point
+        std::future<long> request;          ///< pending read
+    };
+
+    IntType m_NumTimePoints;   ///< number of time points (nt+1)
+    IntType m_NumComponents;   ///< number of components
+    IntType m_NumValues;       ///< number of values per component (local)
+    IntType m_NumBlocks;       ///< number of blocks per component
+
+    ScalarType m_Tolerance;    ///< absolute error bound
+    bool m_SinglePrecision;    ///< flag: store uncompressed blocks as float
+
+    std::vector< std::vector<unsigned char> > m_Data;   ///< compressed blocks (per time point and component)
+    std::vector< std::vector<IntType> > m_Offset;       ///< offset of blocks in compressed data
+    std::vector<unsigned char> m_Width;                 ///< bits per value for each block (work array)
+    ScalarType* m_Buffer;                               ///< decompressed component
+
+    std::string m_ScratchFolder;        ///< folder for out-of-core storage (empty: in memory)
+    int m_FileDescriptor;               ///< scratch file (-1: not open)
+    IntType m_SliceCapacity;            ///< max number of bytes per time point in scratch file
+    std::vector<IntType> m_SliceBytes;  ///< number of bytes per time point in scratch file
+    std::vector<IntType> m_Start;       ///< start of components within time point (out-of-core)
+    Slot m_Slot[NSLOTS];                ///< staged time points
+    std::vector<unsigned char> m_WriteBuffer[2];    ///< double buffer for writes
+    std::future<long> m_WriteRequest[2];            ///< pending writes
+    int m_WriteSlot;                                ///< next write buffer
+
+    RegOpt* m_Opt;
+};
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _TIMEHISTORY_HPP_
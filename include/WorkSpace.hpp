@@ -0,0 +1,147 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _WORKSPACE_HPP_
+#define _WORKSPACE_HPP_
+
+#include <map>
+#include "RegOpt.hpp"
+#include "CLAIREUtils.hpp"
+#include "VecField.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief pool of memory for temporary (work) fields; the memory is
+ * handed out as leases (PETSc vectors that wrap a pooled buffer) and
+ * returned to the pool when the lease goes out of scope; a request
+ * is served by the smallest free buffer that is large enough, i.e.,
+ * fields on a coarse grid reuse the memory of fields on a fine grid
+ * if their lifetimes do not overlap; the pool is shared between the
+ * options of all grid levels (see RegOpt::Copy); live and peak usage
+ * are tracked for every subsystem (owner) that acquires a lease
+ *******************************************************************/
+class WorkSpace {
+ public:
+    typedef WorkSpace Self;
+
+    /* lease of a scalar field */
+    class ScaFieldLease {
+     public:
+        ScaFieldLease();
+        ~ScaFieldLease();
+
+        /*! get field with given communicator and local/global size from pool */
+        PetscErrorCode Acquire(WorkSpace*, MPI_Comm, IntType, IntType, std::string);
+
+        /*! return field to pool (done by destructor if not called) */
+        PetscErrorCode Release();
+
+        Vec m_X;    ///< leased field
+
+     private:
+        ScaFieldLease(const ScaFieldLease&);
+        ScaFieldLease& operator=(const ScaFieldLease&);
+
+        WorkSpace* m_WorkSpace;
+    };
+
+    /* lease of a vector field (three pooled components) */
+    class VecFieldLease {
+     public:
+        VecFieldLease();
+        ~VecFieldLease();
+
+        /*! get vector field on grid defined by options from pool */
+        PetscErrorCode Acquire(WorkSpace*, RegOpt*, std::string);
+
+        /*! return components to pool (done by destructor if not called) */
+        PetscErrorCode Release();
+
+        VecField* m_X;  ///< leased field
+
+     private:
+        VecFieldLease(const VecFieldLease&);
+        VecFieldLease& operator=(const VecFieldLease&);
+
+        WorkSpace* m_WorkSpace;
+    };
+
+    WorkSpace();
+    virtual ~WorkSpace();
+
+    /*! get scalar field from pool */
+    PetscErrorCode GetScaField(Vec&, MPI_Comm, IntType, IntType, std::string);
+
+    /*! return scalar field to pool */
+    PetscErrorCode ReturnScaField(Vec&);
+
+    /*! release buffers that are not leased */
+    PetscErrorCode Shrink();
+
+    /*! display live and peak usage per subsystem (max over all ranks) */
+    PetscErrorCode Report(MPI_Comm);
+
+ protected:
+    PetscErrorCode Initialize();
+    PetscErrorCode ClearMemory();
+
+    struct Buffer {
+        ScalarType* data;           ///< memory (aligned as fft data)
+        IntType capacity;           ///< number of values
+        bool inuse;                 ///< flag: buffer is leased
+    };
+
+    struct Lease {
+        Vec x;                      ///< vector that wraps buffer
+        int buffer;                 ///< index of buffer
+        IntType nl;                 ///< number of values (local)
+        std::string owner;          ///< subsystem that holds the lease
+    };
+
+    struct Usage {
+        double live;                ///< bytes currently leased
+        double peak;                ///< max bytes leased at any time
+        long count;                 ///< number of leases
+    };
+
+    std::vector<Buffer> m_Buffer;               ///< pooled buffers
+    std::vector<Lease> m_Lease;                 ///< active leases
+    std::map<std::string, Usage> m_Usage;       ///< usage per subsystem
+
+    double m_LiveBytes;     ///< bytes currently leased (all subsystems)
+    double m_PeakBytes;     ///< max bytes leased at any time (all subsystems)
+    double m_PoolBytes;     ///< bytes allocated by pool
+};
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _WORKSPACE_HPP_
@@ -44,7 +44,9 @@
 
 #define COORD_DIM 3
 #include <mpi.h>
+#include <stdint.h>
 #include <vector>
+#include <utility>
 #include <interp3_common.hpp>
 #include <set>
 #include <compact_mem_mgr.hpp>
@@ -81,6 +83,28 @@ void interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
 		Real* query_points, Real* query_values, int interp_order,
 		bool query_values_already_scaled = false); // higher order interpolation
 
+void linear_interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
+		int * N_reg_g, int* isize_g, int* istart, const int N_pts, int g_size,
+		Real* query_points, Real* query_values,
+		bool query_values_already_scaled = false); // linear interpolation
+
+void bspline_interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
+		int * N_reg_g, int* isize_g, int* istart, const int N_pts, int g_size,
+		Real* query_points, Real* query_values,
+		bool query_values_already_scaled = false); // cubic b-spline interpolation (prefiltered input)
+
+void batched_interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
+		int * N_reg_g, int* isize_g, int* istart, const int N_pts, int g_size,
+		Real* query_points, Real* query_values,
+		bool query_values_already_scaled = false); // cubic interpolation of several fields (shared weights)
+
+bool interp3_variant_available(int variant);
+
+void interp3_variant_ghost_xyz_p(int variant, Real* reg_grid_vals, int data_dof, int* N_reg,
+		int * N_reg_g, int* isize_g, int* istart, const int N_pts, int g_size,
+		Real* query_points, Real* query_values,
+		bool query_values_already_scaled = false); // cubic interpolation (selected variant)
+
 void interp3_ghost_p(Real* reg_grid_vals, int data_dof, int* N_reg,
 		int * N_reg_g, int* isize_g, int* istart, const int N_pts, int g_size,
 		Real* query_points, Real* query_values);
@@ -114,9 +138,20 @@ public:
 			int * isize, int* istart, const int N_pts, const int g_size,
 			Real* query_values, int* c_dims, MPI_Comm c_comm, double * timings, int interp_order);
 
+	int autotune(Real* ghost_reg_grid_vals, int* N_reg, int* isize, int* istart,
+			const int g_size, MPI_Comm c_comm, double* variant_timings, int version = 0);
+
+	void reserve_scatter_buffers(size_t n_query, size_t n_f);
+	void sort_query_points(double* timings);
+	void commit_types(const int N_pts);
+
 	int N_reg_g[3];
 	int isize_g[3];
+	int kernel; // interpolation kernel (Interp3_Kernel); default is INTERP3_CUBIC
+	int variant; // implementation of the cubic kernel (Interp3_Variant); -1 is the compiled default
+	int variant_version; // plan version the variant has been tuned on; -1 applies it to all versions
 	int total_query_points;
+	int offrank_query_points; // query points sent to or received from other procs
 	int data_dof_max;
   int nplans_;
   pvfmm::Iterator<int> data_dofs_;
@@ -125,6 +160,27 @@ public:
 
   pvfmm::Iterator<Real> all_query_points;
   pvfmm::Iterator<Real> all_f_cubic;
+  size_t all_query_points_capacity; // allocated size of all_query_points (grow-only)
+  size_t all_f_cubic_capacity; // allocated size of all_f_cubic (grow-only)
+
+  // compressed scatter of the query points: 0 sends raw Real coordinates;
+  // 16 or 21 sends fixed point offsets relative to the destination pencil
+  int compress_bits;
+  std::vector<uint16_t> query_send_packed; // encoded coordinates sent to other procs
+  std::vector<uint16_t> query_recv_packed; // encoded coordinates received from other procs
+
+  // morton ordering of the received query points: -1 sorts if the stencils of
+  // consecutive points do not overlap (large deformations), 0 never, 1 always
+  int query_sort;
+  bool query_sorted; // the query points of the last scatter have been sorted
+  std::vector<int> query_perm; // position of the i-th sorted point in scatter order
+  std::vector<std::pair<uint64_t, int> > query_keys; // morton keys (scratch)
+  std::vector<Real> query_tmp; // coordinates (scratch)
+  std::vector<Real> query_f_sorted; // interpolated values in sorted order (scratch)
+
+  // strides the committed stypes/rtypes (one per version) were built for
+  int types_N_pts_, types_total_query_points_;
+  bool types_baked;
   pvfmm::Iterator<Real> f_cubic_unordered;
 
   pvfmm::Iterator<int> f_index_procs_others_offset; // offset in the all_query_points array
@@ -1,6 +1,119 @@
 #ifndef _INTERP3_COMMON_HPP_
 #define _INTERP3_COMMON_HPP_
 
+#include <cstring>
+
 // #define SORT_QUERIES
 
+/*
+ * Interpolation kernels available in Interp3_Plan::interpolate. Each kernel
+ * is described by the polynomial order of its 1D basis (the stencil has
+ * order+1 points per axis) and by the number of ghost layers it needs around
+ * the local pencil. Query points are accepted up to one grid cell outside of
+ * the pencil (see Interp3_Plan::scatter), which gives g_size = (order+1)/2 + 1.
+ */
+enum Interp3_Kernel {
+  INTERP3_LINEAR = 0,  // trilinear, 2x2x2 stencil
+  INTERP3_CUBIC,       // cubic lagrange, 4x4x4 stencil (default)
+  INTERP3_BSPLINE,     // cubic b-spline, 4x4x4 stencil (prefiltered input)
+  INTERP3_QUINTIC,     // quintic lagrange, 6x6x6 stencil
+  INTERP3_NKERNELS
+};
+
+struct Interp3_KernelInfo {
+  const char* name;  // name of the kernel (used on the command line)
+  int order;         // polynomial order of the 1D basis
+  int g_size;        // number of ghost layers required by the stencil
+  bool prefilter;    // grid values have to be converted to spline coefficients
+};
+
+static const Interp3_KernelInfo interp3_kernels[INTERP3_NKERNELS] = {
+  {"linear",  1, 2, false},
+  {"cubic",   3, 3, false},
+  {"bspline", 3, 3, true},
+  {"quintic", 5, 4, false},
+};
+
+inline const char* interp3_kernel_name(int kernel) {
+  return interp3_kernels[kernel].name;
+}
+
+inline int interp3_kernel_order(int kernel) {
+  return interp3_kernels[kernel].order;
+}
+
+inline int interp3_kernel_ghost_size(int kernel) {
+  return interp3_kernels[kernel].g_size;
+}
+
+inline bool interp3_kernel_prefilter(int kernel) {
+  return interp3_kernels[kernel].prefilter;
+}
+
+/*
+ * Entries of the timings array passed to Interp3_Plan::scatter/interpolate.
+ * The first INTERP3_NQUERIES entries are wall clock times; the remaining ones
+ * are per rank load counters (used to monitor load imbalance, since departure
+ * points of large deformations pile up on a few ranks).
+ */
+enum Interp3_Timer {
+  INTERP3_COMM = 0,   // communication of query points and interpolated values
+  INTERP3_EXEC,       // local interpolation
+  INTERP3_ALLOC,      // allocation
+  INTERP3_SORT,       // sorting of query points
+  INTERP3_NQUERIES,   // number of query points interpolated by this rank
+  INTERP3_NBYTES,     // number of bytes sent and received by this rank
+  NINTERPTIMERS
+};
+
+/*
+ * Implementations of the cubic lagrange kernel. Which one is fastest depends
+ * on the CPU, the precision and the size of the local pencil, so the variant
+ * can be selected at run time (Interp3_Plan::variant) and autotuned (see
+ * Interp3_Plan::autotune). A variant of -1 uses the compiled default.
+ */
+enum Interp3_Variant {
+  INTERP3_VAR_OPTIMIZED = 0,  // optimized_interp3_ghost_xyz_p (default w/o simd)
+  INTERP3_VAR_GOLD,           // gold_optimized_interp3_ghost_xyz_p
+  INTERP3_VAR_V1,             // _optimized_interp3_ghost_xyz_p
+  INTERP3_VAR_V3,             // ___optimized_interp3_ghost_xyz_p
+  INTERP3_VAR_V4,             // _v4_optimized_interp3_ghost_xyz_p
+  INTERP3_VAR_BATCHED,        // batched_interp3_ghost_xyz_p (all fields at once)
+  INTERP3_VAR_GENERIC,        // interp3_ghost_xyz_p (reference; modulo addressing)
+  INTERP3_VAR_VECTORIZED,     // vectorized_interp3_ghost_xyz_p (FAST_INTERPV only)
+  INTERP3_NVARIANTS
+};
+
+static const char* const interp3_variant_names[INTERP3_NVARIANTS] = {
+  "optimized", "gold", "v1", "v3", "v4", "batched", "generic", "vectorized"
+};
+
+inline const char* interp3_variant_name(int variant) {
+  return variant < 0 ? "default" : interp3_variant_names[variant];
+}
+
+/* look up a variant by name; returns -1 if the name is unknown */
+inline int interp3_variant_from_name(const char* name) {
+  for (int i = 0; i < INTERP3_NVARIANTS; ++i) {
+    if (strcmp(interp3_variant_names[i], name) == 0) return i;
+  }
+  return -1;
+}
+
+/* look up a kernel by name; returns -1 if the name is unknown */
+inline int interp3_kernel_from_name(const char* name) {
+  for (int i = 0; i < INTERP3_NKERNELS; ++i) {
+    if (strcmp(interp3_kernels[i].name, name) == 0) return i;
+  }
+  return -1;
+}
+
+/* look up a kernel by polynomial order; returns -1 if there is none */
+inline int interp3_kernel_from_order(int order) {
+  for (int i = 0; i < INTERP3_NKERNELS; ++i) {
+    if (interp3_kernels[i].order == order) return i;
+  }
+  return -1;
+}
+
 #endif
@@ -130,7 +130,49 @@ PetscErrorCode BenchmarkOpt::ParseArguments(int argc, char** argv) {
             this->m_PDESolver.cflnumber = atof(argv[1]);
         } else if (strcmp(argv[1], "-iporder") == 0) {
             argc--; argv++;
-            this->m_PDESolver.iporder = atoi(argv[1]);
+            if (interp3_kernel_from_order(atoi(argv[1])) < 0) {
+                msg = "\n\x1b[31m no interpolation kernel of order: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+            this->m_PDESolver.ipkernel = static_cast<Interp3_Kernel>(interp3_kernel_from_order(atoi(argv[1])));
+        } else if (strcmp(argv[1], "-ipkernel") == 0) {
+            argc--; argv++;
+            if (interp3_kernel_from_name(argv[1]) < 0) {
+                msg = "\n\x1b[31m interpolation kernel not defined: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+            this->m_PDESolver.ipkernel = static_cast<Interp3_Kernel>(interp3_kernel_from_name(argv[1]));
+        } else if (strcmp(argv[1], "-ipsweep") == 0) {
+            this->m_InterpSweep = true;
+        } else if (strcmp(argv[1], "-ipcompress") == 0) {
+            argc--; argv++;
+            this->m_PDESolver.ipcompress = atoi(argv[1]);
+            if (this->m_PDESolver.ipcompress != 16 && this->m_PDESolver.ipcompress != 21) {
+                msg = "\n\x1b[31m compressed scatter supports 16 or 21 bits: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-ipsort") == 0) {
+            argc--; argv++;
+            if (strcmp(argv[1], "auto") == 0) {
+                this->m_PDESolver.ipsort = -1;
+            } else if (strcmp(argv[1], "off") == 0) {
+                this->m_PDESolver.ipsort = 0;
+            } else if (strcmp(argv[1], "on") == 0) {
+                this->m_PDESolver.ipsort = 1;
+            } else {
+                msg = "\n\x1b[31m sorting of query points not defined: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-vmag") == 0) {
+            argc--; argv++;
+            this->m_VelocityMagnitude = atof(argv[1]);
+        } else if (strcmp(argv[1], "-nc") == 0) {
+            argc--; argv++;
+            this->m_Domain.nc = static_cast<IntType>(atoi(argv[1]));
         } else if (strcmp(argv[1], "-nthreads") == 0) {
             argc--; argv++;
             this->m_NumThreads = atoi(argv[1]);
@@ -161,6 +203,8 @@ PetscErrorCode BenchmarkOpt::ParseArguments(int argc, char** argv) {
             this->m_BenchmarkID = 2;
         } else if (strcmp(argv[1], "-terror") == 0) {
             this->m_BenchmarkID = 3;
+        } else if (strcmp(argv[1], "-interp") == 0) {
+            this->m_BenchmarkID = 4;
         } else if (strcmp(argv[1], "-repeats") == 0) {
             argc--; argv++;
             this->m_NumRepeats = atoi(argv[1]);
@@ -225,6 +269,8 @@ PetscErrorCode BenchmarkOpt::Initialize() {
 
     this->m_BenchmarkID = -1;
     this->m_NumRepeats = 1;
+    this->m_VelocityMagnitude = 1.0;
+    this->m_InterpSweep = false;
 
     PetscFunctionReturn(ierr);
 }
@@ -256,6 +302,11 @@ PetscErrorCode BenchmarkOpt::Usage(bool advanced) {
         std::cout << " -gradient                   benchmark gradient evaluation"<<std::endl;
         std::cout << " -repeats <int>              set number of repeats"<<std::endl;
         std::cout << " -terror                     compute numerical error for solution of transport equation"<<std::endl;
+        std::cout << " -interp                     benchmark the parts of the semi-lagrangian interpolation (scatter of query"<<std::endl;
+        std::cout << "                             points, ghost exchange, local kernel, gather) for 1, 3 and nc fields"<<std::endl;
+        std::cout << " -vmag <dbl>                 maximal displacement of the query points in grid cells (for '-interp';"<<std::endl;
+        std::cout << "                             default: 1)"<<std::endl;
+        std::cout << " -ipsweep                    run '-interp' for all interpolation kernels"<<std::endl;
         std::cout << " -logwork                    log work load (requires -x option)"<<std::endl;
         if (advanced) {
         std::cout << line << std::endl;
@@ -284,7 +335,11 @@ PetscErrorCode BenchmarkOpt::Usage(bool advanced) {
         std::cout << " -nt <int>                   number of time points (for time integration; default: 4)"<<std::endl;
         std::cout << " -adapttimestep              vary number of time steps according to defined number"<<std::endl;
         std::cout << " -cflnumber <dbl>            set cfl number"<<std::endl;
-        std::cout << " -iporder <int>              order of interpolation model (default is 3)" << std::endl;
+        std::cout << " -iporder <int>              order of interpolation model (1, 3 or 5; default is 3)" << std::endl;
+        std::cout << " -ipkernel <type>            interpolation kernel (linear, cubic, bspline or quintic; default is cubic)" << std::endl;
+        std::cout << " -ipcompress <int>           compressed scatter of query points (16 or 21 bits per coordinate)" << std::endl;
+        std::cout << " -ipsort <type>              morton order of query points (auto, on or off; default is auto)" << std::endl;
+        std::cout << " -nc <int>                   number of image components (fields interpolated at once; default: 1)" << std::endl;
         std::cout << line << std::endl;
         // ####################### advanced options #######################
         std::cout << line << std::endl;
@@ -374,6 +429,12 @@ PetscErrorCode BenchmarkOpt::CheckArguments() {
 
 //    ierr = Assert(this->m_NumThreads > 0, "omp threads < 0"); CHKERRQ(ierr);
 
+    if (this->m_VelocityMagnitude < 0.0) {
+        msg = "\x1b[31m displacement magnitude has to be nonnegative\x1b[0m\n";
+        ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+        ierr = this->Usage(); CHKERRQ(ierr);
+    }
+
     if (this->m_BenchmarkID == -1) {
         msg = "\x1b[31m you need to define a benchmark test\x1b[0m\n";
         ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
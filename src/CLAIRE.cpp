@@ -35,6 +35,37 @@ namespace reg {
 
 
 
+/********************************************************************
+ * @brief swaps two semi-lagrangian methods for the lifetime of the
+ * object (or until Restore is called); the swap is undone on every
+ * path, including early returns on errors
+ *******************************************************************/
+class SemiLagrangianSwap {
+ public:
+    SemiLagrangianSwap(SemiLagrangian*& a, SemiLagrangian*& b, bool swap)
+        : m_A(a), m_B(b), m_Swapped(swap) {
+        if (this->m_Swapped) std::swap(this->m_A, this->m_B);
+    }
+    ~SemiLagrangianSwap() {
+        this->Restore();
+    }
+    void Restore() {
+        if (this->m_Swapped) std::swap(this->m_A, this->m_B);
+        this->m_Swapped = false;
+    }
+
+ private:
+    SemiLagrangianSwap(const SemiLagrangianSwap&);
+    SemiLagrangianSwap& operator=(const SemiLagrangianSwap&);
+
+    SemiLagrangian*& m_A;
+    SemiLagrangian*& m_B;
+    bool m_Swapped;
+};
+
+
+
+
 /********************************************************************
  * @brief default constructor
  *******************************************************************/
@@ -77,6 +108,12 @@ PetscErrorCode CLAIRE::Initialize() {
     this->m_IncStateVariable = NULL;    ///< incremental state variable
     this->m_IncAdjointVariable = NULL;  ///< incremental adjoint variable
 
+
+    this->m_StateHistory = NULL;        ///< compressed time history of state variable
+
+    this->m_TimeStride = 1;                     ///< hessian matvecs on full time grid
+    this->m_CoarseTimeSemiLagrangian = NULL;    ///< trajectories on coarse time grid
+
     PetscFunctionReturn(ierr);
 }
 
@@ -123,6 +160,15 @@ PetscErrorCode CLAIRE::ClearVariables(void) {
         ierr = VecDestroy(&this->m_IncAdjointVariable); CHKERRQ(ierr);
         this->m_IncAdjointVariable = NULL;
     }
+    if (this->m_StateHistory != NULL) {
+        delete this->m_StateHistory;
+        this->m_StateHistory = NULL;
+    }
+    if (this->m_CoarseTimeSemiLagrangian != NULL) {
+        delete this->m_CoarseTimeSemiLagrangian;
+        this->m_CoarseTimeSemiLagrangian = NULL;
+    }
+    this->m_TimeStride = 1;
 
     PetscFunctionReturn(ierr);
 }
@@ -146,28 +192,26 @@ PetscErrorCode CLAIRE::InitializeSolver(void) {
     nl = this->m_Opt->m_Domain.nl;
     ng = this->m_Opt->m_Domain.ng;
 
-    if (this->m_StateVariable == NULL) {
-        ierr = VecCreate(this->m_StateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
-    }
+    ierr = this->AllocateStateVariable(); CHKERRQ(ierr);
     if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
         if (this->m_AdjointVariable == NULL) {
-            ierr = VecCreate(this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         }
         if (this->m_IncAdjointVariable == NULL) {
-            ierr = VecCreate(this->m_IncAdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncAdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         }
         if (this->m_IncStateVariable == NULL) {
-            ierr = VecCreate(this->m_IncStateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncStateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         }
     } else {
         if (this->m_AdjointVariable == NULL) {
-            ierr = VecCreate(this->m_AdjointVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
         if (this->m_IncAdjointVariable == NULL) {
-            ierr = VecCreate(this->m_IncAdjointVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncAdjointVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
         if (this->m_IncStateVariable == NULL) {
-            ierr = VecCreate(this->m_IncStateVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncStateVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
     }
 
@@ -185,13 +229,13 @@ PetscErrorCode CLAIRE::InitializeSolver(void) {
     }
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField3 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
     }
 
     if (this->m_Opt->m_PDESolver.type == SL) {
@@ -261,15 +305,15 @@ PetscErrorCode CLAIRE::InitializeOptimization() {
             ierr = this->m_WorkVecField1->Copy(this->m_VelocityField); CHKERRQ(ierr);
         }
     }
-    ierr = VecCreate(g, 3*nl, 3*ng); CHKERRQ(ierr);
-    ierr = VecCreate(v, 3*nl, 3*ng); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, g, 3*nl, 3*ng, 3); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, v, 3*nl, 3*ng, 3); CHKERRQ(ierr);
     ierr = VecSet(v, 0.0); CHKERRQ(ierr);
 
     // if we use a non-zero initial guess, we compute
     // the first velocity using a steepest descent approach
     if (!this->m_Opt->m_OptPara.usezeroinitialguess) {
-        ierr = VecCreate(dv, 3*nl, 3*ng); CHKERRQ(ierr);
-        ierr = VecCreate(vtilde, 3*nl, 3*ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, dv, 3*nl, 3*ng, 3); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, vtilde, 3*nl, 3*ng, 3); CHKERRQ(ierr);
 
         lsred = 1E-4;  // reduction rate for line search
         for (int l = 0; l < 1; ++l) {
@@ -283,7 +327,7 @@ PetscErrorCode CLAIRE::InitializeOptimization() {
             ierr = this->EvaluateGradient(dv, v); CHKERRQ(ierr);
 
             // inner product between gradient and search direction
-            ierr = VecTDot(g, dv, &descent); CHKERRQ(ierr);
+            ierr = VecInnerProduct(g, dv, &descent); CHKERRQ(ierr);
 
             alpha = 1.0; lssuccess = false;
             for (int i = 0; i < 20; ++i) {
@@ -331,7 +375,7 @@ PetscErrorCode CLAIRE::InitializeOptimization() {
     ierr = this->EvaluateGradient(g, v); CHKERRQ(ierr);
 
     // compute gradient norm
-    ierr = VecNorm(g, NORM_2, &value); CHKERRQ(ierr);
+    ierr = VecNormL2(g, &value); CHKERRQ(ierr);
     this->m_Opt->m_Monitor.gradnorm0 = value;
 
     if (this->m_Opt->m_Verbosity > 0) {
@@ -359,6 +403,218 @@ PetscErrorCode CLAIRE::InitializeOptimization() {
 
 
 
+/********************************************************************
+ * @brief allocate the state variable; for the inversion we store
+ * the entire time history; if lossy compression (-histtol),
+ * out-of-core storage (-histdir) or single precision storage
+ * (-mixedprecision) is enabled, the time history is stored in
+ * m_StateHistory and the state variable only holds the current
+ * time point (m(t=1) after the forward solve); the solver reads
+ * and writes PetscReal, the conversion is done by the container
+ *******************************************************************/
+PetscErrorCode CLAIRE::AllocateStateVariable() {
+    PetscErrorCode ierr = 0;
+    IntType nt, nl, nc, ng;
+    bool usehistory;
+
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    nt = this->m_Opt->m_Domain.nt;
+    nc = this->m_Opt->m_Domain.nc;
+    nl = this->m_Opt->m_Domain.nl;
+    ng = this->m_Opt->m_Domain.ng;
+
+    usehistory = this->m_Opt->m_RegFlags.runinversion
+              && (this->m_Opt->m_PDESolver.histtol > 0.0
+                  || !this->m_Opt->m_FileNames.histdir.empty()
+                  || this->m_Opt->m_PDESolver.mixedprecision);
+
+    if (this->m_StateVariable == NULL) {
+        if (this->m_Opt->m_RegFlags.runinversion && !usehistory) {
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_StateVariable, (nt+1)*nl*nc, (nt+1)*ng*nc, (nt+1)*nc); CHKERRQ(ierr);
+        } else {
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_StateVariable, nl*nc, ng*nc, nc); CHKERRQ(ierr);
+        }
+    }
+
+    if (usehistory) {
+        if (this->m_StateHistory == NULL) {
+            try {this->m_StateHistory = new TimeHistory(this->m_Opt);}
+            catch (std::bad_alloc& err) {
+                ierr = reg::ThrowError(err); CHKERRQ(ierr);
+            }
+            ierr = this->m_StateHistory->SetTolerance(this->m_Opt->m_PDESolver.histtol); CHKERRQ(ierr);
+            ierr = this->m_StateHistory->SetSinglePrecision(this->m_Opt->m_PDESolver.mixedprecision); CHKERRQ(ierr);
+            if (!this->m_Opt->m_FileNames.histdir.empty()) {
+                ierr = this->m_StateHistory->SetScratchFolder(this->m_Opt->m_FileNames.histdir); CHKERRQ(ierr);
+            }
+        }
+        // number of time steps may have changed (adaptive time stepping)
+        ierr = this->m_StateHistory->SetSizes(nt, nc, nl); CHKERRQ(ierr);
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief get pointer to component k of the state variable at time
+ * point j; if the time history is compressed, the data is
+ * decompressed into a buffer that is valid until the next call; j
+ * refers to the time grid of the hessian matvecs (every m_TimeStride-th
+ * time point of the state variable)
+ * @param[out] p_mj pointer to m_k(t^j)
+ * @param[in] p_m raw pointer to state variable
+ * @param[in] j index of time point
+ * @param[in] k index of component
+ *******************************************************************/
+PetscErrorCode CLAIRE::GetStateTimePoint(ScalarType*& p_mj, ScalarType* p_m, IntType j, IntType k) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nc;
+
+    PetscFunctionBegin;
+
+    nc = this->m_Opt->m_Domain.nc;
+    nl = this->m_Opt->m_Domain.nl;
+    j *= this->m_TimeStride;
+
+    if (this->m_StateHistory != NULL) {
+        ierr = this->m_StateHistory->GetTimePoint(p_mj, j, k); CHKERRQ(ierr);
+    } else {
+        p_mj = p_m + j*nl*nc + k*nl;
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief start to load the state variable at time point j (only
+ * has an effect for out-of-core storage of the time history; the
+ * read overlaps with the computation of the current time step)
+ * @param[in] j index of time point
+ *******************************************************************/
+PetscErrorCode CLAIRE::PrefetchStateTimePoint(IntType j) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    if (this->m_StateHistory != NULL) {
+        ierr = this->m_StateHistory->Prefetch(j*this->m_TimeStride); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief select the time grid for the hessian matvecs of the next
+ * krylov solve (multi-fidelity); as long as the norm of the gradient
+ * has not been reduced by hessfidelitytol, the incremental equations
+ * are solved on a time grid that is coarser by a factor of
+ * hesscoarsent (every hesscoarsent-th time point of the state
+ * variable is used); the trajectories for the coarse time step are
+ * computed once per krylov solve (the velocity does not change)
+ * @param[in] g right hand side of hessian system (negative gradient)
+ *******************************************************************/
+PetscErrorCode CLAIRE::SetHessianFidelity(Vec g) {
+    PetscErrorCode ierr = 0;
+    IntType stride, nt;
+    ScalarType gnorm, ht;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    stride = 1;
+    if (this->m_Opt->m_KrylovMethod.hesscoarsent > 1 && this->m_Opt->m_Monitor.gradnorm0 > 0.0) {
+        ierr = VecNormL2(g, &gnorm); CHKERRQ(ierr);
+        if (gnorm > this->m_Opt->m_KrylovMethod.hessfidelitytol*this->m_Opt->m_Monitor.gradnorm0) {
+            // coarse time grid has to be nested in time grid of state variable
+            nt = this->m_Opt->m_Domain.nt;
+            stride = std::min(static_cast<IntType>(this->m_Opt->m_KrylovMethod.hesscoarsent), nt);
+            while (nt % stride != 0) --stride;
+        }
+    }
+
+    if (stride > 1) {
+        ierr = Assert(this->m_VelocityField != NULL, "null pointer"); CHKERRQ(ierr);
+        if (this->m_WorkVecField1 == NULL) {
+            try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
+            catch (std::bad_alloc& err) {
+                ierr = reg::ThrowError(err); CHKERRQ(ierr);
+            }
+        }
+        if (this->m_CoarseTimeSemiLagrangian == NULL) {
+            try {this->m_CoarseTimeSemiLagrangian = new SemiLagrangianType(this->m_Opt);}
+            catch (std::bad_alloc& err) {
+                ierr = reg::ThrowError(err); CHKERRQ(ierr);
+            }
+            ierr = this->m_CoarseTimeSemiLagrangian->SetWorkVecField(this->m_WorkVecField1); CHKERRQ(ierr);
+        }
+        ht = static_cast<ScalarType>(stride)*this->m_Opt->GetTimeStepSize();
+        ierr = this->m_CoarseTimeSemiLagrangian->SetTimeStepSize(ht); CHKERRQ(ierr);
+        ierr = this->m_CoarseTimeSemiLagrangian->ComputeTrajectory(this->m_VelocityField, "state"); CHKERRQ(ierr);
+        ierr = this->m_CoarseTimeSemiLagrangian->ComputeTrajectory(this->m_VelocityField, "adjoint"); CHKERRQ(ierr);
+    }
+
+    if (this->m_Opt->m_Verbosity > 1 && stride != this->m_TimeStride) {
+        ss << "hessian matvecs on time grid with nt = " << this->m_Opt->m_Domain.nt/stride;
+        ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+    }
+    this->m_TimeStride = stride;
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief pre-processing before the krylov solve (select the time
+ * grid of the hessian matvecs)
+ *******************************************************************/
+PetscErrorCode CLAIRE::PreKrylovSolve(Vec g, Vec x) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = this->SetHessianFidelity(g); CHKERRQ(ierr);
+    ierr = SuperClass::PreKrylovSolve(g, x); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief post-processing after the krylov solve (hessian matvecs
+ * outside of the krylov solve use the full time grid)
+ *******************************************************************/
+PetscErrorCode CLAIRE::PostKrylovSolve(Vec g, Vec x) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = SuperClass::PostKrylovSolve(g, x); CHKERRQ(ierr);
+    this->m_TimeStride = 1;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief set m at t=0
  * @param[in] m0 density/image at t=0 (initial condition of forward
@@ -367,7 +623,7 @@ PetscErrorCode CLAIRE::InitializeOptimization() {
 PetscErrorCode CLAIRE::SetInitialState(Vec m0) {
     PetscErrorCode ierr = 0;
     ScalarType *p_m0 = NULL, *p_m = NULL;
-    IntType nt, nl, nc, ng;
+    IntType nl, nc;
 
     PetscFunctionBegin;
 
@@ -375,19 +631,11 @@ PetscErrorCode CLAIRE::SetInitialState(Vec m0) {
 
     ierr = Assert(m0 != NULL, "null pointer"); CHKERRQ(ierr);
 
-    nt = this->m_Opt->m_Domain.nt;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
-    ng = this->m_Opt->m_Domain.ng;
 
     // allocate state variable
-    if (this->m_StateVariable == NULL) {
-        if (this->m_Opt->m_RegFlags.runinversion) {
-            ierr = VecCreate(this->m_StateVariable, (nt+1)*nl*nc, (nt+1)*ng*nc); CHKERRQ(ierr);
-        } else {
-            ierr = VecCreate(this->m_StateVariable, nl*nc, ng*nc); CHKERRQ(ierr);
-        }
-    }
+    ierr = this->AllocateStateVariable(); CHKERRQ(ierr);
 
     // copy m_0 to m(t=0)
     ierr = VecGetArray(m0, &p_m0); CHKERRQ(ierr);
@@ -396,6 +644,9 @@ PetscErrorCode CLAIRE::SetInitialState(Vec m0) {
     catch (std::exception& err) {
         ierr = ThrowError(err); CHKERRQ(ierr);
     }
+    if (this->m_StateHistory != NULL) {
+        ierr = this->m_StateHistory->SetTimePoint(p_m, 0); CHKERRQ(ierr);
+    }
     ierr = VecRestoreArray(this->m_StateVariable, &p_m); CHKERRQ(ierr);
     ierr = VecRestoreArray(m0, &p_m0); CHKERRQ(ierr);
 
@@ -427,8 +678,8 @@ PetscErrorCode CLAIRE::GetFinalState(Vec m1) {
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
 
-    if (!this->m_Opt->m_RegFlags.runinversion) {
-        nt = 0; // we did not store the time history
+    if (!this->m_Opt->m_RegFlags.runinversion || this->m_StateHistory != NULL) {
+        nt = 0; // we did not store the time history (or it is compressed)
     }
 
     // copy m(t=1) to m_1
@@ -478,7 +729,7 @@ PetscErrorCode CLAIRE::SetFinalAdjoint(Vec l1) {
 
     // allocate pointer if not done so already
     if (this->m_AdjointVariable == NULL) {
-        ierr = VecCreate(this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
     }
 
     // copy l1 to lambda(t=1)
@@ -558,9 +809,12 @@ PetscErrorCode CLAIRE::SolveAdjointProblem(Vec l0, Vec m1) {
 
     // allocate state variable
     if (this->m_StateVariable == NULL) {
-        ierr = VecCreate(this->m_StateVariable, (nt+1)*nl*nc, (nt+1)*ng*nc); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_StateVariable, (nt+1)*nl*nc, (nt+1)*ng*nc, (nt+1)*nc); CHKERRQ(ierr);
         ierr = VecSet(this->m_StateVariable, 0); CHKERRQ(ierr);
     }
+    if (this->m_StateHistory != NULL) {
+        nt = 0; // state variable only holds m(t=1)
+    }
 
     // copy memory for m_1
     ierr = GetRawPointer(m1, &p_m1); CHKERRQ(ierr);
@@ -617,7 +871,7 @@ PetscErrorCode CLAIRE::SetStateVariable(Vec m) {
     // we need to make sure that we don't delete the external
     // pointer
     if (this->m_StateVariable == NULL) {
-        ierr = VecCreate(this->m_StateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_StateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
     }
     ierr = VecCopy(m, this->m_StateVariable); CHKERRQ(ierr);
 
@@ -695,9 +949,9 @@ PetscErrorCode CLAIRE::SetAdjointVariable(Vec lambda) {
     // we need to make sure that we don't delete the external pointer
     if (this->m_AdjointVariable == NULL) {
         if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
-            ierr = VecCreate(this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         } else {
-            ierr = VecCreate(this->m_AdjointVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
     }
     ierr = VecCopy(lambda, this->m_AdjointVariable); CHKERRQ(ierr);
@@ -969,7 +1223,7 @@ PetscErrorCode CLAIRE::EvaluateGradient(Vec g, Vec v) {
 //        ierr = VecScale(g, hd); CHKERRQ(ierr);
 
         if (this->m_Opt->m_Verbosity > 2) {
-            ierr = VecNorm(g, NORM_2, &value); CHKERRQ(ierr);
+            ierr = VecNormL2(g, &value); CHKERRQ(ierr);
             ss << "||g||_2 = " << std::scientific << value;
             ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
             ss.clear(); ss.str(std::string());
@@ -1084,7 +1338,7 @@ PetscErrorCode CLAIRE::ComputeBodyForce() {
     IntType nt, nl, nc, l;
     std::stringstream ss;
     std::bitset<3> xyz; xyz[0] = 1; xyz[1] = 1; xyz[2] = 1;
-    ScalarType *p_mt = NULL, *p_m = NULL, *p_l = NULL,
+    ScalarType *p_mt = NULL, *p_m = NULL, *p_mj = NULL, *p_l = NULL,
                *p_gradm1 = NULL, *p_gradm2 = NULL, *p_gradm3 = NULL,
                *p_b1 = NULL, *p_b2 = NULL, *p_b3 = NULL;
     ScalarType ht, scale, lambda, value;
@@ -1158,14 +1412,18 @@ PetscErrorCode CLAIRE::ComputeBodyForce() {
         ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
         // compute numerical integration (trapezoidal rule)
         for (IntType j = 0; j <= nt; ++j) {
+            // overlap reading the next time point with this one
+            ierr = this->PrefetchStateTimePoint(j+1); CHKERRQ(ierr);
+
             // scaling for trapezoidal rule
             if ((j == 0) || (j == nt)) scale *= 0.5;
             for (IntType k = 0; k < nc; ++k) {  // for all components
                 l = j*nl*nc + k*nl;
 
                 // grad(m^j)
+                ierr = this->GetStateTimePoint(p_mj, p_m, j, k); CHKERRQ(ierr);
                 this->m_Opt->StartTimer(FFTSELFEXEC);
-                accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_m+l, this->m_Opt->m_FFT.plan, &xyz, timer);
+                accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
                 this->m_Opt->StopTimer(FFTSELFEXEC);
                 this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -1277,25 +1535,276 @@ PetscErrorCode CLAIRE::HessianMatVec(Vec Hvtilde, Vec vtilde, bool scale) {
     }
 
 
-    if (Hvtilde != NULL) {
-        // TODO @ Andreas: fix for two-level precond
-        // scale by lebesgue measure
-        if (scale == false) {
-            hd = this->m_Opt->GetLebesgueMeasure();
-            ierr = VecScale(Hvtilde, 1/hd); CHKERRQ(ierr);
-        }
-
-//        gamma = this->m_Opt->m_KrylovMethod.hessshift;
-//        if (gamma > 0.0) {
-//            ierr = VecAXPY(Hvtilde, gamma, vtilde); CHKERRQ(ierr);
-//        }
-    }
+    if (Hvtilde != NULL) {
+        // TODO @ Andreas: fix for two-level precond
+        // scale by lebesgue measure
+        if (scale == false) {
+            hd = this->m_Opt->GetLebesgueMeasure();
+            ierr = VecScale(Hvtilde, 1/hd); CHKERRQ(ierr);
+        }
+
+//        gamma = this->m_Opt->m_KrylovMethod.hessshift;
+//        if (gamma > 0.0) {
+//            ierr = VecAXPY(Hvtilde, gamma, vtilde); CHKERRQ(ierr);
+//        }
+    }
+
+    // stop hessian matvec timer
+    ierr = this->m_Opt->StopTimer(HMVEXEC); CHKERRQ(ierr);
+
+    // increment matvecs
+    this->m_Opt->IncrementCounter(HESSMATVEC);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief applies the hessian to a block of k vectors; the trajectory,
+ * the gradients of the state variable and the interpolation sweeps
+ * are shared across the vectors of a block (blocks of at most
+ * hessblock vectors); only implemented for the semi-lagrangian method
+ * and the gauss-newton approximation (the vectors are applied one by
+ * one otherwise)
+ * @param[in] vtilde block of incremental velocity fields
+ * @param[in] k number of vectors
+ * @param[in] scale flag to switch on scaling by lebesgue measure
+ * @param[out] Hvtilde hessian applied to vectors
+ *******************************************************************/
+PetscErrorCode CLAIRE::HessianMatVecBlock(Vec* Hvtilde, Vec* vtilde, IntType k, bool scale) {
+    PetscErrorCode ierr = 0;
+    IntType nl, ng, nc, nb, nbmax, lb;
+    ScalarType hd;
+    ScalarType *p_vb = NULL, *p_bb = NULL, *p_x1 = NULL, *p_x2 = NULL, *p_x3 = NULL;
+    const ScalarType *p_v = NULL, *p_v1 = NULL, *p_v2 = NULL, *p_v3 = NULL;
+    bool batch;
+    WorkSpace::ScaFieldLease vblock, bblock, mblock;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(Hvtilde != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(vtilde != NULL, "null pointer"); CHKERRQ(ierr);
+
+    nbmax = static_cast<IntType>(this->m_Opt->m_KrylovMethod.hessblock);
+
+    batch = k > 1 && nbmax > 1;
+    batch = batch && this->m_Opt->m_PDESolver.type == SL;
+    batch = batch && this->m_Opt->m_OptPara.method == GAUSSNEWTON;
+    if (batch) {
+        ierr = this->IsVelocityZero(); CHKERRQ(ierr);
+        batch = !this->m_VelocityIsZero;
+    }
+
+    // apply the hessian one vector at a time
+    if (!batch) {
+        ierr = SuperClass::HessianMatVecBlock(Hvtilde, vtilde, k, scale); CHKERRQ(ierr);
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
+    if (this->m_Opt->m_Verbosity > 2) {
+        ierr = DbgMsg("computing block hessian matvec"); CHKERRQ(ierr);
+    }
+
+    ierr = Assert(this->m_StateVariable != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_SemiLagrangianMethod != NULL, "null pointer"); CHKERRQ(ierr);
+
+    nl = this->m_Opt->m_Domain.nl;
+    ng = this->m_Opt->m_Domain.ng;
+    nc = this->m_Opt->m_Domain.nc;
+    hd = this->m_Opt->GetLebesgueMeasure();
+
+    ierr = this->m_Opt->StartTimer(HMVEXEC); CHKERRQ(ierr);
+
+    // allocate containers (block buffers are sized for the max block size)
+    if (this->m_IncVelocityField == NULL) {
+        try {this->m_IncVelocityField = new VecField(this->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_WorkVecField1 == NULL) {
+        try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_WorkVecField2 == NULL) {
+        try {this->m_WorkVecField2 = new VecField(this->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_WorkVecField5 == NULL) {
+        try {this->m_WorkVecField5 = new VecField(this->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_Regularization == NULL) {
+        ierr = this->SetupRegularization(); CHKERRQ(ierr);
+    }
+    if (this->m_IncStateVariable == NULL) {
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncStateVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
+    }
+    if (this->m_IncAdjointVariable == NULL) {
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncAdjointVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
+    }
+
+    // block buffers are only held for the duration of the matvec
+    ierr = vblock.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt->m_Comm, 3*nbmax*nl, 3*nbmax*ng, "claire"); CHKERRQ(ierr);
+    ierr = bblock.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt->m_Comm, 3*nbmax*nl, 3*nbmax*ng, "claire"); CHKERRQ(ierr);
+    ierr = mblock.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt->m_Comm, nbmax*nc*nl, nbmax*nc*ng, "claire"); CHKERRQ(ierr);
+
+    // terminal condition of the incremental adjoint equations
+    if (this->m_DistanceMeasure == NULL) {
+        ierr = this->SetupDistanceMeasure(); CHKERRQ(ierr);
+    }
+    ierr = this->m_DistanceMeasure->SetReferenceImage(this->m_ReferenceImage); CHKERRQ(ierr);
+    ierr = this->m_DistanceMeasure->SetStateVariable(this->m_StateVariable); CHKERRQ(ierr);
+    ierr = this->m_DistanceMeasure->SetIncStateVariable(this->m_IncStateVariable); CHKERRQ(ierr);
+    ierr = this->m_DistanceMeasure->SetIncAdjointVariable(this->m_IncAdjointVariable); CHKERRQ(ierr);
+
+    // on the coarse time grid, the incremental equations are transported
+    // along the trajectories computed for the coarse time step
+    SemiLagrangianSwap slswap(this->m_SemiLagrangianMethod, this->m_CoarseTimeSemiLagrangian,
+                              this->m_TimeStride > 1);
+
+    for (IntType l = 0; l < k; l += nb) {
+        nb = std::min(nbmax, k - l);
+
+        // gather incremental velocities of block (for the symmetrized operator
+        // we transport (\beta\D{A})^{-1/2}\vect{\tilde{v}})
+        ierr = GetRawPointer(vblock.m_X, &p_vb); CHKERRQ(ierr);
+        for (IntType b = 0; b < nb; ++b) {
+            ierr = Assert(vtilde[l+b] != NULL, "null pointer"); CHKERRQ(ierr);
+            lb = 3*b*nl;
+            if (this->m_Opt->m_KrylovMethod.matvectype == PRECONDMATVECSYM) {
+                ierr = this->m_WorkVecField5->SetComponents(vtilde[l+b]); CHKERRQ(ierr);
+                ierr = this->m_Regularization->ApplyInverse(this->m_IncVelocityField, this->m_WorkVecField5, true); CHKERRQ(ierr);
+                ierr = this->m_IncVelocityField->GetArraysRead(p_v1, p_v2, p_v3); CHKERRQ(ierr);
+#pragma omp parallel
+{
+#pragma omp for
+                for (IntType i = 0; i < nl; ++i) {
+                    p_vb[lb + i       ] = p_v1[i];
+                    p_vb[lb + i +   nl] = p_v2[i];
+                    p_vb[lb + i + 2*nl] = p_v3[i];
+                }
+}  // omp
+                ierr = this->m_IncVelocityField->RestoreArraysRead(p_v1, p_v2, p_v3); CHKERRQ(ierr);
+            } else {
+                ierr = GetRawPointerRead(vtilde[l+b], &p_v); CHKERRQ(ierr);
+#pragma omp parallel
+{
+#pragma omp for
+                for (IntType i = 0; i < 3*nl; ++i) {
+                    p_vb[lb + i] = p_v[i];
+                }
+}  // omp
+                ierr = RestoreRawPointerRead(vtilde[l+b], &p_v); CHKERRQ(ierr);
+            }
+        }
+        ierr = RestoreRawPointer(vblock.m_X, &p_vb); CHKERRQ(ierr);
+
+        // compute \tilde{m}(x,t=1) for all vectors of the block
+        ierr = this->SolveIncStateEquationBlockSL(mblock.m_X, vblock.m_X, bblock.m_X, nb); CHKERRQ(ierr);
+
+        // compute \tilde{\lambda}(x,t) and incremental body forces
+        ierr = this->SolveIncAdjointEquationBlockGNSL(bblock.m_X, mblock.m_X, nb); CHKERRQ(ierr);
+
+        // apply regularization operators (one vector at a time)
+        ierr = GetRawPointer(vblock.m_X, &p_vb); CHKERRQ(ierr);
+        ierr = GetRawPointer(bblock.m_X, &p_bb); CHKERRQ(ierr);
+        for (IntType b = 0; b < nb; ++b) {
+            lb = 3*b*nl;
+
+            // incremental velocity and body force of current vector
+            ierr = this->m_IncVelocityField->GetArrays(p_x1, p_x2, p_x3); CHKERRQ(ierr);
+#pragma omp parallel
+{
+#pragma omp for
+            for (IntType i = 0; i < nl; ++i) {
+                p_x1[i] = p_vb[lb + i       ];
+                p_x2[i] = p_vb[lb + i +   nl];
+                p_x3[i] = p_vb[lb + i + 2*nl];
+            }
+}  // omp
+            ierr = this->m_IncVelocityField->RestoreArrays(p_x1, p_x2, p_x3); CHKERRQ(ierr);
+
+            ierr = this->m_WorkVecField2->GetArrays(p_x1, p_x2, p_x3); CHKERRQ(ierr);
+#pragma omp parallel
+{
+#pragma omp for
+            for (IntType i = 0; i < nl; ++i) {
+                p_x1[i] = p_bb[lb + i       ];
+                p_x2[i] = p_bb[lb + i +   nl];
+                p_x3[i] = p_bb[lb + i + 2*nl];
+            }
+}  // omp
+            ierr = this->m_WorkVecField2->RestoreArrays(p_x1, p_x2, p_x3); CHKERRQ(ierr);
+
+            // apply K[\tilde{b}] and scale by hd (see SolveIncAdjointEquation)
+            ierr = this->ApplyProjection(); CHKERRQ(ierr);
+            ierr = this->m_WorkVecField2->Scale(hd); CHKERRQ(ierr);
+
+            // same operators as HessMatVec, PrecondHessMatVec and PrecondHessMatVecSym
+            switch (this->m_Opt->m_KrylovMethod.matvectype) {
+                case DEFAULTMATVEC:
+                {
+                    ierr = this->m_Regularization->HessianMatVec(this->m_WorkVecField1, this->m_IncVelocityField); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField1->AXPY(1.0, this->m_WorkVecField2); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField1->GetComponents(Hvtilde[l+b]); CHKERRQ(ierr);
+                    break;
+                }
+                case PRECONDMATVEC:
+                {
+                    ierr = this->m_Regularization->ApplyInverse(this->m_WorkVecField1, this->m_WorkVecField2, false); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField2->WAXPY(hd, this->m_IncVelocityField, this->m_WorkVecField1); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField2->GetComponents(Hvtilde[l+b]); CHKERRQ(ierr);
+                    break;
+                }
+                case PRECONDMATVECSYM:
+                {
+                    ierr = this->m_Regularization->ApplyInverse(this->m_WorkVecField1, this->m_WorkVecField2, true); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField5->SetComponents(vtilde[l+b]); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField5->Scale(hd); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField5->AXPY(1.0, this->m_WorkVecField1); CHKERRQ(ierr);
+                    ierr = this->m_WorkVecField5->GetComponents(Hvtilde[l+b]); CHKERRQ(ierr);
+                    break;
+                }
+                default:
+                {
+                    ierr = ThrowError("operator not implemented"); CHKERRQ(ierr);
+                    break;
+                }
+            }
+
+            // scale by lebesgue measure
+            if (scale == false) {
+                ierr = VecScale(Hvtilde[l+b], 1.0/hd); CHKERRQ(ierr);
+            }
+        }
+        ierr = RestoreRawPointer(bblock.m_X, &p_bb); CHKERRQ(ierr);
+        ierr = RestoreRawPointer(vblock.m_X, &p_vb); CHKERRQ(ierr);
+    }
+
+    slswap.Restore();
+
+    ierr = mblock.Release(); CHKERRQ(ierr);
+    ierr = bblock.Release(); CHKERRQ(ierr);
+    ierr = vblock.Release(); CHKERRQ(ierr);
 
     // stop hessian matvec timer
     ierr = this->m_Opt->StopTimer(HMVEXEC); CHKERRQ(ierr);
 
     // increment matvecs
-    this->m_Opt->IncrementCounter(HESSMATVEC);
+    this->m_Opt->IncrementCounter(HESSMATVEC, static_cast<int>(k));
 
     this->m_Opt->Exit(__func__);
 
@@ -1304,7 +1813,6 @@ PetscErrorCode CLAIRE::HessianMatVec(Vec Hvtilde, Vec vtilde, bool scale) {
 
 
 
-
 /********************************************************************
  * @brief applies the hessian to a vector (default way of doing this)
  *******************************************************************/
@@ -1342,12 +1850,19 @@ PetscErrorCode CLAIRE::HessMatVec(Vec Hvtilde, Vec vtilde) {
         ierr = this->m_IncVelocityField->SetComponents(vtilde); CHKERRQ(ierr);
     }
 
+    // on the coarse time grid, the incremental equations are transported
+    // along the trajectories computed for the coarse time step
+    SemiLagrangianSwap slswap(this->m_SemiLagrangianMethod, this->m_CoarseTimeSemiLagrangian,
+                              this->m_TimeStride > 1);
+
     // compute \tilde{m}(x,t)
     ierr = this->SolveIncStateEquation(); CHKERRQ(ierr);
 
     // compute \tilde{\lambda}(x,t)
     ierr = this->SolveIncAdjointEquation(); CHKERRQ(ierr);
 
+    slswap.Restore();
+
     // compute incremental body force
 //    ierr = this->ComputeIncBodyForce(); CHKERRQ(ierr);
 
@@ -1580,15 +2095,15 @@ PetscErrorCode CLAIRE::ComputeInitialCondition(Vec m, Vec lambda) {
 
     // allocate state and adjoint variables
     if (this->m_StateVariable == NULL) {
-        ierr = VecCreate(this->m_StateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_StateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
     }
 
     // allocate state and adjoint variables
     if (this->m_AdjointVariable == NULL) {
         if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
-            ierr = VecCreate(this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         } else {
-            ierr = VecCreate(this->m_AdjointVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
     }
 
@@ -1632,13 +2147,14 @@ PetscErrorCode CLAIRE::ComputeInitialCondition(Vec m, Vec lambda) {
 PetscErrorCode CLAIRE::ComputeIncBodyForce() {
     PetscErrorCode ierr = 0;
     IntType nt, nl, nc, l;
-    ScalarType *p_m = NULL, *p_mt = NULL, *p_l = NULL, *p_lt = NULL,
+    ScalarType *p_m = NULL, *p_mj = NULL, *p_mt = NULL, *p_l = NULL, *p_lt = NULL,
                 *p_bt1 = NULL, *p_bt2 = NULL, *p_bt3 = NULL,
                 *p_gradm1 = NULL, *p_gradm2 = NULL, *p_gradm3 = NULL,
                 *p_gradmt1 = NULL, *p_gradmt2 = NULL, *p_gradmt3 = NULL;
     std::bitset<3> XYZ; XYZ[0] = 1; XYZ[1] = 1; XYZ[2] = 1;
     ScalarType ht, scale, lj, ltj;
     double timer[NFFTTIMERS] = {0};
+    WorkSpace::VecFieldLease gradmt;
 
     PetscFunctionBegin;
 
@@ -1683,17 +2199,13 @@ PetscErrorCode CLAIRE::ComputeIncBodyForce() {
         ierr = Assert(this->m_AdjointVariable != NULL, "null pointer"); CHKERRQ(ierr);
         ierr = Assert(this->m_IncStateVariable != NULL, "null pointer"); CHKERRQ(ierr);
 
-        if (this->m_WorkVecField3 == NULL) {
-            try {this->m_WorkVecField3 = new VecField(this->m_Opt);}
-            catch (std::bad_alloc& err) {
-                ierr = reg::ThrowError(err); CHKERRQ(ierr);
-            }
-        }
+        // gradient of \tilde{m} (only needed for the full newton step)
+        ierr = gradmt.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt, "claire"); CHKERRQ(ierr);
 
         ierr = GetRawPointer(this->m_AdjointVariable, &p_l); CHKERRQ(ierr);  // adjoint variable for all t^j
         ierr = GetRawPointer(this->m_IncStateVariable, &p_mt); CHKERRQ(ierr);  // incremental state variable for all t^j
 
-        ierr = this->m_WorkVecField3->GetArrays(p_gradmt1, p_gradmt2, p_gradmt3); CHKERRQ(ierr);
+        ierr = gradmt.m_X->GetArrays(p_gradmt1, p_gradmt2, p_gradmt3); CHKERRQ(ierr);
 
         // compute numerical integration (trapezoidal rule)
         for (IntType j = 0; j <= nt; ++j) {  // for all time points
@@ -1738,18 +2250,23 @@ PetscErrorCode CLAIRE::ComputeIncBodyForce() {
 
         ierr = RestoreRawPointer(this->m_AdjointVariable, &p_l); CHKERRQ(ierr);  // adjoint variable for all t^j
         ierr = RestoreRawPointer(this->m_IncStateVariable, &p_mt); CHKERRQ(ierr);  // incremental state variable for all t^j
-        ierr = this->m_WorkVecField3->RestoreArrays(p_gradmt1, p_gradmt2, p_gradmt3); CHKERRQ(ierr);
+        ierr = gradmt.m_X->RestoreArrays(p_gradmt1, p_gradmt2, p_gradmt3); CHKERRQ(ierr);
+        ierr = gradmt.Release(); CHKERRQ(ierr);
     } else if (this->m_Opt->m_OptPara.method == GAUSSNEWTON) {  // gauss newton approximation
         // compute numerical integration (trapezoidal rule)
         for (IntType j = 0; j <= nt; ++j) {  // for all time points
+            // overlap reading the next time point with this one
+            ierr = this->PrefetchStateTimePoint(j+1); CHKERRQ(ierr);
+
             // trapezoidal rule (apply scaling)
             if ((j == 0) || (j == nt)) scale *= 0.5;
             for (IntType k = 0; k < nc; ++k) {  // for all image components
                 l = j*nl*nc + k*nl;
 
                 // compute gradient of m^j
+                ierr = this->GetStateTimePoint(p_mj, p_m, j, k); CHKERRQ(ierr);
                 this->m_Opt->StartTimer(FFTSELFEXEC);
-                accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_m+l, this->m_Opt->m_FFT.plan, &XYZ, timer);
+                accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_mj, this->m_Opt->m_FFT.plan, &XYZ, timer);
                 this->m_Opt->StopTimer(FFTSELFEXEC);
                 this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -1798,7 +2315,7 @@ PetscErrorCode CLAIRE::ComputeIncBodyForce() {
 PetscErrorCode CLAIRE::StoreStateVariable() {
     PetscErrorCode ierr = 0;
     IntType nl, ng, nc, nt;
-    ScalarType *p_m = NULL, *p_mj = NULL;
+    ScalarType *p_m = NULL, *p_mj = NULL, *p_mjk = NULL;
     std::stringstream ss;
     std::string ext;
 
@@ -1815,7 +2332,7 @@ PetscErrorCode CLAIRE::StoreStateVariable() {
     ext = this->m_Opt->m_FileNames.extension;
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     ierr = Assert(this->m_ReadWrite != NULL, "null pointer"); CHKERRQ(ierr);
 
@@ -1824,8 +2341,9 @@ PetscErrorCode CLAIRE::StoreStateVariable() {
     // store individual time points
     for (IntType j = 0; j <= nt; ++j) {
         for (IntType k = 0; k < nc; ++k) {
+            ierr = this->GetStateTimePoint(p_mjk, p_m, j, k); CHKERRQ(ierr);
             ierr = GetRawPointer(this->m_WorkScaField1, &p_mj); CHKERRQ(ierr);
-            try {std::copy(p_m+j*nl*nc + k*nl, p_m+j*nl*nc + (k+1)*nl, p_mj);}
+            try {std::copy(p_mjk, p_mjk+nl, p_mj);}
             catch (std::exception& err) {
                 ierr = ThrowError(err); CHKERRQ(ierr);
             }
@@ -1908,7 +2426,13 @@ PetscErrorCode CLAIRE::SolveStateEquation() {
     ierr = this->IsVelocityZero(); CHKERRQ(ierr);
     if (this->m_VelocityIsZero) {
         // we copy m_0 to all t for v=0
-        if (this->m_Opt->m_RegFlags.runinversion) {
+        if (this->m_StateHistory != NULL) {
+            ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
+            for (IntType j = 1; j <= nt; ++j) {
+                ierr = this->m_StateHistory->SetTimePoint(p_m, j); CHKERRQ(ierr);
+            }
+            ierr = RestoreRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
+        } else if (this->m_Opt->m_RegFlags.runinversion) {
             ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
             for (IntType j = 1; j <= nt; ++j) {
                 try {std::copy(p_m, p_m+nc*nl, p_m+j*nl*nc);}
@@ -1949,6 +2473,15 @@ PetscErrorCode CLAIRE::SolveStateEquation() {
 
     ierr = this->m_Opt->StopTimer(PDEEXEC); CHKERRQ(ierr);
 
+    if (this->m_Opt->m_Verbosity > 1 && this->m_StateHistory != NULL) {
+        ScalarType ratio;
+        ierr = this->m_StateHistory->GetCompressionRatio(ratio); CHKERRQ(ierr);
+        ss  << "compression ratio of time history: " << std::fixed
+            << std::setprecision(2) << ratio;
+        ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+    }
+
     if (this->m_Opt->m_Verbosity > 2) {
         ScalarType maxval, minval, nvx1, nvx2, nvx3;
         ierr = VecMax(this->m_StateVariable, NULL, &maxval); CHKERRQ(ierr);
@@ -2024,10 +2557,10 @@ PetscErrorCode CLAIRE::SolveStateEquationRK2(void) {
         }
     }
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
 
     ierr = this->m_VelocityField->GetArrays(p_vx1, p_vx2, p_vx3); CHKERRQ(ierr);
@@ -2124,8 +2657,9 @@ PetscErrorCode CLAIRE::SolveStateEquationSL(void) {
     PetscFunctionBegin;
     this->m_Opt->Enter(__func__);
 
-    // flag to identify if we store the time history
-    store = this->m_Opt->m_RegFlags.runinversion;
+    // flag to identify if we store the time history (the compressed
+    // time history is updated after every time step)
+    store = this->m_Opt->m_RegFlags.runinversion && this->m_StateHistory == NULL;
 
     nt = this->m_Opt->m_Domain.nt;
     nc = this->m_Opt->m_Domain.nc;
@@ -2156,9 +2690,13 @@ PetscErrorCode CLAIRE::SolveStateEquationSL(void) {
         } else {
             l = 0; lnext = 0;
         }
-        for (IntType k = 0; k < nc; ++k) {  // for all image components
-            // compute m(X,t^{j+1}) (interpolate state variable)
-            ierr = this->m_SemiLagrangianMethod->Interpolate(p_m + lnext + k*nl, p_m + l + k*nl, "state"); CHKERRQ(ierr);
+        // compute m(X,t^{j+1}) (interpolate state variable; all image components at once)
+        ierr = this->m_SemiLagrangianMethod->Interpolate(p_m + lnext, p_m + l, nc, "state"); CHKERRQ(ierr);
+
+        // we propagate the uncompressed state; the compression error
+        // does not accumulate over time
+        if (this->m_StateHistory != NULL) {
+            ierr = this->m_StateHistory->SetTimePoint(p_m, j+1); CHKERRQ(ierr);
         }
     }
 
@@ -2215,11 +2753,11 @@ PetscErrorCode CLAIRE::SolveAdjointEquation() {
 
     if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
         if (this->m_AdjointVariable == NULL) {
-            ierr = VecCreate(this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         }
     } else {
         if (this->m_AdjointVariable == NULL) {
-            ierr = VecCreate(this->m_AdjointVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_AdjointVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
     }
 
@@ -2392,10 +2930,10 @@ PetscErrorCode CLAIRE::SolveAdjointEquationRK2(void) {
     ierr = Assert(ht > 0, "ht < 0"); CHKERRQ(ierr);
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkVecField1 == NULL) {
         try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
@@ -2551,14 +3089,15 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
     PetscErrorCode ierr = 0;
     ScalarType *p_v1 = NULL, *p_v2 = NULL, *p_v3 = NULL,
                 *p_divv = NULL, *p_divvx = NULL,
-                *p_l = NULL, *p_lx = NULL, *p_m = NULL,
+                *p_l = NULL, *p_lx = NULL, *p_lxmc = NULL, *p_m = NULL, *p_mj = NULL,
                 *p_vec1 = NULL, *p_vec2 = NULL, *p_vec3 = NULL,
                 *p_b1 = NULL, *p_b2 = NULL, *p_b3 = NULL;
     ScalarType ht, lambdax, lambda, rhs0, rhs1, scale;
-    IntType nl, ng, nc, nt, ll, lm, llnext;
+    IntType nl, ng, nc, nt, ll, llnext;
     std::bitset<3> xyz; xyz[0] = 1; xyz[1] = 1; xyz[2] = 1;
     bool fullnewton = false;
     double timer[NFFTTIMERS] = {0};
+    WorkSpace::ScaFieldLease lxmc;
 
     PetscFunctionBegin;
 
@@ -2575,13 +3114,13 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
     ierr = Assert(this->m_VelocityField != NULL, "null pointer"); CHKERRQ(ierr);
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField3 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkVecField1 == NULL) {
         try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
@@ -2616,6 +3155,14 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
     ierr = GetRawPointer(this->m_WorkScaField2, &p_divvx); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_WorkScaField3, &p_lx); CHKERRQ(ierr);
 
+    // work buffer for lambda(X) (all image components)
+    if (nc > 1) {
+        ierr = lxmc.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt->m_Comm, nl*nc, ng*nc, "claire"); CHKERRQ(ierr);
+        ierr = GetRawPointer(lxmc.m_X, &p_lxmc); CHKERRQ(ierr);
+    } else {
+        p_lxmc = p_lx;
+    }
+
     // compute divergence of velocity field
     ierr = this->m_VelocityField->GetArrays(p_v1, p_v2, p_v3); CHKERRQ(ierr);
     this->m_Opt->StartTimer(FFTSELFEXEC);
@@ -2644,7 +3191,9 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
     // perform numerical time integration for adjoint variable and
     // add up body force
     for (IntType j = 0; j < nt; ++j) {
-        lm = (nt-j)*nc*nl;
+        // overlap reading the next time point with this one
+        ierr = this->PrefetchStateTimePoint(nt-(j+1)); CHKERRQ(ierr);
+
         if (fullnewton) {
             ll = (nt-j)*nc*nl; llnext = (nt-(j+1))*nc*nl;
         } else {
@@ -2653,13 +3202,16 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
 
         // scaling for trapezoidal rule (for body force)
         if (j == 0) scale *= 0.5;
+
+        // compute lambda(t^j,X) (all image components at once)
+        ierr = this->m_SemiLagrangianMethod->Interpolate(p_lxmc, p_l + ll, nc, "adjoint"); CHKERRQ(ierr);
+
         for (IntType k = 0; k < nc; ++k) {
-            // compute lambda(t^j,X)
-            ierr = this->m_SemiLagrangianMethod->Interpolate(p_lx, p_l + ll + k*nl, "adjoint"); CHKERRQ(ierr);
 
             // compute gradient of m (for incremental body force)
+            ierr = this->GetStateTimePoint(p_mj, p_m, nt-j, k); CHKERRQ(ierr);
             this->m_Opt->StartTimer(FFTSELFEXEC);
-            accfft_grad_t(p_vec1, p_vec2, p_vec3, p_m + lm + k*nl, this->m_Opt->m_FFT.plan, &xyz, timer);
+            accfft_grad_t(p_vec1, p_vec2, p_vec3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
             this->m_Opt->StopTimer(FFTSELFEXEC);
             this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 #pragma omp parallel
@@ -2667,7 +3219,7 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
 #pragma omp for
             for (IntType i = 0; i < nl; ++i) {
                 lambda  = p_l[ll + k*nl + i];
-                lambdax = p_lx[i];
+                lambdax = p_lxmc[k*nl + i];
 
                 rhs0 = lambdax*p_divvx[i];
                 rhs1 = (lambdax + ht*rhs0)*p_divv[i];
@@ -2688,11 +3240,12 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
 
     // compute body force for last time point t = 0 (i.e., for j = nt)
     for (IntType k = 0; k < nc; ++k) {  // for all image components
-        ll = k*nl; lm = k*nl;
+        ll = k*nl;
 
         // compute gradient of m (for incremental body force)
+        ierr = this->GetStateTimePoint(p_mj, p_m, 0, k); CHKERRQ(ierr);
         this->m_Opt->StartTimer(FFTSELFEXEC);
-        accfft_grad_t(p_vec1, p_vec2, p_vec3, p_m + lm, this->m_Opt->m_FFT.plan, &xyz, timer);
+        accfft_grad_t(p_vec1, p_vec2, p_vec3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
         this->m_Opt->StopTimer(FFTSELFEXEC);
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -2711,6 +3264,9 @@ PetscErrorCode CLAIRE::SolveAdjointEquationSL() {
     ierr = this->m_WorkVecField2->RestoreArrays(p_b1, p_b2, p_b3); CHKERRQ(ierr);
     ierr = this->m_WorkVecField1->RestoreArrays(p_vec1, p_vec2, p_vec3); CHKERRQ(ierr);
 
+    if (nc > 1) {
+        ierr = RestoreRawPointer(lxmc.m_X, &p_lxmc); CHKERRQ(ierr);
+    }
     ierr = RestoreRawPointer(this->m_WorkScaField3, &p_lx); CHKERRQ(ierr);
     ierr = RestoreRawPointer(this->m_WorkScaField2, &p_divvx); CHKERRQ(ierr);
     ierr = RestoreRawPointer(this->m_WorkScaField1, &p_divv); CHKERRQ(ierr);
@@ -2748,8 +3304,9 @@ PetscErrorCode CLAIRE::SolveContinuityEquationSL() {
 
     this->m_Opt->Enter(__func__);
 
-    // flag to identify if we store the time history
-    store = this->m_Opt->m_RegFlags.runinversion;
+    // flag to identify if we store the time history (the compressed
+    // time history is updated after every time step)
+    store = this->m_Opt->m_RegFlags.runinversion && this->m_StateHistory == NULL;
 
     nt = this->m_Opt->m_Domain.nt;
     nc = this->m_Opt->m_Domain.nc;
@@ -2759,13 +3316,13 @@ PetscErrorCode CLAIRE::SolveContinuityEquationSL() {
     hthalf = 0.5*ht;
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField3 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
     }
 
 
@@ -2840,6 +3397,9 @@ PetscErrorCode CLAIRE::SolveContinuityEquationSL() {
             }
         }
 }  // omp
+        if (this->m_StateHistory != NULL) {
+            ierr = this->m_StateHistory->SetTimePoint(p_m, j+1); CHKERRQ(ierr);
+        }
     }
 
     ierr = RestoreRawPointer(this->m_WorkScaField3, &p_mx); CHKERRQ(ierr);
@@ -2895,9 +3455,9 @@ PetscErrorCode CLAIRE::SolveIncStateEquation(void) {
     // allocate variables
     if (this->m_IncStateVariable == NULL) {
         if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
-            ierr = VecCreate(this->m_IncStateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncStateVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         } else {
-            ierr = VecCreate(this->m_IncStateVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncStateVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
     }
 
@@ -2988,10 +3548,10 @@ PetscErrorCode CLAIRE::SolveIncStateEquationRK2(void) {
 
     // allocate variables
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
 
     if (this->m_WorkVecField1 == NULL) {
@@ -3146,11 +3706,11 @@ PetscErrorCode CLAIRE::SolveIncStateEquationRK2(void) {
  *******************************************************************/
 PetscErrorCode CLAIRE::SolveIncStateEquationSL(void) {
     PetscErrorCode ierr = 0;
-    IntType nl, ng, nt, nc, lm, lmnext, lmt, lmtnext;
+    IntType nl, ng, nt, nc, lmt, lmtnext;
     std::bitset<3> XYZ; XYZ[0] = 1; XYZ[1] = 1; XYZ[2] = 1;
     ScalarType ht, hthalf;
     ScalarType *p_gm1 = NULL, *p_gm2 = NULL, *p_gm3 = NULL,
-                *p_mtilde = NULL, *p_m = NULL, *p_mx = NULL;
+                *p_mtilde = NULL, *p_m = NULL, *p_mj = NULL, *p_mx = NULL;
     const ScalarType *p_vtilde1 = NULL, *p_vtilde2 = NULL, *p_vtilde3 = NULL,
                      *p_vtildex1 = NULL, *p_vtildex2 = NULL, *p_vtildex3 = NULL;
     double timer[NFFTTIMERS] = {0};
@@ -3159,11 +3719,11 @@ PetscErrorCode CLAIRE::SolveIncStateEquationSL(void) {
 
     this->m_Opt->Enter(__func__);
 
-    nt = this->m_Opt->m_Domain.nt;
+    nt = this->m_Opt->m_Domain.nt/this->m_TimeStride;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
     ng = this->m_Opt->m_Domain.ng;
-    ht = this->m_Opt->GetTimeStepSize();
+    ht = this->m_TimeStride*this->m_Opt->GetTimeStepSize();
     hthalf = 0.5*ht;
 
     ierr = Assert(this->m_StateVariable != NULL, "null pointer"); CHKERRQ(ierr);
@@ -3171,7 +3731,7 @@ PetscErrorCode CLAIRE::SolveIncStateEquationSL(void) {
     ierr = Assert(this->m_IncVelocityField != NULL, "null pointer"); CHKERRQ(ierr);
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkVecField1 == NULL) {
         try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
@@ -3218,16 +3778,20 @@ PetscErrorCode CLAIRE::SolveIncStateEquationSL(void) {
     ierr = this->m_IncVelocityField->GetArraysRead(p_vtilde1, p_vtilde2, p_vtilde3); CHKERRQ(ierr);
 
     for (IntType j = 0; j < nt; ++j) {  // for all time points
-        lm = j*nl*nc; lmnext = (j+1)*nl*nc;
+        // we need m^j and m^{j+1}; overlap reading m^{j+2}
+        ierr = this->PrefetchStateTimePoint(j+1); CHKERRQ(ierr);
+        ierr = this->PrefetchStateTimePoint(j+2); CHKERRQ(ierr);
+
         if (fullnewton) {   // full newton
             lmt = j*nl*nc; lmtnext = (j+1)*nl*nc;
         } else {
             lmt = 0; lmtnext = 0;
         }
 
+        // interpolate incremental adjoint variable \tilde{m}^j(X) (all image components at once)
+        ierr = this->m_SemiLagrangianMethod->Interpolate(p_mtilde + lmtnext, p_mtilde + lmt, nc, "state"); CHKERRQ(ierr);
+
         for (IntType k = 0; k < nc; ++k) {  // for all image components
-            // interpolate incremental adjoint variable \tilde{m}^j(X)
-            ierr = this->m_SemiLagrangianMethod->Interpolate(p_mtilde + lmtnext + k*nl, p_mtilde + lmt + k*nl, "state"); CHKERRQ(ierr);
             // interpolate m
 //            ierr = this->m_SemiLagrangianMethod->Interpolate(p_mx, p_m + lm + k*nl, "state"); CHKERRQ(ierr);
 
@@ -3239,8 +3803,9 @@ PetscErrorCode CLAIRE::SolveIncStateEquationSL(void) {
 
 
             // compute gradient for state variable
+            ierr = this->GetStateTimePoint(p_mj, p_m, j, k); CHKERRQ(ierr);
             this->m_Opt->StartTimer(FFTSELFEXEC);
-            accfft_grad_t(p_gm1, p_gm2, p_gm3, p_m + lm + k*nl, this->m_Opt->m_FFT.plan, &XYZ, timer);
+            accfft_grad_t(p_gm1, p_gm2, p_gm3, p_mj, this->m_Opt->m_FFT.plan, &XYZ, timer);
             this->m_Opt->StopTimer(FFTSELFEXEC);
             this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -3257,8 +3822,9 @@ PetscErrorCode CLAIRE::SolveIncStateEquationSL(void) {
             }
 }  // omp
             // compute gradient for state variable at next time time point
+            ierr = this->GetStateTimePoint(p_mj, p_m, j+1, k); CHKERRQ(ierr);
             this->m_Opt->StartTimer(FFTSELFEXEC);
-            accfft_grad_t(p_gm1, p_gm2, p_gm3, p_m + lmnext + k*nl, this->m_Opt->m_FFT.plan, &XYZ, timer);
+            accfft_grad_t(p_gm1, p_gm2, p_gm3, p_mj, this->m_Opt->m_FFT.plan, &XYZ, timer);
             this->m_Opt->StopTimer(FFTSELFEXEC);
             this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -3344,11 +3910,11 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquation(void) {
     // allocate state and adjoint variables
     if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
         if (this->m_IncAdjointVariable == NULL) {
-            ierr = VecCreate(this->m_IncAdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncAdjointVariable, (nt+1)*nc*nl, (nt+1)*nc*ng, (nt+1)*nc); CHKERRQ(ierr);
         }
     } else {
         if (this->m_IncAdjointVariable == NULL) {
-            ierr = VecCreate(this->m_IncAdjointVariable, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_IncAdjointVariable, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
     }
 
@@ -3512,6 +4078,7 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationGNRK2(void) {
     std::bitset<3> xyz; xyz[0] = 1; xyz[1] = 1; xyz[2] = 1;
     ScalarType ht, hthalf, scale, ltilde;
     double timer[NFFTTIMERS] = {0};
+    WorkSpace::VecFieldLease gradm;
 
     PetscFunctionBegin;
 
@@ -3526,10 +4093,10 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationGNRK2(void) {
     hthalf = 0.5*ht;
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkVecField1 == NULL) {
         try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
@@ -3543,20 +4110,15 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationGNRK2(void) {
             ierr = reg::ThrowError(err); CHKERRQ(ierr);
         }
     }
-    if (this->m_WorkVecField3 == NULL) {
-        try {this->m_WorkVecField3 = new VecField(this->m_Opt);}
-        catch (std::bad_alloc& err) {
-            ierr = reg::ThrowError(err); CHKERRQ(ierr);
-        }
-    }
-
+    // gradient of the state variable (returned to the pool at the end)
+    ierr = gradm.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt, "claire"); CHKERRQ(ierr);
 
     ierr = GetRawPointer(this->m_IncAdjointVariable, &p_ltilde); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_WorkScaField1, &p_rhs0); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_WorkScaField2, &p_rhs1); CHKERRQ(ierr);
     ierr = this->m_WorkVecField1->GetArrays(p_ltjvx1, p_ltjvx2, p_ltjvx3); CHKERRQ(ierr);
-    ierr = this->m_WorkVecField3->GetArrays(p_gradm1, p_gradm2, p_gradm3); CHKERRQ(ierr);
+    ierr = gradm.m_X->GetArrays(p_gradm1, p_gradm2, p_gradm3); CHKERRQ(ierr);
     ierr = this->m_VelocityField->GetArrays(p_vx1, p_vx2, p_vx3); CHKERRQ(ierr);
 
     // init body force for numerical integration
@@ -3657,7 +4219,8 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationGNRK2(void) {
     ierr = this->m_VelocityField->RestoreArrays(p_vx1, p_vx2, p_vx3); CHKERRQ(ierr);
     ierr = this->m_WorkVecField1->RestoreArrays(p_ltjvx1, p_ltjvx2, p_ltjvx3); CHKERRQ(ierr);
     ierr = this->m_WorkVecField2->RestoreArrays(p_bt1, p_bt2, p_bt3); CHKERRQ(ierr);
-    ierr = this->m_WorkVecField3->RestoreArrays(p_gradm1, p_gradm2, p_gradm3); CHKERRQ(ierr);
+    ierr = gradm.m_X->RestoreArrays(p_gradm1, p_gradm2, p_gradm3); CHKERRQ(ierr);
+    ierr = gradm.Release(); CHKERRQ(ierr);
     ierr = RestoreRawPointer(this->m_WorkScaField2, &p_rhs1); CHKERRQ(ierr);
     ierr = RestoreRawPointer(this->m_WorkScaField1, &p_rhs0); CHKERRQ(ierr);
     ierr = RestoreRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
@@ -3703,7 +4266,7 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationFNRK2(void) {
     hthalf = 0.5*ht;
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkVecField1 == NULL) {
         try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
@@ -3759,7 +4322,7 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationFNRK2(void) {
         }  // for all image components
     } else {  // velocity is zero
         if (this->m_WorkScaField2 == NULL) {
-            ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
         }
 
         ierr = this->m_VelocityField->GetArrays(p_vx1, p_vx2, p_vx3); CHKERRQ(ierr);
@@ -3848,8 +4411,8 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationFNRK2(void) {
  *******************************************************************/
 PetscErrorCode CLAIRE::SolveIncAdjointEquationGNSL(void) {
     PetscErrorCode ierr = 0;
-    IntType nl, ng, nc, nt, ll, lm;
-    ScalarType *p_ltilde = NULL, *p_ltildex = NULL, *p_m = NULL,
+    IntType nl, ng, nc, nt, ll;
+    ScalarType *p_ltilde = NULL, *p_ltildex = NULL, *p_m = NULL, *p_mj = NULL,
                 *p_divv = NULL, *p_divvx = NULL,
                 *p_v1 = NULL, *p_v2 = NULL, *p_v3 = NULL,
                 *p_bt1 = NULL, *p_bt2 = NULL, *p_bt3 = NULL,
@@ -3865,22 +4428,22 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationGNSL(void) {
     ierr = Assert(this->m_StateVariable != NULL, "null pointer"); CHKERRQ(ierr);
     ierr = Assert(this->m_VelocityField != NULL, "null pointer"); CHKERRQ(ierr);
 
-    nt = this->m_Opt->m_Domain.nt;
+    nt = this->m_Opt->m_Domain.nt/this->m_TimeStride;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
     ng = this->m_Opt->m_Domain.ng;
-    ht = this->m_Opt->GetTimeStepSize();
+    ht = this->m_TimeStride*this->m_Opt->GetTimeStepSize();
     scale = ht;
     hthalf = 0.5*ht;
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField3 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkVecField1 == NULL) {
         try {this->m_WorkVecField1 = new VecField(this->m_Opt);}
@@ -3938,15 +4501,18 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationGNSL(void) {
     ierr = this->m_WorkVecField2->GetArrays(p_bt1, p_bt2, p_bt3); CHKERRQ(ierr);
 
     for (IntType j = 0; j < nt; ++j) {
-        lm = (nt-j)*nc*nl;
+        // overlap reading the next time point with this one
+        ierr = this->PrefetchStateTimePoint(nt-(j+1)); CHKERRQ(ierr);
+
         if (j == 0) scale *= 0.5;
         for (IntType k = 0; k < nc; ++k) {
             ll = k*nl;
             ierr = this->m_SemiLagrangianMethod->Interpolate(p_ltildex, p_ltilde + ll, "adjoint"); CHKERRQ(ierr);
 
             // compute gradient of m^j
+            ierr = this->GetStateTimePoint(p_mj, p_m, nt-j, k); CHKERRQ(ierr);
             this->m_Opt->StartTimer(FFTSELFEXEC);
-            accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_m + lm + k*nl, this->m_Opt->m_FFT.plan, &xyz, timer);
+            accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
             this->m_Opt->StopTimer(FFTSELFEXEC);
             this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -3977,11 +4543,12 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationGNSL(void) {
 
     // compute body force for last time point t = 0 (i.e., for j = nt)
     for (IntType k = 0; k < nc; ++k) {  // for all image components
-        ll = k*nl; lm = k*nl;
+        ll = k*nl;
 
         // compute gradient of m (for incremental body force)
+        ierr = this->GetStateTimePoint(p_mj, p_m, 0, k); CHKERRQ(ierr);
         this->m_Opt->StartTimer(FFTSELFEXEC);
-        accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_m + lm, this->m_Opt->m_FFT.plan, &xyz, timer);
+        accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
         this->m_Opt->StopTimer(FFTSELFEXEC);
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -4037,6 +4604,318 @@ PetscErrorCode CLAIRE::SolveIncAdjointEquationFNSL(void) {
 
 
 
+/********************************************************************
+ * @brief solve a block of nb incremental state equations (gauss--newton
+ * approximation; only the final time point is stored); the gradients
+ * of the state variable (and their values along the characteristics)
+ * are computed once and shared across the block; the incremental
+ * velocities and state variables of the block are interpolated with a
+ * single sweep each
+ * @param[out] mtilde block of incremental state variables (\tilde{m}(t=1)
+ * of vector b stored at b*nc*nl)
+ * @param[in] vtilde block of incremental velocities (vector b stored at 3*b*nl)
+ * @param vtildex work block for the interpolated incremental velocities
+ * @param[in] nb number of vectors in block
+ *******************************************************************/
+PetscErrorCode CLAIRE::SolveIncStateEquationBlockSL(Vec mtilde, Vec vtilde, Vec vtildex, IntType nb) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nt, nc, lv, lm;
+    std::bitset<3> XYZ; XYZ[0] = 1; XYZ[1] = 1; XYZ[2] = 1;
+    ScalarType ht, hthalf;
+    ScalarType *p_gm1 = NULL, *p_gm2 = NULL, *p_gm3 = NULL,
+               *p_mtilde = NULL, *p_m = NULL, *p_mj = NULL,
+               *p_vtilde = NULL, *p_vtildex = NULL;
+    double timer[NFFTTIMERS] = {0};
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    nt = this->m_Opt->m_Domain.nt/this->m_TimeStride;
+    nc = this->m_Opt->m_Domain.nc;
+    nl = this->m_Opt->m_Domain.nl;
+    ht = this->m_TimeStride*this->m_Opt->GetTimeStepSize();
+    hthalf = 0.5*ht;
+
+    ierr = Assert(this->m_StateVariable != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(mtilde != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(vtilde != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(vtildex != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_WorkVecField1 != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_SemiLagrangianMethod != NULL, "null pointer"); CHKERRQ(ierr);
+
+    ierr = this->m_Opt->StartTimer(PDEEXEC); CHKERRQ(ierr);
+
+    // set initial value
+    ierr = VecSet(mtilde, 0.0); CHKERRQ(ierr);
+
+    ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
+    ierr = GetRawPointer(mtilde, &p_mtilde); CHKERRQ(ierr);
+    ierr = GetRawPointer(vtilde, &p_vtilde); CHKERRQ(ierr);
+    ierr = GetRawPointer(vtildex, &p_vtildex); CHKERRQ(ierr);
+    ierr = this->m_WorkVecField1->GetArrays(p_gm1, p_gm2, p_gm3); CHKERRQ(ierr);
+
+    // interpolate all incremental velocities \tilde{v}(X) at once
+    ierr = this->m_SemiLagrangianMethod->Interpolate(p_vtildex, p_vtilde, 3*nb, "state"); CHKERRQ(ierr);
+
+    for (IntType j = 0; j < nt; ++j) {  // for all time points
+        // we need m^j and m^{j+1}; overlap reading m^{j+2}
+        ierr = this->PrefetchStateTimePoint(j+1); CHKERRQ(ierr);
+        ierr = this->PrefetchStateTimePoint(j+2); CHKERRQ(ierr);
+
+        // interpolate \tilde{m}^j(X) (all vectors and image components at once)
+        ierr = this->m_SemiLagrangianMethod->Interpolate(p_mtilde, p_mtilde, nb*nc, "state"); CHKERRQ(ierr);
+
+        for (IntType k = 0; k < nc; ++k) {  // for all image components
+            // compute gradient of m^j at X (shared across the block)
+            ierr = this->GetStateTimePoint(p_mj, p_m, j, k); CHKERRQ(ierr);
+            this->m_Opt->StartTimer(FFTSELFEXEC);
+            accfft_grad_t(p_gm1, p_gm2, p_gm3, p_mj, this->m_Opt->m_FFT.plan, &XYZ, timer);
+            this->m_Opt->StopTimer(FFTSELFEXEC);
+            this->m_Opt->IncrementCounter(FFT, FFTGRAD);
+
+            ierr = this->m_SemiLagrangianMethod->Interpolate(p_gm1, p_gm2, p_gm3, p_gm1, p_gm2, p_gm3, "state"); CHKERRQ(ierr);
+
+            // first part of time integration
+            for (IntType b = 0; b < nb; ++b) {
+                lm = (b*nc + k)*nl; lv = 3*b*nl;
+#pragma omp parallel
+{
+#pragma omp for
+                for (IntType i = 0; i < nl; ++i) {
+                    p_mtilde[lm + i] -= hthalf*(p_gm1[i]*p_vtildex[lv + i]
+                                              + p_gm2[i]*p_vtildex[lv + i + nl]
+                                              + p_gm3[i]*p_vtildex[lv + i + 2*nl]);
+                }
+}  // omp
+            }
+
+            // compute gradient of m^{j+1} (shared across the block)
+            ierr = this->GetStateTimePoint(p_mj, p_m, j+1, k); CHKERRQ(ierr);
+            this->m_Opt->StartTimer(FFTSELFEXEC);
+            accfft_grad_t(p_gm1, p_gm2, p_gm3, p_mj, this->m_Opt->m_FFT.plan, &XYZ, timer);
+            this->m_Opt->StopTimer(FFTSELFEXEC);
+            this->m_Opt->IncrementCounter(FFT, FFTGRAD);
+
+            // second part of time integration
+            for (IntType b = 0; b < nb; ++b) {
+                lm = (b*nc + k)*nl; lv = 3*b*nl;
+#pragma omp parallel
+{
+#pragma omp for
+                for (IntType i = 0; i < nl; ++i) {
+                    p_mtilde[lm + i] -= hthalf*(p_gm1[i]*p_vtilde[lv + i]
+                                              + p_gm2[i]*p_vtilde[lv + i + nl]
+                                              + p_gm3[i]*p_vtilde[lv + i + 2*nl]);
+                }
+}  // omp
+            }
+        }  // for all image components
+    }  // for all time points
+
+    ierr = this->m_WorkVecField1->RestoreArrays(p_gm1, p_gm2, p_gm3); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(vtildex, &p_vtildex); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(vtilde, &p_vtilde); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(mtilde, &p_mtilde); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
+
+    this->m_Opt->IncreaseFFTTimers(timer);
+
+    ierr = this->m_Opt->StopTimer(PDEEXEC); CHKERRQ(ierr);
+
+    // increment counter
+    this->m_Opt->IncrementCounter(PDESOLVE, static_cast<int>(nb));
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief solve a block of nb incremental adjoint equations (gauss--
+ * newton approximation); the terminal conditions are set from the
+ * incremental state variables (one vector at a time, via the distance
+ * measure); the incremental adjoint variables overwrite the incremental
+ * state variables; the gradients of the state variable and the
+ * divergence of the velocity are shared across the block; for
+ * incompressible velocities (stokes), \tilde{\lambda} is only
+ * transported (see CLAIREStokes)
+ * @param[out] btilde block of incremental body forces (body force of
+ * vector b stored at 3*b*nl; not yet projected or scaled)
+ * @param ltilde block of incremental state variables on input and of
+ * incremental adjoint variables on output
+ * @param[in] nb number of vectors in block
+ *******************************************************************/
+PetscErrorCode CLAIRE::SolveIncAdjointEquationBlockGNSL(Vec btilde, Vec ltilde, IntType nb) {
+    PetscErrorCode ierr = 0;
+    IntType nl, ng, nc, nt, lm, lv;
+    ScalarType *p_ltilde = NULL, *p_lt = NULL, *p_mt = NULL, *p_m = NULL, *p_mj = NULL,
+               *p_divv = NULL, *p_divvx = NULL, *p_bt = NULL,
+               *p_v1 = NULL, *p_v2 = NULL, *p_v3 = NULL,
+               *p_gradm1 = NULL, *p_gradm2 = NULL, *p_gradm3 = NULL;
+    ScalarType ht, hthalf, scale;
+    std::bitset<3> xyz; xyz[0] = 1; xyz[1] = 1; xyz[2] = 1;
+    double timer[NFFTTIMERS] = {0};
+    bool incompressible;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(this->m_StateVariable != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_VelocityField != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(ltilde != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(btilde != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_DistanceMeasure != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_SemiLagrangianMethod != NULL, "null pointer"); CHKERRQ(ierr);
+
+    nt = this->m_Opt->m_Domain.nt/this->m_TimeStride;
+    nc = this->m_Opt->m_Domain.nc;
+    nl = this->m_Opt->m_Domain.nl;
+    ng = this->m_Opt->m_Domain.ng;
+    ht = this->m_TimeStride*this->m_Opt->GetTimeStepSize();
+    scale = ht;
+    hthalf = 0.5*ht;
+    incompressible = this->m_Opt->m_RegModel == STOKES;
+
+    ierr = this->m_Opt->StartTimer(PDEEXEC); CHKERRQ(ierr);
+
+    if (this->m_WorkScaField1 == NULL) {
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+    }
+    if (this->m_WorkScaField2 == NULL) {
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+    }
+
+    // terminal conditions \tilde{\lambda}_1 (one vector at a time)
+    ierr = GetRawPointer(ltilde, &p_ltilde); CHKERRQ(ierr);
+    for (IntType b = 0; b < nb; ++b) {
+        lm = b*nc*nl;
+        ierr = GetRawPointer(this->m_IncStateVariable, &p_mt); CHKERRQ(ierr);
+#pragma omp parallel
+{
+#pragma omp for
+        for (IntType i = 0; i < nc*nl; ++i) {
+            p_mt[i] = p_ltilde[lm + i];
+        }
+}  // omp
+        ierr = RestoreRawPointer(this->m_IncStateVariable, &p_mt); CHKERRQ(ierr);
+
+        ierr = this->m_DistanceMeasure->SetFinalConditionIAE(); CHKERRQ(ierr);
+
+        ierr = GetRawPointer(this->m_IncAdjointVariable, &p_lt); CHKERRQ(ierr);
+#pragma omp parallel
+{
+#pragma omp for
+        for (IntType i = 0; i < nc*nl; ++i) {
+            p_ltilde[lm + i] = p_lt[i];
+        }
+}  // omp
+        ierr = RestoreRawPointer(this->m_IncAdjointVariable, &p_lt); CHKERRQ(ierr);
+    }
+
+    // compute divergence of velocity field (and its value at X)
+    ierr = GetRawPointer(this->m_WorkScaField1, &p_divv); CHKERRQ(ierr);
+    ierr = GetRawPointer(this->m_WorkScaField2, &p_divvx); CHKERRQ(ierr);
+    if (!incompressible) {
+        ierr = this->m_VelocityField->GetArrays(p_v1, p_v2, p_v3); CHKERRQ(ierr);
+        this->m_Opt->StartTimer(FFTSELFEXEC);
+        accfft_divergence_t(p_divv, p_v1, p_v2, p_v3, this->m_Opt->m_FFT.plan, timer);
+        this->m_Opt->StopTimer(FFTSELFEXEC);
+        ierr = this->m_VelocityField->RestoreArrays(p_v1, p_v2, p_v3); CHKERRQ(ierr);
+        this->m_Opt->IncrementCounter(FFT, FFTDIV);
+
+        ierr = this->m_SemiLagrangianMethod->Interpolate(p_divvx, p_divv, "adjoint"); CHKERRQ(ierr);
+    }
+
+    ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
+    ierr = this->m_WorkVecField1->GetArrays(p_gradm1, p_gradm2, p_gradm3); CHKERRQ(ierr);
+
+    // initialize body forces
+    ierr = VecSet(btilde, 0.0); CHKERRQ(ierr);
+    ierr = GetRawPointer(btilde, &p_bt); CHKERRQ(ierr);
+
+    for (IntType j = 0; j <= nt; ++j) {
+        // overlap reading the next time point with this one
+        if (j < nt) {
+            ierr = this->PrefetchStateTimePoint(nt-(j+1)); CHKERRQ(ierr);
+        }
+
+        // trapezoidal rule for body force (half weight at t = 1 and t = 0)
+        if (j == 0 || j == nt) scale *= 0.5;
+
+        // b = \sum_k\int_{\Omega} \tilde{\lambda}_k \grad m_k dt
+        for (IntType k = 0; k < nc; ++k) {
+            ierr = this->GetStateTimePoint(p_mj, p_m, nt-j, k); CHKERRQ(ierr);
+            this->m_Opt->StartTimer(FFTSELFEXEC);
+            accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
+            this->m_Opt->StopTimer(FFTSELFEXEC);
+            this->m_Opt->IncrementCounter(FFT, FFTGRAD);
+
+            for (IntType b = 0; b < nb; ++b) {
+                lm = (b*nc + k)*nl; lv = 3*b*nl;
+#pragma omp parallel
+{
+#pragma omp for
+                for (IntType i = 0; i < nl; ++i) {
+                    ScalarType ltilde = p_ltilde[lm + i];
+                    p_bt[lv + i       ] += scale*p_gradm1[i]*ltilde/static_cast<ScalarType>(nc);
+                    p_bt[lv + i +   nl] += scale*p_gradm2[i]*ltilde/static_cast<ScalarType>(nc);
+                    p_bt[lv + i + 2*nl] += scale*p_gradm3[i]*ltilde/static_cast<ScalarType>(nc);
+                }
+}  // omp
+            }
+        }  // for all image components
+
+        if (j == 0) scale *= 2.0;
+        if (j == nt) break;
+
+        // interpolate \tilde{\lambda}(X) (all vectors and image components at once)
+        ierr = this->m_SemiLagrangianMethod->Interpolate(p_ltilde, p_ltilde, nb*nc, "adjoint"); CHKERRQ(ierr);
+        if (incompressible) continue;
+
+#pragma omp parallel
+{
+#pragma omp for
+        for (IntType i = 0; i < nl; ++i) {
+            for (IntType l = 0; l < nb*nc; ++l) {
+                ScalarType ltildex = p_ltilde[l*nl + i];
+
+                // scale div(v)(X) by \tilde{\lambda}(X)
+                ScalarType rhs0 = ltildex*p_divvx[i];
+
+                // scale div(v) by \tilde{\lambda}*
+                ScalarType rhs1 = (ltildex + ht*rhs0)*p_divv[i];
+
+                // final rk2 step
+                p_ltilde[l*nl + i] = ltildex + hthalf*(rhs0 + rhs1);
+            }
+        }
+}  // omp
+    }  // for all time points
+
+    ierr = RestoreRawPointer(btilde, &p_bt); CHKERRQ(ierr);
+    ierr = this->m_WorkVecField1->RestoreArrays(p_gradm1, p_gradm2, p_gradm3); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(this->m_WorkScaField2, &p_divvx); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(this->m_WorkScaField1, &p_divv); CHKERRQ(ierr);
+    ierr = RestoreRawPointer(ltilde, &p_ltilde); CHKERRQ(ierr);
+
+    this->m_Opt->IncreaseFFTTimers(timer);
+
+    ierr = this->m_Opt->StopTimer(PDEEXEC); CHKERRQ(ierr);
+
+    // increment counter
+    this->m_Opt->IncrementCounter(PDESOLVE, static_cast<int>(nb));
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
 /********************************************************************
  * @brief apply projection to map \tilde{v} onto the manifold
  * of divergence free velocity fields
@@ -4065,7 +4944,7 @@ PetscErrorCode CLAIRE::FinalizeIteration(Vec v) {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     ierr = Assert(v != NULL, "null pointer"); CHKERRQ(ierr);
 
@@ -4074,6 +4953,9 @@ PetscErrorCode CLAIRE::FinalizeIteration(Vec v) {
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
     ng = this->m_Opt->m_Domain.ng;
+    if (this->m_StateHistory != NULL) {
+        nt = 0; // state variable only holds m(t=1)
+    }
 
     // parse extension
     ext = this->m_Opt->m_FileNames.extension;
@@ -4107,7 +4989,7 @@ PetscErrorCode CLAIRE::FinalizeIteration(Vec v) {
     if (this->m_Opt->m_ReadWriteFlags.iterates) {
         // allocate
         if (this->m_WorkScaFieldMC == NULL) {
-            ierr = VecCreate(this->m_WorkScaFieldMC, nl*nc, ng*nc); CHKERRQ(ierr);
+            ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaFieldMC, nl*nc, ng*nc, nc); CHKERRQ(ierr);
         }
 
         iter = this->m_Opt->GetCounter(ITERATIONS);
@@ -4195,14 +5077,17 @@ PetscErrorCode CLAIRE::Finalize(VecField* v) {
     ierr = Assert(v != NULL, "null pointer"); CHKERRQ(ierr);
 
     // get rank
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nproc);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+    MPI_Comm_size(this->m_Opt->m_Comm, &nproc);
 
     // get sizes
     nt = this->m_Opt->m_Domain.nt;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
     ng = this->m_Opt->m_Domain.ng;
+    if (this->m_StateHistory != NULL) {
+        nt = 0; // state variable only holds m(t=1)
+    }
 
     if (this->m_Opt->m_Verbosity >= 2) {
         ierr = DbgMsg("finalizing registration"); CHKERRQ(ierr);
@@ -4218,10 +5103,10 @@ PetscErrorCode CLAIRE::Finalize(VecField* v) {
     ierr = this->m_VelocityField->Copy(v); CHKERRQ(ierr);
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaFieldMC == NULL) {
-        ierr = VecCreate(this->m_WorkScaFieldMC, nl*nc, ng*nc); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaFieldMC, nl*nc, ng*nc, nc); CHKERRQ(ierr);
     }
 
     // process timer
@@ -549,8 +549,8 @@ PetscErrorCode CLAIREBase::ComputeInitialGuess() {
     if (!this->m_Opt->m_OptPara.usezeroinitialguess) {
         nl = this->m_Opt->m_Domain.nl;
         ng = this->m_Opt->m_Domain.ng;
-        ierr = VecCreate(v, nl, ng); CHKERRQ(ierr);
-        ierr = VecCreate(g, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, v, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, g, nl, ng); CHKERRQ(ierr);
 
         ierr = this->m_VelocityField->GetComponents(v); CHKERRQ(ierr);
 
@@ -832,27 +832,27 @@ PetscErrorCode CLAIREBase::SetupDeformationField() {
     ierr = this->m_DeformationFields->SetWorkVecField(this->m_WorkVecField3, 3); CHKERRQ(ierr);
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
     ierr = this->m_DeformationFields->SetWorkScaField(this->m_WorkScaField1, 1); CHKERRQ(ierr);
 
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2, nl, ng); CHKERRQ(ierr);
     }
     ierr = this->m_DeformationFields->SetWorkScaField(this->m_WorkScaField2, 2); CHKERRQ(ierr);
 
     if (this->m_WorkScaField3 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField3, nl, ng); CHKERRQ(ierr);
     }
     ierr = this->m_DeformationFields->SetWorkScaField(this->m_WorkScaField3, 3); CHKERRQ(ierr);
 
     if (this->m_WorkScaField4 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField4, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField4, nl, ng); CHKERRQ(ierr);
     }
     ierr = this->m_DeformationFields->SetWorkScaField(this->m_WorkScaField4, 4); CHKERRQ(ierr);
 
     if (this->m_WorkScaField5 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField5, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField5, nl, ng); CHKERRQ(ierr);
     }
     ierr = this->m_DeformationFields->SetWorkScaField(this->m_WorkScaField5, 5); CHKERRQ(ierr);
 
@@ -1062,13 +1062,13 @@ PetscErrorCode CLAIREBase::SetupSyntheticProb(Vec &mR, Vec &mT) {
 
     // allocate reference image
     if (mR == NULL) {
-        ierr = VecCreate(mR, nl*nc, ng*nc); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, mR, nl*nc, ng*nc, nc); CHKERRQ(ierr);
     }
     ierr = VecSet(mR, 0); CHKERRQ(ierr);
 
     // allocate template image
     if (mT == NULL) {
-        ierr = VecCreate(mT, nl*nc, ng*nc); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, mT, nl*nc, ng*nc, nc); CHKERRQ(ierr);
     }
     ierr = VecSet(mT, 0); CHKERRQ(ierr);
 
@@ -1308,7 +1308,7 @@ PetscErrorCode CLAIREBase::ComputeCFLCondition() {
     nt = this->m_Opt->m_Domain.nt;
 
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1, nl, ng); CHKERRQ(ierr);
     }
 
     if (this->m_WorkVecField1 == NULL) {
@@ -94,6 +94,8 @@ PetscErrorCode CLAIREInterface::Initialize(void) {
 
     this->m_DeleteSolution = true;
 
+    this->m_ParaContGroup = NULL;
+
     PetscFunctionReturn(ierr);
 }
 
@@ -107,6 +109,10 @@ PetscErrorCode CLAIREInterface::ClearMemory(void) {
     PetscErrorCode ierr = 0;
     PetscFunctionBegin;
 
+    // delete task groups and solutions of parameter continuation
+    ierr = this->ClearParaContGroups(); CHKERRQ(ierr);
+    ierr = this->ClearParaContSolutions(); CHKERRQ(ierr);
+
     // delete class for registration problem
     if (this->m_RegProblem != NULL) {
         delete this->m_RegProblem;
@@ -375,7 +381,7 @@ PetscErrorCode CLAIREInterface::SetCellDensity(Vec mC) {
 PetscErrorCode CLAIREInterface::GetFinalState(Vec m1) {
     PetscErrorCode ierr = 0;
     Vec m = NULL;
-    IntType nl, nc, nt;
+    IntType nl, nc, nt, nlm;
     ScalarType *p_m = NULL, *p_m1 = NULL;
     PetscFunctionBegin;
 
@@ -388,6 +394,10 @@ PetscErrorCode CLAIREInterface::GetFinalState(Vec m1) {
     nl = this->m_Opt->m_Domain.nl;
     nt = this->m_Opt->m_Domain.nt;
 
+    // state variable only holds m(t=1) if time history is compressed
+    ierr = VecGetLocalSize(m, &nlm); CHKERRQ(ierr);
+    if (nlm == nl*nc) nt = 0;
+
     ierr = VecGetArray(m, &p_m); CHKERRQ(ierr);
     ierr = VecGetArray(m1, &p_m1); CHKERRQ(ierr);
 
@@ -470,8 +480,8 @@ PetscErrorCode CLAIREInterface
 
     ierr = vel->GetSize(nl, ng); CHKERRQ(ierr);
 
-    ierr = VecCreate(g, 3*nl, 3*ng); CHKERRQ(ierr);
-    ierr = VecCreate(v, 3*nl, 3*ng); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, g, 3*nl, 3*ng, 3); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, v, 3*nl, 3*ng, 3); CHKERRQ(ierr);
 
     ierr = vel->GetComponents(v); CHKERRQ(ierr);
 
@@ -485,7 +495,7 @@ PetscErrorCode CLAIREInterface
     ierr = this->m_RegProblem->EvaluateObjective(&value, v); CHKERRQ(ierr);
     ierr = this->m_RegProblem->EvaluateGradient(g, v); CHKERRQ(ierr);
 
-    ierr = VecNorm(g, NORM_2, gnorm); CHKERRQ(ierr);
+    ierr = VecNormL2(g, gnorm); CHKERRQ(ierr);
 
     if (g != NULL) {ierr = VecDestroy(&g); CHKERRQ(ierr);}
     if (v != NULL) {ierr = VecDestroy(&v); CHKERRQ(ierr);}
@@ -716,7 +726,7 @@ PetscErrorCode CLAIREInterface::Run() {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     ierr = Msg("starting optimization"); CHKERRQ(ierr);
     if (rank == 0) std::cout << std::string(this->m_Opt->m_LineLength, '-') << std::endl;
@@ -950,18 +960,23 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaCont() {
  * regularization weight using a binary search; we reduce/lift the
  * regularization parameter until we found a deformation map that
  * is diffeomorphic and results in a map that is close to the bound
- * on jacobian set by user
+ * on jacobian set by user; the accepted solutions are stored by
+ * regularization parameter and every probe is warm started from
+ * the accepted solution closest to it; if task groups are enabled,
+ * a batch of regularization parameters is probed concurrently (one
+ * per group)
  *******************************************************************/
 PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
     PetscErrorCode ierr = 0;
-    int maxsteps, level, rank;
-    bool stop, boundreached, converged;
+    int maxsteps, level, rank, nprobes;
+    bool stop;
     std::ofstream logwriter;
     std::stringstream ss;
     std::string filename, msg;
     ScalarType beta, betamin, betascale, dbetascale,
                 betastar, betahat, dbeta, dbetamin;
-    Vec x = NULL;
+    std::vector<ScalarType> betas;
+    std::vector<bool> converged, boundreached;
 
     PetscFunctionBegin;
 
@@ -970,7 +985,7 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
     ierr = Assert(this->m_Optimizer != NULL, "null pointer"); CHKERRQ(ierr);
     ierr = Assert(this->m_RegProblem != NULL, "null pointer"); CHKERRQ(ierr);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     // get parameters
     betamin = this->m_Opt->GetBetaMinParaCont();
@@ -980,78 +995,85 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
     ierr = Assert(betascale < 1.0 && betascale > 0.0, "scale for beta not in (0,1)"); CHKERRQ(ierr);
     ierr = Assert(betamin > 0.0 && betamin < 1.0, "lower bound for beta in (0,1)"); CHKERRQ(ierr);
 
-    // set optimization problem
-    ierr = this->m_Optimizer->SetProblem(this->m_RegProblem); CHKERRQ(ierr);
-
-    // set initial guess for current level
-    ierr = this->m_Optimizer->SetInitialGuess(this->m_Solution); CHKERRQ(ierr);
-
     // initialize parameters (can be user defined)
     beta = this->m_Opt->m_ParaCont.beta0;
     betastar = beta;
-
-    // initialize registration problem (evaluate objective and gradient
-    // for zero velocity field)
     this->m_Opt->m_RegNorm.beta[0] = beta;
-    ierr = this->m_RegProblem->InitializeOptimization(); CHKERRQ(ierr);
+
+    ierr = this->ClearParaContSolutions(); CHKERRQ(ierr);
+
+    // set up task groups (the registration problem is
+    // initialized on every group)
+    if (this->m_Opt->m_ParaCont.ngroups > 1) {
+        ierr = this->SetupParaContGroups(); CHKERRQ(ierr);
+    }
+    nprobes = this->m_ParaContGroup != NULL ? this->m_ParaContGroup->m_NumGroups : 1;
+
+    if (this->m_ParaContGroup == NULL) {
+        // set optimization problem
+        ierr = this->m_Optimizer->SetProblem(this->m_RegProblem); CHKERRQ(ierr);
+
+        // set initial guess for current level
+        ierr = this->m_Optimizer->SetInitialGuess(this->m_Solution); CHKERRQ(ierr);
+
+        // initialize registration problem (evaluate objective and gradient
+        // for zero velocity field)
+        ierr = this->m_RegProblem->InitializeOptimization(); CHKERRQ(ierr);
+    }
 
     if (this->m_Opt->m_Verbosity > 0) {
         ierr = DbgMsg("starting coarse search for regularization weight"); CHKERRQ(ierr);
     }
 
     // reduce regularization parameter by one order of magnitude until
-    // we hit tolerance
+    // we hit tolerance (one order of magnitude per probe of a batch)
     stop = false; level = 0;
     while (level < maxsteps) {
-        this->m_Opt->m_RegNorm.beta[0] = beta;
-        //this->m_Opt->InitialGradNormSet(false);
-
-        ss << std::scientific << std::setw(3)
-            << "level " << level << " ( betav=" << beta
-            << "; betav*=" << betastar << " )";
-        ierr = this->DispLevelMsg(ss.str(), rank); CHKERRQ(ierr);
-        ss.str(std::string()); ss.clear();
-
-        if (this->m_Opt->m_OptPara.fastsolve) {
-//            ierr = this->m_RegProblem->InitializeOptimization(this->m_Solution); CHKERRQ(ierr);
-            ierr = this->m_RegProblem->InitializeOptimization(); CHKERRQ(ierr);
+        betas.clear();
+        for (int k = 0; k < nprobes && level + k < maxsteps; ++k) {
+            if (k > 0 && betas.back()*betascale < betamin) break;
+            betas.push_back(k == 0 ? beta : betas.back()*betascale);
         }
 
-        // set initial guess for current level
-        ierr = this->m_Optimizer->SetInitialGuess(this->m_Solution); CHKERRQ(ierr);
+        for (size_t k = 0; k < betas.size(); ++k) {
+            ss << std::scientific << std::setw(3)
+                << "level " << level + k << " ( betav=" << betas[k]
+                << "; betav*=" << betastar << " )";
+            ierr = this->DispLevelMsg(ss.str(), rank); CHKERRQ(ierr);
+            ss.str(std::string()); ss.clear();
+        }
 
         // run the optimization
-        ierr = this->m_Optimizer->Run(); CHKERRQ(ierr);
-
-        // if we did not converge, we do not want to decrease
-        // the regularization parameter
-        ierr = this->m_Optimizer->GetSolutionStatus(converged); CHKERRQ(ierr);
-        if (!converged && level > 0) break;
-
-        // get the solution
-        ierr = this->m_Optimizer->GetSolution(x); CHKERRQ(ierr);
-
-        // check bounds on jacobian
-        ierr = this->m_RegProblem->CheckBounds(x, stop); CHKERRQ(ierr);
+        ierr = this->RunParaContProbes(betas, converged, boundreached); CHKERRQ(ierr);
+
+        for (size_t k = 0; k < betas.size(); ++k) {
+            // if we did not converge, we do not want to decrease
+            // the regularization parameter (the first solution is
+            // accepted if it is within the bounds)
+            if (!converged[k] && !this->m_ParaContSolutions.empty()) {
+                stop = true; break;
+            }
 
-        // we have to make sure that the initial parameter was
-        // not too small
-        if (stop) {
-            if (level > 0) {
-                break;  ///< if bound reached go home
-            } else {
+            // we have to make sure that the initial parameter was
+            // not too small
+            if (boundreached[k]) {
+                if (!this->m_ParaContSolutions.empty()) {
+                    stop = true; break;  ///< if bound reached go home
+                }
                 // we reached bound in first step -> increase beta
-                beta /= betascale;
-                level = -1;  ///< reset level to 0
+                beta = betas[k]/betascale;
+                break;
             }
-        } else {
+
             // remember regularization parameter
-            betastar = beta;
+            betastar = betas[k];
             // if we got here, the solution is valid
-            ierr = this->m_Solution->SetComponents(x); CHKERRQ(ierr);
+            ierr = this->StoreParaContSolution(betastar, static_cast<int>(k)); CHKERRQ(ierr);
             // reduce beta
-            beta *= betascale;
+            beta = betastar*betascale;
+            ++level;
         }
+        if (stop) break;
 
         // if regularization parameter is smaller than
         // lower bound, let's stop this
@@ -1065,7 +1087,6 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
             }
             break;
         }
-        ++level;
     }  ///< until we hit the tolerance
 
     if (this->m_Opt->m_Verbosity > 0) {
@@ -1074,10 +1095,8 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
 
     stop = false;  ///< reset search
 
-    // compute new trial beta
+    // lower end of the search interval
     betahat = betascale*betastar;
-    dbeta = (betastar-betahat)/2.0;
-    beta = betastar-dbeta;
     ++level;
 
     // get scale for delta beta; this parameter determines how
@@ -1090,54 +1109,43 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
     dbetamin = dbetascale*betastar;
 
     while (!stop) {
-        // set regularization parameter
-        this->m_Opt->m_RegNorm.beta[0] = beta;
+        // split (betahat, betastar) into nprobes+1 intervals of the same
+        // length (bisection for a single probe)
+        dbeta = (betastar - betahat)/static_cast<ScalarType>(nprobes + 1);
+        betas.clear();
+        for (int k = 1; k <= nprobes; ++k) {
+            betas.push_back(betastar - static_cast<ScalarType>(k)*dbeta);
+        }
 
         // display regularization parameter to user
-        ss << std::setw(3) << "level " << level << " ( betav="
-           << beta << "; betav*=" << betastar << " )";
-        ierr = this->DispLevelMsg(ss.str(), rank); CHKERRQ(ierr);
-        ss.str(std::string()); ss.clear();
-
-        if (this->m_Opt->m_OptPara.fastsolve) {
-//            ierr = this->m_RegProblem->InitializeOptimization(this->m_Solution); CHKERRQ(ierr);
-            ierr = this->m_RegProblem->InitializeOptimization(); CHKERRQ(ierr);
+        for (size_t k = 0; k < betas.size(); ++k) {
+            ss << std::setw(3) << "level " << level + k << " ( betav="
+               << betas[k] << "; betav*=" << betastar << " )";
+            ierr = this->DispLevelMsg(ss.str(), rank); CHKERRQ(ierr);
+            ss.str(std::string()); ss.clear();
         }
 
-        // set initial guess for current level
-        ierr = this->m_Optimizer->SetInitialGuess(this->m_Solution); CHKERRQ(ierr);
-
         // run the optimization
-        ierr = this->m_Optimizer->Run(); CHKERRQ(ierr);
-
-        // if we did not converge, beta is too small, also
-        ierr = this->m_Optimizer->GetSolutionStatus(converged); CHKERRQ(ierr);
-        if (converged) {
-            // get the solution
-            ierr = this->m_Optimizer->GetSolution(x); CHKERRQ(ierr);
-
-            // check bounds on jacobian
-            boundreached = false;
-            ierr = this->m_RegProblem->CheckBounds(x, boundreached); CHKERRQ(ierr);
-
-            // if bound is reached, the lower bound is now beta
-            // if not, beta is our new best estimate
-            if (boundreached) {
-                betahat = beta;
+        ierr = this->RunParaContProbes(betas, converged, boundreached); CHKERRQ(ierr);
+
+        // the probes are sorted by decreasing beta; the first one that
+        // did not converge or reached the bound is the new lower end of
+        // the interval; the ones before are valid (new best estimate)
+        for (size_t k = 0; k < betas.size(); ++k) {
+            if (converged[k] && !boundreached[k]) {
+                betastar = betas[k];
+                ierr = this->StoreParaContSolution(betastar, static_cast<int>(k)); CHKERRQ(ierr);
             } else {
-                betastar = beta;  // new best estimate
-
-                // if we got here, the solution is valid
-                ierr = this->m_Solution->SetComponents(x); CHKERRQ(ierr);
+                if (!converged[k]) {
+                    ierr = WrngMsg("solver did not converge"); CHKERRQ(ierr);
+                }
+                betahat = betas[k];
+                break;
             }
-        } else {
-            ierr = WrngMsg("solver did not converge"); CHKERRQ(ierr);
-            betahat = beta;
         }
 
         // increase or reduce beta
-        dbeta = (betastar - betahat)/2.0;
-        beta = betastar - dbeta;
+        dbeta = (betastar - betahat)/static_cast<ScalarType>(nprobes + 1);
         if (fabs(dbeta) < dbetamin) {
             stop = true;
             if (this->m_Opt->m_Verbosity > 0) {
@@ -1147,8 +1155,17 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
                 ss.str(std::string()); ss.clear();
             }
         }
-        ++level;
+        level += static_cast<int>(betas.size());
+    }
+
+    // the solution is the one for the estimated regularization parameter
+    if (this->m_ParaContSolutions.count(betastar) != 0) {
+        ierr = this->m_Solution->Copy(this->m_ParaContSolutions[betastar]); CHKERRQ(ierr);
     }
+    this->m_Opt->m_RegNorm.beta[0] = betastar;
+
+    ierr = this->ClearParaContGroups(); CHKERRQ(ierr);
+    ierr = this->ClearParaContSolutions(); CHKERRQ(ierr);
 
     if (rank == 0) std::cout << std::string(this->m_Opt->m_LineLength, '-') << std::endl;
     ss << std::scientific << "estimated regularization parameter betav=" << betastar;
@@ -1181,6 +1198,580 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContBinarySearch() {
 
 
 
+/********************************************************************
+ * @brief solve the registration problem for a batch of
+ * regularization parameters; without task groups, the batch holds
+ * a single parameter and is solved on all tasks; with task groups,
+ * group k solves for the k-th parameter (groups without parameter
+ * are idle); every probe is warm started from the accepted solution
+ * closest to its parameter; the solutions are kept in the data
+ * layout of all tasks (see StoreParaContSolution)
+ * @param[in] beta regularization parameters of the batch
+ * @param[out] converged flag: solver converged (per parameter)
+ * @param[out] boundreached flag: jacobian bound reached (per parameter)
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::RunParaContProbes(const std::vector<ScalarType>& beta,
+                                                  std::vector<bool>& converged,
+                                                  std::vector<bool>& boundreached) {
+    PetscErrorCode ierr = 0;
+    int nprobes, ngroups, k, rval;
+    bool conv, bound;
+    std::vector<int> flag;
+    VecField* x0 = NULL;
+    Vec x = NULL;
+    ParaContGroup* grp = NULL;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    grp = this->m_ParaContGroup;
+    ngroups = grp != NULL ? grp->m_NumGroups : 1;
+    nprobes = static_cast<int>(beta.size());
+    ierr = Assert(nprobes > 0 && nprobes <= ngroups, "number of probes out of bounds"); CHKERRQ(ierr);
+
+    // solutions of the probes (data layout of all tasks)
+    if (static_cast<int>(this->m_ParaContProbes.size()) != ngroups) {
+        for (size_t i = 0; i < this->m_ParaContProbes.size(); ++i) {
+            if (this->m_ParaContProbes[i] != NULL) delete this->m_ParaContProbes[i];
+        }
+        this->m_ParaContProbes.assign(ngroups, NULL);
+        for (int i = 0; i < ngroups; ++i) {
+            try {this->m_ParaContProbes[i] = new VecField(this->m_Opt);}
+            catch (std::bad_alloc& err) {
+                ierr = reg::ThrowError(err); CHKERRQ(ierr);
+            }
+        }
+    }
+
+    if (grp == NULL) {
+        this->m_Opt->m_RegNorm.beta[0] = beta[0];
+
+        if (this->m_Opt->m_OptPara.fastsolve) {
+            ierr = this->m_RegProblem->InitializeOptimization(); CHKERRQ(ierr);
+        }
+
+        // set initial guess for current level
+        ierr = this->GetParaContInitialGuess(x0, beta[0]); CHKERRQ(ierr);
+        ierr = this->m_Optimizer->SetInitialGuess(x0); CHKERRQ(ierr);
+
+        // run the optimization
+        ierr = this->m_Optimizer->Run(); CHKERRQ(ierr);
+        ierr = this->m_Optimizer->GetSolutionStatus(conv); CHKERRQ(ierr);
+
+        // get the solution and check bounds on jacobian
+        ierr = this->m_Optimizer->GetSolution(x); CHKERRQ(ierr);
+        ierr = this->m_RegProblem->CheckBounds(x, bound); CHKERRQ(ierr);
+        ierr = this->m_ParaContProbes[0]->SetComponents(x); CHKERRQ(ierr);
+
+        converged.assign(1, conv);
+        boundreached.assign(1, bound);
+    } else {
+        // distribute initial guesses (idle groups get the one of the
+        // first probe; they do not use it)
+        for (k = 0; k < ngroups; ++k) {
+            ierr = this->GetParaContInitialGuess(x0, beta[std::min(k, nprobes-1)]); CHKERRQ(ierr);
+            ierr = this->m_ParaContProbes[k]->Copy(x0); CHKERRQ(ierr);
+        }
+        ierr = this->ExchangeParaContSolutions(true); CHKERRQ(ierr);
+
+        // solve on task group
+        flag.assign(2*ngroups, 0);
+        k = grp->m_Group;
+        if (k < nprobes) {
+            grp->m_Opt->m_RegNorm.beta[0] = beta[k];
+
+            if (grp->m_Opt->m_OptPara.fastsolve) {
+                ierr = grp->m_RegProblem->InitializeOptimization(); CHKERRQ(ierr);
+            }
+
+            ierr = grp->m_Optimizer->SetInitialGuess(grp->m_Solution); CHKERRQ(ierr);
+            ierr = grp->m_Optimizer->Run(); CHKERRQ(ierr);
+            ierr = grp->m_Optimizer->GetSolutionStatus(conv); CHKERRQ(ierr);
+
+            ierr = grp->m_Optimizer->GetSolution(x); CHKERRQ(ierr);
+            ierr = grp->m_RegProblem->CheckBounds(x, bound); CHKERRQ(ierr);
+            ierr = grp->m_Solution->SetComponents(x); CHKERRQ(ierr);
+
+            flag[k] = conv ? 1 : 0;
+            flag[ngroups + k] = bound ? 1 : 0;
+        }
+
+        // all tasks of a group hold the same flags
+        rval = MPI_Allreduce(MPI_IN_PLACE, flag.data(), 2*ngroups, MPI_INT, MPI_MAX, grp->m_WorldComm);
+        ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+        // collect solutions
+        ierr = this->ExchangeParaContSolutions(false); CHKERRQ(ierr);
+
+        converged.resize(nprobes);
+        boundreached.resize(nprobes);
+        for (k = 0; k < nprobes; ++k) {
+            converged[k] = flag[k] != 0;
+            boundreached[k] = flag[ngroups + k] != 0;
+        }
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief get initial guess for a probe of the parameter
+ * continuation; this is the accepted solution with the regularization
+ * parameter closest to beta (on a log scale); if no solution has
+ * been accepted yet, it is the initial guess of the user
+ * @param[out] x initial guess (not to be deleted)
+ * @param[in] beta regularization parameter of probe
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::GetParaContInitialGuess(VecField*& x, ScalarType beta) {
+    PetscErrorCode ierr = 0;
+    ScalarType dist, distmin;
+    std::map<ScalarType, VecField*>::iterator it;
+    PetscFunctionBegin;
+
+    ierr = Assert(this->m_Solution != NULL, "null pointer"); CHKERRQ(ierr);
+
+    x = this->m_Solution;
+    distmin = std::numeric_limits<ScalarType>::max();
+    for (it = this->m_ParaContSolutions.begin(); it != this->m_ParaContSolutions.end(); ++it) {
+        dist = std::abs(std::log(it->first/beta));
+        if (dist < distmin) {
+            distmin = dist;
+            x = it->second;
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief accept solution of a probe of the parameter continuation;
+ * the probes of the search always lie below the smallest accepted
+ * regularization parameter, so the solutions for larger parameters
+ * are never used again as initial guess and are deleted
+ * @param[in] beta regularization parameter of probe
+ * @param[in] k index of probe in last batch (see RunParaContProbes)
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::StoreParaContSolution(ScalarType beta, int k) {
+    PetscErrorCode ierr = 0;
+    VecField* x = NULL;
+    std::map<ScalarType, VecField*>::iterator it;
+    PetscFunctionBegin;
+
+    ierr = Assert(k >= 0 && k < static_cast<int>(this->m_ParaContProbes.size()), "index out of bounds"); CHKERRQ(ierr);
+    ierr = Assert(this->m_ParaContProbes[k] != NULL, "null pointer"); CHKERRQ(ierr);
+
+    // reuse the storage of the solutions we drop
+    it = this->m_ParaContSolutions.upper_bound(beta);
+    while (it != this->m_ParaContSolutions.end()) {
+        if (x == NULL) {
+            x = it->second;
+        } else {
+            delete it->second;
+        }
+        this->m_ParaContSolutions.erase(it++);
+    }
+    if (this->m_ParaContSolutions.count(beta) != 0) {
+        if (x != NULL) delete x;
+        x = this->m_ParaContSolutions[beta];
+    }
+    if (x == NULL) {
+        try {x = new VecField(this->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    }
+    ierr = x->Copy(this->m_ParaContProbes[k]); CHKERRQ(ierr);
+    this->m_ParaContSolutions[beta] = x;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief delete the solutions of the parameter continuation
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::ClearParaContSolutions() {
+    PetscErrorCode ierr = 0;
+    std::map<ScalarType, VecField*>::iterator it;
+    PetscFunctionBegin;
+
+    for (it = this->m_ParaContSolutions.begin(); it != this->m_ParaContSolutions.end(); ++it) {
+        if (it->second != NULL) delete it->second;
+    }
+    this->m_ParaContSolutions.clear();
+
+    for (size_t i = 0; i < this->m_ParaContProbes.size(); ++i) {
+        if (this->m_ParaContProbes[i] != NULL) delete this->m_ParaContProbes[i];
+    }
+    this->m_ParaContProbes.clear();
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set up task groups for the binary search; the tasks are
+ * split into ngroups groups of contiguous ranks; every group holds
+ * its own copy of the registration problem (options, problem,
+ * optimizer, preconditioner) on the full grid; output, logging and
+ * the cache for eigenvalue estimates are disabled on the groups;
+ * if the number of tasks is not a multiple of the number of groups,
+ * we probe on all tasks
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::SetupParaContGroups() {
+    PetscErrorCode ierr = 0;
+    int rank, nprocs, ngroups, rval;
+    std::stringstream ss;
+    Vec mR = NULL, mT = NULL, mask = NULL;
+    ParaContGroup* grp = NULL;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = this->ClearParaContGroups(); CHKERRQ(ierr);
+
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+    MPI_Comm_size(this->m_Opt->m_Comm, &nprocs);
+
+    ngroups = this->m_Opt->m_ParaCont.ngroups;
+    if (ngroups > nprocs || nprocs % ngroups != 0) {
+        ss << "number of mpi tasks (" << nprocs << ") not a multiple of number of task groups ("
+           << ngroups << "); probing on all tasks";
+        ierr = WrngMsg(ss.str()); CHKERRQ(ierr);
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+    if (this->m_CellDensity != NULL || this->m_AuxVariable != NULL) {
+        ierr = WrngMsg("task groups not available for coupled formulation; probing on all tasks"); CHKERRQ(ierr);
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
+    try {this->m_ParaContGroup = new ParaContGroup();}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    grp = this->m_ParaContGroup;
+    grp->m_Opt = NULL;
+    grp->m_RegProblem = NULL;
+    grp->m_Optimizer = NULL;
+    grp->m_Precond = NULL;
+    grp->m_PreProc = NULL;
+    grp->m_ReferenceImage = NULL;
+    grp->m_TemplateImage = NULL;
+    grp->m_Mask = NULL;
+    grp->m_Solution = NULL;
+    grp->m_Comm = MPI_COMM_NULL;
+
+    grp->m_NumGroups = ngroups;
+    grp->m_GroupSize = nprocs/ngroups;
+    grp->m_Group = rank/grp->m_GroupSize;
+    grp->m_WorldComm = this->m_Opt->m_Comm;
+    rval = MPI_Comm_split(grp->m_WorldComm, grp->m_Group, rank, &grp->m_Comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+    if (this->m_Opt->m_Verbosity > 1) {
+        ss << "parameter continuation: " << ngroups << " task groups of "
+           << grp->m_GroupSize << " tasks";
+        ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+    }
+
+    // set up options for task group (copy all parameters and do
+    // setup of all plans on the communicator of the group)
+    try {grp->m_Opt = new RegOpt(*this->m_Opt);}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    grp->m_Opt->m_Comm = grp->m_Comm;
+    grp->m_Opt->m_ParaCont.ngroups = 1;
+    grp->m_Opt->m_ReadWriteFlags.iterates = false;
+    grp->m_Opt->m_ReadWriteFlags.timeseries = false;
+    grp->m_Opt->m_StoreCheckPoints = false;
+    grp->m_Opt->m_FileNames.pceigfile.clear();
+    for (int i = 0; i < NLOGFLAGS; ++i) {
+        grp->m_Opt->m_Log.enabled[i] = false;
+    }
+    ierr = grp->m_Opt->DoSetup(false); CHKERRQ(ierr);
+
+    // allocate class for registration
+    if (grp->m_Opt->m_RegModel == COMPRESSIBLE) {
+        try {grp->m_RegProblem = new CLAIRE(grp->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    } else if (grp->m_Opt->m_RegModel == STOKES) {
+        try {grp->m_RegProblem = new CLAIREStokes(grp->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    } else if (grp->m_Opt->m_RegModel == RELAXEDSTOKES) {
+        try {grp->m_RegProblem = new CLAIREDivReg(grp->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    } else {
+        ierr = ThrowError("registration model not available"); CHKERRQ(ierr);
+    }
+
+    try {grp->m_Optimizer = new OptimizerType(grp->m_Opt);}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    try {grp->m_PreProc = new Preprocessing(grp->m_Opt);}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    if (grp->m_Opt->m_KrylovMethod.pctype != NOPC) {
+        try {grp->m_Precond = new Preconditioner(grp->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+        ierr = grp->m_Precond->SetPreProc(grp->m_PreProc); CHKERRQ(ierr);
+        ierr = grp->m_Precond->SetProblem(grp->m_RegProblem); CHKERRQ(ierr);
+        ierr = grp->m_Optimizer->SetPreconditioner(grp->m_Precond); CHKERRQ(ierr);
+    }
+
+    try {grp->m_Solution = new VecField(grp->m_Opt);}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    ierr = grp->m_Solution->SetValue(0.0); CHKERRQ(ierr);
+
+    // distribute the (preprocessed) images
+    ierr = this->SetupParaContRedistribution(); CHKERRQ(ierr);
+
+    ierr = this->m_RegProblem->GetReferenceImage(mR); CHKERRQ(ierr);
+    ierr = this->m_RegProblem->GetTemplateImage(mT); CHKERRQ(ierr);
+    ierr = this->m_RegProblem->GetMask(mask); CHKERRQ(ierr);
+    ierr = this->DistributeParaContImage(grp->m_ReferenceImage, mR); CHKERRQ(ierr);
+    ierr = this->DistributeParaContImage(grp->m_TemplateImage, mT); CHKERRQ(ierr);
+    if (mask != NULL) {
+        ierr = this->DistributeParaContImage(grp->m_Mask, mask); CHKERRQ(ierr);
+    }
+
+    // initialize registration problem (evaluate objective and
+    // gradient for zero velocity field)
+    ierr = grp->m_RegProblem->SetReferenceImage(grp->m_ReferenceImage); CHKERRQ(ierr);
+    ierr = grp->m_RegProblem->SetTemplateImage(grp->m_TemplateImage); CHKERRQ(ierr);
+    if (grp->m_Mask != NULL) {
+        ierr = grp->m_RegProblem->SetMask(grp->m_Mask); CHKERRQ(ierr);
+    }
+    ierr = grp->m_Optimizer->SetProblem(grp->m_RegProblem); CHKERRQ(ierr);
+    ierr = grp->m_Optimizer->SetInitialGuess(grp->m_Solution); CHKERRQ(ierr);
+    ierr = grp->m_RegProblem->InitializeOptimization(); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief compute the communication pattern to redistribute scalar
+ * fields between the data layout of all tasks and the data layout
+ * of the task groups; every task sends its box (layout of all tasks)
+ * to every group (see Redistribution)
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::SetupParaContRedistribution() {
+    PetscErrorCode ierr = 0;
+    IntType sbox[6], tbox[6];
+    ParaContGroup* grp = NULL;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    grp = this->m_ParaContGroup;
+    ierr = Assert(grp != NULL, "null pointer"); CHKERRQ(ierr);
+
+    // local box in data layout of all tasks and of task group (istart, isize)
+    for (int j = 0; j < 3; ++j) {
+        sbox[j]   = this->m_Opt->m_Domain.istart[j];
+        sbox[3+j] = this->m_Opt->m_Domain.isize[j];
+        tbox[j]   = grp->m_Opt->m_Domain.istart[j];
+        tbox[3+j] = grp->m_Opt->m_Domain.isize[j];
+    }
+
+    ierr = grp->m_Redistribution.Setup(grp->m_WorldComm, sbox, tbox); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief copy (multi-component) image given in the data layout of
+ * all tasks to all task groups; collective on all tasks
+ * @param[out] x_g image in data layout of task group (allocated here)
+ * @param[in] x_w image in data layout of all tasks
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::DistributeParaContImage(Vec& x_g, Vec x_w) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nlg, ngg, nc;
+    ScalarType *p_xg = NULL, *p_xw = NULL;
+    std::vector<const ScalarType*> p_world;
+    ParaContGroup* grp = NULL;
+    PetscFunctionBegin;
+
+    grp = this->m_ParaContGroup;
+    ierr = Assert(grp != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(x_w != NULL, "null pointer"); CHKERRQ(ierr);
+
+    // number of components
+    ierr = VecGetLocalSize(x_w, &nl); CHKERRQ(ierr);
+    nc = nl/this->m_Opt->m_Domain.nl;
+
+    nlg = grp->m_Opt->m_Domain.nl;
+    ngg = grp->m_Opt->m_Domain.ng;
+    ierr = VecCreate(grp->m_Opt->m_Comm, x_g, nc*nlg, nc*ngg, nc); CHKERRQ(ierr);
+
+    nl = this->m_Opt->m_Domain.nl;
+    ierr = VecGetArray(x_w, &p_xw); CHKERRQ(ierr);
+    ierr = VecGetArray(x_g, &p_xg); CHKERRQ(ierr);
+    for (IntType k = 0; k < nc; ++k) {
+        p_world.assign(grp->m_NumGroups, p_xw + k*nl);
+        ierr = grp->m_Redistribution.Scatter(p_xg + k*nlg, p_world.data(), grp->m_NumGroups); CHKERRQ(ierr);
+    }
+    ierr = VecRestoreArray(x_g, &p_xg); CHKERRQ(ierr);
+    ierr = VecRestoreArray(x_w, &p_xw); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief redistribute the velocity fields between the solutions of
+ * the probes (m_ParaContProbes; data layout of all tasks) and the
+ * solutions on the task groups; collective on all tasks
+ * @param[in] scatter if true, group k receives the k-th probe as
+ * initial guess (and the k-th probe receives the solution of group k
+ * if false)
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::ExchangeParaContSolutions(bool scatter) {
+    PetscErrorCode ierr = 0;
+    int ngroups;
+    std::vector<ScalarType*> p_x1, p_x2, p_x3;
+    ScalarType *p_g1 = NULL, *p_g2 = NULL, *p_g3 = NULL;
+    ParaContGroup* grp = NULL;
+    PetscFunctionBegin;
+
+    grp = this->m_ParaContGroup;
+    ierr = Assert(grp != NULL, "null pointer"); CHKERRQ(ierr);
+
+    ngroups = grp->m_NumGroups;
+    p_x1.assign(ngroups, NULL);
+    p_x2.assign(ngroups, NULL);
+    p_x3.assign(ngroups, NULL);
+
+    for (int k = 0; k < ngroups; ++k) {
+        ierr = this->m_ParaContProbes[k]->GetArrays(p_x1[k], p_x2[k], p_x3[k]); CHKERRQ(ierr);
+    }
+    ierr = grp->m_Solution->GetArrays(p_g1, p_g2, p_g3); CHKERRQ(ierr);
+
+    if (scatter) {
+        ierr = grp->m_Redistribution.Scatter(p_g1, p_x1.data(), ngroups); CHKERRQ(ierr);
+        ierr = grp->m_Redistribution.Scatter(p_g2, p_x2.data(), ngroups); CHKERRQ(ierr);
+        ierr = grp->m_Redistribution.Scatter(p_g3, p_x3.data(), ngroups); CHKERRQ(ierr);
+    } else {
+        ierr = grp->m_Redistribution.Gather(p_x1.data(), p_g1, ngroups); CHKERRQ(ierr);
+        ierr = grp->m_Redistribution.Gather(p_x2.data(), p_g2, ngroups); CHKERRQ(ierr);
+        ierr = grp->m_Redistribution.Gather(p_x3.data(), p_g3, ngroups); CHKERRQ(ierr);
+    }
+
+    ierr = grp->m_Solution->RestoreArrays(p_g1, p_g2, p_g3); CHKERRQ(ierr);
+    for (int k = 0; k < ngroups; ++k) {
+        ierr = this->m_ParaContProbes[k]->RestoreArrays(p_x1[k], p_x2[k], p_x3[k]); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief delete task groups of the binary search
+ *******************************************************************/
+PetscErrorCode CLAIREInterface::ClearParaContGroups() {
+    PetscErrorCode ierr = 0;
+    ParaContGroup* grp = NULL;
+    PetscFunctionBegin;
+
+    grp = this->m_ParaContGroup;
+    if (grp == NULL) PetscFunctionReturn(ierr);
+
+    if (grp->m_Optimizer != NULL) {
+        delete grp->m_Optimizer;
+        grp->m_Optimizer = NULL;
+    }
+    if (grp->m_Precond != NULL) {
+        delete grp->m_Precond;
+        grp->m_Precond = NULL;
+    }
+    if (grp->m_RegProblem != NULL) {
+        delete grp->m_RegProblem;
+        grp->m_RegProblem = NULL;
+    }
+    if (grp->m_PreProc != NULL) {
+        delete grp->m_PreProc;
+        grp->m_PreProc = NULL;
+    }
+    if (grp->m_Solution != NULL) {
+        delete grp->m_Solution;
+        grp->m_Solution = NULL;
+    }
+    if (grp->m_ReferenceImage != NULL) {
+        ierr = VecDestroy(&grp->m_ReferenceImage); CHKERRQ(ierr);
+        grp->m_ReferenceImage = NULL;
+    }
+    if (grp->m_TemplateImage != NULL) {
+        ierr = VecDestroy(&grp->m_TemplateImage); CHKERRQ(ierr);
+        grp->m_TemplateImage = NULL;
+    }
+    if (grp->m_Mask != NULL) {
+        ierr = VecDestroy(&grp->m_Mask); CHKERRQ(ierr);
+        grp->m_Mask = NULL;
+    }
+    if (grp->m_Opt != NULL) {
+        // account for the work done by the probes of this task group
+        ierr = this->m_Opt->AddTimersAndCounters(grp->m_Opt); CHKERRQ(ierr);
+        delete grp->m_Opt;
+        grp->m_Opt = NULL;
+    }
+
+    if (grp->m_Comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&grp->m_Comm);
+        grp->m_Comm = MPI_COMM_NULL;
+    }
+
+    delete this->m_ParaContGroup;
+    this->m_ParaContGroup = NULL;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief we solves the optimization problem by simply reducing
  * the regularization parameter until the mapping becomes
@@ -1201,7 +1792,7 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContReductSearch() {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     // get parameters
     betamin = this->m_Opt->GetBetaMinParaCont();
@@ -1308,7 +1899,7 @@ PetscErrorCode CLAIREInterface::RunSolverRegParaContReduction() {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     // get target regularization weight
     betastar = this->m_Opt->m_ParaCont.targetbeta;
@@ -1394,7 +1985,7 @@ PetscErrorCode CLAIREInterface::RunSolverScaleCont() {
 
     PetscFunctionBegin;
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     // set up preprocessing
     if (this->m_PreProc == NULL) {
@@ -1520,7 +2111,7 @@ PetscErrorCode CLAIREInterface::RunSolverGridCont() {
 
     PetscFunctionBegin;
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     // set up preprocessing
     if (this->m_PreProc == NULL) {
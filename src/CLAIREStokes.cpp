@@ -168,8 +168,8 @@ PetscErrorCode CLAIREStokes::ComputeIncBodyForce() {
  *******************************************************************/
 PetscErrorCode CLAIREStokes::SolveAdjointEquationSL() {
     PetscErrorCode ierr = 0;
-    IntType nl, nc, nt, ll, lm, llnext;
-    ScalarType *p_l = NULL,  *p_m=NULL,
+    IntType nl, nc, nt, ll, llnext;
+    ScalarType *p_l = NULL,  *p_m=NULL, *p_mj = NULL,
                 *p_vec1 = NULL, *p_vec2 = NULL, *p_vec3 = NULL,
                 *p_b1 = NULL, *p_b2 = NULL, *p_b3 = NULL;
     ScalarType lambda, ht, scale;
@@ -222,7 +222,9 @@ PetscErrorCode CLAIREStokes::SolveAdjointEquationSL() {
     ierr = this->m_WorkVecField1->GetArrays(p_vec1, p_vec2, p_vec3); CHKERRQ(ierr);
 
     for (IntType j = 0; j < nt; ++j) {  // for all time points
-        lm = (nt-j)*nc*nl;
+        // overlap reading the next time point with this one
+        ierr = this->PrefetchStateTimePoint(nt-(j+1)); CHKERRQ(ierr);
+
         if (fullnewton) {
             ll = (nt-j)*nc*nl; llnext = (nt-(j+1))*nc*nl;
         } else {
@@ -233,8 +235,9 @@ PetscErrorCode CLAIREStokes::SolveAdjointEquationSL() {
         if (j == 0) scale *= 0.5;
         for (IntType k = 0; k < nc; ++k) {  // for all image components
             // compute gradient of m
+            ierr = this->GetStateTimePoint(p_mj, p_m, nt-j, k); CHKERRQ(ierr);
             this->m_Opt->StartTimer(FFTSELFEXEC);
-            accfft_grad_t(p_vec1, p_vec2, p_vec3, p_m+lm+k*nl, this->m_Opt->m_FFT.plan, &xyz, timer);
+            accfft_grad_t(p_vec1, p_vec2, p_vec3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
             this->m_Opt->StopTimer(FFTSELFEXEC);
             this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -256,11 +259,12 @@ PetscErrorCode CLAIREStokes::SolveAdjointEquationSL() {
 
     // compute body force for last time point t = 0 (i.e., for j = nt)
     for (IntType k = 0; k < nc; ++k) {  // for all image components
-        ll = k*nl; lm = k*nl;
+        ll = k*nl;
 
         // compute gradient of m (for incremental body force)
+        ierr = this->GetStateTimePoint(p_mj, p_m, 0, k); CHKERRQ(ierr);
         this->m_Opt->StartTimer(FFTSELFEXEC);
-        accfft_grad_t(p_vec1, p_vec2, p_vec3, p_m+lm, this->m_Opt->m_FFT.plan, &xyz, timer);
+        accfft_grad_t(p_vec1, p_vec2, p_vec3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
         this->m_Opt->StopTimer(FFTSELFEXEC);
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -296,8 +300,8 @@ PetscErrorCode CLAIREStokes::SolveAdjointEquationSL() {
  *******************************************************************/
 PetscErrorCode CLAIREStokes::SolveIncAdjointEquationGNSL() {
     PetscErrorCode ierr = 0;
-    IntType nl, nt, nc, lm, ll;
-    ScalarType *p_ltilde = NULL, *p_m = NULL,
+    IntType nl, nt, nc, ll;
+    ScalarType *p_ltilde = NULL, *p_m = NULL, *p_mj = NULL,
                 *p_btilde1 = NULL, *p_btilde2 = NULL, *p_btilde3 = NULL,
                 *p_gradm1 = NULL, *p_gradm2 = NULL, *p_gradm3 = NULL;
     ScalarType ht, scale, ltilde;
@@ -305,10 +309,10 @@ PetscErrorCode CLAIREStokes::SolveIncAdjointEquationGNSL() {
     double timer[NFFTTIMERS] = {0};
     PetscFunctionBegin;
 
-    nt = this->m_Opt->m_Domain.nt;
+    nt = this->m_Opt->m_Domain.nt/this->m_TimeStride;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
-    ht = this->m_Opt->GetTimeStepSize();
+    ht = this->m_TimeStride*this->m_Opt->GetTimeStepSize();
     scale = ht;
 
     if (this->m_WorkVecField1 == NULL) {
@@ -343,15 +347,17 @@ PetscErrorCode CLAIREStokes::SolveIncAdjointEquationGNSL() {
 
     // do numerical time integration
     for (IntType j = 0; j < nt; ++j) {  // for all time points
-        lm = (nt-j)*nc*nl;
+        // overlap reading the next time point with this one
+        ierr = this->PrefetchStateTimePoint(nt-(j+1)); CHKERRQ(ierr);
 
         if (j == 0) scale *= 0.5;
         for (IntType k = 0; k < nc; ++k) {  // for all image components
             ll = k*nl;
 
             // compute gradient of m (for incremental body force)
+            ierr = this->GetStateTimePoint(p_mj, p_m, nt-j, k); CHKERRQ(ierr);
             this->m_Opt->StartTimer(FFTSELFEXEC);
-            accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_m+lm, this->m_Opt->m_FFT.plan, &xyz, timer);
+            accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
             this->m_Opt->StopTimer(FFTSELFEXEC);
             this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -370,11 +376,12 @@ PetscErrorCode CLAIREStokes::SolveIncAdjointEquationGNSL() {
 
     // incremental compute body force for last time point t = 0 (i.e., for j = nt)
     for (IntType k = 0; k < nc; ++k) {  // for all image components
-        ll = k*nl; lm = k*nl;
+        ll = k*nl;
 
         // compute gradient of m (for incremental body force)
+        ierr = this->GetStateTimePoint(p_mj, p_m, 0, k); CHKERRQ(ierr);
         this->m_Opt->StartTimer(FFTSELFEXEC);
-        accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_m+lm, this->m_Opt->m_FFT.plan, &xyz, timer);
+        accfft_grad_t(p_gradm1, p_gradm2, p_gradm3, p_mj, this->m_Opt->m_FFT.plan, &xyz, timer);
         this->m_Opt->StopTimer(FFTSELFEXEC);
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
@@ -20,6 +20,10 @@
 #ifndef _CLAIREUTILS_CPP_
 #define _CLAIREUTILS_CPP_
 
+#include <cstdint>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "CLAIREUtils.hpp"
 
 
@@ -30,6 +34,13 @@ namespace reg {
 
 
 
+/* placement of field data (set once at startup; see SetMemoryPolicy) */
+static bool g_FirstTouch = false;
+static bool g_HugePages = false;
+
+
+
+
 /********************************************************************
  * @brief error handling: check if condition is valid, and if
  * not throw an error PETSc style
@@ -168,11 +179,11 @@ PetscErrorCode ShowValues(Vec x, IntType nc) {
             }
 
             // get min accross all procs
-            rval = MPI_Allreduce(&minval, &minval_g, 1, MPIU_REAL, MPI_MIN, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&minval, &minval_g, 1, MPIU_REAL, MPI_MIN, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             // get max accross all procs
-            rval = MPI_Allreduce(&maxval, &maxval_g, 1, MPIU_REAL, MPI_MAX, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&maxval, &maxval_g, 1, MPIU_REAL, MPI_MAX, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             // TODO: add norm
@@ -368,9 +379,85 @@ void isleep(unsigned int nanosec) {
 
 
 /********************************************************************
- * @brief setup library
+ * @brief pin openmp threads to cores; thread i of a task is bound
+ * to the i-th cpu of the affinity mask of the task; if the mask
+ * covers the cores of all tasks on the node (no binding by the mpi
+ * launcher), the cpus are split between the tasks on the node; the
+ * mask of the first call is kept, so that repeated calls (setup of
+ * the options of each grid level or task group) pin the same way
+ * @param[in] nthreads number of threads per task
+ * @param[in] comm communicator of the tasks (collective)
+ *******************************************************************/
+PetscErrorCode PinThreads(int nthreads, MPI_Comm comm) {
+    PetscErrorCode ierr = 0;
+#ifdef __linux__
+    // affinity mask of the process before the first pinning (the
+    // mask of the master thread is a single cpu afterwards)
+    static cpu_set_t mask;
+    static bool maskstored = false;
+    std::vector<int> cpus;
+    int lrank, nlocal, offset, rval, nfailed = 0;
+    MPI_Comm nodecomm;
+    std::stringstream ss;
+
+    PetscFunctionBegin;
+
+    if (!maskstored) {
+        rval = sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+        ierr = Assert(rval == 0, "could not get affinity mask"); CHKERRQ(ierr);
+        maskstored = true;
+    }
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &mask)) cpus.push_back(i);
+    }
+
+    // tasks on this node
+    rval = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodecomm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+    MPI_Comm_rank(nodecomm, &lrank);
+    MPI_Comm_size(nodecomm, &nlocal);
+    MPI_Comm_free(&nodecomm);
+
+    offset = 0;
+    if (nlocal > 1 && static_cast<int>(cpus.size()) >= nlocal*nthreads) {
+        offset = lrank*nthreads;
+    }
+
+    if (static_cast<int>(cpus.size()) < offset + nthreads) {
+        ss << "not enough cpus to pin " << nthreads << " threads (" << cpus.size() << " available)";
+        ierr = WrngMsg(ss.str()); CHKERRQ(ierr);
+        PetscFunctionReturn(ierr);
+    }
+
+#pragma omp parallel num_threads(nthreads) reduction(+:nfailed)
+{
+    cpu_set_t tmask;
+    CPU_ZERO(&tmask);
+    CPU_SET(cpus[offset + omp_get_thread_num()], &tmask);
+    if (sched_setaffinity(0, sizeof(cpu_set_t), &tmask) != 0) nfailed++;
+}  // omp parallel
+
+    if (nfailed != 0) {
+        ierr = WrngMsg("pinning of threads failed"); CHKERRQ(ierr);
+    }
+#else
+    PetscFunctionBegin;
+    ierr = WrngMsg("pinning of threads not supported on this platform"); CHKERRQ(ierr);
+#endif
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief setup library; the cartesian communicator for accfft is
+ * created on the tasks of comm (all tasks, or the subset of tasks
+ * that solves a coarse grid or continuation problem)
  *******************************************************************/
-PetscErrorCode InitializeDataDistribution(int nthreads, int *c_grid, MPI_Comm& c_comm, bool c_exists) {
+PetscErrorCode InitializeDataDistribution(int nthreads, int *c_grid, MPI_Comm& c_comm, bool c_exists,
+                                          bool pinthreads, MPI_Comm comm) {
     PetscErrorCode ierr = 0;
     int nprocs, np, ompthreads, rval;
     std::stringstream ss;
@@ -386,8 +473,14 @@ PetscErrorCode InitializeDataDistribution(int nthreads, int *c_grid, MPI_Comm& c
     ierr = Assert(ompthreads == nthreads, ss.str().c_str()); CHKERRQ(ierr);
     ss.str(std::string()); ss.clear();
 
+    // bind threads before any field data is touched (the team
+    // of the first parallel region is reused by all later ones)
+    if (pinthreads) {
+        ierr = PinThreads(nthreads, comm); CHKERRQ(ierr);
+    }
+
     // set up MPI/cartesian grid
-    MPI_Comm_size(PETSC_COMM_WORLD, &nprocs);
+    MPI_Comm_size(comm, &nprocs);
     np = c_grid[0]*c_grid[1];
     if (np != nprocs) {
         // update cartesian grid layout
@@ -402,7 +495,7 @@ PetscErrorCode InitializeDataDistribution(int nthreads, int *c_grid, MPI_Comm& c
     }
 
     // initialize accfft
-    accfft_create_comm(PETSC_COMM_WORLD, c_grid, &c_comm);
+    accfft_create_comm(comm, c_grid, &c_comm);
     accfft_init(nthreads);
     accfft_init();
 
@@ -462,17 +555,145 @@ PetscErrorCode VecView(Vec x) {
 
 
 /********************************************************************
- * @brief interface to create vector
+ * @brief set placement policy for field data: first touch with
+ * the static schedule of the compute loops (pages are mapped to
+ * the numa node of the thread that works on them) and hint for
+ * transparent huge pages (time histories, multi-component fields,
+ * and ghost buffers)
  *******************************************************************/
-PetscErrorCode VecCreate(Vec& x, IntType nl, IntType ng) {
+PetscErrorCode SetMemoryPolicy(bool firsttouch, bool hugepages) {
     PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    g_FirstTouch = firsttouch;
+    g_HugePages = hugepages;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief advise the kernel to back the given (not yet touched)
+ * buffer by transparent huge pages; this is a hint only
+ *******************************************************************/
+PetscErrorCode AdviseHugePages(void* p, size_t nbytes) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+#if defined(MADV_HUGEPAGE) && !defined(REG_HAS_CUDA)
+    if (g_HugePages && p != NULL) {
+        uintptr_t pagesize, begin, end;
+        pagesize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        // madvise operates on whole pages
+        begin = (reinterpret_cast<uintptr_t>(p) + pagesize - 1) & ~(pagesize - 1);
+        end = (reinterpret_cast<uintptr_t>(p) + nbytes) & ~(pagesize - 1);
+        if (end > begin) {
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+        }
+    }
+#endif
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief first touch (zero) buffer of n values that consists of
+ * nblocks blocks (components/time points); every block is split
+ * between the threads with the static schedule of the compute
+ * loops, which operate on one component at a time
+ *******************************************************************/
+PetscErrorCode FirstTouch(ScalarType* p, IntType n, IntType nblocks) {
+    PetscErrorCode ierr = 0;
+    IntType nb;
+    PetscFunctionBegin;
+
+    if (!g_FirstTouch || p == NULL || n == 0) PetscFunctionReturn(ierr);
+
+    ierr = Assert(nblocks > 0 && n % nblocks == 0, "size mismatch"); CHKERRQ(ierr);
+    nb = n / nblocks;
+
+#pragma omp parallel
+{
+    for (IntType k = 0; k < nblocks; ++k) {
+        ScalarType* pk = p + k*nb;
+#pragma omp for schedule(static)
+        for (IntType i = 0; i < nb; ++i) {
+            pk[i] = 0.0;
+        }
+    }
+}  // omp parallel
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief release buffer of vector created by VecCreate (called by
+ * petsc if the vector and the container attached to it are destroyed)
+ *******************************************************************/
+static PetscErrorCode FreePlacedArray(void* p) {
+    PetscFunctionBegin;
+    if (p != NULL) accfft_free(p);
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief interface to create vector; nblocks is the number of
+ * components/time points stored in the vector (first touch);
+ * buffers with several blocks are hinted for huge pages; if a
+ * placement policy is set, we allocate the buffer ourselves (petsc
+ * zeroes the array it allocates on the master thread, which maps
+ * all pages to its numa node), touch it in the layout of the compute
+ * loops, and wrap it; the buffer is freed with the vector; the
+ * vector is distributed on the tasks of comm
+ *******************************************************************/
+PetscErrorCode VecCreate(MPI_Comm comm, Vec& x, IntType nl, IntType ng, IntType nblocks) {
+    PetscErrorCode ierr = 0;
+#ifndef REG_HAS_CUDA
+    ScalarType* p_x = NULL;
+    PetscContainer container = NULL;
+    bool hugepages = g_HugePages && nblocks > 1;
+#endif
 
     if (x != NULL) {
         ierr = VecDestroy(&x); CHKERRQ(ierr);
         x = NULL;
     }
 
-    ierr = VecCreate(PETSC_COMM_WORLD, &x); CHKERRQ(ierr);
+#ifndef REG_HAS_CUDA
+    if ((g_FirstTouch || hugepages) && nl > 0) {
+        // same alignment as fft data (see WorkSpace)
+        p_x = reinterpret_cast<ScalarType*>(accfft_alloc(nl*sizeof(ScalarType)));
+        ierr = Assert(p_x != NULL, "allocation failed"); CHKERRQ(ierr);
+        if (hugepages) {
+            ierr = AdviseHugePages(p_x, nl*sizeof(ScalarType)); CHKERRQ(ierr);
+        }
+        ierr = FirstTouch(p_x, nl, nblocks); CHKERRQ(ierr);
+
+        ierr = VecCreateMPIWithArray(comm, 1, nl, ng, p_x, &x); CHKERRQ(ierr);
+
+        // the vector owns the buffer
+        ierr = PetscContainerCreate(PETSC_COMM_SELF, &container); CHKERRQ(ierr);
+        ierr = PetscContainerSetPointer(container, p_x); CHKERRQ(ierr);
+        ierr = PetscContainerSetUserDestroy(container, FreePlacedArray); CHKERRQ(ierr);
+        ierr = PetscObjectCompose((PetscObject)x, "reg_placed_array", (PetscObject)container); CHKERRQ(ierr);
+        ierr = PetscContainerDestroy(&container); CHKERRQ(ierr);
+
+        PetscFunctionReturn(ierr);
+    }
+#endif
+
+    ierr = VecCreate(comm, &x); CHKERRQ(ierr);
     ierr = VecSetSizes(x, nl, ng); CHKERRQ(ierr);
     #ifdef REG_HAS_CUDA
         ierr = VecSetType(x, VECCUDA); CHKERRQ(ierr);
@@ -486,6 +707,21 @@ PetscErrorCode VecCreate(Vec& x, IntType nl, IntType ng) {
 
 
 
+/********************************************************************
+ * @brief interface to create vector on all tasks (see above)
+ *******************************************************************/
+PetscErrorCode VecCreate(Vec& x, IntType nl, IntType ng, IntType nblocks) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = VecCreate(PETSC_COMM_WORLD, x, nl, ng, nblocks); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief rescale data to [0,1]
  *******************************************************************/
@@ -539,11 +775,11 @@ PetscErrorCode Normalize(Vec x, IntType nc) {
             }
 
             // get min accross all procs
-            rval = MPI_Allreduce(&xmin, &xmin_g, 1, MPIU_REAL, MPI_MIN, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&xmin, &xmin_g, 1, MPIU_REAL, MPI_MIN, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             // get max accross all procs
-            rval = MPI_Allreduce(&xmax, &xmax_g, 1, MPIU_REAL, MPI_MAX, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&xmax, &xmax_g, 1, MPIU_REAL, MPI_MAX, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             if (xmin_g < 0.0) {
@@ -737,11 +973,11 @@ PetscErrorCode Rescale(Vec x, ScalarType xminout, ScalarType xmaxout, IntType nc
             }
 
             // get min accross all procs
-            rval = MPI_Allreduce(&xmin, &xmin_g, 1, MPIU_REAL, MPI_MIN, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&xmin, &xmin_g, 1, MPIU_REAL, MPI_MIN, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             // get max accross all procs
-            rval = MPI_Allreduce(&xmax, &xmax_g, 1, MPIU_REAL, MPI_MAX, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&xmax, &xmax_g, 1, MPIU_REAL, MPI_MAX, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             // compute shift and scale
@@ -769,6 +1005,68 @@ PetscErrorCode Rescale(Vec x, ScalarType xminout, ScalarType xmaxout, IntType nc
 
 
 
+/********************************************************************
+ * @brief inner product x^T y; in single precision builds the local
+ * sums and the reduction are carried out in double precision (the
+ * fields are stored in single precision to save memory bandwidth in
+ * the transport, fft and interpolation kernels; the objective, the
+ * line search and the stopping criteria are evaluated from these
+ * reductions and suffer from cancellation if accumulated in single
+ * precision for large grids)
+ *******************************************************************/
+PetscErrorCode VecInnerProduct(Vec x, Vec y, ScalarType* value) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+#if defined(PETSC_USE_REAL_SINGLE) && !defined(REG_HAS_CUDA)
+    const ScalarType *p_x = NULL, *p_y = NULL;
+    double sum = 0.0, sum_g = 0.0;
+    IntType nl, i;
+    int rval;
+
+    ierr = VecGetLocalSize(x, &nl); CHKERRQ(ierr);
+    ierr = VecGetArrayRead(x, &p_x); CHKERRQ(ierr);
+    ierr = VecGetArrayRead(y, &p_y); CHKERRQ(ierr);
+#pragma omp parallel for reduction(+:sum)
+    for (i = 0; i < nl; ++i) {
+        sum += static_cast<double>(p_x[i])*static_cast<double>(p_y[i]);
+    }
+    ierr = VecRestoreArrayRead(y, &p_y); CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(x, &p_x); CHKERRQ(ierr);
+
+    rval = MPI_Allreduce(&sum, &sum_g, 1, MPI_DOUBLE, MPI_SUM, PetscObjectComm((PetscObject)x));
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+    *value = static_cast<ScalarType>(sum_g);
+#else
+    ierr = VecTDot(x, y, value); CHKERRQ(ierr);
+#endif
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief l2 norm of x (see VecInnerProduct)
+ *******************************************************************/
+PetscErrorCode VecNormL2(Vec x, ScalarType* value) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+#if defined(PETSC_USE_REAL_SINGLE) && !defined(REG_HAS_CUDA)
+    ierr = VecInnerProduct(x, x, value); CHKERRQ(ierr);
+    *value = std::sqrt(*value);
+#else
+    ierr = VecNorm(x, NORM_2, value); CHKERRQ(ierr);
+#endif
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief rescale data to [xminout,xmaxout]
  *******************************************************************/
@@ -807,11 +1105,11 @@ PetscErrorCode VecNorm(Vec x, IntType nc) {
             }
 
             // get min accross all procs
-            rval = MPI_Allreduce(&minval, &xmin_g, 1, MPIU_REAL, MPI_MIN, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&minval, &xmin_g, 1, MPIU_REAL, MPI_MIN, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             // get max accross all procs
-            rval = MPI_Allreduce(&maxval, &xmax_g, 1, MPIU_REAL, MPI_MAX, PETSC_COMM_WORLD);
+            rval = MPI_Allreduce(&maxval, &xmax_g, 1, MPIU_REAL, MPI_MAX, PetscObjectComm((PetscObject)x));
             ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
             // TODO: compute norm
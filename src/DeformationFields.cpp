@@ -1332,13 +1332,13 @@ PetscErrorCode DeformationFields::ComputeDeformationMapRK2A() {
         }
     }
     if (this->m_WorkScaField1 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField1,nl,ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField1,nl,ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField2 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField2,nl,ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField2,nl,ng); CHKERRQ(ierr);
     }
     if (this->m_WorkScaField3 == NULL) {
-        ierr = VecCreate(this->m_WorkScaField3,nl,ng); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_WorkScaField3,nl,ng); CHKERRQ(ierr);
     }
 
     ierr = GetRawPointer(this->m_WorkScaField1,&p_divv); CHKERRQ(ierr);
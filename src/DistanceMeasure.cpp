@@ -207,6 +207,31 @@ PetscErrorCode DistanceMeasure::SetMask(Vec mask) {
 
 
 
+/********************************************************************
+ * @brief get offset of the final state m(t=1) in the state variable;
+ * the state variable either holds the entire time history or (if
+ * the time history is compressed) only m(t=1)
+ *******************************************************************/
+PetscErrorCode DistanceMeasure::GetFinalStateOffset(IntType& offset) {
+    PetscErrorCode ierr = 0;
+    IntType nt, nc, nl, nlm;
+    PetscFunctionBegin;
+
+    ierr = Assert(this->m_StateVariable != NULL, "null pointer"); CHKERRQ(ierr);
+
+    nt = this->m_Opt->m_Domain.nt;
+    nc = this->m_Opt->m_Domain.nc;
+    nl = this->m_Opt->m_Domain.nl;
+
+    ierr = VecGetLocalSize(this->m_StateVariable, &nlm); CHKERRQ(ierr);
+    offset = (nlm == nl*nc) ? 0 : nt*nl*nc;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief set state variable
  *******************************************************************/
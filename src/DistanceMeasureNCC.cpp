@@ -79,8 +79,9 @@ PetscErrorCode DistanceMeasureNCC::SetupScale(){
     PetscErrorCode ierr = 0;	
     ScalarType *p_mr = NULL, *p_mt = NULL, *p_w = NULL;
     IntType nt, nc, nl, l;
-    ScalarType norm_l2_loc, norm_mT_loc, norm_mR_loc, inpr_mT_mR_loc, 
-	       norm_l2, norm_mT, norm_mR, inpr_mT_mR, mTi, mRi;
+    double norm_l2_loc, norm_mT_loc, norm_mR_loc, inpr_mT_mR_loc,
+           norm_l2, norm_mT, norm_mR, inpr_mT_mR;
+    ScalarType mTi, mRi;
     int rval;
     ScalarType l2distance, nccdistance, hd;
 
@@ -138,16 +139,16 @@ PetscErrorCode DistanceMeasureNCC::SetupScale(){
         }
     }
     // All reduce the pieces
-    rval = MPI_Allreduce(&norm_l2_loc, &norm_l2, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_l2_loc, &norm_l2, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&norm_mT_loc, &norm_mT, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_mT_loc, &norm_mT, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&inpr_mT_mR_loc, &inpr_mT_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&inpr_mT_mR_loc, &inpr_mT_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
     
     ierr = RestoreRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
@@ -171,10 +172,10 @@ PetscErrorCode DistanceMeasureNCC::SetupScale(){
 PetscErrorCode DistanceMeasureNCC::EvaluateFunctional(ScalarType* D) {
     PetscErrorCode ierr = 0;
     ScalarType *p_mr = NULL, *p_m = NULL, *p_w = NULL;
-    IntType nt, nc, nl, l;
-    ScalarType norm_m1_loc, norm_mR_loc, inpr_m1_mR_loc, 
-	       norm_m1, norm_mR, inpr_m1_mR,
-               m1i, mRi, scale;
+    IntType nc, nl, l;
+    double norm_m1_loc, norm_mR_loc, inpr_m1_mR_loc,
+           norm_m1, norm_mR, inpr_m1_mR;
+    ScalarType m1i, mRi, scale;
     int rval;
 
     PetscFunctionBegin;
@@ -185,7 +186,6 @@ PetscErrorCode DistanceMeasureNCC::EvaluateFunctional(ScalarType* D) {
     ierr = Assert(this->m_ReferenceImage != NULL, "null pointer"); CHKERRQ(ierr);
 
     // Get sizes
-    nt = this->m_Opt->m_Domain.nt;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
     scale = this->m_Opt->m_Distance.scale;
@@ -193,7 +193,7 @@ PetscErrorCode DistanceMeasureNCC::EvaluateFunctional(ScalarType* D) {
     ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
 
-    l = nt*nl*nc;
+    ierr = this->GetFinalStateOffset(l); CHKERRQ(ierr);
     norm_m1_loc = 0.0;
     norm_mR_loc = 0.0;
     inpr_m1_mR_loc = 0.0;
@@ -220,13 +220,13 @@ PetscErrorCode DistanceMeasureNCC::EvaluateFunctional(ScalarType* D) {
         }
     }
     // All reduce various pieces
-    rval = MPI_Allreduce(&norm_m1_loc, &norm_m1, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_m1_loc, &norm_m1, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&inpr_m1_mR_loc, &inpr_m1_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&inpr_m1_mR_loc, &inpr_m1_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
     ierr = RestoreRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
@@ -253,7 +253,7 @@ PetscErrorCode DistanceMeasureNCC::SetFinalConditionAE() {
     IntType nl, nc, nt, l, ll;
     int rval;
     ScalarType *p_mr = NULL, *p_m = NULL, *p_l = NULL, *p_w = NULL;
-    ScalarType norm_m1_loc, norm_mR_loc, inpr_m1_mR_loc, norm_m1, norm_mR, inpr_m1_mR;
+    double norm_m1_loc, norm_mR_loc, inpr_m1_mR_loc, norm_m1, norm_mR, inpr_m1_mR;
     ScalarType const1, const2, m1i, mRi, hd, scale;
     PetscFunctionBegin;
 
@@ -280,7 +280,7 @@ PetscErrorCode DistanceMeasureNCC::SetFinalConditionAE() {
     ierr = GetRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_AdjointVariable, &p_l); CHKERRQ(ierr);
 
-    l = nt*nc*nl;
+    ierr = this->GetFinalStateOffset(l); CHKERRQ(ierr);
     norm_m1_loc = 0.0;
     norm_mR_loc = 0.0;
     inpr_m1_mR_loc = 0.0;
@@ -314,13 +314,13 @@ PetscErrorCode DistanceMeasureNCC::SetFinalConditionAE() {
     }
 
     // All reduce for full inner products
-    rval = MPI_Allreduce(&norm_m1_loc, &norm_m1, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_m1_loc, &norm_m1, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&inpr_m1_mR_loc, &inpr_m1_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&inpr_m1_mR_loc, &inpr_m1_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
     // Now, write the terminal condition to lambda
@@ -372,8 +372,8 @@ PetscErrorCode DistanceMeasureNCC::SetFinalConditionIAE() {
     ScalarType *p_m = NULL, *p_mr = NULL, *p_mtilde = NULL,
                 *p_ltilde = NULL, *p_w = NULL;
     ScalarType const1, const2, const3, const4, const5, hd, scale;
-    ScalarType norm_m1_loc, norm_mR_loc, inpr_m1_mR_loc, inpr_m1_mtilde_loc, inpr_mR_mtilde_loc;
-    ScalarType norm_m1, norm_mR, inpr_m1_mR, inpr_m1_mtilde, inpr_mR_mtilde;
+    double norm_m1_loc, norm_mR_loc, inpr_m1_mR_loc, inpr_m1_mtilde_loc, inpr_mR_mtilde_loc;
+    double norm_m1, norm_mR, inpr_m1_mR, inpr_m1_mtilde, inpr_mR_mtilde;
     ScalarType m1i, mRi, mtilde1i;
 
     this->m_Opt->Enter(__func__);
@@ -409,7 +409,7 @@ PetscErrorCode DistanceMeasureNCC::SetFinalConditionIAE() {
     inpr_m1_mtilde_loc = 0.0;
     inpr_mR_mtilde_loc = 0.0;
 
-    l = nt*nc*nl;
+    ierr = this->GetFinalStateOffset(l); CHKERRQ(ierr);
 
     if (this->m_Mask != NULL) {
         // mask objective functional
@@ -447,19 +447,19 @@ PetscErrorCode DistanceMeasureNCC::SetFinalConditionIAE() {
     }
 
     // All reduce for full inner products
-    rval = MPI_Allreduce(&norm_m1_loc, &norm_m1, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_m1_loc, &norm_m1, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&norm_mR_loc, &norm_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&inpr_m1_mR_loc, &inpr_m1_mR, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&inpr_m1_mR_loc, &inpr_m1_mR, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&inpr_m1_mtilde_loc, &inpr_m1_mtilde, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&inpr_m1_mtilde_loc, &inpr_m1_mtilde, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&inpr_mR_mtilde_loc, &inpr_mR_mtilde, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&inpr_mR_mtilde_loc, &inpr_mR_mtilde, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
     // Now, write the terminal condition to lambda tilde
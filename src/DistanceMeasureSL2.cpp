@@ -93,9 +93,10 @@ PetscErrorCode DistanceMeasureSL2::SetupScale() {
 PetscErrorCode DistanceMeasureSL2::EvaluateFunctional(ScalarType* D) {
     PetscErrorCode ierr = 0;
     ScalarType *p_mr = NULL, *p_m = NULL, *p_w = NULL;
-    IntType nt, nc, nl, l;
+    IntType nc, nl, l;
     int rval;
-    ScalarType dr, value, l2distance, hx;
+    ScalarType dr, hx;
+    double value, l2distance;  // accumulated in double precision
 
     PetscFunctionBegin;
 
@@ -105,7 +106,6 @@ PetscErrorCode DistanceMeasureSL2::EvaluateFunctional(ScalarType* D) {
     ierr = Assert(this->m_ReferenceImage != NULL, "null pointer"); CHKERRQ(ierr);
 
     // get sizes
-    nt = this->m_Opt->m_Domain.nt;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
     hx  = this->m_Opt->GetLebesgueMeasure();   
@@ -113,7 +113,7 @@ PetscErrorCode DistanceMeasureSL2::EvaluateFunctional(ScalarType* D) {
     ierr = GetRawPointer(this->m_StateVariable, &p_m); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
 
-    l = nt*nl*nc;
+    ierr = this->GetFinalStateOffset(l); CHKERRQ(ierr);
     value = 0.0;
     if (this->m_Mask != NULL) {
         // mask objective functional
@@ -132,7 +132,7 @@ PetscErrorCode DistanceMeasureSL2::EvaluateFunctional(ScalarType* D) {
         }
     }
     // all reduce
-    rval = MPI_Allreduce(&value, &l2distance, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&value, &l2distance, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
 
     ierr = RestoreRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
@@ -180,7 +180,7 @@ PetscErrorCode DistanceMeasureSL2::SetFinalConditionAE() {
     ierr = GetRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_AdjointVariable, &p_l); CHKERRQ(ierr);
 
-    l = nt*nc*nl;
+    ierr = this->GetFinalStateOffset(l); CHKERRQ(ierr);
     // compute terminal condition \lambda_1 = -(m_1 - m_R) = m_R - m_1
     if (this->m_Mask != NULL) {
         // mask objective functional
@@ -79,9 +79,10 @@ PetscErrorCode DistanceMeasureSL2aux::ClearMemory() {
 PetscErrorCode DistanceMeasureSL2aux::EvaluateFunctional(ScalarType* D) {
     PetscErrorCode ierr = 0;
     ScalarType *p_mr = NULL, *p_m = NULL, *p_q = NULL, *p_c = NULL;
-    IntType nt, nc, nl, l;
+    IntType nc, nl, l;
     int rval;
-    ScalarType dr, value, val1, val2, l2distance, hx;
+    ScalarType dr, hx;
+    double value, val1, val2, l2distance;  // accumulated in double precision
 
     PetscFunctionBegin;
 
@@ -93,7 +94,6 @@ PetscErrorCode DistanceMeasureSL2aux::EvaluateFunctional(ScalarType* D) {
     ierr = Assert(this->m_ReferenceImage != NULL, "null pointer"); CHKERRQ(ierr);
 
     // get sizes
-    nt = this->m_Opt->m_Domain.nt;
     nc = this->m_Opt->m_Domain.nc;
     nl = this->m_Opt->m_Domain.nl;
     hx  = this->m_Opt->GetLebesgueMeasure();   
@@ -101,7 +101,7 @@ PetscErrorCode DistanceMeasureSL2aux::EvaluateFunctional(ScalarType* D) {
     ierr = VecGetArray(this->m_StateVariable, &p_m); CHKERRQ(ierr);
     ierr = VecGetArray(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
 
-    l = nt*nl*nc;
+    ierr = this->GetFinalStateOffset(l); CHKERRQ(ierr);
     value = 0.0, val1 = 0.0, val2 = 0.0;
     ierr = VecGetArray(this->m_AuxVar1, &p_c); CHKERRQ(ierr);
     ierr = VecGetArray(this->m_AuxVar2, &p_q); CHKERRQ(ierr);
@@ -118,11 +118,11 @@ PetscErrorCode DistanceMeasureSL2aux::EvaluateFunctional(ScalarType* D) {
     ierr = VecRestoreArray(this->m_AuxVar1, &p_c); CHKERRQ(ierr);
 
     // all reduce
-    rval = MPI_Allreduce(&val1, &value, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&val1, &value, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
     l2distance  = value;
 
-    rval = MPI_Allreduce(&val2, &value, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&val2, &value, 1, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
     l2distance += value;
     // parse value to registration monitor for display
@@ -176,7 +176,7 @@ PetscErrorCode DistanceMeasureSL2aux::SetFinalConditionAE() {
     ierr = GetRawPointer(this->m_ReferenceImage, &p_mr); CHKERRQ(ierr);
     ierr = GetRawPointer(this->m_AdjointVariable, &p_l); CHKERRQ(ierr);
 
-    l = nt*nc*nl;
+    ierr = this->GetFinalStateOffset(l); CHKERRQ(ierr);
 #pragma omp parallel
 {
 #pragma omp for
@@ -10,6 +10,9 @@
 #include <iostream>
 #include <stdint.h>
 #include <limits.h>
+#include <limits>
+#include <utility>
+#include <omp.h>
 #ifdef __unix__
 # include <unistd.h>
 #elif defined _WIN32
@@ -38,10 +41,82 @@ void parallel_print(T in, const char* prefix) {
 Interp3_Plan::Interp3_Plan() {
 	this->allocate_baked = false;
 	this->scatter_baked = false;
+	this->kernel = INTERP3_CUBIC;
+	this->variant = -1;
+	this->variant_version = -1;
+	this->query_sort = -1;
+	this->query_sorted = false;
+	this->types_baked = false;
+	this->compress_bits = 0;
+	this->offrank_query_points = 0;
+	this->all_query_points_capacity = 0;
+	this->all_f_cubic_capacity = 0;
   procs_i_recv_from_size_ = 0;
   procs_i_send_to_size_ = 0;
 }
 
+/*
+ * Makes sure the receive buffers of the scatter phase hold at least n_query
+ * coordinates and n_f interpolated values. The buffers only grow, so
+ * repeated scatters (one per time step and matvec) reuse the high-water mark
+ * allocation instead of going back to the allocator every time.
+ */
+void Interp3_Plan::reserve_scatter_buffers(size_t n_query, size_t n_f) {
+	if (n_query > all_query_points_capacity || all_query_points_capacity == 0) {
+		if (all_query_points_capacity != 0)
+			pvfmm::aligned_delete<Real>(all_query_points);
+		all_query_points_capacity = std::max(n_query, (size_t) 1);
+		all_query_points = pvfmm::aligned_new<Real>(all_query_points_capacity);
+	}
+	if (n_f > all_f_cubic_capacity || all_f_cubic_capacity == 0) {
+		if (all_f_cubic_capacity != 0)
+			pvfmm::aligned_delete<Real>(all_f_cubic);
+		all_f_cubic_capacity = std::max(n_f, (size_t) 1);
+		all_f_cubic = pvfmm::aligned_new<Real>(all_f_cubic_capacity);
+	}
+}
+
+/*
+ * Builds a strided MPI datatype for one interpolated value: data_dof values
+ * that are stride apart, resized to the extent of a single value, so that
+ * count consecutive points of a message are count elements of the type.
+ */
+static void commit_point_type(int data_dof, int stride, MPI_Datatype* type) {
+	MPI_Datatype vec;
+	MPI_Type_vector(data_dof, 1, stride, MPI_T, &vec);
+	MPI_Type_create_resized(vec, 0, sizeof(Real), type);
+	MPI_Type_free(&vec);
+	MPI_Type_commit(type);
+}
+
+/*
+ * Builds the strided MPI datatypes used to exchange the interpolated values.
+ * The message sizes enter as the count of the send/recv calls, so the types
+ * only depend on the version (data_dof) and on the stride of the value arrays:
+ * rtypes are built for the stride N_pts (fixed for the plan), stypes for the
+ * stride total_query_points (rebuilt if the number of received query points
+ * changes, one type per version).
+ */
+void Interp3_Plan::commit_types(const int N_pts) {
+	if (!types_baked || N_pts != types_N_pts_) {
+		for (int ver = 0; ver < nplans_; ++ver) {
+			if (types_baked)
+				MPI_Type_free(&rtypes[ver]);
+			commit_point_type(data_dofs_[ver], N_pts, &rtypes[ver]);
+		}
+	}
+	if (!types_baked || total_query_points != types_total_query_points_) {
+		for (int ver = 0; ver < nplans_; ++ver) {
+			if (types_baked)
+				MPI_Type_free(&stypes[ver]);
+			commit_point_type(data_dofs_[ver], total_query_points, &stypes[ver]);
+		}
+	}
+	types_N_pts_ = N_pts;
+	types_total_query_points_ = total_query_points;
+	types_baked = true;
+}
+
 void Interp3_Plan::allocate(int N_pts, int* data_dofs, int nplans) {
 	int nprocs, procid;
 	MPI_Comm_rank(MPI_COMM_WORLD, &procid);
@@ -77,8 +152,8 @@ void Interp3_Plan::allocate(int N_pts, int* data_dofs, int nplans) {
 	f_cubic_unordered = pvfmm::aligned_new<Real>(N_pts * data_dof_max); // The reshuffled semi-final interpolated values are stored here
   memset(&f_cubic_unordered[0],0, N_pts * sizeof(Real) * data_dof_max);
 
-	stypes = pvfmm::aligned_new<MPI_Datatype>(nprocs*nplans_); // strided for multiple plan calls
-	rtypes = pvfmm::aligned_new<MPI_Datatype>(nprocs*nplans_);
+	stypes = pvfmm::aligned_new<MPI_Datatype>(nplans_); // strided for multiple plan calls
+	rtypes = pvfmm::aligned_new<MPI_Datatype>(nplans_);
 	this->allocate_baked = true;
 #ifdef INTERP_DEBUG
   PCOUT << "allocate done\n";
@@ -281,6 +356,174 @@ static void zsort_queries(std::vector<Real>* query_outside,
 }
 #endif
 
+/*
+ * Helpers for the compressed scatter. A query point that is sent to proc lies
+ * in the pencil owned by proc (extended by one cell to account for the
+ * periodic wrap at the lower boundary). Its coordinates are stored as
+ * fixed point offsets relative to that box: with 16 bits each coordinate
+ * takes one uint16_t (3 per point), with 21 bits the three coordinates are
+ * packed into one 64 bit word (4 uint16_t per point).
+ */
+static inline int query_packed_units(int bits) {
+	return (bits == 16) ? 3 : 4;
+}
+
+static inline void query_box(int proc, int* c_dims, int isize0, int isize1,
+		Real* h, Real* lo, Real* scale, int bits) {
+	const Real qmax = (Real) ((1 << bits) - 1);
+	lo[0] = (proc / c_dims[1]) * isize0 * h[0] - h[0];
+	lo[1] = (proc % c_dims[1]) * isize1 * h[1] - h[1];
+	lo[2] = -h[2];
+	scale[0] = qmax / ((isize0 + 2) * h[0]);
+	scale[1] = qmax / ((isize1 + 2) * h[1]);
+	scale[2] = qmax / (1 + 2 * h[2]);
+}
+
+static inline void encode_query(const Real* q, const Real* lo,
+		const Real* scale, int bits, uint16_t* out) {
+	const Real qmax = (Real) ((1 << bits) - 1);
+	uint64_t u[3];
+	for (int j = 0; j < 3; ++j) {
+		Real v = (q[j] - lo[j]) * scale[j];
+		v = std::min(std::max(v, (Real) 0), qmax);
+		u[j] = (uint64_t) (v + 0.5);
+	}
+	if (bits == 16) {
+		out[0] = (uint16_t) u[0];
+		out[1] = (uint16_t) u[1];
+		out[2] = (uint16_t) u[2];
+	} else {
+		uint64_t w = u[0] | (u[1] << 21) | (u[2] << 42);
+		for (int k = 0; k < 4; ++k)
+			out[k] = (uint16_t) (w >> (16 * k));
+	}
+}
+
+static inline void decode_query(const uint16_t* in, const Real* lo,
+		const Real* scale, int bits, Real* q) {
+	uint64_t u[3];
+	if (bits == 16) {
+		u[0] = in[0];
+		u[1] = in[1];
+		u[2] = in[2];
+	} else {
+		uint64_t w = 0;
+		for (int k = 0; k < 4; ++k)
+			w |= ((uint64_t) in[k]) << (16 * k);
+		u[0] = w & 0x1FFFFF;
+		u[1] = (w >> 21) & 0x1FFFFF;
+		u[2] = (w >> 42) & 0x1FFFFF;
+	}
+	for (int j = 0; j < 3; ++j)
+		q[j] = lo[j] + u[j] / scale[j];
+}
+
+/*
+ * Helpers for the morton ordering of the received query points. The points
+ * are given in grid units of the padded local array (output of rescale_xyz),
+ * so the cell of a point is the integer part of its coordinates.
+ */
+static inline void query_cell(const Real* q, uint_fast32_t* c) {
+	for (int j = 0; j < 3; ++j)
+		c[j] = (uint_fast32_t) std::max((Real) 0, std::floor(q[j]));
+}
+
+/*
+ * Returns true if the stencils of consecutive query points do not overlap for
+ * more than 10% of the points (stencil of width w along each axis). In grid
+ * order (small deformations) this only happens at the end of a row of the
+ * pencil, so sorting would not pay off.
+ */
+static bool query_stream_scattered(const Real* Q, const int N_pts, const int w) {
+	long jumps = 0;
+#pragma omp parallel for reduction(+:jumps)
+	for (int i = 1; i < N_pts; ++i) {
+		uint_fast32_t a[3], b[3];
+		query_cell(&Q[(i - 1) * COORD_DIM], a);
+		query_cell(&Q[i * COORD_DIM], b);
+		for (int j = 0; j < 3; ++j) {
+			if ((a[j] > b[j] ? a[j] - b[j] : b[j] - a[j]) >= (uint_fast32_t) w) {
+				++jumps;
+				break;
+			}
+		}
+	}
+	return 10 * jumps > N_pts;
+}
+
+/*
+ * Sorts (key, index) pairs with all threads: the chunks of the threads are
+ * sorted independently and then merged pairwise.
+ */
+static void sort_query_keys(std::pair<uint64_t, int>* a, const int n) {
+	const int nt = omp_get_max_threads();
+	if (nt == 1 || n < (1 << 14)) {
+		std::sort(a, a + n);
+		return;
+	}
+	std::vector<int> bounds(nt + 1);
+	for (int t = 0; t <= nt; ++t)
+		bounds[t] = (int) (((long) n * t) / nt);
+#pragma omp parallel for
+	for (int t = 0; t < nt; ++t)
+		std::sort(a + bounds[t], a + bounds[t + 1]);
+	for (int w = 1; w < nt; w *= 2) {
+#pragma omp parallel for
+		for (int t = 0; t < nt; t += 2 * w) {
+			if (t + w < nt)
+				std::inplace_merge(a + bounds[t], a + bounds[t + w],
+						a + bounds[std::min(t + 2 * w, nt)]);
+		}
+	}
+}
+
+/*
+ * Reorders the received query points (all_query_points) along a morton curve
+ * through the cells of the padded local array, so that consecutive points
+ * reuse the cache lines of the stencil of their predecessor. query_perm[i] is
+ * the position of the i-th sorted point in the order of the scatter; the
+ * interpolated values are permuted back in Interp3_Plan::interpolate before
+ * they are sent to their owners. With query_sort < 0, the points are only
+ * sorted if the stencils of consecutive points do not overlap.
+ */
+void Interp3_Plan::sort_query_points(double* timings) {
+	query_sorted = false;
+	if (query_sort == 0 || total_query_points < 2)
+		return;
+#ifdef INTERP_USE_MORE_MEM_L1
+	// the grid index is baked into the coordinates of the simd kernel
+	if (kernel == INTERP3_CUBIC)
+		return;
+#endif
+	timings[INTERP3_SORT] += -MPI_Wtime();
+	const int n = total_query_points;
+	Real* Q = &all_query_points[0];
+	if (query_sort > 0 || query_stream_scattered(Q, n, interp3_kernel_order(kernel) + 1)) {
+		query_keys.resize(n);
+		query_perm.resize(n);
+		query_tmp.resize(n * COORD_DIM);
+#pragma omp parallel for
+		for (int i = 0; i < n; ++i) {
+			uint_fast32_t c[3];
+			query_cell(&Q[i * COORD_DIM], c);
+			query_keys[i].first = morton3D_64_encode(c[0], c[1], c[2]);
+			query_keys[i].second = i;
+		}
+		sort_query_keys(&query_keys[0], n);
+#pragma omp parallel for
+		for (int i = 0; i < n; ++i) {
+			const int k = query_keys[i].second;
+			query_perm[i] = k;
+			query_tmp[i * COORD_DIM + 0] = Q[k * COORD_DIM + 0];
+			query_tmp[i * COORD_DIM + 1] = Q[k * COORD_DIM + 1];
+			query_tmp[i * COORD_DIM + 2] = Q[k * COORD_DIM + 2];
+		}
+		memcpy(Q, &query_tmp[0], n * COORD_DIM * sizeof(Real));
+		query_sorted = true;
+	}
+	timings[INTERP3_SORT] += +MPI_Wtime();
+}
+
 /*
  * Phase 1 of the parallel interpolation: This function computes which query_points needs to be sent to
  * other processors and which ones can be interpolated locally. Then a sparse alltoall is performed and
@@ -306,12 +549,13 @@ void Interp3_Plan::fast_scatter(int* N_reg, int * isize, int* istart,
 				<< "ERROR Interp3_Plan Scatter called before calling allocate.\n";
 		return;
 	}
-	if (this->scatter_baked == true) {
-		for (int proc = 0; proc < nprocs; ++proc) {
-			std::vector<int>().swap(f_index[proc]);
-			std::vector<Real>().swap(query_outside[proc]);
-		}
+	// clear (but keep the capacity of) the per process lists of the previous scatter
+	for (int proc = 0; proc < nprocs; ++proc) {
+		f_index[proc].clear();
+		query_outside[proc].clear();
 	}
+	procs_i_send_to_.clear();
+	procs_i_recv_from_.clear();
 	all_query_points_allocation = 0;
 
 	{
@@ -501,14 +745,9 @@ void Interp3_Plan::fast_scatter(int* N_reg, int * isize, int* istart,
     // pvfmm::aligned_delete(bins_Q);
     // pvfmm::aligned_delete(bins_f);
     //pvfmm::aligned_delete<Real>(query_points);
-		// Now sort the query points in zyx order
-#ifdef SORT_QUERIES
-		timings[3]+=-MPI_Wtime();
-		zsort_queries(query_outside,f_index,N_reg,h,c_comm);
-		timings[3]+=+MPI_Wtime();
-		//if(procid==0) std::cout<<"Sorting time="<<s_time<<std::endl;;
-		//if(procid==0) std::cout<<"Sorting Queries\n";
-#endif
+		// note: the received query points are sorted after the alltoall (see
+		// sort_query_points); sorting the send lists (zsort_queries) does not
+		// order the points we receive from several procs
 
 		// Now we need to send the query_points that land onto other processor's domain.
 		// This is done using a sparse alltoallv.
@@ -569,21 +808,15 @@ void Interp3_Plan::fast_scatter(int* N_reg, int * isize, int* istart,
 		}
 		total_query_points = all_query_points_allocation / COORD_DIM;
 
-		// This if condition is to allow multiple calls to scatter fucntion with different query points
-		// without having to create a new plan
-		if (this->scatter_baked == true) {
-      pvfmm::aligned_delete<Real>(this->all_query_points);
-      pvfmm::aligned_delete<Real>(this->all_f_cubic);
-		}
+		// The buffers are reused across calls to scatter with different query
+		// points; they are only reallocated if they have to grow
 #ifdef INTERP_USE_MORE_MEM_L1
-		all_query_points = pvfmm::aligned_new<Real>(
-				(total_query_points+16)*(COORD_DIM+1)); // 16 for blocking in interp
+		reserve_scatter_buffers((total_query_points+16)*(COORD_DIM+1), // 16 for blocking in interp
+				total_query_points * data_dof_max + (16*isize_g[2]*isize_g[1]+16*isize_g[1]+16));
 #else
-		all_query_points = pvfmm::aligned_new<Real>(
-				(total_query_points+16)*(COORD_DIM)); // 16 for blocking in interp
-#endif
-		all_f_cubic = pvfmm::aligned_new<Real>(
+		reserve_scatter_buffers((total_query_points+16)*(COORD_DIM), // 16 for blocking in interp
 				total_query_points * data_dof_max + (16*isize_g[2]*isize_g[1]+16*isize_g[1]+16));
+#endif
 
 #ifdef INTERP_DEBUG
     //parallel_print(total_query_points, "total_q_points");
@@ -593,7 +826,58 @@ void Interp3_Plan::fast_scatter(int* N_reg, int * isize, int* istart,
 #endif
 		// Now perform the allotall to send/recv query_points
 		timings[0] += -MPI_Wtime();
-		{
+		if (compress_bits != 0) {
+			// compressed scatter: coordinates sent to other procs are encoded
+			// relative to the destination pencil; our own points are copied
+			const int units = query_packed_units(compress_bits);
+			Real lo[3], scale[3];
+			query_send_packed.resize(std::max(N_pts * units, 1));
+			query_recv_packed.resize(std::max(total_query_points * units, 1));
+
+			for (int i = 0; i < procs_i_recv_from_size_; ++i) {
+				int dst_r = procs_i_recv_from_[i];
+				request[dst_r] = MPI_REQUEST_NULL;
+				if (dst_r == procid) continue;
+				int roffset = f_index_procs_others_offset[dst_r] * units;
+				MPI_Irecv(&query_recv_packed[roffset],
+						f_index_procs_others_sizes[dst_r] * units,
+						MPI_UNSIGNED_SHORT, dst_r, 0, c_comm, &request[dst_r]);
+			}
+			for (int i = 0; i < procs_i_send_to_size_; ++i) {
+				int dst_s = procs_i_send_to_[i];
+				s_request[dst_s] = MPI_REQUEST_NULL;
+				if (dst_s == procid) continue;
+				int soffset = f_index_procs_self_offset[dst_s] * units;
+				query_box(dst_s, c_dims, isize0, isize1, h, lo, scale, compress_bits);
+				for (int j = 0; j < f_index_procs_self_sizes[dst_s]; ++j)
+					encode_query(&query_outside[dst_s][j * COORD_DIM], lo, scale,
+							compress_bits, &query_send_packed[soffset + j * units]);
+				MPI_Isend(&query_send_packed[soffset],
+						f_index_procs_self_sizes[dst_s] * units, MPI_UNSIGNED_SHORT,
+						dst_s, 0, c_comm, &s_request[dst_s]);
+			}
+			if (f_index_procs_self_sizes[procid] != 0)
+				memcpy(&all_query_points[f_index_procs_others_offset[procid] * COORD_DIM],
+						&query_outside[procid][0],
+						f_index_procs_self_sizes[procid] * COORD_DIM * sizeof(Real));
+
+			query_box(procid, c_dims, isize0, isize1, h, lo, scale, compress_bits);
+			for (int i = 0; i < procs_i_recv_from_size_; ++i) {
+				int proc = procs_i_recv_from_[i];
+				if (request[proc] != MPI_REQUEST_NULL)
+					MPI_Wait(&request[proc], MPI_STATUS_IGNORE);
+				if (proc == procid) continue;
+				int offset = f_index_procs_others_offset[proc];
+				for (int j = 0; j < f_index_procs_others_sizes[proc]; ++j)
+					decode_query(&query_recv_packed[(offset + j) * units], lo, scale,
+							compress_bits, &all_query_points[(offset + j) * COORD_DIM]);
+			}
+			for (int i = 0; i < procs_i_send_to_size_; ++i) {
+				int proc = procs_i_send_to_[i];
+				if (s_request[proc] != MPI_REQUEST_NULL)
+					MPI_Wait(&s_request[proc], MPI_STATUS_IGNORE);
+			}
+		} else {
 			int dst_r, dst_s;
 			for (int i = 0; i < procs_i_recv_from_size_; ++i) {
 				dst_r = procs_i_recv_from_[i];    //(procid+i)%nprocs;
@@ -648,6 +932,20 @@ void Interp3_Plan::fast_scatter(int* N_reg, int * isize, int* istart,
 		}
 		timings[0] += +MPI_Wtime();
     time+=MPI_Wtime();
+
+		// load counters: query points we exchange with other procs
+		offrank_query_points = 0;
+		for (int proc = 0; proc < nprocs; ++proc) {
+			if (proc == procid) continue;
+			offrank_query_points += f_index_procs_self_sizes[proc]
+					+ f_index_procs_others_sizes[proc];
+		}
+		if (compress_bits != 0)
+			timings[INTERP3_NBYTES] += (double) offrank_query_points
+					* query_packed_units(compress_bits) * sizeof(uint16_t);
+		else
+			timings[INTERP3_NBYTES] += (double) offrank_query_points
+					* COORD_DIM * sizeof(Real);
     //std::cout << "**** time = " << time << std::endl;
 
 	}
@@ -657,28 +955,25 @@ void Interp3_Plan::fast_scatter(int* N_reg, int * isize, int* istart,
 #endif
   // ParLOG << "nplans_ = " << nplans_ << " data_dof_max = " << data_dof_max << std::endl;
   // ParLOG << "data_dofs[0] = " << data_dofs_[0] << " [1] = " << data_dofs_[1] << std::endl;
-  for(int ver = 0; ver < nplans_; ++ver){
-	for (int i = 0; i < nprocs; ++i) {
-		MPI_Type_vector(data_dofs_[ver], f_index_procs_self_sizes[i], N_pts, MPI_T,
-				&rtypes[i+ver*nprocs]);
-		MPI_Type_vector(data_dofs_[ver], f_index_procs_others_sizes[i],
-				total_query_points, MPI_T, &stypes[i+ver*nprocs]);
-		MPI_Type_commit(&stypes[i+ver*nprocs]);
-		MPI_Type_commit(&rtypes[i+ver*nprocs]);
-	}
-  }
+  commit_types(N_pts);
 #ifdef INTERP_USE_MORE_MEM_L1
-  if(total_query_points !=0)
+  // the grid index is baked into the coordinates only for the cubic kernel
+  if(total_query_points !=0 && kernel == INTERP3_CUBIC)
 	rescale_xyzgrid(g_size, N_reg, N_reg_g, istart, isize, isize_g, total_query_points,
 			all_query_points);
+  else if(total_query_points !=0)
+	rescale_xyz(g_size, N_reg, N_reg_g, istart, isize, isize_g, total_query_points,
+			&all_query_points[0]);
 #else
   if(total_query_points !=0)
 	rescale_xyz(g_size, N_reg, N_reg_g, istart, isize, isize_g, total_query_points,
 			&all_query_points[0]);
 #endif
+  // morton order of the points we interpolate (cache locality of the stencils)
+  sort_query_points(timings);
 
-    if (procs_i_recv_from_.size() != 0) procs_i_recv_from_.clear();
-    if (procs_i_send_to_.size() != 0) procs_i_send_to_.clear();
+    // note: procs_i_send_to_/procs_i_recv_from_ are used by interpolate; they
+    // are reset at the beginning of the next scatter
 
 	this->scatter_baked = true;
 #ifdef INTERP_DEBUG
@@ -716,7 +1011,38 @@ void Interp3_Plan::interpolate(Real* __restrict ghost_reg_grid_vals,
 		return;
 	}
 
+	// with sorted query points, the kernel writes into a scratch array that
+	// is permuted back into the order of the scatter below
+	Real* f_cubic = &all_f_cubic[0];
+	if (query_sorted) {
+		query_f_sorted.resize((size_t) total_query_points * data_dofs_[version]);
+		f_cubic = &query_f_sorted[0];
+	}
+
 	timings[1] += -MPI_Wtime();
+  if (kernel == INTERP3_LINEAR) {
+    if(total_query_points!=0)
+	  linear_interp3_ghost_xyz_p(ghost_reg_grid_vals, data_dofs_[version], N_reg, N_reg_g, isize_g,
+			istart, total_query_points, g_size, &all_query_points[0], f_cubic,
+			true);
+  } else if (kernel == INTERP3_BSPLINE) {
+    if(total_query_points!=0)
+	  bspline_interp3_ghost_xyz_p(ghost_reg_grid_vals, data_dofs_[version], N_reg, N_reg_g, isize_g,
+			istart, total_query_points, g_size, &all_query_points[0], f_cubic,
+			true);
+  } else if (kernel == INTERP3_QUINTIC) {
+    if(total_query_points!=0)
+	  interp3_ghost_xyz_p(ghost_reg_grid_vals, data_dofs_[version], N_reg, N_reg_g, isize_g,
+			istart, total_query_points, g_size, &all_query_points[0], f_cubic,
+			interp3_kernel_order(kernel), true);
+  } else if (variant >= 0 && (variant_version < 0 || variant_version == version)) {
+    // implementation selected at run time (see Interp3_Plan::autotune); a
+    // tuned variant is only used for the dofs it has been timed on
+    if(total_query_points!=0)
+	  interp3_variant_ghost_xyz_p(variant, ghost_reg_grid_vals, data_dofs_[version], N_reg, N_reg_g, isize_g,
+			istart, total_query_points, g_size, &all_query_points[0], f_cubic,
+			true);
+  } else {
 #ifdef FAST_INTERP
 #ifdef FAST_INTERPV
   const int N_reg3 = isize_g[0] * isize_g[1] * isize_g[2];
@@ -728,26 +1054,55 @@ void Interp3_Plan::interpolate(Real* __restrict ghost_reg_grid_vals,
   if(total_query_points!=0)
     for (int k = 0; k < data_dofs_[version]; ++k){
 	    vectorized_interp3_ghost_xyz_p(&ghost_reg_grid_vals[k*N_reg3], 1, N_reg_c, N_reg_g_c, isize_g_c,
-			  istart_c, total_query_points_c, g_size, &all_query_points[0], &all_f_cubic[k*total_query_points],
+			  istart_c, total_query_points_c, g_size, &all_query_points[0], &f_cubic[k*total_query_points],
 			  true);
       //std::cout << "data_dofs_[version ] = " << data_dofs_[version] << std::endl;
       //do{}while(1);
     }
 #else
   const int N_reg3 = isize_g[0] * isize_g[1] * isize_g[2];
+#ifndef INTERP_USE_MORE_MEM_L1
+  // several fields (e.g., all components of a multi-component image): compute
+  // the stencil weights once per query point and reuse them for all fields
+  // (this includes the blocks of vector fields of the blocked hessian matvec,
+  // dof 3*nb); single vector fields (dof 3) stay on the tuned per-component
+  // kernel; the batched kernel reads the query points in the COORD_DIM layout,
+  // not in the padded layout of rescale_xyzgrid (INTERP_USE_MORE_MEM_L1)
+  if(total_query_points!=0 && data_dofs_[version] > 1 && data_dofs_[version] != 3)
+	  batched_interp3_ghost_xyz_p(ghost_reg_grid_vals, data_dofs_[version], N_reg, N_reg_g, isize_g,
+			istart, total_query_points, g_size, &all_query_points[0], f_cubic,
+			true);
+  else
+#endif
   if(total_query_points!=0)
     for (int k = 0; k < data_dofs_[version]; ++k)
 	  optimized_interp3_ghost_xyz_p(&ghost_reg_grid_vals[k*N_reg3], 1, N_reg, N_reg_g, isize_g,
-			istart, total_query_points, g_size, &all_query_points[0], &all_f_cubic[k*total_query_points],
+			istart, total_query_points, g_size, &all_query_points[0], &f_cubic[k*total_query_points],
 			true);
 #endif
 #else
   if(total_query_points!=0)
 	 interp3_ghost_xyz_p(ghost_reg_grid_vals, data_dofs_[version], N_reg, N_reg_g, isize_g,
-			istart, total_query_points, g_size, &all_query_points[0], &all_f_cubic[0],
+			istart, total_query_points, g_size, &all_query_points[0], f_cubic,
 			true);
 #endif
+  }
 	timings[1] += +MPI_Wtime();
+	if (query_sorted) {
+		timings[INTERP3_SORT] += -MPI_Wtime();
+		const int n = total_query_points;
+		const int dof = data_dofs_[version];
+#pragma omp parallel for
+		for (int i = 0; i < n; ++i) {
+			const int k = query_perm[i];
+			for (int j = 0; j < dof; ++j)
+				all_f_cubic[j * n + k] = query_f_sorted[j * n + i];
+		}
+		timings[INTERP3_SORT] += +MPI_Wtime();
+	}
+	timings[INTERP3_NQUERIES] += total_query_points;
+	timings[INTERP3_NBYTES] += (double) offrank_query_points
+			* data_dofs_[version] * sizeof(Real);
 
 	// Now we have to do an alltoall to distribute the interpolated data from all_f_cubic to
 	// f_cubic_unordered.
@@ -766,7 +1121,7 @@ void Interp3_Plan::interpolate(Real* __restrict ghost_reg_grid_vals,
 			request[dst_r] = MPI_REQUEST_NULL; //recv
 			int roffset = f_index_procs_self_offset[dst_r];
 
-			MPI_Irecv(&f_cubic_unordered[roffset], 1, rtypes[dst_r+version*nprocs], dst_r, 0,
+			MPI_Irecv(&f_cubic_unordered[roffset], f_index_procs_self_sizes[dst_r], rtypes[version], dst_r, 0,
 					c_comm, &request[dst_r]);
 		}
 		for (int i = 0; i < procs_i_recv_from_size_; ++i) {
@@ -775,7 +1130,7 @@ void Interp3_Plan::interpolate(Real* __restrict ghost_reg_grid_vals,
 			s_request[dst_s] = MPI_REQUEST_NULL; //send
 			int soffset = f_index_procs_others_offset[dst_s];
 
-			MPI_Isend(&all_f_cubic[soffset], 1, stypes[dst_s+version*nprocs], dst_s, 0, c_comm,
+			MPI_Isend(&all_f_cubic[soffset], f_index_procs_others_sizes[dst_s], stypes[version], dst_s, 0, c_comm,
 					&s_request[dst_s]);
 		}
     // wait to receive your part
@@ -844,6 +1199,93 @@ void Interp3_Plan::interpolate(Real* __restrict ghost_reg_grid_vals,
 	return;
 }
 
+/*
+ * Times the implementations of the cubic kernel (Interp3_Variant) on a batch of
+ * the query points of the last scatter and returns the fastest one whose result
+ * agrees with the reference implementation on all procs; -1 if no variant can
+ * be used (kernel other than cubic, or coordinates in the simd layout).
+ * variant_timings (size INTERP3_NVARIANTS) returns the time of each variant
+ * (max over all procs); rejected variants are marked with -1. The variant of
+ * the plan is not changed; this function is collective over c_comm.
+ */
+int Interp3_Plan::autotune(Real* ghost_reg_grid_vals, int* N_reg, int* isize, int* istart,
+		const int g_size, MPI_Comm c_comm, double* variant_timings, int version) {
+	const int nrep = 3;
+	const int N_batch = std::min(total_query_points, 1 << 15);
+	int ok[INTERP3_NVARIANTS], ok_all[INTERP3_NVARIANTS];
+	double t[INTERP3_NVARIANTS], t_all[INTERP3_NVARIANTS];
+	int best = -1;
+
+	for (int v = 0; v < INTERP3_NVARIANTS; ++v) {
+		ok[v] = 0;
+		t[v] = 0;
+		variant_timings[v] = -1;
+	}
+	if (this->allocate_baked == false || this->scatter_baked == false) {
+		std::cout
+				<< "ERROR Interp3_Plan autotune called before calling scatter.\n";
+		return -1;
+	}
+#ifdef INTERP_USE_MORE_MEM_L1
+	return -1;
+#endif
+	if (kernel != INTERP3_CUBIC)
+		return -1;
+
+	const int dof = data_dofs_[version];
+	std::vector<Real> ref(N_batch * dof + 1), val(N_batch * dof + 1);
+
+	// reference values (modulo addressing; no unrolling)
+	Real scale = 1;
+	if (N_batch != 0) {
+		interp3_ghost_xyz_p(ghost_reg_grid_vals, dof, N_reg, N_reg_g, isize_g,
+				istart, N_batch, g_size, &all_query_points[0], &ref[0], true);
+		for (int i = 0; i < N_batch * dof; ++i)
+			scale = std::max(scale, (Real) std::abs(ref[i]));
+	}
+	const Real tol = (sizeof(Real) == 4 ? 1e-4 : 1e-10) * scale;
+
+	for (int v = 0; v < INTERP3_NVARIANTS; ++v) {
+		if (!interp3_variant_available(v))
+			continue;
+		ok[v] = 1;
+		if (N_batch == 0)
+			continue;
+		// first call also warms up the cache
+		interp3_variant_ghost_xyz_p(v, ghost_reg_grid_vals, dof, N_reg, N_reg_g, isize_g,
+				istart, N_batch, g_size, &all_query_points[0], &val[0], true);
+		for (int i = 0; i < N_batch * dof; ++i) {
+			if (!(std::abs(val[i] - ref[i]) <= tol)) {
+				ok[v] = 0;
+				break;
+			}
+		}
+		if (ok[v] == 0)
+			continue;
+		t[v] = std::numeric_limits<double>::max();
+		for (int r = 0; r < nrep; ++r) {
+			double tr = -MPI_Wtime();
+			interp3_variant_ghost_xyz_p(v, ghost_reg_grid_vals, dof, N_reg, N_reg_g, isize_g,
+					istart, N_batch, g_size, &all_query_points[0], &val[0], true);
+			tr += MPI_Wtime();
+			t[v] = std::min(t[v], tr);
+		}
+	}
+
+	// a variant is used only if it is correct everywhere; the slowest proc decides
+	MPI_Allreduce(ok, ok_all, INTERP3_NVARIANTS, MPI_INT, MPI_MIN, c_comm);
+	MPI_Allreduce(t, t_all, INTERP3_NVARIANTS, MPI_DOUBLE, MPI_MAX, c_comm);
+
+	for (int v = 0; v < INTERP3_NVARIANTS; ++v) {
+		if (ok_all[v] == 0)
+			continue;
+		variant_timings[v] = t_all[v];
+		if (best < 0 || t_all[v] < t_all[best])
+			best = v;
+	}
+	return best;
+}
+
 Interp3_Plan::~Interp3_Plan() {
 	int nprocs, procid;
 	MPI_Comm_rank(MPI_COMM_WORLD, &procid);
@@ -869,15 +1311,16 @@ Interp3_Plan::~Interp3_Plan() {
 
 	}
 
-	if (this->scatter_baked) {
-		for (int ver = 0; ver < nplans_; ++ver)
-		for (int i = 0; i < nprocs; ++i) {
-			MPI_Type_free(&stypes[i+ver*nprocs]);
-			MPI_Type_free(&rtypes[i+ver*nprocs]);
+	if (this->types_baked) {
+		for (int ver = 0; ver < nplans_; ++ver) {
+			MPI_Type_free(&stypes[ver]);
+			MPI_Type_free(&rtypes[ver]);
 		}
+	}
+	if (this->all_query_points_capacity != 0)
     pvfmm::aligned_delete<Real>(all_query_points);
+	if (this->all_f_cubic_capacity != 0)
     pvfmm::aligned_delete<Real>(all_f_cubic);
-	}
 
 	if (this->allocate_baked) {
     pvfmm::aligned_delete<MPI_Datatype>(rtypes);
@@ -980,12 +1423,13 @@ void Interp3_Plan::scatter(int* N_reg, int * isize, int* istart,
 				<< "ERROR Interp3_Plan Scatter called before calling allocate.\n";
 		return;
 	}
-	if (this->scatter_baked == true) {
-		for (int proc = 0; proc < nprocs; ++proc) {
-			std::vector<int>().swap(f_index[proc]);
-			std::vector<Real>().swap(query_outside[proc]);
-		}
+	// clear (but keep the capacity of) the per process lists of the previous scatter
+	for (int proc = 0; proc < nprocs; ++proc) {
+		f_index[proc].clear();
+		query_outside[proc].clear();
 	}
+	procs_i_send_to_.clear();
+	procs_i_recv_from_.clear();
 	all_query_points_allocation = 0;
 
 	{
@@ -1145,21 +1589,10 @@ void Interp3_Plan::scatter(int* N_reg, int * isize, int* istart,
 		}
 		total_query_points = all_query_points_allocation / COORD_DIM;
 
-		// This if condition is to allow multiple calls to scatter fucntion with different query points
-		// without having to create a new plan
-		if (this->scatter_baked == true) {
-      pvfmm::aligned_delete<Real>(this->all_query_points);
-      pvfmm::aligned_delete<Real>(this->all_f_cubic);
-			all_query_points = pvfmm::aligned_new<Real>(
-					all_query_points_allocation);
-			all_f_cubic = pvfmm::aligned_new<Real>(
-					total_query_points * data_dof_max);
-		} else {
-			all_query_points = pvfmm::aligned_new<Real>(
-					all_query_points_allocation);
-			all_f_cubic = pvfmm::aligned_new<Real>(
-					total_query_points * data_dof_max);
-		}
+		// The buffers are reused across calls to scatter with different query
+		// points; they are only reallocated if they have to grow
+		reserve_scatter_buffers(all_query_points_allocation,
+				total_query_points * data_dof_max);
 
 		// Now perform the allotall to send/recv query_points
 		timings[0] += -MPI_Wtime();
@@ -1191,25 +1624,24 @@ void Interp3_Plan::scatter(int* N_reg, int * isize, int* istart,
 			}
 		}
 		timings[0] += +MPI_Wtime();
-	}
 
-  for(int ver = 0; ver < nplans_; ++ver){
-	for (int i = 0; i < nprocs; ++i) {
-		MPI_Type_vector(data_dofs_[ver], f_index_procs_self_sizes[i], N_pts, MPI_T,
-				&rtypes[i+ver*nprocs]);
-		MPI_Type_vector(data_dofs_[ver], f_index_procs_others_sizes[i],
-				total_query_points, MPI_T, &stypes[i+ver*nprocs]);
-		MPI_Type_commit(&stypes[i+ver*nprocs]);
-		MPI_Type_commit(&rtypes[i+ver*nprocs]);
+		// load counters: query points we exchange with other procs
+		offrank_query_points = 0;
+		for (int proc = 0; proc < nprocs; ++proc) {
+			if (proc == procid) continue;
+			offrank_query_points += f_index_procs_self_sizes[proc]
+					+ f_index_procs_others_sizes[proc];
+		}
+		timings[INTERP3_NBYTES] += (double) offrank_query_points
+				* COORD_DIM * sizeof(Real);
 	}
-  }
+
+  commit_types(N_pts);
 
 	rescale_xyz(g_size, N_reg, N_reg_g, istart, isize, isize_g, total_query_points,
 			all_query_points);
 	//rescale_xyz(g_size, N_reg, N_reg_g, istart, isize, total_query_points,
 	//		all_query_points);
-    if(!procs_i_recv_from_.empty()) procs_i_recv_from_.clear();
-    if(!procs_i_send_to_.empty()) procs_i_send_to_.clear();
 	this->scatter_baked = true;
 	return;
 #endif
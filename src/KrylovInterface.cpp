@@ -21,6 +21,7 @@
 #define _KRYLOVINTERFACE_CPP_
 
 #include "KrylovInterface.hpp"
+#include "KrylovRecycler.hpp"
 
 
 namespace reg {
@@ -105,7 +106,7 @@ PetscErrorCode PreKrylovSolve(KSP krylovmethod, Vec b, Vec x, void* ptr) {
      || (optprob->GetOptions()->m_KrylovMethod.matvectype == PRECONDMATVECSYM))  {
         // get current gradient and compute norm
         // before we apply the preconditioner to the right hand side
-        ierr = VecNorm(b, NORM_2, &gnorm); CHKERRQ(ierr);
+        ierr = VecNormL2(b, &gnorm); CHKERRQ(ierr);
     }
 
     // use default tolreance
@@ -119,7 +120,7 @@ PetscErrorCode PreKrylovSolve(KSP krylovmethod, Vec b, Vec x, void* ptr) {
     if (optprob->GetOptions()->m_KrylovMethod.fseqtype != NOFS) {
         if (gnorm == 0.0) {
             // get current gradient and compute norm
-            ierr = VecNorm(b, NORM_2, &gnorm); CHKERRQ(ierr);
+            ierr = VecNormL2(b, &gnorm); CHKERRQ(ierr);
         }
 
         if (!optprob->GetOptions()->m_KrylovMethod.g0normset) {
@@ -421,6 +422,29 @@ PetscErrorCode InvertPrecondMatVec(Mat P, Vec x, Vec Px) {
 
 
 
+/****************************************************************************
+ * @brief computes the hessian matrix vector product on the grid of the
+ * preconditioner (smoother of the multilevel preconditioner)
+ ****************************************************************************/
+PetscErrorCode SmootherMatVec(Mat H, Vec x, Vec Hx) {
+    PetscErrorCode ierr = 0;
+    void* ptr;
+    Preconditioner* precond = NULL;
+    PetscFunctionBegin;
+
+    ierr = MatShellGetContext(H, reinterpret_cast<void**>(&ptr)); CHKERRQ(ierr);
+    precond = reinterpret_cast<Preconditioner*>(ptr);
+    ierr = Assert(precond != NULL, "null pointer"); CHKERRQ(ierr);
+
+    // apply hessian
+    ierr = precond->LevelHessianMatVec(Hx, x); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /****************************************************************************
  * @brief initialization before applying the preconditioner
  * @para[in] krylovmethod pointer to krylov method
@@ -543,6 +567,106 @@ PetscErrorCode InvertPrecondPreKrylovSolve(KSP krylovmethod, Vec b,
 
 
 
+/****************************************************************************
+ * @brief preprocessing before the krylov solve if the krylov subspace is
+ * recycled (see PreKrylovSolve); sets the initial guess and deflates it
+ * @para[in] krylovmethod pointer to krylov method
+ * @para[in] b right hand side of equation
+ * @para[in] x solution vector
+ * @para[in] ptr pointer to recycler
+ ****************************************************************************/
+PetscErrorCode RecycledPreKrylovSolve(KSP krylovmethod, Vec b, Vec x, void* ptr) {
+    PetscErrorCode ierr = 0;
+    KrylovRecycler* recycler = NULL;
+
+    PetscFunctionBegin;
+
+    recycler = reinterpret_cast<KrylovRecycler*>(ptr);
+    ierr = Assert(recycler != NULL, "null pointer"); CHKERRQ(ierr);
+
+    ierr = PreKrylovSolve(krylovmethod, b, x, recycler->GetProblem()); CHKERRQ(ierr);
+    ierr = recycler->PreSolve(b, x); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/****************************************************************************
+ * @brief postprocessing after the krylov solve if the krylov subspace is
+ * recycled (see PostKrylovSolve); the recycled space is updated before
+ * the solution is mapped back (symmetric preconditioning)
+ * @para[in] krylovmethod pointer to krylov method
+ * @para[in] b right hand side of equation
+ * @para[in] x solution vector
+ * @para[in] ptr pointer to recycler
+ ****************************************************************************/
+PetscErrorCode RecycledPostKrylovSolve(KSP krylovmethod, Vec b, Vec x, void* ptr) {
+    PetscErrorCode ierr = 0;
+    KrylovRecycler* recycler = NULL;
+
+    PetscFunctionBegin;
+
+    recycler = reinterpret_cast<KrylovRecycler*>(ptr);
+    ierr = Assert(recycler != NULL, "null pointer"); CHKERRQ(ierr);
+
+    ierr = recycler->PostSolve(x); CHKERRQ(ierr);
+    ierr = PostKrylovSolve(krylovmethod, b, x, recycler->GetProblem()); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/****************************************************************************
+ * @brief hessian matvec if the krylov subspace is recycled (records
+ * the matvecs)
+ ****************************************************************************/
+PetscErrorCode RecycledHessianMatVec(Mat H, Vec x, Vec Hx) {
+    PetscErrorCode ierr = 0;
+    void* ptr;
+    KrylovRecycler* recycler = NULL;
+
+    PetscFunctionBegin;
+
+    ierr = MatShellGetContext(H, reinterpret_cast<void**>(&ptr)); CHKERRQ(ierr);
+
+    recycler = reinterpret_cast<KrylovRecycler*>(ptr);
+    ierr = Assert(recycler != NULL, "null pointer"); CHKERRQ(ierr);
+
+    ierr = recycler->HessianMatVec(Hx, x); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/****************************************************************************
+ * @brief deflated preconditioner if the krylov subspace is recycled
+ ****************************************************************************/
+PetscErrorCode RecycledPrecondMatVec(PC Hpre, Vec x, Vec Hprex) {
+    PetscErrorCode ierr = 0;
+    void* ptr;
+    KrylovRecycler* recycler = NULL;
+
+    PetscFunctionBegin;
+
+    ierr = PCShellGetContext(Hpre, &ptr); CHKERRQ(ierr);
+
+    recycler = reinterpret_cast<KrylovRecycler*>(ptr);
+    ierr = Assert(recycler != NULL, "null pointer"); CHKERRQ(ierr);
+
+    ierr = recycler->PrecondMatVec(Hprex, x); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 }  // namespace reg
 
 
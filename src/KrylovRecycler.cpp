@@ -0,0 +1,698 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _KRYLOVRECYCLER_CPP_
+#define _KRYLOVRECYCLER_CPP_
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "KrylovRecycler.hpp"
+#include "Preconditioner.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief default constructor
+ *******************************************************************/
+KrylovRecycler::KrylovRecycler() {
+    this->Initialize();
+}
+
+
+
+
+/********************************************************************
+ * @brief constructor
+ *******************************************************************/
+KrylovRecycler::KrylovRecycler(RegOpt* opt) {
+    this->Initialize();
+    this->m_Opt = opt;
+    this->m_NumVectors = opt->m_KrylovMethod.nrecycle;
+    this->m_MaxRecord = 2*opt->m_KrylovMethod.nrecycle;
+}
+
+
+
+
+/********************************************************************
+ * @brief default destructor
+ *******************************************************************/
+KrylovRecycler::~KrylovRecycler() {
+    this->ClearMemory();
+}
+
+
+
+
+/********************************************************************
+ * @brief initialize class variables
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::Initialize() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    this->m_Opt = NULL;
+    this->m_OptimizationProblem = NULL;
+    this->m_Precond = NULL;
+
+    this->m_NumVectors = 0;
+    this->m_MaxRecord = 0;
+
+    this->m_Recording = false;
+    this->m_Deflate = false;
+
+    this->m_Solution = NULL;
+    this->m_WorkVec = NULL;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief clean up
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::ClearMemory() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = this->Reset(); CHKERRQ(ierr);
+
+    for (size_t i = 0; i < this->m_Pool.size(); ++i) {
+        ierr = VecDestroy(&this->m_Pool[i]); CHKERRQ(ierr);
+    }
+    this->m_Pool.clear();
+
+    if (this->m_WorkVec != NULL) {
+        ierr = VecDestroy(&this->m_WorkVec); CHKERRQ(ierr);
+        this->m_WorkVec = NULL;
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set optimization problem
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::SetProblem(OptProbType* optprob) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = Assert(optprob != NULL, "null pointer"); CHKERRQ(ierr);
+    this->m_OptimizationProblem = optprob;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set preconditioner
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::SetPreconditioner(Preconditioner* precond) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    this->m_Precond = precond;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief drop recycled space and stored solution (vectors are kept
+ * for reuse unless the size changes)
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::Reset() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    for (size_t i = 0; i < this->m_W.size(); ++i) {
+        ierr = this->ReturnVector(this->m_W[i]); CHKERRQ(ierr);
+    }
+    for (size_t i = 0; i < this->m_AW.size(); ++i) {
+        ierr = this->ReturnVector(this->m_AW[i]); CHKERRQ(ierr);
+    }
+    for (size_t i = 0; i < this->m_V.size(); ++i) {
+        ierr = this->ReturnVector(this->m_V[i]); CHKERRQ(ierr);
+        ierr = this->ReturnVector(this->m_AV[i]); CHKERRQ(ierr);
+    }
+    this->m_W.clear();
+    this->m_AW.clear();
+    this->m_V.clear();
+    this->m_AV.clear();
+
+    if (this->m_Solution != NULL) {
+        ierr = VecDestroy(&this->m_Solution); CHKERRQ(ierr);
+        this->m_Solution = NULL;
+    }
+
+    this->m_Recording = false;
+    this->m_Deflate = false;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief get vector from pool (allocate if pool is empty)
+ * @param[out] x vector
+ * @param[in] v template (layout)
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::GetVector(Vec& x, Vec v) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    if (!this->m_Pool.empty()) {
+        x = this->m_Pool.back();
+        this->m_Pool.pop_back();
+    } else {
+        ierr = VecDuplicate(v, &x); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief return vector to pool
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::ReturnVector(Vec& x) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    if (x != NULL) {
+        this->m_Pool.push_back(x);
+        x = NULL;
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set initial guess (zero or solution of previous solve) and
+ * remove the recycled modes from the initial residual; this applies
+ * the hessian to the recycled vectors (the operator has changed)
+ * @param[in] b right hand side
+ * @param[in,out] x initial guess
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::PreSolve(Vec b, Vec x) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nlw;
+    int k;
+    bool spd;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(this->m_OptimizationProblem != NULL, "null pointer"); CHKERRQ(ierr);
+
+    // the grid has changed (grid continuation); start over
+    ierr = VecGetLocalSize(b, &nl); CHKERRQ(ierr);
+    if (this->m_WorkVec != NULL) {
+        ierr = VecGetLocalSize(this->m_WorkVec, &nlw); CHKERRQ(ierr);
+        if (nlw != nl) {
+            ierr = this->ClearMemory(); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_WorkVec == NULL) {
+        ierr = VecDuplicate(b, &this->m_WorkVec); CHKERRQ(ierr);
+    }
+
+    // activate secant pairs of last solve (quasi-newton preconditioner)
+    if (this->m_Precond != NULL) {
+        ierr = this->m_Precond->UpdateSecantPairs(); CHKERRQ(ierr);
+    }
+
+    // initial guess
+    if (this->m_Opt->m_KrylovMethod.warmstart && this->m_Solution != NULL) {
+        ierr = VecCopy(this->m_Solution, x); CHKERRQ(ierr);
+    } else {
+        ierr = VecSet(x, 0.0); CHKERRQ(ierr);
+    }
+
+    this->m_Deflate = false;
+    k = static_cast<int>(this->m_W.size());
+    if (k > 0) {
+        // apply current hessian to recycled vectors (as a block)
+        for (int i = 0; i < k; ++i) {
+            if (this->m_AW[i] == NULL) {
+                ierr = this->GetVector(this->m_AW[i], b); CHKERRQ(ierr);
+            }
+        }
+        ierr = this->m_OptimizationProblem->HessianMatVecBlock(this->m_AW.data(), this->m_W.data(), k); CHKERRQ(ierr);
+
+        // E = W^T A W (symmetrized)
+        this->m_E.assign(k*k, 0.0);
+        this->m_Coeff.resize(k);
+        for (int j = 0; j < k; ++j) {
+            ierr = VecMDot(this->m_AW[j], k, this->m_W.data(), this->m_Coeff.data()); CHKERRQ(ierr);
+            for (int i = 0; i < k; ++i) {
+                this->m_E[i*k+j] += 0.5*static_cast<double>(this->m_Coeff[i]);
+                this->m_E[j*k+i] += 0.5*static_cast<double>(this->m_Coeff[i]);
+            }
+        }
+        ierr = Cholesky(this->m_E, k, spd); CHKERRQ(ierr);
+
+        if (spd) {
+            this->m_Deflate = true;
+            // x <- x + W E^{-1} W^T (b - A x)
+            ierr = this->ApplyCoarseCorrection(x, b, x); CHKERRQ(ierr);
+        } else {
+            ierr = WrngMsg("recycled space is not positive definite; dropping it"); CHKERRQ(ierr);
+            for (int i = 0; i < k; ++i) {
+                ierr = this->ReturnVector(this->m_W[i]); CHKERRQ(ierr);
+                ierr = this->ReturnVector(this->m_AW[i]); CHKERRQ(ierr);
+            }
+            this->m_W.clear();
+            this->m_AW.clear();
+        }
+
+        if (this->m_Opt->m_Verbosity > 1) {
+            ss << "deflating krylov solve with " << this->m_W.size() << " recycled vectors";
+            ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+        }
+    }
+
+    this->m_Recording = this->m_NumVectors > 0;
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief store solution (warm start) and compute new recycled
+ * vectors from recorded matvecs
+ * @param[in] x solution of krylov solve
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::PostSolve(Vec x) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    this->m_Recording = false;
+    this->m_Deflate = false;
+
+    if (this->m_Opt->m_KrylovMethod.warmstart) {
+        if (this->m_Solution == NULL) {
+            ierr = VecDuplicate(x, &this->m_Solution); CHKERRQ(ierr);
+        }
+        ierr = VecCopy(x, this->m_Solution); CHKERRQ(ierr);
+    }
+
+    if (this->m_NumVectors > 0) {
+        ierr = this->ComputeRitzVectors(); CHKERRQ(ierr);
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief apply hessian; the first matvecs of a solve are recorded
+ * (they span the leading part of the krylov subspace); all matvecs
+ * are passed to the preconditioner (secant pairs for lbfgs update)
+ * @param[out] Hx hessian applied to x
+ * @param[in] x input vector
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::HessianMatVec(Vec Hx, Vec x) {
+    PetscErrorCode ierr = 0;
+    Vec v = NULL, av = NULL;
+    PetscFunctionBegin;
+
+    ierr = Assert(this->m_OptimizationProblem != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = this->m_OptimizationProblem->HessianMatVec(Hx, x); CHKERRQ(ierr);
+
+    if (this->m_Recording && static_cast<int>(this->m_V.size()) < this->m_MaxRecord) {
+        ierr = this->GetVector(v, x); CHKERRQ(ierr);
+        ierr = this->GetVector(av, x); CHKERRQ(ierr);
+        ierr = VecCopy(x, v); CHKERRQ(ierr);
+        ierr = VecCopy(Hx, av); CHKERRQ(ierr);
+        this->m_V.push_back(v);
+        this->m_AV.push_back(av);
+    }
+
+    if (this->m_Precond != NULL) {
+        ierr = this->m_Precond->AddSecantPair(x, Hx); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief apply deflated preconditioner
+ * P = (I - W E^{-1} (AW)^T) M^{-1} + W E^{-1} W^T
+ * @param[out] Px preconditioner applied to x
+ * @param[in] x input vector (residual)
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::PrecondMatVec(Vec Px, Vec x) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    if (this->m_Precond != NULL) {
+        ierr = this->m_Precond->MatVec(Px, x); CHKERRQ(ierr);
+    } else {
+        ierr = VecCopy(x, Px); CHKERRQ(ierr);
+    }
+
+    if (this->m_Deflate) {
+        ierr = this->ApplyCoarseCorrection(Px, x, Px); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief y = z + W E^{-1} (W^T r - (AW)^T z); y and z can be the same
+ * vector (A is symmetric, so (AW)^T z = W^T A z)
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::ApplyCoarseCorrection(Vec y, Vec r, Vec z) {
+    PetscErrorCode ierr = 0;
+    int k;
+    std::vector<double> c;
+    std::vector<ScalarType> caw;
+    PetscFunctionBegin;
+
+    k = static_cast<int>(this->m_W.size());
+    c.resize(k);
+    caw.resize(k);
+
+    ierr = VecMDot(r, k, this->m_W.data(), this->m_Coeff.data()); CHKERRQ(ierr);
+    ierr = VecMDot(z, k, this->m_AW.data(), caw.data()); CHKERRQ(ierr);
+    for (int i = 0; i < k; ++i) {
+        c[i] = static_cast<double>(this->m_Coeff[i]) - static_cast<double>(caw[i]);
+    }
+    ierr = CholeskySolve(this->m_E, c, k); CHKERRQ(ierr);
+    for (int i = 0; i < k; ++i) {
+        this->m_Coeff[i] = static_cast<ScalarType>(c[i]);
+    }
+
+    if (y != z) {
+        ierr = VecCopy(z, y); CHKERRQ(ierr);
+    }
+    ierr = VecMAXPY(y, k, this->m_Coeff.data(), this->m_W.data()); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief rayleigh-ritz for the preconditioned hessian on the span
+ * of the recycled and the recorded vectors; the basis is made
+ * A-orthonormal (we know A applied to all of them), so that the
+ * ritz values follow from the symmetric eigenvalue problem
+ * (AQ)^T M^{-1} (AQ) y = theta y; we keep the ritz vectors of the
+ * smallest ritz values; M is the spectral preconditioner (for all
+ * other preconditioners we use M = I, since applying them is as
+ * expensive as a krylov solve)
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::ComputeRitzVectors() {
+    PetscErrorCode ierr = 0;
+    std::vector<Vec> q, aq, unused;
+    std::vector<double> g, y, theta;
+    std::vector<ScalarType> coeff;
+    std::vector<int> idx;
+    ScalarType nrm0, nrm, c, droptol;
+    int n, k;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    droptol = std::sqrt(std::numeric_limits<ScalarType>::epsilon());
+
+    // collect basis (recycled and recorded vectors; all have been
+    // applied to the current operator)
+    std::vector<Vec> z(this->m_W), az(this->m_AW);
+    z.insert(z.end(), this->m_V.begin(), this->m_V.end());
+    az.insert(az.end(), this->m_AV.begin(), this->m_AV.end());
+    this->m_W.clear(); this->m_AW.clear();
+    this->m_V.clear(); this->m_AV.clear();
+
+    // A-orthonormalize (modified gram-schmidt)
+    for (size_t j = 0; j < z.size(); ++j) {
+        ierr = VecDot(z[j], az[j], &nrm0); CHKERRQ(ierr);
+        for (size_t i = 0; i < q.size(); ++i) {
+            ierr = VecDot(z[j], aq[i], &c); CHKERRQ(ierr);
+            ierr = VecAXPY(z[j], -c, q[i]); CHKERRQ(ierr);
+            ierr = VecAXPY(az[j], -c, aq[i]); CHKERRQ(ierr);
+        }
+        ierr = VecDot(z[j], az[j], &nrm); CHKERRQ(ierr);
+        if (nrm0 > 0.0 && nrm > droptol*nrm0) {
+            nrm = 1.0/std::sqrt(nrm);
+            ierr = VecScale(z[j], nrm); CHKERRQ(ierr);
+            ierr = VecScale(az[j], nrm); CHKERRQ(ierr);
+            q.push_back(z[j]);
+            aq.push_back(az[j]);
+        } else {
+            unused.push_back(z[j]);
+            unused.push_back(az[j]);
+        }
+    }
+
+    n = static_cast<int>(q.size());
+    k = std::min(n, this->m_NumVectors);
+
+    if (k > 0) {
+        // G = (AQ)^T M^{-1} (AQ)
+        g.assign(n*n, 0.0);
+        coeff.resize(n);
+        for (int j = 0; j < n; ++j) {
+            if (this->m_Precond != NULL && this->m_Opt->m_KrylovMethod.pctype == INVREG) {
+                ierr = this->m_Precond->MatVec(this->m_WorkVec, aq[j]); CHKERRQ(ierr);
+                ierr = VecMDot(this->m_WorkVec, n, aq.data(), coeff.data()); CHKERRQ(ierr);
+            } else {
+                ierr = VecMDot(aq[j], n, aq.data(), coeff.data()); CHKERRQ(ierr);
+            }
+            for (int i = 0; i < n; ++i) {
+                g[i*n+j] += 0.5*static_cast<double>(coeff[i]);
+                g[j*n+i] += 0.5*static_cast<double>(coeff[i]);
+            }
+        }
+        ierr = SymmetricEigen(g, y, theta, n); CHKERRQ(ierr);
+
+        // sort ritz values (ascending)
+        idx.resize(n);
+        for (int i = 0; i < n; ++i) idx[i] = i;
+        std::sort(idx.begin(), idx.end(), [&theta](int a, int b) {return theta[a] < theta[b];});
+
+        // ritz vectors W = Q y_l (the vectors that hold AQ are free now)
+        for (int l = 0; l < k; ++l) {
+            for (int i = 0; i < n; ++i) {
+                coeff[i] = static_cast<ScalarType>(y[i*n+idx[l]]);
+            }
+            ierr = VecSet(aq[l], 0.0); CHKERRQ(ierr);
+            ierr = VecMAXPY(aq[l], n, coeff.data(), q.data()); CHKERRQ(ierr);
+            this->m_W.push_back(aq[l]);
+            this->m_AW.push_back(NULL);
+        }
+
+        if (this->m_Opt->m_Verbosity > 1) {
+            ss << "recycling " << k << " ritz vectors (ritz values in ["
+               << std::scientific << theta[idx[0]] << "," << theta[idx[k-1]] << "])";
+            ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+        }
+    }
+
+    // return unused vectors to pool
+    for (int i = 0; i < n; ++i) {
+        ierr = this->ReturnVector(q[i]); CHKERRQ(ierr);
+        if (i >= k) {
+            ierr = this->ReturnVector(aq[i]); CHKERRQ(ierr);
+        }
+    }
+    for (size_t i = 0; i < unused.size(); ++i) {
+        ierr = this->ReturnVector(unused[i]); CHKERRQ(ierr);
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief cholesky factorization of dense symmetric matrix (in place;
+ * lower triangle, row major)
+ * @param[in,out] a matrix/factor
+ * @param[in] n size of matrix
+ * @param[out] spd flag: matrix is positive definite
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::Cholesky(std::vector<double>& a, int n, bool& spd) {
+    PetscErrorCode ierr = 0;
+    double s;
+    PetscFunctionBegin;
+
+    spd = true;
+    for (int j = 0; j < n && spd; ++j) {
+        s = a[j*n+j];
+        for (int l = 0; l < j; ++l) s -= a[j*n+l]*a[j*n+l];
+        if (s <= 0.0) {
+            spd = false;
+            break;
+        }
+        a[j*n+j] = std::sqrt(s);
+        for (int i = j+1; i < n; ++i) {
+            s = a[i*n+j];
+            for (int l = 0; l < j; ++l) s -= a[i*n+l]*a[j*n+l];
+            a[i*n+j] = s/a[j*n+j];
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief solve L L^T x = b (factor computed by Cholesky)
+ * @param[in] l cholesky factor
+ * @param[in,out] b right hand side/solution
+ * @param[in] n size of system
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::CholeskySolve(const std::vector<double>& l, std::vector<double>& b, int n) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < i; ++j) b[i] -= l[i*n+j]*b[j];
+        b[i] /= l[i*n+i];
+    }
+    for (int i = n-1; i >= 0; --i) {
+        for (int j = i+1; j < n; ++j) b[i] -= l[j*n+i]*b[j];
+        b[i] /= l[i*n+i];
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief eigenvalues and eigenvectors of a small dense symmetric
+ * matrix (cyclic jacobi method)
+ * @param[in,out] a matrix (row major; destroyed)
+ * @param[out] v eigenvectors (columns; row major)
+ * @param[out] w eigenvalues
+ * @param[in] n size of matrix
+ *******************************************************************/
+PetscErrorCode KrylovRecycler::SymmetricEigen(std::vector<double>& a, std::vector<double>& v,
+                                              std::vector<double>& w, int n) {
+    PetscErrorCode ierr = 0;
+    double off, nrm, theta, t, c, s, x, y;
+    PetscFunctionBegin;
+
+    v.assign(n*n, 0.0);
+    for (int i = 0; i < n; ++i) v[i*n+i] = 1.0;
+
+    nrm = 0.0;
+    for (int i = 0; i < n*n; ++i) nrm += a[i]*a[i];
+
+    for (int sweep = 0; sweep < 100; ++sweep) {
+        off = 0.0;
+        for (int p = 0; p < n; ++p) {
+            for (int q = p+1; q < n; ++q) off += a[p*n+q]*a[p*n+q];
+        }
+        if (off <= 1E-28*nrm) break;
+
+        for (int p = 0; p < n; ++p) {
+            for (int q = p+1; q < n; ++q) {
+                if (a[p*n+q] == 0.0) continue;
+                // rotation that annihilates a_pq
+                theta = (a[q*n+q] - a[p*n+p])/(2.0*a[p*n+q]);
+                t = (theta >= 0.0 ? 1.0 : -1.0)/(std::abs(theta) + std::sqrt(theta*theta + 1.0));
+                c = 1.0/std::sqrt(t*t + 1.0);
+                s = t*c;
+                for (int l = 0; l < n; ++l) {
+                    x = a[l*n+p]; y = a[l*n+q];
+                    a[l*n+p] = c*x - s*y;
+                    a[l*n+q] = s*x + c*y;
+                }
+                for (int l = 0; l < n; ++l) {
+                    x = a[p*n+l]; y = a[q*n+l];
+                    a[p*n+l] = c*x - s*y;
+                    a[q*n+l] = s*x + c*y;
+                }
+                for (int l = 0; l < n; ++l) {
+                    x = v[l*n+p]; y = v[l*n+q];
+                    v[l*n+p] = c*x - s*y;
+                    v[l*n+q] = s*x + c*y;
+                }
+            }
+        }
+    }
+
+    w.resize(n);
+    for (int i = 0; i < n; ++i) w[i] = a[i*n+i];
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _KRYLOVRECYCLER_CPP_
@@ -174,7 +174,7 @@ PetscErrorCode OptimizationProblem::DerivativeCheckGradient() {
     ng = this->m_Opt->m_Domain.ng;
 
     // create an extra array for initial guess (has to be flat for optimizer)
-    ierr = VecCreate(PETSC_COMM_WORLD, &v); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, &v); CHKERRQ(ierr);
     ierr = VecSetSizes(v, 3*nl, 3*ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(v); CHKERRQ(ierr);
     ierr = VecSet(v, 0.0); CHKERRQ(ierr);
@@ -184,7 +184,7 @@ PetscErrorCode OptimizationProblem::DerivativeCheckGradient() {
     ierr = VecDuplicate(v, &w); CHKERRQ(ierr);
 
     // create random vectors
-    ierr = PetscRandomCreate(PETSC_COMM_WORLD, &rctx); CHKERRQ(ierr);
+    ierr = PetscRandomCreate(this->m_Opt->m_Comm, &rctx); CHKERRQ(ierr);
     ierr = PetscRandomSetFromOptions(rctx); CHKERRQ(ierr);
     ierr = VecSetRandom(v, rctx); CHKERRQ(ierr);
     ierr = VecSetRandom(w, rctx); CHKERRQ(ierr);
@@ -239,6 +239,27 @@ PetscErrorCode OptimizationProblem::DerivativeCheckGradient() {
 
 
 
+/********************************************************************
+ * @brief apply hessian to a block of k vectors; the default is to
+ * apply the hessian to one vector at a time (derived classes can
+ * share the work across the vectors of the block)
+ * @param[in] x block of vectors
+ * @param[in] k number of vectors
+ * @param[out] Hx hessian applied to vectors
+ *******************************************************************/
+PetscErrorCode OptimizationProblem::HessianMatVecBlock(Vec* Hx, Vec* x, IntType k, bool scale) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    for (IntType i = 0; i < k; ++i) {
+        ierr = this->HessianMatVec(Hx[i], x[i], scale); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
 /********************************************************************
  * @brief check gradient based on a taylor expansion
  *******************************************************************/
@@ -262,7 +283,7 @@ PetscErrorCode OptimizationProblem::DerivativeCheckHessian() {
     ng = this->m_Opt->m_Domain.ng;
 
     // create an extra array for initial guess (has to be flat for optimizer)
-    ierr = VecCreate(PETSC_COMM_WORLD, &v); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, &v); CHKERRQ(ierr);
     ierr = VecSetSizes(v, 3*nl, 3*ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(v); CHKERRQ(ierr);
     ierr = VecSet(v, 0.0); CHKERRQ(ierr);
@@ -273,7 +294,7 @@ PetscErrorCode OptimizationProblem::DerivativeCheckHessian() {
     ierr = VecDuplicate(v, &hvtilde); CHKERRQ(ierr);
 
     // create random vectors
-    ierr = PetscRandomCreate(PETSC_COMM_WORLD, &rctx); CHKERRQ(ierr);
+    ierr = PetscRandomCreate(this->m_Opt->m_Comm, &rctx); CHKERRQ(ierr);
     ierr = PetscRandomSetFromOptions(rctx); CHKERRQ(ierr);
     ierr = VecSetRandom(v, rctx); CHKERRQ(ierr);
     ierr = VecSetRandom(w, rctx); CHKERRQ(ierr);
@@ -356,7 +377,7 @@ PetscErrorCode OptimizationProblem::DerivativeCheckHessianFD() {
     ng = this->m_Opt->m_Domain.ng;
 
     // create an extra array for initial guess (has to be flat for optimizer)
-    ierr = VecCreate(PETSC_COMM_WORLD, &v); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, &v); CHKERRQ(ierr);
     ierr = VecSetSizes(v, 3*nl, 3*ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(v); CHKERRQ(ierr);
     ierr = VecSet(v, 0.0); CHKERRQ(ierr);
@@ -369,7 +390,7 @@ PetscErrorCode OptimizationProblem::DerivativeCheckHessianFD() {
     ierr = VecDuplicate(v, &delta); CHKERRQ(ierr);
 
     // create random vectors
-    ierr = PetscRandomCreate(PETSC_COMM_WORLD, &rctx); CHKERRQ(ierr);
+    ierr = PetscRandomCreate(this->m_Opt->m_Comm, &rctx); CHKERRQ(ierr);
     ierr = PetscRandomSetFromOptions(rctx); CHKERRQ(ierr);
     ierr = VecSetRandom(v, rctx); CHKERRQ(ierr);
     ierr = VecSetRandom(w, rctx); CHKERRQ(ierr);
@@ -433,14 +454,14 @@ PetscErrorCode OptimizationProblem::DerivativeCheckHessianFD() {
 /********************************************************************
  * @brief check symmetry of hessian
  * the idea is to use the identity
- *   \langle A x, A x \rangle = \langle A^T*Ax, x \rangle
- * for the inner product
+ *   \langle A x, y \rangle = \langle x, A y \rangle
+ * for two random vectors x and y (both matvecs are applied as a block)
  *******************************************************************/
 PetscErrorCode OptimizationProblem::HessianSymmetryCheck() {
     PetscErrorCode ierr = 0;
     IntType nl, ng;
-    Vec v = NULL, Hv = NULL, HHv = NULL;
-    ScalarType HvHv, HHvv, symerr, relsymerr, normHv;
+    Vec v[2] = {NULL, NULL}, Hv[2] = {NULL, NULL};
+    ScalarType Hvw, vHw, symerr, relsymerr, normHv;
     std::string msg;
     std::stringstream sserr, ssrelerr;
     PetscRandom rctx;
@@ -451,24 +472,25 @@ PetscErrorCode OptimizationProblem::HessianSymmetryCheck() {
     ng = this->m_Opt->m_Domain.ng;
 
     // create arrays
-    ierr = VecCreate(v, 3*nl, 3*ng); CHKERRQ(ierr);
-    ierr = VecDuplicate(v, &Hv); CHKERRQ(ierr);
-    ierr = VecDuplicate(v, &HHv); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, v[0], 3*nl, 3*ng, 3); CHKERRQ(ierr);
+    ierr = VecDuplicate(v[0], &v[1]); CHKERRQ(ierr);
+    ierr = VecDuplicate(v[0], &Hv[0]); CHKERRQ(ierr);
+    ierr = VecDuplicate(v[0], &Hv[1]); CHKERRQ(ierr);
 
     // create random vectors
-    ierr = PetscRandomCreate(PETSC_COMM_WORLD, &rctx); CHKERRQ(ierr);
+    ierr = PetscRandomCreate(this->m_Opt->m_Comm, &rctx); CHKERRQ(ierr);
     ierr = PetscRandomSetFromOptions(rctx); CHKERRQ(ierr);
-    ierr = VecSetRandom(v, rctx); CHKERRQ(ierr);
+    ierr = VecSetRandom(v[0], rctx); CHKERRQ(ierr);
+    ierr = VecSetRandom(v[1], rctx); CHKERRQ(ierr);
 
-    // apply hessian to vector field
-    ierr = this->HessianMatVec(Hv, v); CHKERRQ(ierr);
-    ierr = this->HessianMatVec(HHv, Hv); CHKERRQ(ierr);
+    // apply hessian to both vector fields
+    ierr = this->HessianMatVecBlock(Hv, v, 2); CHKERRQ(ierr);
 
-    ierr = VecTDot(Hv, Hv, &HvHv); CHKERRQ(ierr);
-    ierr = VecTDot(HHv, v, &HHvv); CHKERRQ(ierr);
-    ierr = VecNorm(Hv, NORM_2, &normHv); CHKERRQ(ierr);
+    ierr = VecTDot(Hv[0], v[1], &Hvw); CHKERRQ(ierr);
+    ierr = VecTDot(v[0], Hv[1], &vHw); CHKERRQ(ierr);
+    ierr = VecNorm(Hv[0], NORM_2, &normHv); CHKERRQ(ierr);
 
-    symerr = std::abs(HvHv-HHvv);
+    symerr = std::abs(Hvw-vHw);
     relsymerr = symerr/normHv;
 
     sserr << symerr;
@@ -478,9 +500,12 @@ PetscErrorCode OptimizationProblem::HessianSymmetryCheck() {
 
     ierr = DbgMsg(msg); CHKERRQ(ierr);
 
-    if (v != NULL) {ierr = VecDestroy(&v); CHKERRQ(ierr);v = NULL;}
-    if (Hv != NULL) {ierr = VecDestroy(&Hv); CHKERRQ(ierr); Hv = NULL;}
-    if (HHv != NULL) {ierr = VecDestroy(&HHv); CHKERRQ(ierr); HHv = NULL;}
+    for (int i = 0; i < 2; ++i) {
+        if (v[i] != NULL) {ierr = VecDestroy(&v[i]); CHKERRQ(ierr); v[i] = NULL;}
+        if (Hv[i] != NULL) {ierr = VecDestroy(&Hv[i]); CHKERRQ(ierr); Hv[i] = NULL;}
+    }
+    if (rctx != NULL) {ierr = PetscRandomDestroy(&rctx); CHKERRQ(ierr); rctx = NULL;}
+
     PetscFunctionReturn(ierr);
 }
 
@@ -75,11 +75,17 @@ PetscErrorCode Optimizer::Initialize(void) {
 
     this->m_Tao = NULL;
     this->m_Precond = NULL;
+    this->m_Recycler = NULL;
 
     this->m_MatVec = NULL;
     this->m_PreProc = NULL;
     this->m_Solution = NULL;
 
+    this->m_Gradient = NULL;
+    this->m_Step = NULL;
+    this->m_Trial = NULL;
+    this->m_ConvergedReason = TAO_CONTINUE_ITERATING;
+
     this->m_KrylovMethod = NULL;
     this->m_OptimizationProblem = NULL;
 
@@ -96,11 +102,14 @@ PetscErrorCode Optimizer::ClearMemory(void) {
     PetscErrorCode ierr = 0;
     PetscFunctionBegin;
 
-    // clean up tao
+    // clean up tao (owns the krylov method)
     if (this->m_Tao != NULL) {
         ierr = TaoDestroy(&this->m_Tao); CHKERRQ(ierr);
         this->m_Tao = NULL;
+    } else if (this->m_KrylovMethod != NULL) {
+        ierr = KSPDestroy(&this->m_KrylovMethod); CHKERRQ(ierr);
     }
+    this->m_KrylovMethod = NULL;
 
     // delete solution vector
     if (this->m_Solution != NULL) {
@@ -108,11 +117,29 @@ PetscErrorCode Optimizer::ClearMemory(void) {
         this->m_Solution = NULL;
     }
 
+    if (this->m_Gradient != NULL) {
+        ierr = VecDestroy(&this->m_Gradient); CHKERRQ(ierr);
+        this->m_Gradient = NULL;
+    }
+    if (this->m_Step != NULL) {
+        ierr = VecDestroy(&this->m_Step); CHKERRQ(ierr);
+        this->m_Step = NULL;
+    }
+    if (this->m_Trial != NULL) {
+        ierr = VecDestroy(&this->m_Trial); CHKERRQ(ierr);
+        this->m_Trial = NULL;
+    }
+
     if (this->m_MatVec != NULL) {
         ierr = MatDestroy(&this->m_MatVec); CHKERRQ(ierr);
         this->m_MatVec = NULL;
     }
 
+    if (this->m_Recycler != NULL) {
+        delete this->m_Recycler;
+        this->m_Recycler = NULL;
+    }
+
     PetscFunctionReturn(ierr);
 }
 
@@ -135,7 +162,7 @@ PetscErrorCode Optimizer::SetInitialGuess(VecField* x) {
         // compute number of unknowns
         nlu = 3*this->m_Opt->m_Domain.nl;
         ngu = 3*this->m_Opt->m_Domain.ng;
-        ierr = VecCreate(this->m_Solution, nlu, ngu); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_Solution, nlu, ngu); CHKERRQ(ierr);
         ierr = VecSet(this->m_Solution, 0.0); CHKERRQ(ierr);
     }
 
@@ -158,7 +185,8 @@ PetscErrorCode Optimizer::SetInitialGuess(VecField* x) {
 
 
 /********************************************************************
- * @brief parse initial guess to tao
+ * @brief parse initial guess to tao (the native newton-krylov
+ * driver iterates on the solution vector in place)
  *******************************************************************/
 PetscErrorCode Optimizer::SetInitialGuess() {
     PetscErrorCode ierr = 0;
@@ -167,18 +195,18 @@ PetscErrorCode Optimizer::SetInitialGuess() {
     PetscFunctionBegin;
     this->m_Opt->Enter(__func__);
 
-    // check if tao has been set up
-    ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
-
     if (this->m_Solution == NULL) {
         nlu = 3*this->m_Opt->m_Domain.nl;
         ngu = 3*this->m_Opt->m_Domain.ng;
-        ierr = VecCreate(this->m_Solution, nlu, ngu); CHKERRQ(ierr);
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_Solution, nlu, ngu); CHKERRQ(ierr);
         ierr = VecSet(this->m_Solution, 0.0); CHKERRQ(ierr);
     }
 
     // parse initial guess to tao
-    ierr = TaoSetInitialVector(this->m_Tao, this->m_Solution); CHKERRQ(ierr);
+    if (!this->m_Opt->m_OptPara.nativenewton) {
+        ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
+        ierr = TaoSetInitialVector(this->m_Tao, this->m_Solution); CHKERRQ(ierr);
+    }
 
     this->m_Opt->Exit(__func__);
 
@@ -234,21 +262,14 @@ PetscErrorCode Optimizer::SetPreconditioner(Preconditioner* precond) {
  *******************************************************************/
 PetscErrorCode Optimizer::SetupTao() {
     PetscErrorCode ierr = 0;
-    IntType nlu, ngu;
-    ScalarType gatol, grtol, gttol, reltol, abstol, divtol;
-    IntType maxit;
+    ScalarType gatol, grtol, gttol;
     void* optprob;
-    PC preconditioner;
     TaoLineSearch linesearch;
     PetscFunctionBegin;
     this->m_Opt->Enter(__func__);
 
     ierr = Assert(this->m_OptimizationProblem !=NULL, "optimization problem not set"); CHKERRQ(ierr);
 
-    // compute the number of unknowns
-    nlu = 3*this->m_Opt->m_Domain.nl;
-    ngu = 3*this->m_Opt->m_Domain.ng;
-
     // if tao exists, kill it
     if (this->m_Tao != NULL) {
         ierr = TaoDestroy(&this->m_Tao); CHKERRQ(ierr);
@@ -256,7 +277,7 @@ PetscErrorCode Optimizer::SetupTao() {
     }
 
     std::string method = "nls";
-    ierr = TaoCreate(PETSC_COMM_WORLD, &this->m_Tao); CHKERRQ(ierr);
+    ierr = TaoCreate(this->m_Opt->m_Comm, &this->m_Tao); CHKERRQ(ierr);
     ierr = TaoSetType(this->m_Tao, "nls"); CHKERRQ(ierr);
 
     // get the ksp of the optimizer and set options
@@ -296,67 +317,11 @@ PetscErrorCode Optimizer::SetupTao() {
 #endif
             ierr = TaoSetFromOptions(this->m_Tao); CHKERRQ(ierr);
         }
-
-        // set tolerances for krylov subspace method
-        reltol = this->m_Opt->m_KrylovMethod.tol[0];     // 1E-12;
-        abstol = this->m_Opt->m_KrylovMethod.tol[1];     // 1E-12;
-        divtol = this->m_Opt->m_KrylovMethod.tol[2];     // 1E+06;
-        maxit  = this->m_Opt->m_KrylovMethod.maxiter;    // 1000;
-        maxit  = std::max(static_cast<IntType>(0), maxit-1);
-        ierr = KSPSetTolerances(this->m_KrylovMethod, reltol, abstol, divtol, maxit); CHKERRQ(ierr);
-        ierr = KSPSetInitialGuessNonzero(this->m_KrylovMethod, PETSC_FALSE); CHKERRQ(ierr);
-//        ierr = KSPSetInitialGuessNonzero(this->m_KrylovMethod, PETSC_TRUE); CHKERRQ(ierr);
-
-        // KSP_NORM_UNPRECONDITIONED unpreconditioned norm: ||b-Ax||_2)
-        // KSP_NORM_PRECONDITIONED   preconditioned norm: ||P(b-Ax)||_2)
-        // KSP_NORM_NATURAL          natural norm: sqrt((b-A*x)*P*(b-A*x))
-        ierr = KSPSetNormType(this->m_KrylovMethod, KSP_NORM_UNPRECONDITIONED); CHKERRQ(ierr);
-//        ierr = KSPSetNormType(this->m_KrylovMethod,KSP_NORM_PRECONDITIONED); CHKERRQ(ierr);
-//        ierr = KSPSetNormType(this->m_KrylovMethod,KSP_NORM_NATURAL); CHKERRQ(ierr);
-
-        // set the kylov method
-        if (this->m_Opt->m_KrylovMethod.solver == GMRES) {
-            ierr = KSPSetType(this->m_KrylovMethod, KSPGMRES); CHKERRQ(ierr);
-        } else if (this->m_Opt->m_KrylovMethod.solver == PCG) {
-            ierr = KSPSetType(this->m_KrylovMethod, KSPCG); CHKERRQ(ierr);
-        } else if (this->m_Opt->m_KrylovMethod.solver == FCG) {
-            ierr = KSPSetType(this->m_KrylovMethod, KSPFCG); CHKERRQ(ierr);
-        } else if (this->m_Opt->m_KrylovMethod.solver == FGMRES) {
-            ierr = KSPSetType(this->m_KrylovMethod, KSPFGMRES); CHKERRQ(ierr);
-        } else {
-            ierr = ThrowError("interface for solver not provided"); CHKERRQ(ierr);
-        }
-
-        // apply projection operator to gradient and
-        // solution if needed (two-level preconditioner)
-        ierr = KSPSetPostSolve(this->m_KrylovMethod, PostKrylovSolve, this->m_OptimizationProblem); CHKERRQ(ierr);
-        ierr = KSPSetPreSolve(this->m_KrylovMethod, PreKrylovSolve, this->m_OptimizationProblem); CHKERRQ(ierr);
-
-        // set krylov monitor
-        if (this->m_Opt->m_Verbosity > 0) {  /// || (this->m_Opt->GetLogger()->IsEnabled(LOGKSPRES))) {
-            ierr = KSPMonitorSet(this->m_KrylovMethod, KrylovMonitor, this->m_OptimizationProblem, NULL); CHKERRQ(ierr);
-        }
-
-        // set the preconditioner
-        ierr = KSPGetPC(this->m_KrylovMethod, &preconditioner); CHKERRQ(ierr);
-        ierr = KSPSetFromOptions(this->m_KrylovMethod); CHKERRQ(ierr);
-
-        // switch between different preconditioners
-        if (this->m_Opt->m_KrylovMethod.pctype == NOPC) {
-            ierr = PCSetType(preconditioner, PCNONE); CHKERRQ(ierr);
-        } else {
-            ierr = Assert(this->m_Precond != NULL, "null pointer"); CHKERRQ(ierr);
-
-            // we have to create a shell object for the preconditioner,
-            // since our solver is matrix free
-            ierr = PCSetType(preconditioner, PCSHELL); CHKERRQ(ierr);
-            ierr = PCShellSetApply(preconditioner, PrecondMatVec); CHKERRQ(ierr);
-            ierr = PCShellSetContext(preconditioner, this->m_Precond); CHKERRQ(ierr);
-//            ierr = PCShellSetName(taokktpc,"kktpc"); CHKERRQ(ierr);
-//            ierr = PCShellSetSetUp(preconditioner, PrecondSetup); CHKERRQ(ierr);
-        }
     }
 
+    // set up krylov method, preconditioner, and hessian matvec
+    ierr = this->SetupKrylovMethod(); CHKERRQ(ierr);
+
     optprob = reinterpret_cast<void*>(this->m_OptimizationProblem);
 
     // set the routine to evaluate the objective and compute the gradient
@@ -431,9 +396,6 @@ PetscErrorCode Optimizer::SetupTao() {
     ierr = TaoSetMaximumIterations(this->m_Tao, this->m_Opt->m_OptPara.maxiter-1); CHKERRQ(ierr);
     ierr = TaoSetFunctionLowerBound(this->m_Tao, 1E-6); CHKERRQ(ierr);
 
-    ierr = MatCreateShell(PETSC_COMM_WORLD, nlu, nlu, ngu, ngu, optprob, &this->m_MatVec); CHKERRQ(ierr);
-    ierr = MatShellSetOperation(this->m_MatVec, MATOP_MULT, (void(*)(void))HessianMatVec); CHKERRQ(ierr);
-    ierr = MatSetOption(this->m_MatVec, MAT_SYMMETRIC, PETSC_TRUE); CHKERRQ(ierr);
     ierr = TaoSetHessianRoutine(this->m_Tao, this->m_MatVec, this->m_MatVec, EvaluateHessian, optprob); CHKERRQ(ierr);
 
     this->m_Opt->Exit(__func__);
@@ -443,6 +405,144 @@ PetscErrorCode Optimizer::SetupTao() {
 
 
 
+/********************************************************************
+ * @brief set up the krylov subspace method for the hessian system
+ * (tolerances, pre/postprocessing, preconditioner) and the matrix
+ * free hessian matvec; the krylov method is either owned by tao or
+ * by the native newton-krylov driver
+ *******************************************************************/
+PetscErrorCode Optimizer::SetupKrylovMethod() {
+    PetscErrorCode ierr = 0;
+    IntType nlu, ngu;
+    ScalarType reltol, abstol, divtol;
+    IntType maxit;
+    PC preconditioner;
+    bool recycle;
+    PetscFunctionBegin;
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(this->m_OptimizationProblem != NULL, "optimization problem not set"); CHKERRQ(ierr);
+
+    // recycling of krylov subspace/warm start of hessian solves; the
+    // lbfgs preconditioner also needs the recorded hessian matvecs
+    recycle = this->m_Opt->m_KrylovMethod.nrecycle > 0
+           || this->m_Opt->m_KrylovMethod.pctype == INVREGLBFGS;
+    if ((recycle || this->m_Opt->m_KrylovMethod.warmstart) && this->m_Recycler == NULL) {
+        try {this->m_Recycler = new KrylovRecycler(this->m_Opt);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_Recycler != NULL) {
+        ierr = this->m_Recycler->SetProblem(this->m_OptimizationProblem); CHKERRQ(ierr);
+        if (this->m_Opt->m_KrylovMethod.pctype != NOPC) {
+            ierr = this->m_Recycler->SetPreconditioner(this->m_Precond); CHKERRQ(ierr);
+        }
+    }
+
+    // compute the number of unknowns
+    nlu = 3*this->m_Opt->m_Domain.nl;
+    ngu = 3*this->m_Opt->m_Domain.ng;
+
+    // ksp is only nonzero if we use a newton type method
+    if (this->m_KrylovMethod != NULL) {
+        // set tolerances for krylov subspace method
+        reltol = this->m_Opt->m_KrylovMethod.tol[0];     // 1E-12;
+        abstol = this->m_Opt->m_KrylovMethod.tol[1];     // 1E-12;
+        divtol = this->m_Opt->m_KrylovMethod.tol[2];     // 1E+06;
+        maxit  = this->m_Opt->m_KrylovMethod.maxiter;    // 1000;
+        maxit  = std::max(static_cast<IntType>(0), maxit-1);
+        ierr = KSPSetTolerances(this->m_KrylovMethod, reltol, abstol, divtol, maxit); CHKERRQ(ierr);
+        if (this->m_Recycler != NULL) {
+            // initial guess is set by the recycler
+            ierr = KSPSetInitialGuessNonzero(this->m_KrylovMethod, PETSC_TRUE); CHKERRQ(ierr);
+        } else {
+            ierr = KSPSetInitialGuessNonzero(this->m_KrylovMethod, PETSC_FALSE); CHKERRQ(ierr);
+        }
+
+        // KSP_NORM_UNPRECONDITIONED unpreconditioned norm: ||b-Ax||_2)
+        // KSP_NORM_PRECONDITIONED   preconditioned norm: ||P(b-Ax)||_2)
+        // KSP_NORM_NATURAL          natural norm: sqrt((b-A*x)*P*(b-A*x))
+        ierr = KSPSetNormType(this->m_KrylovMethod, KSP_NORM_UNPRECONDITIONED); CHKERRQ(ierr);
+//        ierr = KSPSetNormType(this->m_KrylovMethod,KSP_NORM_PRECONDITIONED); CHKERRQ(ierr);
+//        ierr = KSPSetNormType(this->m_KrylovMethod,KSP_NORM_NATURAL); CHKERRQ(ierr);
+
+        // set the kylov method
+        if (this->m_Opt->m_KrylovMethod.solver == GMRES) {
+            ierr = KSPSetType(this->m_KrylovMethod, KSPGMRES); CHKERRQ(ierr);
+        } else if (this->m_Opt->m_KrylovMethod.solver == PCG) {
+            ierr = KSPSetType(this->m_KrylovMethod, KSPCG); CHKERRQ(ierr);
+        } else if (this->m_Opt->m_KrylovMethod.solver == FCG) {
+            ierr = KSPSetType(this->m_KrylovMethod, KSPFCG); CHKERRQ(ierr);
+        } else if (this->m_Opt->m_KrylovMethod.solver == FGMRES) {
+            ierr = KSPSetType(this->m_KrylovMethod, KSPFGMRES); CHKERRQ(ierr);
+        } else {
+            ierr = ThrowError("interface for solver not provided"); CHKERRQ(ierr);
+        }
+
+        // apply projection operator to gradient and
+        // solution if needed (two-level preconditioner)
+        if (this->m_Recycler != NULL) {
+            ierr = KSPSetPostSolve(this->m_KrylovMethod, RecycledPostKrylovSolve, this->m_Recycler); CHKERRQ(ierr);
+            ierr = KSPSetPreSolve(this->m_KrylovMethod, RecycledPreKrylovSolve, this->m_Recycler); CHKERRQ(ierr);
+        } else {
+            ierr = KSPSetPostSolve(this->m_KrylovMethod, PostKrylovSolve, this->m_OptimizationProblem); CHKERRQ(ierr);
+            ierr = KSPSetPreSolve(this->m_KrylovMethod, PreKrylovSolve, this->m_OptimizationProblem); CHKERRQ(ierr);
+        }
+
+        // set krylov monitor
+        if (this->m_Opt->m_Verbosity > 0) {  /// || (this->m_Opt->GetLogger()->IsEnabled(LOGKSPRES))) {
+            ierr = KSPMonitorSet(this->m_KrylovMethod, KrylovMonitor, this->m_OptimizationProblem, NULL); CHKERRQ(ierr);
+        }
+
+        // set the preconditioner
+        ierr = KSPGetPC(this->m_KrylovMethod, &preconditioner); CHKERRQ(ierr);
+        ierr = KSPSetFromOptions(this->m_KrylovMethod); CHKERRQ(ierr);
+
+        // switch between different preconditioners
+        if (recycle) {
+            // deflated preconditioner (wraps the preconditioner set by the user)
+            ierr = PCSetType(preconditioner, PCSHELL); CHKERRQ(ierr);
+            ierr = PCShellSetApply(preconditioner, RecycledPrecondMatVec); CHKERRQ(ierr);
+            ierr = PCShellSetContext(preconditioner, this->m_Recycler); CHKERRQ(ierr);
+        } else if (this->m_Opt->m_KrylovMethod.pctype == NOPC) {
+            ierr = PCSetType(preconditioner, PCNONE); CHKERRQ(ierr);
+        } else {
+            ierr = Assert(this->m_Precond != NULL, "null pointer"); CHKERRQ(ierr);
+
+            // we have to create a shell object for the preconditioner,
+            // since our solver is matrix free
+            ierr = PCSetType(preconditioner, PCSHELL); CHKERRQ(ierr);
+            ierr = PCShellSetApply(preconditioner, PrecondMatVec); CHKERRQ(ierr);
+            ierr = PCShellSetContext(preconditioner, this->m_Precond); CHKERRQ(ierr);
+//            ierr = PCShellSetName(taokktpc,"kktpc"); CHKERRQ(ierr);
+//            ierr = PCShellSetSetUp(preconditioner, PrecondSetup); CHKERRQ(ierr);
+        }
+    }
+
+    if (this->m_MatVec != NULL) {
+        ierr = MatDestroy(&this->m_MatVec); CHKERRQ(ierr);
+        this->m_MatVec = NULL;
+    }
+
+    if (recycle) {
+        // hessian matvecs are recorded to update the recycled space
+        // (and the secant pairs of the lbfgs preconditioner)
+        ierr = MatCreateShell(this->m_Opt->m_Comm, nlu, nlu, ngu, ngu, this->m_Recycler, &this->m_MatVec); CHKERRQ(ierr);
+        ierr = MatShellSetOperation(this->m_MatVec, MATOP_MULT, (void(*)(void))RecycledHessianMatVec); CHKERRQ(ierr);
+    } else {
+        ierr = MatCreateShell(this->m_Opt->m_Comm, nlu, nlu, ngu, ngu, this->m_OptimizationProblem, &this->m_MatVec); CHKERRQ(ierr);
+        ierr = MatShellSetOperation(this->m_MatVec, MATOP_MULT, (void(*)(void))HessianMatVec); CHKERRQ(ierr);
+    }
+    ierr = MatSetOption(this->m_MatVec, MAT_SYMMETRIC, PETSC_TRUE); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief run the optimizer (main interface; calls specific functions
  * according to user settings (parameter continuation, grid
@@ -462,10 +562,16 @@ PetscErrorCode Optimizer::Run(bool presolve) {
     ierr = Assert(this->m_OptimizationProblem != NULL, "null pointer"); CHKERRQ(ierr);
 
     // do setup
-    if (this->m_Tao == NULL) {
-        ierr = this->SetupTao(); CHKERRQ(ierr);
+    if (this->m_Opt->m_OptPara.nativenewton) {
+        if (this->m_KrylovMethod == NULL) {
+            ierr = this->SetupNewtonKrylov(); CHKERRQ(ierr);
+        }
+    } else {
+        if (this->m_Tao == NULL) {
+            ierr = this->SetupTao(); CHKERRQ(ierr);
+        }
+        ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
     }
-    ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
 
     // modify tolerance if requestged ||g(x)|| / ||g(x0)|| <= gttol
     if (presolve) {
@@ -481,18 +587,20 @@ PetscErrorCode Optimizer::Run(bool presolve) {
         maxit = this->m_Opt->m_OptPara.maxiter;
     }
 
-    // set tolerance
+    // set initial guess
+    ierr = this->SetInitialGuess(); CHKERRQ(ierr);
+
+    if (!this->m_Opt->m_OptPara.nativenewton) {
+        // set tolerance
 #if (PETSC_VERSION_MAJOR >= 3) && (PETSC_VERSION_MINOR >= 7)
-    ierr = TaoSetTolerances(this->m_Tao, PETSC_DEFAULT, PETSC_DEFAULT, gtol); CHKERRQ(ierr);
+        ierr = TaoSetTolerances(this->m_Tao, PETSC_DEFAULT, PETSC_DEFAULT, gtol); CHKERRQ(ierr);
 #else
-    ierr = TaoSetTolerances(this->m_Tao, PETSC_DEFAULT, PETSC_DEFAULT,
-                                         PETSC_DEFAULT, PETSC_DEFAULT, gtol); CHKERRQ(ierr);
+        ierr = TaoSetTolerances(this->m_Tao, PETSC_DEFAULT, PETSC_DEFAULT,
+                                             PETSC_DEFAULT, PETSC_DEFAULT, gtol); CHKERRQ(ierr);
 #endif
-    ierr = TaoSetMaximumIterations(this->m_Tao, maxit-1); CHKERRQ(ierr);
-
-    // set initial guess
-    ierr = this->SetInitialGuess(); CHKERRQ(ierr);
-    ierr = TaoSetUp(this->m_Tao); CHKERRQ(ierr);
+        ierr = TaoSetMaximumIterations(this->m_Tao, maxit-1); CHKERRQ(ierr);
+        ierr = TaoSetUp(this->m_Tao); CHKERRQ(ierr);
+    }
 
     if (this->m_Opt->m_KrylovMethod.pctype != NOPC) {
         // in case we call the optimizer/solver several times
@@ -500,27 +608,210 @@ PetscErrorCode Optimizer::Run(bool presolve) {
         ierr = this->m_Precond->Reset(); CHKERRQ(ierr);
     }
 
+    if (this->m_Recycler != NULL) {
+        // the operator changes between runs (regularization parameter or
+        // grid level); discard the warm start and the recycled subspace
+        ierr = this->m_Recycler->Reset(); CHKERRQ(ierr);
+    }
+
     // solve optimization problem
-    ierr = this->m_Opt->StartTimer(T2SEXEC); CHKERRQ(ierr);
-    ierr = TaoSolve(this->m_Tao); CHKERRQ(ierr);
-    ierr = this->m_Opt->StopTimer(T2SEXEC); CHKERRQ(ierr);
+    if (this->m_Opt->m_OptPara.nativenewton) {
+        // the solution is updated in place
+        ierr = this->m_Opt->StartTimer(T2SEXEC); CHKERRQ(ierr);
+        ierr = this->RunNewtonKrylov(gtol, maxit); CHKERRQ(ierr);
+        ierr = this->m_Opt->StopTimer(T2SEXEC); CHKERRQ(ierr);
+    } else {
+        ierr = this->m_Opt->StartTimer(T2SEXEC); CHKERRQ(ierr);
+        ierr = TaoSolve(this->m_Tao); CHKERRQ(ierr);
+        ierr = this->m_Opt->StopTimer(T2SEXEC); CHKERRQ(ierr);
+
+        // get solution
+        ierr = TaoGetSolutionVector(this->m_Tao, &x); CHKERRQ(ierr);
+
+        // copy solution into place holder
+        ierr = VecCopy(x, this->m_Solution); CHKERRQ(ierr);
+
+        // if we did not converge, we should display what's going on
+        if (!this->m_OptimizationProblem->Converged()) {
+            ierr = OptimizationMonitor(this->m_Tao, this->m_OptimizationProblem); CHKERRQ(ierr);
+        }
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(0);
+}
+
 
-    // get solution
-    ierr = TaoGetSolutionVector(this->m_Tao, &x); CHKERRQ(ierr);
 
-    // copy solution into place holder
-    ierr = VecCopy(x, this->m_Solution); CHKERRQ(ierr);
 
-    // if we did not converge, we should display what's going on
-    if (!this->m_OptimizationProblem->Converged()) {
-        ierr = OptimizationMonitor(this->m_Tao, this->m_OptimizationProblem); CHKERRQ(ierr);
+/********************************************************************
+ * @brief set up the native inexact newton-krylov driver; the
+ * krylov method is created here (instead of being owned by tao)
+ * and configured the same way as for the tao based solver
+ *******************************************************************/
+PetscErrorCode Optimizer::SetupNewtonKrylov() {
+    PetscErrorCode ierr = 0;
+    IntType nlu, ngu;
+    PetscFunctionBegin;
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(this->m_OptimizationProblem != NULL, "optimization problem not set"); CHKERRQ(ierr);
+
+    // if the krylov method exists, kill it
+    if (this->m_KrylovMethod != NULL && this->m_Tao == NULL) {
+        ierr = KSPDestroy(&this->m_KrylovMethod); CHKERRQ(ierr);
+        this->m_KrylovMethod = NULL;
     }
 
+    ierr = KSPCreate(this->m_Opt->m_Comm, &this->m_KrylovMethod); CHKERRQ(ierr);
 
+    // set up krylov method, preconditioner, and hessian matvec
+    ierr = this->SetupKrylovMethod(); CHKERRQ(ierr);
+    ierr = KSPSetOperators(this->m_KrylovMethod, this->m_MatVec, this->m_MatVec); CHKERRQ(ierr);
+
+    // allocate gradient, search direction, and trial point
+    nlu = 3*this->m_Opt->m_Domain.nl;
+    ngu = 3*this->m_Opt->m_Domain.ng;
+    if (this->m_Gradient == NULL) {
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_Gradient, nlu, ngu); CHKERRQ(ierr);
+    }
+    if (this->m_Step == NULL) {
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_Step, nlu, ngu); CHKERRQ(ierr);
+    }
+    if (this->m_Trial == NULL) {
+        ierr = VecCreate(this->m_Opt->m_Comm, this->m_Trial, nlu, ngu); CHKERRQ(ierr);
+    }
 
     this->m_Opt->Exit(__func__);
+    PetscFunctionReturn(ierr);
+}
 
-    PetscFunctionReturn(0);
+
+
+
+/********************************************************************
+ * @brief native inexact (gauss-)newton-krylov method; the objective
+ * and the gradient share the state solve, and the line search is
+ * owned by the driver, so that the gradient at the accepted trial
+ * point reuses the state computed for the armijo test; the gradient
+ * norm is computed once per iteration and used for the convergence
+ * test, the monitor, and the forcing sequence (krylov presolve)
+ * @param[in] gttol relative tolerance for gradient
+ * @param[in] maxit max number of newton iterations
+ *******************************************************************/
+PetscErrorCode Optimizer::RunNewtonKrylov(ScalarType gttol, IntType maxit) {
+    PetscErrorCode ierr = 0;
+    IntType iter, lsiter, maxlsiter;
+    ScalarType J, Jtrial, gnorm, gdx, alpha, step, lsred;
+    KSPConvergedReason kspreason;
+    OptimizationProblem* optprob = NULL;
+    WorkSpace::ScaFieldLease rhs;
+    std::stringstream ss;
+    Vec x = NULL;
+    bool lssuccess;
+    PetscFunctionBegin;
+    this->m_Opt->Enter(__func__);
+
+    optprob = this->m_OptimizationProblem;
+    ierr = Assert(optprob != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_KrylovMethod != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_Solution != NULL, "null pointer"); CHKERRQ(ierr);
+    x = this->m_Solution;
+
+    lsred = 1E-4;       // sufficient decrease (armijo rule)
+    maxlsiter = 30;     // max number of step size reductions
+
+    this->m_ConvergedReason = TAO_CONTINUE_ITERATING;
+    optprob->Converged(false);
+
+    // evaluate objective and gradient at initial guess (the
+    // gradient reuses the state computed for the objective)
+    ierr = optprob->EvaluateObjective(&J, x); CHKERRQ(ierr);
+    ierr = optprob->EvaluateGradient(this->m_Gradient, x); CHKERRQ(ierr);
+    ierr = VecNormL2(this->m_Gradient, &gnorm); CHKERRQ(ierr);
+    step = 1.0;
+
+    for (iter = 0; ; ++iter) {
+        // same monitor and stopping conditions as for tao
+        ierr = OptimizationMonitor(optprob, x, iter, J, gnorm, step, this->m_ConvergedReason); CHKERRQ(ierr);
+        ierr = CheckConvergenceGrad(optprob, iter, maxit-1, J, gnorm, step,
+                                    this->m_Opt->m_OptPara.tol[0], gttol, this->m_ConvergedReason); CHKERRQ(ierr);
+        if (this->m_ConvergedReason != TAO_CONTINUE_ITERATING) break;
+
+        // solve hessian system H[dx] = g (the tolerance is set by
+        // the forcing sequence in the presolve of the krylov method);
+        // the presolve may apply the preconditioner to the right hand
+        // side in place, so we solve for a copy of the gradient
+        ierr = rhs.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt->m_Comm, 3*this->m_Opt->m_Domain.nl,
+                           3*this->m_Opt->m_Domain.ng, "optimizer"); CHKERRQ(ierr);
+        ierr = VecCopy(this->m_Gradient, rhs.m_X); CHKERRQ(ierr);
+        ierr = KSPSolve(this->m_KrylovMethod, rhs.m_X, this->m_Step); CHKERRQ(ierr);
+        ierr = rhs.Release(); CHKERRQ(ierr);
+        ierr = KSPGetConvergedReason(this->m_KrylovMethod, &kspreason); CHKERRQ(ierr);
+        ierr = VecScale(this->m_Step, -1.0); CHKERRQ(ierr);
+
+        // fall back to steepest descent if we do not get a descent direction
+        ierr = VecDot(this->m_Gradient, this->m_Step, &gdx); CHKERRQ(ierr);
+        if ((kspreason < 0 && kspreason != KSP_DIVERGED_ITS) || !(gdx < 0.0)) {
+            ierr = WrngMsg("newton step is not a descent direction; using gradient step"); CHKERRQ(ierr);
+            ierr = VecCopy(this->m_Gradient, this->m_Step); CHKERRQ(ierr);
+            ierr = VecScale(this->m_Step, -1.0); CHKERRQ(ierr);
+            gdx = -gnorm*gnorm;
+        }
+
+        // backtracking line search; every trial point requires a
+        // state solve, which we keep for the gradient evaluation
+        alpha = 1.0; lssuccess = false;
+        for (lsiter = 0; lsiter < maxlsiter; ++lsiter) {
+            ierr = VecWAXPY(this->m_Trial, alpha, this->m_Step, x); CHKERRQ(ierr);
+            ierr = optprob->EvaluateObjective(&Jtrial, this->m_Trial); CHKERRQ(ierr);
+
+            // a non-finite objective is never accepted; without
+            // globalization there is no smaller step to try
+            if (PetscIsInfOrNanReal(Jtrial)) {
+                if (this->m_Opt->m_OptPara.glmethod == NOGM) break;
+                alpha /= 2.0;
+                continue;
+            }
+
+            // armijo rule (unit step if globalization is switched off)
+            if (this->m_Opt->m_OptPara.glmethod == NOGM || Jtrial <= J + lsred*alpha*gdx) {
+                lssuccess = true;
+                break;
+            }
+            alpha /= 2.0;
+        }
+
+        if (this->m_Opt->m_Verbosity > 1) {
+            ss << "line search " << (lssuccess ? "successful" : "failed")
+               << " (alpha=" << std::scientific << alpha << ", "
+               << lsiter + 1 << " objective evaluations)";
+            ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+            ss.str(std::string()); ss.clear();
+        }
+
+        if (!lssuccess && this->m_Opt->m_OptPara.glmethod == NOGM) {
+            ierr = WrngMsg("objective is not finite at newton step"); CHKERRQ(ierr);
+            this->m_ConvergedReason = TAO_DIVERGED_NAN;
+            break;
+        }
+        if (!lssuccess) {
+            ierr = WrngMsg("line search failed"); CHKERRQ(ierr);
+            this->m_ConvergedReason = TAO_DIVERGED_LS_FAILURE;
+            break;
+        }
+
+        // accept trial point; the state variable belongs to the
+        // trial point, so the gradient does not require a state solve
+        ierr = VecCopy(this->m_Trial, x); CHKERRQ(ierr);
+        J = Jtrial; step = alpha;
+        ierr = optprob->EvaluateGradient(this->m_Gradient, x); CHKERRQ(ierr);
+        ierr = VecNormL2(this->m_Gradient, &gnorm); CHKERRQ(ierr);
+    }
+
+    this->m_Opt->Exit(__func__);
+    PetscFunctionReturn(ierr);
 }
 
 
@@ -536,11 +827,17 @@ PetscErrorCode Optimizer::GetSolution(Vec &x) {
 
     this->m_Opt->Enter(__func__);
 
-    // check if we have solved the problem / set up tao
-    ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
+    if (this->m_Opt->m_OptPara.nativenewton) {
+        // native newton-krylov driver iterates on solution vector
+        ierr = Assert(this->m_Solution != NULL, "null pointer"); CHKERRQ(ierr);
+        x = this->m_Solution;
+    } else {
+        // check if we have solved the problem / set up tao
+        ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
 
-    // get solution
-    ierr = TaoGetSolutionVector(this->m_Tao, &x); CHKERRQ(ierr);
+        // get solution
+        ierr = TaoGetSolutionVector(this->m_Tao, &x); CHKERRQ(ierr);
+    }
 
     this->m_Opt->Exit(__func__);
 
@@ -561,11 +858,15 @@ PetscErrorCode Optimizer::GetSolutionStatus(bool &converged) {
 
     this->m_Opt->Enter(__func__);
 
-    // check if we have solved the problem / set up tao
-    ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
+    if (this->m_Opt->m_OptPara.nativenewton) {
+        reason = this->m_ConvergedReason;
+    } else {
+        // check if we have solved the problem / set up tao
+        ierr = Assert(this->m_Tao != NULL, "null pointer"); CHKERRQ(ierr);
 
-    // get solution
-    ierr = TaoGetConvergedReason(this->m_Tao, &reason); CHKERRQ(ierr);
+        // get solution
+        ierr = TaoGetConvergedReason(this->m_Tao, &reason); CHKERRQ(ierr);
+    }
 
     converged = true;
     if (reason < 0) {
@@ -594,7 +895,7 @@ PetscErrorCode Optimizer::Finalize() {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
 
     if (rank == 0) {
         std::cout << std::endl;
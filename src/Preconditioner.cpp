@@ -75,6 +75,9 @@ PetscErrorCode Preconditioner::Initialize() {
     this->m_KrylovMethodEigEst = NULL;  ///< pointer to krylov method (for eigenvalue estimation)
     this->m_RandomNumGen = NULL;        ///< random number generator (for eigenvalue estimation)
     this->m_PreProc = NULL;             ///< pointer to preprocessing operator
+    this->m_Smoother = NULL;            ///< smoother (multilevel preconditioner)
+    this->m_MatVecSmoother = NULL;      ///< pointer to matvec in smoother
+    this->m_Residual = NULL;            ///< residual (multilevel preconditioner)
 
     this->m_ControlVariable = NULL;     ///< control variable on fine grid
     this->m_IncControlVariable = NULL;  ///< incremental control variable on fine grid
@@ -82,8 +85,6 @@ PetscErrorCode Preconditioner::Initialize() {
     this->m_ReferenceImage = NULL;      ///< objective masking
 
     this->m_WorkVecField = NULL;        ///< temporary vector field
-    this->m_WorkScaField1 = NULL;       ///< temporary scalar field
-    this->m_WorkScaField2 = NULL;       ///< temporary scalar field
 
     try {this->m_CoarseGrid = new CoarseGrid();}
     catch (std::bad_alloc&) {
@@ -95,17 +96,33 @@ PetscErrorCode Preconditioner::Initialize() {
     this->m_CoarseGrid->m_StateVariable = NULL;         ///< state variable on coarse grid
     this->m_CoarseGrid->m_AdjointVariable = NULL;       ///< adjoint variable on coarse grid
     this->m_CoarseGrid->m_ControlVariable = NULL;       ///< control variable on coarse grid
-    this->m_CoarseGrid->m_IncControlVariable = NULL;    ///< incremental control variable on coarse grid
     this->m_CoarseGrid->m_Mask = NULL;                  ///< mask (objective masking)
     this->m_CoarseGrid->m_ReferenceImage = NULL;        ///< reference image
 
     this->m_CoarseGrid->x = NULL;    ///< container for input to hessian matvec on coarse grid
     this->m_CoarseGrid->y = NULL;    ///< container for hessian matvec on coarse grid
 
-    this->m_CoarseGrid->m_WorkScaField1 = NULL;         ///< temporary scalar field (coarse level)
-    this->m_CoarseGrid->m_WorkScaField2 = NULL;         ///< temporary scalar field (coarse level)
     this->m_CoarseGrid->setupdone = false;
 
+    this->m_CoarseGrid->m_Precond = NULL;   ///< no coarser levels
+    this->m_CoarseGrid->m_PreProc = NULL;
+
+    this->m_CoarseGrid->m_ReferenceSource = NULL;   ///< nothing restricted yet
+    this->m_CoarseGrid->m_MaskSource = NULL;        ///< nothing restricted yet
+    this->m_CoarseGrid->m_Version = -1;             ///< nothing restricted yet
+
+    this->m_CoarseGrid->m_Comm = MPI_COMM_NULL;     ///< communicator of coarse grid solve
+    this->m_CoarseGrid->m_WorldComm = MPI_COMM_NULL;
+    this->m_CoarseGrid->m_Reduced = false;          ///< coarse grid solve on all tasks
+    this->m_CoarseGrid->m_Active = true;
+    this->m_CoarseGrid->m_Buffer = NULL;
+
+    this->m_EigEstimatesRead = false;   ///< eigenvalue estimates in file not read
+
+    this->m_SecantPairs.q = NULL;       ///< work vector for lbfgs update
+    this->m_SecantPairs.stride = 1;     ///< record every matvec
+    this->m_SecantPairs.nseen = 0;      ///< no matvecs recorded
+
 
 
     PetscFunctionReturn(ierr);
@@ -137,6 +154,29 @@ PetscErrorCode Preconditioner::ClearMemory() {
         ierr = MatDestroy(&this->m_MatVecEigEst); CHKERRQ(ierr);
         this->m_MatVecEigEst = NULL;
     }
+    if (this->m_Smoother != NULL) {
+        ierr = KSPDestroy(&this->m_Smoother); CHKERRQ(ierr);
+        this->m_Smoother = NULL;
+    }
+    if (this->m_MatVecSmoother != NULL) {
+        ierr = MatDestroy(&this->m_MatVecSmoother); CHKERRQ(ierr);
+        this->m_MatVecSmoother = NULL;
+    }
+    if (this->m_Residual != NULL) {
+        ierr = VecDestroy(&this->m_Residual); CHKERRQ(ierr);
+        this->m_Residual = NULL;
+    }
+
+    // coarser levels of multilevel preconditioner (they refer to
+    // the problem and the options on the coarse grid)
+    if (this->m_CoarseGrid->m_Precond != NULL) {
+        delete this->m_CoarseGrid->m_Precond;
+        this->m_CoarseGrid->m_Precond = NULL;
+    }
+    if (this->m_CoarseGrid->m_PreProc != NULL) {
+        delete this->m_CoarseGrid->m_PreProc;
+        this->m_CoarseGrid->m_PreProc = NULL;
+    }
 
 
     if (this->m_CoarseGrid->x != NULL) {
@@ -159,27 +199,19 @@ PetscErrorCode Preconditioner::ClearMemory() {
         ierr = VecDestroy(&this->m_CoarseGrid->m_ReferenceImage); CHKERRQ(ierr);
         this->m_CoarseGrid->m_ReferenceImage = NULL;
     }
+    if (this->m_CoarseGrid->m_Mask != NULL) {
+        ierr = VecDestroy(&this->m_CoarseGrid->m_Mask); CHKERRQ(ierr);
+        this->m_CoarseGrid->m_Mask = NULL;
+    }
+    if (this->m_CoarseGrid->m_Buffer != NULL) {
+        ierr = VecDestroy(&this->m_CoarseGrid->m_Buffer); CHKERRQ(ierr);
+        this->m_CoarseGrid->m_Buffer = NULL;
+    }
 
     if (this->m_WorkVecField != NULL) {
         delete this->m_WorkVecField;
         this->m_WorkVecField = NULL;
     }
-    if (this->m_WorkScaField1 != NULL) {
-        ierr = VecDestroy(&this->m_WorkScaField1); CHKERRQ(ierr);
-        this->m_WorkScaField1 = NULL;
-    }
-    if (this->m_WorkScaField2 != NULL) {
-        ierr = VecDestroy(&this->m_WorkScaField2); CHKERRQ(ierr);
-        this->m_WorkScaField2 = NULL;
-    }
-    if (this->m_CoarseGrid->m_WorkScaField1 != NULL) {
-        ierr = VecDestroy(&this->m_CoarseGrid->m_WorkScaField1); CHKERRQ(ierr);
-        this->m_CoarseGrid->m_WorkScaField1 = NULL;
-    }
-    if (this->m_CoarseGrid->m_WorkScaField2 != NULL) {
-        ierr = VecDestroy(&this->m_CoarseGrid->m_WorkScaField2); CHKERRQ(ierr);
-        this->m_CoarseGrid->m_WorkScaField2 = NULL;
-    }
 
     if (this->m_CoarseGrid->m_OptimizationProblem != NULL) {
 //        this->m_CoarseGrid->m_OptimizationProblem->GetOptions()->WriteLogFile(true);
@@ -200,23 +232,29 @@ PetscErrorCode Preconditioner::ClearMemory() {
         delete this->m_CoarseGrid->m_ControlVariable;
         this->m_CoarseGrid->m_ControlVariable = NULL;
     }
-    if (this->m_CoarseGrid->m_IncControlVariable != NULL) {
-        delete this->m_CoarseGrid->m_IncControlVariable;
-        this->m_CoarseGrid->m_IncControlVariable = NULL;
-    }
 
     if (this->m_CoarseGrid->m_Opt != NULL) {
+        // timers and communicator of the coarse grid live on the
+        // tasks of the coarse grid solve
         this->m_CoarseGrid->m_Opt->ProcessTimers();
         this->m_CoarseGrid->m_Opt->WriteLogFile(true);
         delete this->m_CoarseGrid->m_Opt;
         this->m_CoarseGrid->m_Opt = NULL;
     }
 
+    if (this->m_CoarseGrid->m_Comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&this->m_CoarseGrid->m_Comm);
+        this->m_CoarseGrid->m_Comm = MPI_COMM_NULL;
+    }
+
     if (this->m_RandomNumGen != NULL) {
         ierr = PetscRandomDestroy(&this->m_RandomNumGen); CHKERRQ(ierr);
         this->m_RandomNumGen = NULL;
     }
 
+    ierr = this->ClearSecantPairs(); CHKERRQ(ierr);
+    ierr = this->ClearEigEstimates(); CHKERRQ(ierr);
+
     delete this->m_CoarseGrid;
 
     PetscFunctionReturn(ierr);
@@ -293,6 +331,13 @@ PetscErrorCode Preconditioner::Reset() {
             // no need to do anything
             break;
         }
+        case INVREGLBFGS:
+        {
+            // the secant pairs were recorded for a different
+            // hessian (e.g., different regularization parameter)
+            ierr = this->ClearSecantPairs(); CHKERRQ(ierr);
+            break;
+        }
         case TWOLEVEL:
         {
             // in case we call the solver multiple times (for
@@ -300,6 +345,23 @@ PetscErrorCode Preconditioner::Reset() {
             // destroying the preconditioner, it is necessary to
             // recompute eigenvalues
             this->m_Opt->m_KrylovMethod.eigvalsestimated = false;
+
+            // images may have changed in place (e.g., scale continuation)
+            // and the iterate may be the same; restrict all data again
+            this->m_CoarseGrid->m_ReferenceSource = NULL;
+            this->m_CoarseGrid->m_MaskSource = NULL;
+            this->m_CoarseGrid->m_Version = -1;
+
+            // coarser levels (multilevel preconditioner); the spectrum
+            // of the hessian changes, so the smoothers have to
+            // re-estimate the eigenvalues
+            if (this->m_CoarseGrid->m_Precond != NULL) {
+                ierr = this->m_CoarseGrid->m_Precond->Reset(); CHKERRQ(ierr);
+                this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcsetupdone = false;
+            }
+            if (this->m_MatVecSmoother != NULL) {
+                ierr = PetscObjectStateIncrease((PetscObject)this->m_MatVecSmoother); CHKERRQ(ierr);
+            }
             break;
         }
         default:
@@ -334,6 +396,13 @@ PetscErrorCode Preconditioner::DoSetup() {
         // apply restriction to adjoint, state and control variable
         ierr = this->ApplyRestriction(); CHKERRQ(ierr);
     }
+
+    // the setup is triggered if the hessian on this level has changed
+    // (new iterate or restricted data); the chebyshev smoother has to
+    // re-estimate the eigenvalue bounds for the new operator
+    if (this->m_MatVecSmoother != NULL) {
+        ierr = PetscObjectStateIncrease((PetscObject)this->m_MatVecSmoother); CHKERRQ(ierr);
+    }
     this->m_Opt->m_KrylovMethod.pcsetupdone = true;
 
     // stop timer
@@ -348,13 +417,16 @@ PetscErrorCode Preconditioner::DoSetup() {
 
 
 /********************************************************************
- * @brief setup phase of preconditioner
+ * @brief setup phase of preconditioner; the coarse grid problem is
+ * allocated on the tasks of the coarse grid solve; restriction and
+ * prolongation are applied by all tasks (data layout of the fine
+ * grid), and the data is redistributed if the coarse grid solve
+ * runs on a subset of the tasks
  *******************************************************************/
 PetscErrorCode Preconditioner::SetupCoarseGrid() {
     PetscErrorCode ierr = 0;
-    IntType nt, nc, nlc, ngc, nl, ng, nxc[3], nx[3];
+    IntType nlb, ngb;
     ScalarType scale, value;
-    std::stringstream ss;
     PetscFunctionBegin;
 
     this->m_Opt->Enter(__func__);
@@ -364,6 +436,77 @@ PetscErrorCode Preconditioner::SetupCoarseGrid() {
     ierr = Assert(this->m_OptimizationProblem != NULL, "null pointer"); CHKERRQ(ierr);
     ierr = Assert(this->m_PreProc != NULL, "null pointer"); CHKERRQ(ierr);
 
+    // get grid scale and compute number of grid points
+    scale = this->m_Opt->m_KrylovMethod.pcgridscale;
+    for (int i = 0; i < 3; ++i) {
+        value = static_cast<ScalarType>(this->m_Opt->m_Domain.nx[i])/scale;
+        this->m_CoarseGrid->nx[i] = static_cast<IntType>(std::ceil(value));
+    }
+
+    // set up communicator for coarse grid solve
+    ierr = this->SetupCoarseGridComm(); CHKERRQ(ierr);
+
+    // allocate coarse grid problem (tasks of coarse grid solve only)
+    if (this->m_CoarseGrid->m_Active) {
+        ierr = this->AllocateCoarseGrid(); CHKERRQ(ierr);
+        if (this->m_Opt->m_KrylovMethod.pcnlevels > 2) {
+            ierr = this->SetupCoarseLevel(); CHKERRQ(ierr);
+        }
+    }
+
+    // create vector fields
+    try {this->m_ControlVariable = new VecField(this->m_Opt);}
+    catch (std::bad_alloc&) {
+        ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
+    }
+    try {this->m_IncControlVariable = new VecField(this->m_Opt);}
+    catch (std::bad_alloc&) {
+        ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
+    }
+
+    // output of restriction and input of prolongation (coarse grid,
+    // data layout of the fine grid tasks)
+    if (this->m_CoarseGrid->m_Buffer != NULL) {
+        ierr = VecDestroy(&this->m_CoarseGrid->m_Buffer); CHKERRQ(ierr);
+        this->m_CoarseGrid->m_Buffer = NULL;
+    }
+    ierr = this->m_Opt->GetSizes(this->m_CoarseGrid->nx, nlb, ngb); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_Opt->m_Comm, this->m_CoarseGrid->m_Buffer, nlb, ngb); CHKERRQ(ierr);
+
+    if (this->m_CoarseGrid->m_Reduced) {
+        ierr = this->SetupRedistribution(); CHKERRQ(ierr);
+    }
+
+    // the coarse grid problem is new; the reference image and the mask
+    // are restricted during the setup (see ApplyRestriction)
+    this->m_CoarseGrid->m_ReferenceSource = NULL;
+    this->m_CoarseGrid->m_MaskSource = NULL;
+    this->m_CoarseGrid->m_Version = -1;
+
+    // switch flag
+    this->m_CoarseGrid->setupdone = true;
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief allocate options, optimization problem and variables on
+ * the coarse grid; the coarse grid problem is distributed on the
+ * communicator of the coarse grid solve (tasks of coarse grid solve only)
+ *******************************************************************/
+PetscErrorCode Preconditioner::AllocateCoarseGrid() {
+    PetscErrorCode ierr = 0;
+    IntType nt, nc, nlc, ngc;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
     nt  = this->m_Opt->m_Domain.nt;
     nc  = this->m_Opt->m_Domain.nc;
 
@@ -378,11 +521,16 @@ PetscErrorCode Preconditioner::SetupCoarseGrid() {
         ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
     }
 
-    // get grid scale and compute number of grid points
-    scale = this->m_Opt->m_KrylovMethod.pcgridscale;
     for (int i = 0; i < 3; ++i) {
-        value = static_cast<ScalarType>(this->m_Opt->m_Domain.nx[i])/scale;
-        this->m_CoarseGrid->m_Opt->m_Domain.nx[i] = static_cast<IntType>(std::ceil(value));
+        this->m_CoarseGrid->m_Opt->m_Domain.nx[i] = this->m_CoarseGrid->nx[i];
+    }
+    // objects of the coarse grid problem live on the tasks of the coarse grid solve
+    if (this->m_CoarseGrid->m_Reduced) {
+        this->m_CoarseGrid->m_Opt->m_Comm = this->m_CoarseGrid->m_Comm;
+    }
+    // the coarse grid solve may use a cheaper interpolation kernel
+    if (this->m_Opt->m_KrylovMethod.pcipkernel != INTERP3_NKERNELS) {
+        this->m_CoarseGrid->m_Opt->m_PDESolver.ipkernel = this->m_Opt->m_KrylovMethod.pcipkernel;
     }
     ierr = this->m_CoarseGrid->m_Opt->DoSetup(false); CHKERRQ(ierr);
 
@@ -424,76 +572,246 @@ PetscErrorCode Preconditioner::SetupCoarseGrid() {
         ierr = ThrowError("registration model not defined"); CHKERRQ(ierr);
     }
 
-    nl = this->m_Opt->m_Domain.nl;
-    ng = this->m_Opt->m_Domain.ng;
-
     nlc = this->m_CoarseGrid->nl();
     ngc = this->m_CoarseGrid->ng();
 
-    // create vector fields
-    ierr = VecCreate(this->m_WorkScaField1, this->m_Opt->m_Domain.nl, this->m_Opt->m_Domain.ng); CHKERRQ(ierr);
-    ierr = VecCreate(this->m_WorkScaField2, this->m_Opt->m_Domain.nl, this->m_Opt->m_Domain.ng); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, this->m_CoarseGrid->m_StateVariable, (nt+1)*nc*nlc, (nt+1)*nc*ngc, (nt+1)*nc); CHKERRQ(ierr);
+    if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
+        ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, this->m_CoarseGrid->m_AdjointVariable, (nt+1)*nc*nlc, (nt+1)*nc*ngc, (nt+1)*nc); CHKERRQ(ierr);
+    } else {
+        ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, this->m_CoarseGrid->m_AdjointVariable, nc*nlc, nc*ngc, nc); CHKERRQ(ierr);
+    }
 
-    try {this->m_ControlVariable = new VecField(this->m_Opt);}
+    try {this->m_CoarseGrid->m_ControlVariable = new VecField(this->m_CoarseGrid->m_Opt);}
     catch (std::bad_alloc&) {
         ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
     }
-    try {this->m_IncControlVariable = new VecField(this->m_Opt);}
-    catch (std::bad_alloc&) {
-        ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
+
+    ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, this->m_CoarseGrid->x, 3*nlc, 3*ngc, 3); CHKERRQ(ierr);
+    ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, this->m_CoarseGrid->y, 3*nlc, 3*ngc, 3); CHKERRQ(ierr);
+
+    // get mask, and if mask is set, allocate memory for coarse grid
+    ierr = this->m_OptimizationProblem->GetMask(this->m_Mask); CHKERRQ(ierr);
+    if (this->m_Mask != NULL) {
+        ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, this->m_CoarseGrid->m_Mask, nlc, ngc); CHKERRQ(ierr);
     }
 
-    ierr = VecCreate(this->m_CoarseGrid->m_StateVariable, (nt+1)*nc*nlc, (nt+1)*nc*ngc); CHKERRQ(ierr);
-    if (this->m_Opt->m_OptPara.method == FULLNEWTON) {
-        ierr = VecCreate(this->m_CoarseGrid->m_AdjointVariable, (nt+1)*nc*nlc, (nt+1)*nc*ngc); CHKERRQ(ierr);
-    } else {
-        ierr = VecCreate(this->m_CoarseGrid->m_AdjointVariable, nc*nlc, nc*ngc); CHKERRQ(ierr);
+    // allocate reference image (for NCC and NGF distance measures)
+    ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, this->m_CoarseGrid->m_ReferenceImage, nlc, ngc); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set up the next level of the multilevel preconditioner; the
+ * preconditioner on the coarse grid is a two level (or multilevel)
+ * preconditioner with one level less; it operates on the coarse grid
+ * problem and is applied as a cycle (see ApplyCycle); all tasks of
+ * the coarse grid solve take part in the coarser levels (the options
+ * of the coarse grid carry the communicator of the coarse grid solve)
+ *******************************************************************/
+PetscErrorCode Preconditioner::SetupCoarseLevel() {
+    PetscErrorCode ierr = 0;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(this->m_CoarseGrid->m_Opt != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_CoarseGrid->m_OptimizationProblem != NULL, "null pointer"); CHKERRQ(ierr);
+
+    // options of coarse grid define the next level
+    this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcnlevels = this->m_Opt->m_KrylovMethod.pcnlevels - 1;
+    this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcnprocs = 0;
+    this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcsetupdone = false;
+    this->m_CoarseGrid->m_Opt->m_KrylovMethod.eigvalsestimated = false;
+
+    if (this->m_Opt->m_Verbosity > 1) {
+        ss  << "preconditioner: cycle on level with nx = ("
+            << this->m_CoarseGrid->nx[0] << ","
+            << this->m_CoarseGrid->nx[1] << ","
+            << this->m_CoarseGrid->nx[2] << "); "
+            << this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcnlevels - 1 << " coarser level(s)";
+        ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
     }
 
-    ierr = VecCreate(this->m_CoarseGrid->m_WorkScaField1, nlc, ngc); CHKERRQ(ierr);
-    ierr = VecCreate(this->m_CoarseGrid->m_WorkScaField2, nlc, ngc); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Precond != NULL) {
+        delete this->m_CoarseGrid->m_Precond;
+        this->m_CoarseGrid->m_Precond = NULL;
+    }
+    if (this->m_CoarseGrid->m_PreProc != NULL) {
+        delete this->m_CoarseGrid->m_PreProc;
+        this->m_CoarseGrid->m_PreProc = NULL;
+    }
 
-    try {this->m_CoarseGrid->m_ControlVariable = new VecField(this->m_CoarseGrid->m_Opt);}
+    // grid transfer between coarse grid and next coarser level
+    try {this->m_CoarseGrid->m_PreProc = new Preprocessing(this->m_CoarseGrid->m_Opt);}
     catch (std::bad_alloc&) {
         ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
     }
-    try {this->m_CoarseGrid->m_IncControlVariable = new VecField(this->m_CoarseGrid->m_Opt);}
+
+    try {this->m_CoarseGrid->m_Precond = new Preconditioner(this->m_CoarseGrid->m_Opt);}
     catch (std::bad_alloc&) {
         ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
     }
+    ierr = this->m_CoarseGrid->m_Precond->SetProblem(this->m_CoarseGrid->m_OptimizationProblem); CHKERRQ(ierr);
+    ierr = this->m_CoarseGrid->m_Precond->SetPreProc(this->m_CoarseGrid->m_PreProc); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+/********************************************************************
+ * @brief set up communicator for the coarse grid solve; if the
+ * number of tasks for the coarse grid solve is set (pcnprocs) and
+ * smaller than the number of tasks, the coarse grid problem is
+ * solved by the first pcnprocs tasks (task 0 is always part of the
+ * coarse grid solve); the other tasks wait for the result
+ *******************************************************************/
+PetscErrorCode Preconditioner::SetupCoarseGridComm() {
+    PetscErrorCode ierr = 0;
+    int rank, nprocs, np, rval;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    if (this->m_CoarseGrid->m_Comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&this->m_CoarseGrid->m_Comm);
+        this->m_CoarseGrid->m_Comm = MPI_COMM_NULL;
+    }
 
-    ierr = VecCreate(this->m_CoarseGrid->x, 3*nlc, 3*ngc); CHKERRQ(ierr);
-    ierr = VecCreate(this->m_CoarseGrid->y, 3*nlc, 3*ngc); CHKERRQ(ierr);
+    this->m_CoarseGrid->m_WorldComm = this->m_Opt->m_Comm;
+    MPI_Comm_rank(this->m_CoarseGrid->m_WorldComm, &rank);
+    MPI_Comm_size(this->m_CoarseGrid->m_WorldComm, &nprocs);
 
-    // get mask, and if mask is set, allocate memory for coarse grid
-    ierr = this->m_OptimizationProblem->GetMask(this->m_Mask); CHKERRQ(ierr);
-    if (this->m_Mask != NULL) {
-        ierr = VecCreate(this->m_CoarseGrid->m_Mask, nlc, ngc); CHKERRQ(ierr);
+    np = this->m_Opt->m_KrylovMethod.pcnprocs;
+    this->m_CoarseGrid->m_Reduced = np > 0 && np < nprocs;
+    this->m_CoarseGrid->m_Active = !this->m_CoarseGrid->m_Reduced || rank < np;
+
+    if (this->m_CoarseGrid->m_Reduced) {
+        rval = MPI_Comm_split(this->m_CoarseGrid->m_WorldComm, this->m_CoarseGrid->m_Active ? 0 : MPI_UNDEFINED,
+                              rank, &this->m_CoarseGrid->m_Comm);
+        ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+        if (this->m_Opt->m_Verbosity > 1) {
+            ss << "preconditioner: coarse grid solve on " << np << " of " << nprocs << " tasks";
+            ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+            ss.str(std::string()); ss.clear();
+        }
     }
 
-    // allocate reference image (for NCC and NGF distance measures)
-    ierr = VecCreate(this->m_CoarseGrid->m_ReferenceImage, nlc, ngc); CHKERRQ(ierr);
+    this->m_Opt->Exit(__func__);
 
-    for (int i = 0; i < 3; ++i) {
-        nx[i]  = this->m_Opt->m_Domain.nx[i];
-        nxc[i] = this->m_CoarseGrid->m_Opt->m_Domain.nx[i];
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief compute the communication pattern to redistribute scalar
+ * fields on the coarse grid between the data layout of the fine grid
+ * tasks and the data layout of the coarse grid solve (see
+ * Redistribution)
+ *******************************************************************/
+PetscErrorCode Preconditioner::SetupRedistribution() {
+    PetscErrorCode ierr = 0;
+    IntType sbox[6], tbox[6];
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    // local box in data layout of fine grid tasks (istart, isize)
+    ierr = this->m_Opt->GetSizes(this->m_CoarseGrid->nx, &sbox[0], &sbox[3]); CHKERRQ(ierr);
+
+    // local box in data layout of coarse grid solve (empty on idle tasks)
+    for (int j = 0; j < 3; ++j) {
+        tbox[j] = 0; tbox[3+j] = 0;
+        if (this->m_CoarseGrid->m_Active) {
+            tbox[j]   = this->m_CoarseGrid->m_Opt->m_Domain.istart[j];
+            tbox[3+j] = this->m_CoarseGrid->m_Opt->m_Domain.isize[j];
+        }
     }
 
-    if (this->m_Opt->m_Verbosity > 2) {
-        ierr = DbgMsg("preconditioner: applying restriction to reference image"); CHKERRQ(ierr);
+    ierr = this->m_CoarseGrid->m_Redistribution.Setup(this->m_CoarseGrid->m_WorldComm, sbox, tbox); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief restrict scalar field to coarse grid (all tasks) and store
+ * it in the data layout of the coarse grid solve
+ * @param[out] p_xc restricted field (not accessed on idle tasks)
+ * @param[in] x_f scalar field on fine grid
+ *******************************************************************/
+PetscErrorCode Preconditioner::RestrictToCoarseGrid(ScalarType* p_xc, Vec x_f) {
+    PetscErrorCode ierr = 0;
+    IntType nl;
+    const ScalarType *p_xb = NULL;
+    PetscFunctionBegin;
+
+    ierr = this->m_PreProc->Restrict(&this->m_CoarseGrid->m_Buffer, x_f,
+                                     this->m_CoarseGrid->nx, this->m_Opt->m_Domain.nx); CHKERRQ(ierr);
+
+    ierr = VecGetArrayRead(this->m_CoarseGrid->m_Buffer, &p_xb); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Reduced) {
+        ierr = this->m_CoarseGrid->m_Redistribution.Scatter(p_xc, &p_xb); CHKERRQ(ierr);
+    } else {
+        ierr = VecGetLocalSize(this->m_CoarseGrid->m_Buffer, &nl); CHKERRQ(ierr);
+        try {std::copy(p_xb, p_xb+nl, p_xc);}
+        catch (std::exception&) {
+            ierr = ThrowError("copy failed"); CHKERRQ(ierr);
+        }
     }
-    // apply restriction operator to incremental control variable
-    ierr = this->m_OptimizationProblem->GetReferenceImage(this->m_ReferenceImage); CHKERRQ(ierr);
-    ierr = this->m_PreProc->Restrict(&this->m_CoarseGrid->m_ReferenceImage,
-                                     this->m_ReferenceImage, nxc, nx); CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(this->m_CoarseGrid->m_Buffer, &p_xb); CHKERRQ(ierr);
 
-    //ierr = VecView(this->m_CoarseGrid->m_ReferenceImage); CHKERRQ(ierr);
-    ierr = this->m_CoarseGrid->m_OptimizationProblem->SetReferenceImage(this->m_CoarseGrid->m_ReferenceImage); CHKERRQ(ierr);
+    PetscFunctionReturn(ierr);
+}
 
-    // switch flag
-    this->m_CoarseGrid->setupdone = true;
 
-    this->m_Opt->Exit(__func__);
+
+
+/********************************************************************
+ * @brief prolong scalar field given in the data layout of the coarse
+ * grid solve to the fine grid (all tasks)
+ * @param[out] x_f prolonged scalar field on fine grid
+ * @param[in] p_xc field on coarse grid (not accessed on idle tasks)
+ *******************************************************************/
+PetscErrorCode Preconditioner::ProlongFromCoarseGrid(Vec x_f, const ScalarType* p_xc) {
+    PetscErrorCode ierr = 0;
+    IntType nl;
+    ScalarType *p_xb = NULL;
+    PetscFunctionBegin;
+
+    ierr = VecGetArray(this->m_CoarseGrid->m_Buffer, &p_xb); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Reduced) {
+        ierr = this->m_CoarseGrid->m_Redistribution.Gather(&p_xb, p_xc); CHKERRQ(ierr);
+    } else {
+        ierr = VecGetLocalSize(this->m_CoarseGrid->m_Buffer, &nl); CHKERRQ(ierr);
+        try {std::copy(p_xc, p_xc+nl, p_xb);}
+        catch (std::exception&) {
+            ierr = ThrowError("copy failed"); CHKERRQ(ierr);
+        }
+    }
+    ierr = VecRestoreArray(this->m_CoarseGrid->m_Buffer, &p_xb); CHKERRQ(ierr);
+
+    ierr = this->m_PreProc->Prolong(&x_f, this->m_CoarseGrid->m_Buffer,
+                                    this->m_Opt->m_Domain.nx, this->m_CoarseGrid->nx); CHKERRQ(ierr);
 
     PetscFunctionReturn(ierr);
 }
@@ -501,6 +819,48 @@ PetscErrorCode Preconditioner::SetupCoarseGrid() {
 
 
 
+/********************************************************************
+ * @brief solve on the coarse grid; the input is stored in x and the
+ * output in y of the coarse grid; on the coarsest level, we invert
+ * the hessian with the krylov method, otherwise we apply a cycle of
+ * the next level (multilevel preconditioner); idle tasks return
+ * immediately
+ *******************************************************************/
+PetscErrorCode Preconditioner::SolveCoarseGrid() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    if (!this->m_CoarseGrid->m_Active) {
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
+    ierr = this->m_Opt->StartTimer(PMVEXEC); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Precond != NULL) {
+        ierr = this->m_CoarseGrid->m_Precond->ApplyCycle(this->m_CoarseGrid->y, this->m_CoarseGrid->x); CHKERRQ(ierr);
+    } else {
+        // do setup
+        if (this->m_KrylovMethod == NULL) {
+            ierr = this->SetupKrylovMethod(this->m_CoarseGrid->nl(), this->m_CoarseGrid->ng()); CHKERRQ(ierr);
+        }
+        ierr = KSPSolve(this->m_KrylovMethod, this->m_CoarseGrid->x, this->m_CoarseGrid->y); CHKERRQ(ierr);
+
+        // inspect pc solver
+        if (this->m_Opt->m_KrylovMethod.monitorpcsolver) {
+            ierr = KSPView(this->m_KrylovMethod, PETSC_VIEWER_STDOUT_(this->m_CoarseGrid->m_Opt->m_Comm)); CHKERRQ(ierr);
+        }
+    }
+    ierr = this->m_Opt->StopTimer(PMVEXEC); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
 /********************************************************************
  * @brief applies the preconditioner for the hessian to a vector
  *******************************************************************/
@@ -523,6 +883,11 @@ PetscErrorCode Preconditioner::MatVec(Vec Px, Vec x) {
             ierr = this->ApplySpectralPrecond(Px, x); CHKERRQ(ierr);
             break;
         }
+        case INVREGLBFGS:
+        {
+            ierr = this->ApplyLBFGSPrecond(Px, x); CHKERRQ(ierr);
+            break;
+        }
         case TWOLEVEL:
         {
             ierr = this->Apply2LevelPrecond(Px, x); CHKERRQ(ierr);
@@ -576,83 +941,321 @@ PetscErrorCode Preconditioner::ApplySpectralPrecond(Vec precx, Vec x) {
 
 
 /********************************************************************
- * @brief applies the preconditioner for the hessian to a vector
+ * @brief apply inverse of regularization operator with limited-memory
+ * bfgs update as preconditioner; the update uses the secant pairs
+ * (s, Hs) recorded during previous hessian solves (two-loop recursion;
+ * the inverse regularization operator serves as initial hessian)
  *******************************************************************/
-PetscErrorCode Preconditioner::Apply2LevelPrecond(Vec Px, Vec x) {
+PetscErrorCode Preconditioner::ApplyLBFGSPrecond(Vec Px, Vec x) {
     PetscErrorCode ierr = 0;
+    IntType k;
+    ScalarType value, beta;
     PetscFunctionBegin;
-    ScalarType pct, value;
-    IntType nxc[3], nx[3];
+
     this->m_Opt->Enter(__func__);
 
-    // do allocation of coarse grid
-    if (!this->m_CoarseGrid->setupdone) {
-        ierr = this->SetupCoarseGrid(); CHKERRQ(ierr);
-    }
+    k = static_cast<IntType>(this->m_SecantPairs.s.size());
 
-    // do setup
-    if (this->m_KrylovMethod == NULL) {
-        ierr = this->SetupKrylovMethod(this->m_CoarseGrid->nl(), this->m_CoarseGrid->ng()); CHKERRQ(ierr);
+    // no pairs yet (first hessian solve)
+    if (k == 0) {
+        ierr = this->ApplySpectralPrecond(Px, x); CHKERRQ(ierr);
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
     }
 
-    // check if all the necessary pointers have been initialized
-    ierr = Assert(this->m_PreProc != NULL, "null pointer"); CHKERRQ(ierr);
-    ierr = Assert(this->m_CoarseGrid->x != NULL, "null pointer"); CHKERRQ(ierr);
-    ierr = Assert(this->m_CoarseGrid->y  != NULL, "null pointer"); CHKERRQ(ierr);
-    ierr = Assert(this->m_CoarseGrid->m_Opt != NULL, "null pointer"); CHKERRQ(ierr);
-    ierr = Assert(this->m_IncControlVariable != NULL, "null pointer"); CHKERRQ(ierr);
-    ierr = Assert(this->m_CoarseGrid->m_IncControlVariable != NULL, "null pointer"); CHKERRQ(ierr);
-
-    // allocate vector field
-    if (this->m_WorkVecField == NULL) {
-        try {this->m_WorkVecField = new VecField(this->m_Opt);}
-        catch (std::bad_alloc&) {
-            ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
-        }
+    if (this->m_SecantPairs.q == NULL) {
+        ierr = VecDuplicate(x, &this->m_SecantPairs.q); CHKERRQ(ierr);
+    }
+    this->m_SecantPairs.alpha.resize(k);
+
+    // first loop (newest to oldest pair)
+    ierr = VecCopy(x, this->m_SecantPairs.q); CHKERRQ(ierr);
+    for (IntType i = k-1; i >= 0; --i) {
+        ierr = VecDot(this->m_SecantPairs.s[i], this->m_SecantPairs.q, &value); CHKERRQ(ierr);
+        this->m_SecantPairs.alpha[i] = this->m_SecantPairs.rho[i]*value;
+        ierr = VecAXPY(this->m_SecantPairs.q, -this->m_SecantPairs.alpha[i], this->m_SecantPairs.y[i]); CHKERRQ(ierr);
     }
 
-    pct = 0; // set to zero, cause we search for a max
-    for (int i = 0; i < 3; ++i) {
-        nx[i]  = this->m_Opt->m_Domain.nx[i];
-        nxc[i] = this->m_CoarseGrid->m_Opt->m_Domain.nx[i];
-        value  = static_cast<ScalarType>(nxc[i])/static_cast<ScalarType>(nx[i]);
+    // initial hessian: inverse regularization operator
+    ierr = this->ApplySpectralPrecond(Px, this->m_SecantPairs.q); CHKERRQ(ierr);
 
-        pct = value > pct ? value : pct;
+    // second loop (oldest to newest pair)
+    for (IntType i = 0; i < k; ++i) {
+        ierr = VecDot(this->m_SecantPairs.y[i], Px, &value); CHKERRQ(ierr);
+        beta = this->m_SecantPairs.rho[i]*value;
+        ierr = VecAXPY(Px, this->m_SecantPairs.alpha[i] - beta, this->m_SecantPairs.s[i]); CHKERRQ(ierr);
     }
 
-    // set components
-    ierr = this->m_WorkVecField->SetComponents(x); CHKERRQ(ierr);
+    this->m_Opt->Exit(__func__);
 
-    // apply low pass filter before we restrict
-    // incremental control variable to coarse grid
-    ierr = this->m_PreProc->ApplyRectFreqFilter(this->m_IncControlVariable,
-                                                this->m_WorkVecField, pct); CHKERRQ(ierr);
+    PetscFunctionReturn(ierr);
+}
 
-    // apply restriction operator to incremental control variable
-    ierr = this->m_PreProc->Restrict(this->m_CoarseGrid->m_IncControlVariable,
-                                     this->m_IncControlVariable, nxc, nx); CHKERRQ(ierr);
 
-    // get the components to interface hessian mat vec
-    ierr = this->m_CoarseGrid->m_IncControlVariable->GetComponents(this->m_CoarseGrid->x); CHKERRQ(ierr);
 
 
-    // invert preconditioner
-    ierr = this->m_Opt->StartTimer(PMVEXEC); CHKERRQ(ierr);
-    ierr = KSPSolve(this->m_KrylovMethod, this->m_CoarseGrid->x, this->m_CoarseGrid->y); CHKERRQ(ierr);
-    ierr = this->m_Opt->StopTimer(PMVEXEC); CHKERRQ(ierr);
+/********************************************************************
+ * @brief record secant pair (s, Hs) for the lbfgs update of the
+ * preconditioner; called for every hessian matvec of the outer
+ * krylov method; to keep at most pclbfgsmem pairs that are spread
+ * over the entire solve, the matvecs are sampled with a stride that
+ * doubles (and every other recorded pair is dropped) when the
+ * buffer is full; pairs without positive curvature are skipped
+ *******************************************************************/
+PetscErrorCode Preconditioner::AddSecantPair(Vec s, Vec y) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nlp, n, m;
+    ScalarType sy, ss;
+    Vec v = NULL;
+    PetscFunctionBegin;
+
+    if (this->m_Opt->m_KrylovMethod.pctype != INVREGLBFGS) {
+        PetscFunctionReturn(ierr);
+    }
+
+    this->m_Opt->Enter(__func__);
+
+    m = this->m_Opt->m_KrylovMethod.pclbfgsmem;
+
+    // sizes changed (grid continuation); drop all pairs
+    if (this->m_SecantPairs.q != NULL) {
+        ierr = VecGetLocalSize(s, &nl); CHKERRQ(ierr);
+        ierr = VecGetLocalSize(this->m_SecantPairs.q, &nlp); CHKERRQ(ierr);
+        if (nl != nlp) {
+            ierr = this->ClearSecantPairs(); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_SecantPairs.q == NULL) {
+        ierr = VecDuplicate(s, &this->m_SecantPairs.q); CHKERRQ(ierr);
+    }
+
+    n = this->m_SecantPairs.nseen++;
+
+    // buffer is full: keep every other pair and double the stride
+    if (n % this->m_SecantPairs.stride == 0
+        && static_cast<IntType>(this->m_SecantPairs.stageds.size()) >= m) {
+        IntType j = 0;
+        for (IntType i = 0; i < static_cast<IntType>(this->m_SecantPairs.stageds.size()); ++i) {
+            if (i % 2 == 0) {
+                this->m_SecantPairs.stageds[j] = this->m_SecantPairs.stageds[i];
+                this->m_SecantPairs.stagedy[j] = this->m_SecantPairs.stagedy[i];
+                ++j;
+            } else {
+                this->m_SecantPairs.pool.push_back(this->m_SecantPairs.stageds[i]);
+                this->m_SecantPairs.pool.push_back(this->m_SecantPairs.stagedy[i]);
+            }
+        }
+        this->m_SecantPairs.stageds.resize(j);
+        this->m_SecantPairs.stagedy.resize(j);
+        this->m_SecantPairs.stride *= 2;
+    }
+
+    if (n % this->m_SecantPairs.stride == 0) {
+        ierr = VecDot(s, y, &sy); CHKERRQ(ierr);
+        ierr = VecDot(s, s, &ss); CHKERRQ(ierr);
+        if (sy > PETSC_SQRT_MACHINE_EPSILON*ss) {
+            for (int i = 0; i < 2; ++i) {
+                if (this->m_SecantPairs.pool.empty()) {
+                    ierr = VecDuplicate(s, &v); CHKERRQ(ierr);
+                } else {
+                    v = this->m_SecantPairs.pool.back();
+                    this->m_SecantPairs.pool.pop_back();
+                }
+                ierr = VecCopy(i == 0 ? s : y, v); CHKERRQ(ierr);
+                if (i == 0) {
+                    this->m_SecantPairs.stageds.push_back(v);
+                } else {
+                    this->m_SecantPairs.stagedy.push_back(v);
+                }
+            }
+        }
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief activate the secant pairs recorded during the last hessian
+ * solve (called before every hessian solve); if no pairs have been
+ * recorded, the active pairs are kept
+ *******************************************************************/
+PetscErrorCode Preconditioner::UpdateSecantPairs() {
+    PetscErrorCode ierr = 0;
+    ScalarType sy;
+    PetscFunctionBegin;
 
-    // inspect pc solver
-    if (this->m_Opt->m_KrylovMethod.monitorpcsolver) {
-        ierr = KSPView(this->m_KrylovMethod,PETSC_VIEWER_STDOUT_WORLD); CHKERRQ(ierr);
+    if (this->m_Opt->m_KrylovMethod.pctype != INVREGLBFGS) {
+        PetscFunctionReturn(ierr);
     }
 
+    this->m_Opt->Enter(__func__);
 
-    // get components (for interface of hessian matvec)
-    ierr = this->m_CoarseGrid->m_IncControlVariable->SetComponents(this->m_CoarseGrid->y); CHKERRQ(ierr);
+    if (!this->m_SecantPairs.stageds.empty()) {
+        // return active pairs to pool
+        for (size_t i = 0; i < this->m_SecantPairs.s.size(); ++i) {
+            this->m_SecantPairs.pool.push_back(this->m_SecantPairs.s[i]);
+            this->m_SecantPairs.pool.push_back(this->m_SecantPairs.y[i]);
+        }
+        this->m_SecantPairs.s.swap(this->m_SecantPairs.stageds);
+        this->m_SecantPairs.y.swap(this->m_SecantPairs.stagedy);
+        this->m_SecantPairs.stageds.clear();
+        this->m_SecantPairs.stagedy.clear();
+
+        this->m_SecantPairs.rho.resize(this->m_SecantPairs.s.size());
+        for (size_t i = 0; i < this->m_SecantPairs.s.size(); ++i) {
+            ierr = VecDot(this->m_SecantPairs.s[i], this->m_SecantPairs.y[i], &sy); CHKERRQ(ierr);
+            this->m_SecantPairs.rho[i] = 1.0/sy;
+        }
+
+        if (this->m_Opt->m_Verbosity > 1) {
+            std::stringstream ss;
+            ss << "lbfgs preconditioner: " << this->m_SecantPairs.s.size() << " secant pairs";
+            ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+        }
+    }
+
+    // restart sampling for next solve
+    this->m_SecantPairs.stride = 1;
+    this->m_SecantPairs.nseen = 0;
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief release all secant pairs of the lbfgs update
+ *******************************************************************/
+PetscErrorCode Preconditioner::ClearSecantPairs() {
+    PetscErrorCode ierr = 0;
+    std::vector<Vec>* list[5];
+    PetscFunctionBegin;
+
+    list[0] = &this->m_SecantPairs.s;
+    list[1] = &this->m_SecantPairs.y;
+    list[2] = &this->m_SecantPairs.stageds;
+    list[3] = &this->m_SecantPairs.stagedy;
+    list[4] = &this->m_SecantPairs.pool;
+
+    for (int l = 0; l < 5; ++l) {
+        for (size_t i = 0; i < list[l]->size(); ++i) {
+            if ((*list[l])[i] != NULL) {
+                ierr = VecDestroy(&(*list[l])[i]); CHKERRQ(ierr);
+            }
+        }
+        list[l]->clear();
+    }
+    this->m_SecantPairs.rho.clear();
+
+    if (this->m_SecantPairs.q != NULL) {
+        ierr = VecDestroy(&this->m_SecantPairs.q); CHKERRQ(ierr);
+        this->m_SecantPairs.q = NULL;
+    }
+
+    this->m_SecantPairs.stride = 1;
+    this->m_SecantPairs.nseen = 0;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief applies the preconditioner for the hessian to a vector
+ *******************************************************************/
+PetscErrorCode Preconditioner::Apply2LevelPrecond(Vec Px, Vec x) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+    ScalarType pct, value, *p_xc = NULL;
+    const ScalarType *p_yc = NULL;
+    IntType nxc[3], nx[3], nlc;
+    this->m_Opt->Enter(__func__);
+
+    // do allocation of coarse grid
+    if (!this->m_CoarseGrid->setupdone) {
+        ierr = this->SetupCoarseGrid(); CHKERRQ(ierr);
+    }
+
+    // the restriction of the variables involves all tasks; it has to be
+    // done before the krylov method on the coarse grid is invoked (the
+    // setup in InvertPrecondPreKrylovSolve only runs on the tasks of the
+    // coarse grid solve)
+    if (!this->m_Opt->m_KrylovMethod.pcsetupdone) {
+        ierr = this->DoSetup(); CHKERRQ(ierr);
+    }
+
+    // check if all the necessary pointers have been initialized
+    ierr = Assert(this->m_PreProc != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_CoarseGrid->m_Buffer != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_IncControlVariable != NULL, "null pointer"); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Active) {
+        ierr = Assert(this->m_CoarseGrid->x != NULL, "null pointer"); CHKERRQ(ierr);
+        ierr = Assert(this->m_CoarseGrid->y  != NULL, "null pointer"); CHKERRQ(ierr);
+        ierr = Assert(this->m_CoarseGrid->m_Opt != NULL, "null pointer"); CHKERRQ(ierr);
+    }
+
+    // allocate vector field
+    if (this->m_WorkVecField == NULL) {
+        try {this->m_WorkVecField = new VecField(this->m_Opt);}
+        catch (std::bad_alloc&) {
+            ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
+        }
+    }
+
+    pct = 0; // set to zero, cause we search for a max
+    for (int i = 0; i < 3; ++i) {
+        nx[i]  = this->m_Opt->m_Domain.nx[i];
+        nxc[i] = this->m_CoarseGrid->nx[i];
+        value  = static_cast<ScalarType>(nxc[i])/static_cast<ScalarType>(nx[i]);
+
+        pct = value > pct ? value : pct;
+    }
+
+    // local size of a component on the coarse grid (idle tasks hold no data)
+    nlc = this->m_CoarseGrid->m_Active ? this->m_CoarseGrid->nl() : 0;
+
+    // set components
+    ierr = this->m_WorkVecField->SetComponents(x); CHKERRQ(ierr);
+
+    // apply low pass filter before we restrict
+    // incremental control variable to coarse grid
+    ierr = this->m_PreProc->ApplyRectFreqFilter(this->m_IncControlVariable,
+                                                this->m_WorkVecField, pct); CHKERRQ(ierr);
+
+    // apply restriction operator to incremental control variable (the
+    // components are stored in the interface of the hessian matvec)
+    if (this->m_CoarseGrid->m_Active) {
+        ierr = GetRawPointer(this->m_CoarseGrid->x, &p_xc); CHKERRQ(ierr);
+    }
+    ierr = this->RestrictToCoarseGrid(p_xc,       this->m_IncControlVariable->m_X1); CHKERRQ(ierr);
+    ierr = this->RestrictToCoarseGrid(p_xc+nlc,   this->m_IncControlVariable->m_X2); CHKERRQ(ierr);
+    ierr = this->RestrictToCoarseGrid(p_xc+2*nlc, this->m_IncControlVariable->m_X3); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Active) {
+        ierr = RestoreRawPointer(this->m_CoarseGrid->x, &p_xc); CHKERRQ(ierr);
+    }
+
+    // invert preconditioner (idle tasks wait for the result)
+    ierr = this->SolveCoarseGrid(); CHKERRQ(ierr);
 
     // apply prolongation operator
-    ierr = this->m_PreProc->Prolong(this->m_IncControlVariable,
-                                    this->m_CoarseGrid->m_IncControlVariable, nx, nxc); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Active) {
+        ierr = GetRawPointerRead(this->m_CoarseGrid->y, &p_yc); CHKERRQ(ierr);
+    }
+    ierr = this->ProlongFromCoarseGrid(this->m_IncControlVariable->m_X1, p_yc      ); CHKERRQ(ierr);
+    ierr = this->ProlongFromCoarseGrid(this->m_IncControlVariable->m_X2, p_yc+nlc  ); CHKERRQ(ierr);
+    ierr = this->ProlongFromCoarseGrid(this->m_IncControlVariable->m_X3, p_yc+2*nlc); CHKERRQ(ierr);
+    if (this->m_CoarseGrid->m_Active) {
+        ierr = RestoreRawPointerRead(this->m_CoarseGrid->y, &p_yc); CHKERRQ(ierr);
+    }
 
     // apply low pass filter to output of hessian matvec
     ierr = this->m_PreProc->ApplyRectFreqFilter(this->m_IncControlVariable,
@@ -677,26 +1280,194 @@ PetscErrorCode Preconditioner::Apply2LevelPrecond(Vec Px, Vec x) {
 
 
 
+/********************************************************************
+ * @brief applies a cycle of the multilevel preconditioner to the
+ * residual b on the grid of this preconditioner (a level below the
+ * coarse grid of the two level preconditioner); the high frequency
+ * error is removed by chebyshev smoothing with the hessian on this
+ * grid (pre- and postsmoothing), the low frequency error by a
+ * correction on the coarse grid (one correction: v-cycle; two
+ * corrections: w-cycle); on the coarsest level the correction is
+ * computed with the krylov method of the two level preconditioner
+ * @param[out] e approximate solution of H e = b
+ * @param[in] b right hand side
+ *******************************************************************/
+PetscErrorCode Preconditioner::ApplyCycle(Vec e, Vec b) {
+    PetscErrorCode ierr = 0;
+    ScalarType *p_xc = NULL;
+    const ScalarType *p_yc = NULL;
+    IntType nlc;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    // do allocation of coarse grid
+    if (!this->m_CoarseGrid->setupdone) {
+        ierr = this->SetupCoarseGrid(); CHKERRQ(ierr);
+    }
+
+    // restrict variables (triggered by the finer level)
+    if (!this->m_Opt->m_KrylovMethod.pcsetupdone) {
+        ierr = this->DoSetup(); CHKERRQ(ierr);
+    }
+
+    if (this->m_Smoother == NULL) {
+        ierr = this->SetupSmoother(); CHKERRQ(ierr);
+    }
+
+    // all tasks take part in the coarser levels
+    ierr = Assert(this->m_CoarseGrid->m_Active, "coarse grid not active"); CHKERRQ(ierr);
+    ierr = Assert(this->m_IncControlVariable != NULL, "null pointer"); CHKERRQ(ierr);
+
+    // allocate work vectors
+    if (this->m_WorkVecField == NULL) {
+        try {this->m_WorkVecField = new VecField(this->m_Opt);}
+        catch (std::bad_alloc&) {
+            ierr = reg::ThrowError("allocation failed"); CHKERRQ(ierr);
+        }
+    }
+    if (this->m_Residual == NULL) {
+        ierr = VecDuplicate(b, &this->m_Residual); CHKERRQ(ierr);
+    }
+
+    nlc = this->m_CoarseGrid->nl();
+
+    // presmoothing
+    ierr = KSPSetInitialGuessNonzero(this->m_Smoother, PETSC_FALSE); CHKERRQ(ierr);
+    ierr = KSPSolve(this->m_Smoother, b, e); CHKERRQ(ierr);
+
+    for (int k = 0; k < this->m_Opt->m_KrylovMethod.pccycle; ++k) {
+        // compute residual r = b - H e
+        ierr = this->LevelHessianMatVec(this->m_Residual, e); CHKERRQ(ierr);
+        ierr = VecAYPX(this->m_Residual, -1.0, b); CHKERRQ(ierr);
+
+        // restrict residual to coarse grid
+        ierr = this->m_WorkVecField->SetComponents(this->m_Residual); CHKERRQ(ierr);
+        ierr = GetRawPointer(this->m_CoarseGrid->x, &p_xc); CHKERRQ(ierr);
+        ierr = this->RestrictToCoarseGrid(p_xc,       this->m_WorkVecField->m_X1); CHKERRQ(ierr);
+        ierr = this->RestrictToCoarseGrid(p_xc+nlc,   this->m_WorkVecField->m_X2); CHKERRQ(ierr);
+        ierr = this->RestrictToCoarseGrid(p_xc+2*nlc, this->m_WorkVecField->m_X3); CHKERRQ(ierr);
+        ierr = RestoreRawPointer(this->m_CoarseGrid->x, &p_xc); CHKERRQ(ierr);
+
+        // coarse grid correction
+        ierr = this->SolveCoarseGrid(); CHKERRQ(ierr);
+
+        // prolong correction and update solution
+        ierr = GetRawPointerRead(this->m_CoarseGrid->y, &p_yc); CHKERRQ(ierr);
+        ierr = this->ProlongFromCoarseGrid(this->m_IncControlVariable->m_X1, p_yc      ); CHKERRQ(ierr);
+        ierr = this->ProlongFromCoarseGrid(this->m_IncControlVariable->m_X2, p_yc+nlc  ); CHKERRQ(ierr);
+        ierr = this->ProlongFromCoarseGrid(this->m_IncControlVariable->m_X3, p_yc+2*nlc); CHKERRQ(ierr);
+        ierr = RestoreRawPointerRead(this->m_CoarseGrid->y, &p_yc); CHKERRQ(ierr);
+
+        ierr = this->m_IncControlVariable->GetComponents(this->m_Residual); CHKERRQ(ierr);
+        ierr = VecAXPY(e, 1.0, this->m_Residual); CHKERRQ(ierr);
+    }
+
+    // postsmoothing
+    ierr = KSPSetInitialGuessNonzero(this->m_Smoother, PETSC_TRUE); CHKERRQ(ierr);
+    ierr = KSPSolve(this->m_Smoother, b, e); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set up chebyshev smoother for the multilevel preconditioner;
+ * the operator is the hessian on the grid of this preconditioner; we
+ * apply a fixed number of iterations (no convergence test) and target
+ * the upper part of the spectrum (eigenvalues are estimated by petsc)
+ *******************************************************************/
+PetscErrorCode Preconditioner::SetupSmoother() {
+    PetscErrorCode ierr = 0;
+    PC pc = NULL;
+    IntType nl, ng;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(this->m_Smoother == NULL, "expecting null pointer"); CHKERRQ(ierr);
+
+    nl = this->m_Opt->m_Domain.nl;
+    ng = this->m_Opt->m_Domain.ng;
+
+    if (this->m_Opt->m_Verbosity > 2) {
+        ierr = DbgMsg("preconditioner: setup chebyshev smoother"); CHKERRQ(ierr);
+    }
+
+    ierr = KSPCreate(this->m_Opt->m_Comm, &this->m_Smoother); CHKERRQ(ierr);
+    ierr = KSPSetType(this->m_Smoother, KSPCHEBYSHEV); CHKERRQ(ierr);
+    ierr = KSPChebyshevEstEigSet(this->m_Smoother, 0.0, 0.1, 0.0, 1.1); CHKERRQ(ierr);
+
+    // fixed number of smoothing steps
+    ierr = KSPSetTolerances(this->m_Smoother, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT,
+                            this->m_Opt->m_KrylovMethod.pcsmooth); CHKERRQ(ierr);
+    ierr = KSPSetConvergenceTest(this->m_Smoother, KSPConvergedSkip, NULL, NULL); CHKERRQ(ierr);
+    ierr = KSPSetNormType(this->m_Smoother, KSP_NORM_NONE); CHKERRQ(ierr);
+
+    // set up matvec for smoother
+    if (this->m_MatVecSmoother != NULL) {
+        ierr = MatDestroy(&this->m_MatVecSmoother); CHKERRQ(ierr);
+        this->m_MatVecSmoother = NULL;
+    }
+    ierr = MatCreateShell(this->m_Opt->m_Comm, 3*nl, 3*nl, 3*ng, 3*ng, this, &this->m_MatVecSmoother); CHKERRQ(ierr);
+    ierr = MatShellSetOperation(this->m_MatVecSmoother, MATOP_MULT, (void(*)(void))SmootherMatVec); CHKERRQ(ierr);
+    ierr = MatSetOption(this->m_MatVecSmoother, MAT_SYMMETRIC, PETSC_TRUE); CHKERRQ(ierr);
+    ierr = KSPSetOperators(this->m_Smoother, this->m_MatVecSmoother, this->m_MatVecSmoother); CHKERRQ(ierr);
+
+    // remove preconditioner (we use a spectrally preconditioned
+    // representation of the hessian)
+    ierr = KSPGetPC(this->m_Smoother, &pc); CHKERRQ(ierr);
+    ierr = PCSetType(pc, PCNONE); CHKERRQ(ierr);
+
+    ierr = KSPAppendOptionsPrefix(this->m_Smoother, "pcsmooth_"); CHKERRQ(ierr);
+    ierr = KSPSetFromOptions(this->m_Smoother); CHKERRQ(ierr);
+    ierr = KSPSetUp(this->m_Smoother); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
 /********************************************************************
  * @brief applies the restriction operator to the state, adjoint,
- * and control variable (setup phase of 2level preconditioner)
+ * and control variable (setup phase of 2level preconditioner); the
+ * restricted data is cached: the reference image and the mask are
+ * restricted once (again only if the problem hands out a different
+ * vector or after a reset), the iterate dependent variables once per
+ * outer iteration; the setup itself is only triggered by the first
+ * application of the coarse solve in an outer iteration; all tasks
+ * apply the restriction, the restricted data is handed to the coarse
+ * grid problem on the tasks of the coarse grid solve
  *******************************************************************/
 PetscErrorCode Preconditioner::ApplyRestriction() {
     PetscErrorCode ierr = 0;
     IntType nl_f, nl_c, nt, nc, l_f, l_c, lnext_f, nx_c[3], nx_f[3];
     std::stringstream ss;
     Vec m = NULL, lambda = NULL;
-    ScalarType *p_mj = NULL, *p_m = NULL, *p_mjcoarse = NULL, *p_mcoarse = NULL,
-                *p_lj = NULL, *p_l = NULL, *p_ljcoarse = NULL, *p_lcoarse = NULL;
-    bool applyrestriction = true;
+    WorkSpace::ScaFieldLease xf;
+    ScalarType *p_mj = NULL, *p_mcoarse = NULL, *p_lj = NULL, *p_lcoarse = NULL,
+               *p_xcoarse = NULL, *p_v1 = NULL, *p_v2 = NULL, *p_v3 = NULL;
+    const ScalarType *p_m = NULL, *p_l = NULL;
+    bool applyrestriction = true, active;
+    long version;
     PetscFunctionBegin;
 
     this->m_Opt->Enter(__func__);
 
+    active = this->m_CoarseGrid->m_Active;
+
     // check if optimization problem is set up
     ierr = Assert(this->m_OptimizationProblem != NULL, "null pointer"); CHKERRQ(ierr);
     ierr = Assert(this->m_PreProc != NULL, "null pointer"); CHKERRQ(ierr);
-    ierr = Assert(this->m_CoarseGrid->m_Opt != NULL, "null pointer"); CHKERRQ(ierr);
+    if (active) {
+        ierr = Assert(this->m_CoarseGrid->m_Opt != NULL, "null pointer"); CHKERRQ(ierr);
+    }
 
     nt  = this->m_Opt->m_Domain.nt;
     nc  = this->m_Opt->m_Domain.nc;
@@ -705,9 +1476,9 @@ PetscErrorCode Preconditioner::ApplyRestriction() {
     nx_f[1] = this->m_Opt->m_Domain.nx[1];
     nx_f[2] = this->m_Opt->m_Domain.nx[2];
 
-    nx_c[0] = this->m_CoarseGrid->m_Opt->m_Domain.nx[0];
-    nx_c[1] = this->m_CoarseGrid->m_Opt->m_Domain.nx[1];
-    nx_c[2] = this->m_CoarseGrid->m_Opt->m_Domain.nx[2];
+    nx_c[0] = this->m_CoarseGrid->nx[0];
+    nx_c[1] = this->m_CoarseGrid->nx[1];
+    nx_c[2] = this->m_CoarseGrid->nx[2];
 
     if (this->m_Opt->m_Verbosity > 1) {
         ss  << "applying restriction to variables "
@@ -718,58 +1489,115 @@ PetscErrorCode Preconditioner::ApplyRestriction() {
     }
 
     // if parameter continuation is enabled, parse regularization weight
-    if (this->m_Opt->m_ParaCont.enabled) {
+    if (this->m_Opt->m_ParaCont.enabled && active) {
         this->m_CoarseGrid->m_Opt->m_RegNorm.beta[0] = this->m_Opt->m_RegNorm.beta[0];
         this->m_CoarseGrid->m_Opt->m_RegNorm.beta[1] = this->m_Opt->m_RegNorm.beta[1];
         this->m_CoarseGrid->m_Opt->m_RegNorm.beta[2] = this->m_Opt->m_RegNorm.beta[2];
     }
 
+    // static data (reference image and mask)
+    ierr = this->m_OptimizationProblem->GetReferenceImage(this->m_ReferenceImage); CHKERRQ(ierr);
+    if (this->m_ReferenceImage != this->m_CoarseGrid->m_ReferenceSource) {
+        if (this->m_Opt->m_Verbosity > 2) {
+            ierr = DbgMsg("preconditioner: applying restriction to reference image"); CHKERRQ(ierr);
+        }
+        if (active) {
+            ierr = VecGetArray(this->m_CoarseGrid->m_ReferenceImage, &p_xcoarse); CHKERRQ(ierr);
+        }
+        ierr = this->RestrictToCoarseGrid(p_xcoarse, this->m_ReferenceImage); CHKERRQ(ierr);
+        if (active) {
+            ierr = VecRestoreArray(this->m_CoarseGrid->m_ReferenceImage, &p_xcoarse); CHKERRQ(ierr);
+            ierr = this->m_CoarseGrid->m_OptimizationProblem->SetReferenceImage(this->m_CoarseGrid->m_ReferenceImage); CHKERRQ(ierr);
+            if (this->m_CoarseGrid->m_Precond != NULL) {
+                this->m_CoarseGrid->m_Precond->m_CoarseGrid->m_ReferenceSource = NULL;
+                this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcsetupdone = false;
+            }
+        }
+        this->m_CoarseGrid->m_ReferenceSource = this->m_ReferenceImage;
+    }
+
+    // if mask was set, we should have allocated mask for coarse grid
+    // during the setup phase
+    ierr = this->m_OptimizationProblem->GetMask(this->m_Mask); CHKERRQ(ierr);
+    if (this->m_Mask != NULL && this->m_Mask != this->m_CoarseGrid->m_MaskSource) {
+        if (active) {
+            ierr = Assert(this->m_CoarseGrid->m_Mask != NULL, "null pointer"); CHKERRQ(ierr);
+            ierr = VecGetArray(this->m_CoarseGrid->m_Mask, &p_xcoarse); CHKERRQ(ierr);
+        }
+        ierr = this->RestrictToCoarseGrid(p_xcoarse, this->m_Mask); CHKERRQ(ierr);
+        if (active) {
+            ierr = VecRestoreArray(this->m_CoarseGrid->m_Mask, &p_xcoarse); CHKERRQ(ierr);
+            ierr = this->m_CoarseGrid->m_OptimizationProblem->SetMask(this->m_CoarseGrid->m_Mask); CHKERRQ(ierr);
+            if (this->m_CoarseGrid->m_Precond != NULL) {
+                this->m_CoarseGrid->m_Precond->m_CoarseGrid->m_MaskSource = NULL;
+                this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcsetupdone = false;
+            }
+        }
+        this->m_CoarseGrid->m_MaskSource = this->m_Mask;
+    }
+
+    // iterate dependent data (the iterate only changes between outer iterations)
+    version = static_cast<long>(this->m_Opt->GetCounter(ITERATIONS));
+    if (version == this->m_CoarseGrid->m_Version) {
+        if (this->m_Opt->m_Verbosity > 1) {
+            ierr = DbgMsg("restricted variables are up to date"); CHKERRQ(ierr);
+        }
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
     // get variables from optimization problem on fine level
     ierr = this->m_OptimizationProblem->GetControlVariable(this->m_ControlVariable); CHKERRQ(ierr);
     ierr = this->m_OptimizationProblem->GetStateVariable(m); CHKERRQ(ierr);
     ierr = this->m_OptimizationProblem->GetAdjointVariable(lambda); CHKERRQ(ierr);
 
     // restrict control variable
-    ierr = this->m_PreProc->Restrict(this->m_CoarseGrid->m_ControlVariable,
-                                     this->m_ControlVariable, nx_c, nx_f); CHKERRQ(ierr);
+    if (active) {
+        ierr = this->m_CoarseGrid->m_ControlVariable->GetArrays(p_v1, p_v2, p_v3); CHKERRQ(ierr);
+    }
+    ierr = this->RestrictToCoarseGrid(p_v1, this->m_ControlVariable->m_X1); CHKERRQ(ierr);
+    ierr = this->RestrictToCoarseGrid(p_v2, this->m_ControlVariable->m_X2); CHKERRQ(ierr);
+    ierr = this->RestrictToCoarseGrid(p_v3, this->m_ControlVariable->m_X3); CHKERRQ(ierr);
+    if (active) {
+        ierr = this->m_CoarseGrid->m_ControlVariable->RestoreArrays(p_v1, p_v2, p_v3); CHKERRQ(ierr);
+    }
 
-    ierr = VecGetArray(m, &p_m); CHKERRQ(ierr);
-    ierr = VecGetArray(lambda, &p_l); CHKERRQ(ierr);
-    ierr = VecGetArray(this->m_CoarseGrid->m_StateVariable, &p_mcoarse); CHKERRQ(ierr);
-    ierr = VecGetArray(this->m_CoarseGrid->m_AdjointVariable, &p_lcoarse); CHKERRQ(ierr);
+    ierr = VecGetArrayRead(m, &p_m); CHKERRQ(ierr);
+    ierr = VecGetArrayRead(lambda, &p_l); CHKERRQ(ierr);
+    if (active) {
+        ierr = VecGetArray(this->m_CoarseGrid->m_StateVariable, &p_mcoarse); CHKERRQ(ierr);
+        ierr = VecGetArray(this->m_CoarseGrid->m_AdjointVariable, &p_lcoarse); CHKERRQ(ierr);
+    }
 
-    nl_c = this->m_CoarseGrid->m_Opt->m_Domain.nl;
+    // idle tasks hold no data on the coarse grid
+    nl_c = active ? this->m_CoarseGrid->m_Opt->m_Domain.nl : 0;
     nl_f = this->m_Opt->m_Domain.nl;
 
+    // work field on fine grid (returned to the pool at the end
+    // of the setup; the memory is reused by the coarse grid solve)
+    ierr = xf.Acquire(this->m_Opt->m_WorkSpace, this->m_Opt->m_Comm, nl_f, this->m_Opt->m_Domain.ng, "preconditioner"); CHKERRQ(ierr);
+
     // apply restriction operator to time series of images
     for (IntType j = 0; j <= nt; ++j) {  // for all time points
         for (IntType k = 0; k < nc; ++k) {  // for all components
             l_f = j*nl_f*nc + k*nl_f;
             lnext_f = j*nl_f*nc + (k+1)*nl_f;
+            l_c = j*nl_c*nc + k*nl_c;
 
             /////////////////////////////////////////////////////////////////////
             ////// state variable
             /////////////////////////////////////////////////////////////////////
             // get time point of state variable on fine grid
-            ierr = VecGetArray(this->m_WorkScaField1, &p_mj); CHKERRQ(ierr);
+            ierr = VecGetArray(xf.m_X, &p_mj); CHKERRQ(ierr);
             try {std::copy(p_m+l_f, p_m+lnext_f, p_mj); }
             catch (std::exception&) {
                 ierr = ThrowError("copy failed"); CHKERRQ(ierr);
             }
-            ierr = VecRestoreArray(this->m_WorkScaField1, &p_mj); CHKERRQ(ierr);
-
-            // apply restriction operator to m_j
-            ierr = this->m_PreProc->Restrict(&this->m_CoarseGrid->m_WorkScaField1,
-                                              this->m_WorkScaField1, nx_c, nx_f); CHKERRQ(ierr);
+            ierr = VecRestoreArray(xf.m_X, &p_mj); CHKERRQ(ierr);
 
-            // store restricted state variable
-            l_c = j*nl_c*nc + k*nl_c;
-            ierr = VecGetArray(this->m_CoarseGrid->m_WorkScaField1, &p_mjcoarse); CHKERRQ(ierr);
-            try {std::copy(p_mjcoarse, p_mjcoarse+nl_c, p_mcoarse+l_c);}
-            catch (std::exception&) {
-                ierr = ThrowError("copy failed"); CHKERRQ(ierr);
-            }
-            ierr = VecRestoreArray(this->m_CoarseGrid->m_WorkScaField1, &p_mjcoarse); CHKERRQ(ierr);
+            // apply restriction operator to m_j and store
+            // restricted state variable
+            ierr = this->RestrictToCoarseGrid(p_mcoarse+l_c, xf.m_X); CHKERRQ(ierr);
 
             /////////////////////////////////////////////////////////////////////
             ////// adjoint variable
@@ -782,48 +1610,46 @@ PetscErrorCode Preconditioner::ApplyRestriction() {
 
             if (applyrestriction) {
                 // get time point of adjoint variable on fine grid
-                ierr = VecGetArray(this->m_WorkScaField2, &p_lj); CHKERRQ(ierr);
+                ierr = VecGetArray(xf.m_X, &p_lj); CHKERRQ(ierr);
                 try {std::copy(p_l+l_f, p_l+lnext_f, p_lj);}
                 catch(std::exception& err) {
                     ierr = ThrowError(err); CHKERRQ(ierr);
                 }
-                ierr = VecRestoreArray(this->m_WorkScaField2, &p_lj); CHKERRQ(ierr);
+                ierr = VecRestoreArray(xf.m_X, &p_lj); CHKERRQ(ierr);
 
-                // apply restriction operator
-                ierr = this->m_PreProc->Restrict(&this->m_CoarseGrid->m_WorkScaField2,
-                                                  this->m_WorkScaField2, nx_c, nx_f); CHKERRQ(ierr);
-
-                // store restricted adjoint variable
-                ierr = VecGetArray(this->m_CoarseGrid->m_WorkScaField2, &p_ljcoarse); CHKERRQ(ierr);
-                try {std::copy(p_ljcoarse, p_ljcoarse+nl_c, p_lcoarse+l_c);}
-                catch(std::exception& err) {
-                    ierr = ThrowError(err); CHKERRQ(ierr);
-                }
-                ierr = VecRestoreArray(this->m_CoarseGrid->m_WorkScaField2, &p_ljcoarse); CHKERRQ(ierr);
+                // apply restriction operator and store
+                // restricted adjoint variable
+                ierr = this->RestrictToCoarseGrid(p_lcoarse+l_c, xf.m_X); CHKERRQ(ierr);
             }
 
         }  // for all components
     }  // for all time points
 
-    ierr = VecRestoreArray(this->m_CoarseGrid->m_AdjointVariable, &p_lcoarse); CHKERRQ(ierr);
-    ierr = VecRestoreArray(this->m_CoarseGrid->m_StateVariable, &p_mcoarse); CHKERRQ(ierr);
-    ierr = VecRestoreArray(lambda, &p_l); CHKERRQ(ierr);
-    ierr = VecRestoreArray(m, &p_m); CHKERRQ(ierr);
+    if (active) {
+        ierr = VecRestoreArray(this->m_CoarseGrid->m_AdjointVariable, &p_lcoarse); CHKERRQ(ierr);
+        ierr = VecRestoreArray(this->m_CoarseGrid->m_StateVariable, &p_mcoarse); CHKERRQ(ierr);
+    }
+    ierr = VecRestoreArrayRead(lambda, &p_l); CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(m, &p_m); CHKERRQ(ierr);
 
     // parse variables to optimization problem on coarse level
     // (we have to set the control variable first)
-    ierr = this->m_CoarseGrid->m_OptimizationProblem->SetControlVariable(this->m_CoarseGrid->m_ControlVariable); CHKERRQ(ierr);
-    ierr = this->m_CoarseGrid->m_OptimizationProblem->SetStateVariable(this->m_CoarseGrid->m_StateVariable); CHKERRQ(ierr);
-    ierr = this->m_CoarseGrid->m_OptimizationProblem->SetAdjointVariable(this->m_CoarseGrid->m_AdjointVariable); CHKERRQ(ierr);
-
-    // if mask was set, we should have allocated mask for coarse grid
-    // during the setup phase
-    if (this->m_Mask != NULL) {
-        // apply restriction operator
-        ierr = this->m_PreProc->Restrict(&this->m_CoarseGrid->m_Mask, this->m_Mask, nx_c, nx_f); CHKERRQ(ierr);
-        ierr = this->m_CoarseGrid->m_OptimizationProblem->SetMask(this->m_CoarseGrid->m_Mask); CHKERRQ(ierr);
+    if (active) {
+        ierr = this->m_CoarseGrid->m_OptimizationProblem->SetControlVariable(this->m_CoarseGrid->m_ControlVariable); CHKERRQ(ierr);
+        ierr = this->m_CoarseGrid->m_OptimizationProblem->SetStateVariable(this->m_CoarseGrid->m_StateVariable); CHKERRQ(ierr);
+        ierr = this->m_CoarseGrid->m_OptimizationProblem->SetAdjointVariable(this->m_CoarseGrid->m_AdjointVariable); CHKERRQ(ierr);
+
+        // the coarser levels restrict the data from the coarse grid (the
+        // outer iterations are not counted on the coarse grid; we trigger
+        // the restriction here; it is done with the next cycle)
+        if (this->m_CoarseGrid->m_Precond != NULL) {
+            this->m_CoarseGrid->m_Precond->m_CoarseGrid->m_Version = -1;
+            this->m_CoarseGrid->m_Opt->m_KrylovMethod.pcsetupdone = false;
+        }
     }
 
+    this->m_CoarseGrid->m_Version = version;
+
     this->m_Opt->Exit(__func__);
 
     PetscFunctionReturn(0);
@@ -843,7 +1669,7 @@ PetscErrorCode Preconditioner::SetupKrylovMethod(IntType nl, IntType ng) {
     this->m_Opt->Enter(__func__);
 
     ierr = Assert(this->m_KrylovMethod == NULL, "expecting null pointer"); CHKERRQ(ierr);
-    ierr = KSPCreate(PETSC_COMM_WORLD, &this->m_KrylovMethod); CHKERRQ(ierr);
+    ierr = KSPCreate(this->m_CoarseGrid->m_Opt->m_Comm, &this->m_KrylovMethod); CHKERRQ(ierr);
 
     if (this->m_Opt->m_Verbosity > 2) {
         ierr = DbgMsg("preconditioner: setup krylovmethod"); CHKERRQ(ierr);
@@ -923,7 +1749,7 @@ PetscErrorCode Preconditioner::SetupKrylovMethod(IntType nl, IntType ng) {
         this->m_MatVec = NULL;
     }
 
-    ierr = MatCreateShell(PETSC_COMM_WORLD, 3*nl, 3*nl, 3*ng, 3*ng, this, &this->m_MatVec); CHKERRQ(ierr);
+    ierr = MatCreateShell(this->m_CoarseGrid->m_Opt->m_Comm, 3*nl, 3*nl, 3*ng, 3*ng, this, &this->m_MatVec); CHKERRQ(ierr);
     ierr = MatShellSetOperation(this->m_MatVec, MATOP_MULT, (void(*)(void))InvertPrecondMatVec); CHKERRQ(ierr);
     ierr = KSPSetOperators(this->m_KrylovMethod, this->m_MatVec, this->m_MatVec);CHKERRQ(ierr);
 
@@ -992,18 +1818,51 @@ PetscErrorCode Preconditioner::HessianMatVec(Vec Hx, Vec x) {
 
 
 
+/********************************************************************
+ * @brief apply the hessian on the grid of this preconditioner (used
+ * by the smoother and the residual of the multilevel preconditioner)
+ *******************************************************************/
+PetscErrorCode Preconditioner::LevelHessianMatVec(Vec Hx, Vec x) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    // no scaling by the spatial integration (see HessianMatVec)
+    ierr = this->m_OptimizationProblem->HessianMatVec(Hx, x, false); CHKERRQ(ierr);
+
+    // increment counter
+    this->m_Opt->IncrementCounter(PCMATVEC);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
 /********************************************************************
  * @brief this is an interface to compute the eigenvalues needed
  * when considering a chebyshev method to invert the preconditioner;
  * the eigenvalues are estimated using the Lanczo (KSPCG) or
- * Arnoldi (KSPGMRES) process using a random right hand side vector
+ * Arnoldi (KSPGMRES) process using a random right hand side vector;
+ * the estimates of our own estimator are cached together with the
+ * signature of the problem (grid, regularization, image statistics);
+ * they are reused if the signature matches and are updated by a few
+ * power iterations (starting from the stored eigenvector) if only
+ * the regularization weights, the images or the iterate changed
  *******************************************************************/
 PetscErrorCode Preconditioner::EstimateEigenValues() {
     PetscErrorCode ierr = 0;
     IntType i, n, neig, nl, ng;
+    int k, match, update;
     std::stringstream ss;
     Vec b = NULL, x = NULL;
     ScalarType *re = NULL, *im = NULL, eigmin, eigmax, emin, emax;
+    const ScalarType tol = 1E-2;    ///< relative tolerance for matching signatures
+    const int npowerits = 5;      ///< power iterations for updating an estimate
+    const ScalarType safety = 1.1;  ///< safety factor for the largest eigenvalue (the estimates are lower bounds)
+    EigEstimate sig;
 
     PetscFunctionBegin;
 
@@ -1046,45 +1905,102 @@ PetscErrorCode Preconditioner::EstimateEigenValues() {
 //                                                               PETSC_DECIDE, PETSC_DECIDE); CHKERRQ(ierr);
             ierr = KSPChebyshevEstEigSet(this->m_KrylovMethod, 0.0, 0.1, 0.0, 1.1); CHKERRQ(ierr);
         } else {
-            if (this->m_Opt->m_Verbosity > 1) {
-                ierr = DbgMsg("estimating eigenvalues"); CHKERRQ(ierr);
+            ierr = this->ComputeEigSignature(sig); CHKERRQ(ierr);
+            if (!this->m_EigEstimatesRead) {
+                ierr = this->ReadEigEstimates(); CHKERRQ(ierr);
             }
-            // get sizes
-            nl = this->m_Opt->m_Domain.nl;
-            ng = this->m_Opt->m_Domain.ng;
 
-            ierr = VecCreate(x, 3*nl, 3*ng); CHKERRQ(ierr);
-            ierr = VecCreate(b, 3*nl, 3*ng); CHKERRQ(ierr);
-
-            // use random right hand side
-            if (this->m_RandomNumGen == NULL) {
-                ierr = PetscRandomCreate(PetscObjectComm((PetscObject)b), &this->m_RandomNumGen); CHKERRQ(ierr);
+            // find estimate for the same problem (match) or for the
+            // same grid with an eigenvector we can start from (update)
+            match = -1; update = -1;
+            for (k = 0; k < static_cast<int>(this->m_EigEstimates.size()); ++k) {
+                EigEstimate& est = this->m_EigEstimates[k];
+                if (est.nx[0] != sig.nx[0] || est.nx[1] != sig.nx[1]
+                    || est.nx[2] != sig.nx[2] || est.regnorm != sig.regnorm) continue;
+                if (est.v != NULL) update = k;
+                if (   std::abs(est.beta[0] - sig.beta[0]) <= tol*sig.beta[0]
+                    && std::abs(est.beta[1] - sig.beta[1]) <= tol*sig.beta[1]
+                    && std::abs(est.rnorm - sig.rnorm) <= tol*sig.rnorm
+                    && std::abs(est.tnorm - sig.tnorm) <= tol*sig.tnorm) match = k;
             }
-            ierr = VecSetRandom(b, this->m_RandomNumGen); CHKERRQ(ierr);
 
-            // do setup
-            if (this->m_KrylovMethodEigEst == NULL) {
-                ierr = this->SetupKrylovMethodEigEst(); CHKERRQ(ierr);
-            }
-            ierr = Assert(this->m_KrylovMethodEigEst != NULL, "null pointer"); CHKERRQ(ierr);
+            // the iterate is not part of the signature; if the user asks
+            // for new estimates, we update them
+            if (match != -1 && this->m_Opt->m_KrylovMethod.reesteigvals == 0) {
+                if (this->m_Opt->m_Verbosity > 1) {
+                    ierr = DbgMsg("reusing eigenvalue estimates"); CHKERRQ(ierr);
+                }
+                eigmin = this->m_EigEstimates[match].emin;
+                eigmax = this->m_EigEstimates[match].emax;
+            } else if (update != -1) {
+                if (this->m_Opt->m_Verbosity > 1) {
+                    ierr = DbgMsg("updating eigenvalue estimates (power iterations)"); CHKERRQ(ierr);
+                }
+                // the smallest eigenvalue of the spectrally preconditioned
+                // hessian is bounded from below by one; we only update the
+                // largest eigenvalue
+                EigEstimate& est = this->m_EigEstimates[update];
+                ierr = this->ApplyPowerIterations(est.v, eigmax, npowerits); CHKERRQ(ierr);
+                eigmax *= safety;
+                eigmin = est.emin;
+                sig.v = est.v; sig.emin = eigmin; sig.emax = eigmax;
+                est = sig;
+                ierr = this->WriteEigEstimate(est); CHKERRQ(ierr);
+            } else {
+                if (this->m_Opt->m_Verbosity > 1) {
+                    ierr = DbgMsg("estimating eigenvalues"); CHKERRQ(ierr);
+                }
+                // get sizes (the operator is the hessian on the coarse grid)
+                nl = this->m_CoarseGrid->nl();
+                ng = this->m_CoarseGrid->ng();
+
+                ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, x, 3*nl, 3*ng, 3); CHKERRQ(ierr);
+                ierr = VecCreate(this->m_CoarseGrid->m_Opt->m_Comm, b, 3*nl, 3*ng, 3); CHKERRQ(ierr);
 
-            ierr = KSPSolve(this->m_KrylovMethodEigEst, b, x); CHKERRQ(ierr);
-            ierr = KSPGetIterationNumber(this->m_KrylovMethodEigEst, &n); CHKERRQ(ierr);
+                // use random right hand side
+                if (this->m_RandomNumGen == NULL) {
+                    ierr = PetscRandomCreate(PetscObjectComm((PetscObject)b), &this->m_RandomNumGen); CHKERRQ(ierr);
+                }
+                ierr = VecSetRandom(b, this->m_RandomNumGen); CHKERRQ(ierr);
 
-            ierr = PetscMalloc2(n, &re, n, &im); CHKERRQ(ierr);
-            ierr = KSPComputeEigenvalues(this->m_KrylovMethodEigEst, n, re, im, &neig); CHKERRQ(ierr);
+                // do setup
+                if (this->m_KrylovMethodEigEst == NULL) {
+                    ierr = this->SetupKrylovMethodEigEst(); CHKERRQ(ierr);
+                }
+                ierr = Assert(this->m_KrylovMethodEigEst != NULL, "null pointer"); CHKERRQ(ierr);
 
-            eigmin = PETSC_MAX_REAL;
-            eigmax = PETSC_MIN_REAL;
+                ierr = KSPSolve(this->m_KrylovMethodEigEst, b, x); CHKERRQ(ierr);
+                ierr = KSPGetIterationNumber(this->m_KrylovMethodEigEst, &n); CHKERRQ(ierr);
 
-            for (i = 0; i < neig; ++i) {
-                eigmin = PetscMin(eigmin, re[i]);
-                eigmax = PetscMax(eigmax, re[i]);
-            }
+                ierr = PetscMalloc2(n, &re, n, &im); CHKERRQ(ierr);
+                ierr = KSPComputeEigenvalues(this->m_KrylovMethodEigEst, n, re, im, &neig); CHKERRQ(ierr);
 
-            // clear memory
-            ierr = PetscFree2(re, im); CHKERRQ(ierr);
-            ierr = this->m_CoarseGrid->m_OptimizationProblem->EstimateExtremalHessEigVals(emin, emax); CHKERRQ(ierr);
+                eigmin = PETSC_MAX_REAL;
+                eigmax = PETSC_MIN_REAL;
+
+                for (i = 0; i < neig; ++i) {
+                    eigmin = PetscMin(eigmin, re[i]);
+                    eigmax = PetscMax(eigmax, re[i]);
+                }
+
+                // clear memory
+                ierr = PetscFree2(re, im); CHKERRQ(ierr);
+                ierr = this->m_CoarseGrid->m_OptimizationProblem->EstimateExtremalHessEigVals(emin, emax); CHKERRQ(ierr);
+
+                // eigenvector of largest eigenvalue (start of later updates;
+                // the random vector is kept)
+                ierr = this->ApplyPowerIterations(b, emax, npowerits); CHKERRQ(ierr);
+                eigmax = safety*PetscMax(eigmax, emax);
+
+                sig.emin = eigmin; sig.emax = eigmax; sig.v = b; b = NULL;
+                if (match != -1) {
+                    // estimate read from file is replaced
+                    this->m_EigEstimates[match] = sig;
+                } else {
+                    this->m_EigEstimates.push_back(sig);
+                }
+                ierr = this->WriteEigEstimate(sig); CHKERRQ(ierr);
+            }
 
             ierr = KSPChebyshevSetEigenvalues(this->m_KrylovMethod, eigmax, eigmin); CHKERRQ(ierr);
         }   // switch between eigenvalue estimators
@@ -1102,6 +2018,209 @@ PetscErrorCode Preconditioner::EstimateEigenValues() {
 
 
 
+/********************************************************************
+ * @brief compute signature of the problem on the coarse grid the
+ * eigenvalues are estimated for (grid size, regularization norm and
+ * weights, and root mean square of reference and template image)
+ *******************************************************************/
+PetscErrorCode Preconditioner::ComputeEigSignature(EigEstimate& sig) {
+    PetscErrorCode ierr = 0;
+    IntType nl, ng, nc, nr;
+    int mpierr;
+    ScalarType value, sum, rval;
+    const ScalarType *p_m = NULL;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(this->m_CoarseGrid->m_ReferenceImage != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(this->m_CoarseGrid->m_StateVariable != NULL, "null pointer"); CHKERRQ(ierr);
+
+    nl = this->m_CoarseGrid->nl();
+    ng = this->m_CoarseGrid->ng();
+    nc = this->m_Opt->m_Domain.nc;
+
+    for (int i = 0; i < 3; ++i) {
+        sig.nx[i] = this->m_CoarseGrid->nx[i];
+    }
+    sig.regnorm = static_cast<int>(this->m_Opt->m_RegNorm.type);
+    sig.beta[0] = this->m_Opt->m_RegNorm.beta[0];
+    sig.beta[1] = this->m_Opt->m_RegNorm.beta[1];
+
+    ierr = VecNorm(this->m_CoarseGrid->m_ReferenceImage, NORM_2, &value); CHKERRQ(ierr);
+    ierr = VecGetSize(this->m_CoarseGrid->m_ReferenceImage, &nr); CHKERRQ(ierr);
+    sig.rnorm = value/std::sqrt(static_cast<ScalarType>(nr));
+
+    // template image is the state variable at t=0
+    sum = 0.0;
+    ierr = VecGetArrayRead(this->m_CoarseGrid->m_StateVariable, &p_m); CHKERRQ(ierr);
+    for (IntType i = 0; i < nc*nl; ++i) {
+        sum += p_m[i]*p_m[i];
+    }
+    ierr = VecRestoreArrayRead(this->m_CoarseGrid->m_StateVariable, &p_m); CHKERRQ(ierr);
+    mpierr = MPI_Allreduce(&sum, &rval, 1, MPIU_REAL, MPI_SUM, this->m_CoarseGrid->m_Opt->m_Comm);
+    ierr = Assert(mpierr == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+    sig.tnorm = std::sqrt(rval/static_cast<ScalarType>(nc*ng));
+
+    sig.emin = 0.0;
+    sig.emax = 0.0;
+    sig.v = NULL;
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief estimate the largest eigenvalue of the hessian on the coarse
+ * grid with power iterations
+ * @param[in,out] v start vector; normalized estimate of eigenvector
+ * @param[out] emax rayleigh quotient of last iterate
+ * @param[in] n number of iterations
+ *******************************************************************/
+PetscErrorCode Preconditioner::ApplyPowerIterations(Vec v, ScalarType& emax, int n) {
+    PetscErrorCode ierr = 0;
+    ScalarType norm;
+    Vec w = NULL;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = VecDuplicate(v, &w); CHKERRQ(ierr);
+
+    ierr = VecNorm(v, NORM_2, &norm); CHKERRQ(ierr);
+    ierr = Assert(norm > 0.0, "zero start vector"); CHKERRQ(ierr);
+    ierr = VecScale(v, 1.0/norm); CHKERRQ(ierr);
+
+    emax = 0.0;
+    for (int k = 0; k < n; ++k) {
+        ierr = this->HessianMatVec(w, v); CHKERRQ(ierr);
+        ierr = VecDot(v, w, &emax); CHKERRQ(ierr);
+        ierr = VecNorm(w, NORM_2, &norm); CHKERRQ(ierr);
+        if (norm == 0.0) break;
+        ierr = VecAXPBY(v, 1.0/norm, 0.0, w); CHKERRQ(ierr);
+    }
+
+    ierr = VecDestroy(&w); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief read eigenvalue estimates from file (one estimate per line:
+ * grid size, regularization norm and weights, rms of reference and
+ * template image, smallest and largest eigenvalue); estimates read
+ * from file do not have an eigenvector
+ *******************************************************************/
+PetscErrorCode Preconditioner::ReadEigEstimates() {
+    PetscErrorCode ierr = 0;
+    std::ifstream reader;
+    std::string line;
+    EigEstimate est;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    this->m_EigEstimatesRead = true;
+    if (this->m_Opt->m_FileNames.pceigfile.empty()) {
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
+    // the file may not exist yet
+    reader.open(this->m_Opt->m_FileNames.pceigfile.c_str());
+    if (!reader.is_open()) {
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
+    while (std::getline(reader, line)) {
+        std::istringstream iss(line);
+        if (iss >> est.nx[0] >> est.nx[1] >> est.nx[2] >> est.regnorm
+                >> est.beta[0] >> est.beta[1] >> est.rnorm >> est.tnorm
+                >> est.emin >> est.emax) {
+            est.v = NULL;
+            this->m_EigEstimates.push_back(est);
+        }
+    }
+    reader.close();
+
+    if (this->m_Opt->m_Verbosity > 1) {
+        std::stringstream ss;
+        ss << "read " << this->m_EigEstimates.size() << " eigenvalue estimate(s) from "
+           << this->m_Opt->m_FileNames.pceigfile;
+        ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief append eigenvalue estimate to file (master rank of all
+ * tasks; the preconditioners of the task groups of the parameter
+ * continuation do not write concurrently to the same file)
+ *******************************************************************/
+PetscErrorCode Preconditioner::WriteEigEstimate(const EigEstimate& est) {
+    PetscErrorCode ierr = 0;
+    std::ofstream writer;
+    int rank;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    if (rank == 0 && !this->m_Opt->m_FileNames.pceigfile.empty()) {
+        writer.open(this->m_Opt->m_FileNames.pceigfile.c_str(), std::ofstream::out | std::ofstream::app);
+        ierr = Assert(writer.is_open(), "could not open file for writing"); CHKERRQ(ierr);
+        writer << est.nx[0] << " " << est.nx[1] << " " << est.nx[2] << " " << est.regnorm
+               << std::scientific << std::setprecision(8)
+               << " " << est.beta[0] << " " << est.beta[1]
+               << " " << est.rnorm << " " << est.tnorm
+               << " " << est.emin << " " << est.emax << std::endl;
+        writer.close();
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief release cached eigenvalue estimates
+ *******************************************************************/
+PetscErrorCode Preconditioner::ClearEigEstimates() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    for (size_t k = 0; k < this->m_EigEstimates.size(); ++k) {
+        if (this->m_EigEstimates[k].v != NULL) {
+            ierr = VecDestroy(&this->m_EigEstimates[k].v); CHKERRQ(ierr);
+        }
+    }
+    this->m_EigEstimates.clear();
+    this->m_EigEstimatesRead = false;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
 /********************************************************************
  * @brief do setup for krylov method to estimate eigenvalues
  *******************************************************************/
@@ -1113,16 +2232,16 @@ PetscErrorCode Preconditioner::SetupKrylovMethodEigEst() {
 
     this->m_Opt->Enter(__func__);
 
-    // get sizes
-    nl = this->m_Opt->m_Domain.nl;
-    ng = this->m_Opt->m_Domain.ng;
+    // get sizes (the operator is the hessian on the coarse grid)
+    nl = this->m_CoarseGrid->nl();
+    ng = this->m_CoarseGrid->ng();
 
     // create krylov method
     if (this->m_KrylovMethodEigEst != NULL) {
         ierr = KSPDestroy(&this->m_KrylovMethodEigEst); CHKERRQ(ierr);
         this->m_KrylovMethodEigEst = NULL;
     }
-    ierr = KSPCreate(PETSC_COMM_WORLD,&this->m_KrylovMethodEigEst); CHKERRQ(ierr);
+    ierr = KSPCreate(this->m_CoarseGrid->m_Opt->m_Comm, &this->m_KrylovMethodEigEst); CHKERRQ(ierr);
 
     // preconditioned conjugate gradient
     ierr = KSPSetType(this->m_KrylovMethodEigEst, KSPCG); CHKERRQ(ierr);
@@ -1140,7 +2259,7 @@ PetscErrorCode Preconditioner::SetupKrylovMethodEigEst() {
         this->m_MatVec = NULL;
     }
 
-    ierr = MatCreateShell(PETSC_COMM_WORLD, 3*nl, 3*nl, 3*ng, 3*ng, this, &this->m_MatVecEigEst); CHKERRQ(ierr);
+    ierr = MatCreateShell(this->m_CoarseGrid->m_Opt->m_Comm, 3*nl, 3*nl, 3*ng, 3*ng, this, &this->m_MatVecEigEst); CHKERRQ(ierr);
     ierr = MatShellSetOperation(this->m_MatVecEigEst, MATOP_MULT, (void(*)(void))InvertPrecondMatVec); CHKERRQ(ierr);
     ierr = KSPSetOperators(this->m_KrylovMethodEigEst, this->m_MatVecEigEst, this->m_MatVecEigEst); CHKERRQ(ierr);
     ierr = MatSetOption(this->m_MatVecEigEst, MAT_SYMMETRIC, PETSC_TRUE); CHKERRQ(ierr);
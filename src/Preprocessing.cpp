@@ -781,8 +781,8 @@ PetscErrorCode Preprocessing::Restrict(Vec* x_c, Vec x_f, IntType* nx_c, IntType
         ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
     }
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nprocs);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+    MPI_Comm_size(this->m_Opt->m_Comm, &nprocs);
 
     ierr = Assert(x_f != NULL, "null pointer"); CHKERRQ(ierr);
     ierr = Assert(x_c != NULL, "null pointer"); CHKERRQ(ierr);
@@ -926,8 +926,8 @@ PetscErrorCode Preprocessing::ComputeGridChangeIndices(IntType* nx_f, IntType* n
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
-    MPI_Comm_size(PETSC_COMM_WORLD,&nprocs);
+    MPI_Comm_rank(this->m_Opt->m_Comm,&rank);
+    MPI_Comm_size(this->m_Opt->m_Comm,&nprocs);
 
     ierr = Assert(nx_c[0] <= nx_f[0], "grid size in restriction wrong"); CHKERRQ(ierr);
     ierr = Assert(nx_c[1] <= nx_f[1], "grid size in restriction wrong"); CHKERRQ(ierr);
@@ -1038,7 +1038,7 @@ PetscErrorCode Preprocessing::ComputeGridChangeIndices(IntType* nx_f, IntType* n
         }  // i2
     }  // i3
 
-    MPI_Barrier(PETSC_COMM_WORLD);
+    MPI_Barrier(this->m_Opt->m_Comm);
     // do the communication
     ierr = this->GridChangeCommIndices(); CHKERRQ(ierr);
 
@@ -1066,8 +1066,8 @@ PetscErrorCode Preprocessing::GridChangeCommIndices() {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nprocs);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+    MPI_Comm_size(this->m_Opt->m_Comm, &nprocs);
 
     if (this->m_OffsetSend == NULL) {
         try{this->m_OffsetSend = new IntType[nprocs];}
@@ -1121,7 +1121,7 @@ PetscErrorCode Preprocessing::GridChangeCommIndices() {
     }
     // communicate the amount of data we will send from one
     // processor to another (all to all)
-    merr = MPI_Alltoall(&this->m_NumSend[0], 1, MPIU_INT, &this->m_NumRecv[0], 1, MPIU_INT, PETSC_COMM_WORLD);
+    merr = MPI_Alltoall(&this->m_NumSend[0], 1, MPIU_INT, &this->m_NumRecv[0], 1, MPIU_INT, this->m_Opt->m_Comm);
     ierr = MPIERRQ(merr); CHKERRQ(ierr);
 
     ierr = Assert(this->m_NumSend[rank] == this->m_NumRecv[rank], "alltoall error"); CHKERRQ(ierr);
@@ -1241,7 +1241,7 @@ PetscErrorCode Preprocessing::GridChangeCommIndices() {
         if (ns > 0) {
             ierr = Assert(&this->m_FourierIndicesSendF[3*os_send] != NULL, "null pointer"); CHKERRQ(ierr);
             merr = MPI_Isend(&this->m_FourierIndicesSendF[3*os_send],
-                             3*ns, MPIU_INT, i_send, 0, PETSC_COMM_WORLD,
+                             3*ns, MPIU_INT, i_send, 0, this->m_Opt->m_Comm,
                              &this->m_SendRequest[i_send]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1251,7 +1251,7 @@ PetscErrorCode Preprocessing::GridChangeCommIndices() {
         if (nr > 0) {
             ierr = Assert(&this->m_FourierIndicesRecvF[3*os_recv] != NULL, "null pointer"); CHKERRQ(ierr);
             merr = MPI_Irecv(&this->m_FourierIndicesRecvF[3*os_recv],
-                             3*nr, MPIU_INT, i_recv, 0, PETSC_COMM_WORLD,
+                             3*nr, MPIU_INT, i_recv, 0, this->m_Opt->m_Comm,
                              &this->m_RecvRequest[i_recv]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1278,7 +1278,7 @@ PetscErrorCode Preprocessing::GridChangeCommIndices() {
         os_send = this->m_OffsetSend[i];
         if (ns > 0) {
             merr = MPI_Isend(&this->m_FourierIndicesSendC[3*os_send],
-                             3*ns, MPIU_INT, i_send, 0, PETSC_COMM_WORLD,
+                             3*ns, MPIU_INT, i_send, 0, this->m_Opt->m_Comm,
                              &this->m_SendRequest[i_send]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1287,7 +1287,7 @@ PetscErrorCode Preprocessing::GridChangeCommIndices() {
         os_recv = this->m_OffsetRecv[i];
         if (nr > 0) {
             merr = MPI_Irecv(&this->m_FourierIndicesRecvC[3*os_recv],
-                             3*nr, MPIU_INT, i_recv, 0, PETSC_COMM_WORLD,
+                             3*nr, MPIU_INT, i_recv, 0, this->m_Opt->m_Comm,
                              &this->m_RecvRequest[i_recv]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1330,8 +1330,8 @@ PetscErrorCode Preprocessing::GridChangeCommDataRestrict() {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
-    MPI_Comm_size(PETSC_COMM_WORLD,&nprocs);
+    MPI_Comm_rank(this->m_Opt->m_Comm,&rank);
+    MPI_Comm_size(this->m_Opt->m_Comm,&nprocs);
 
     ierr = Assert(this->m_OffsetSend != NULL, "error in setup"); CHKERRQ(ierr);
     ierr = Assert(this->m_OffsetRecv != NULL, "error in setup"); CHKERRQ(ierr);
@@ -1423,7 +1423,7 @@ PetscErrorCode Preprocessing::GridChangeCommDataRestrict() {
         ns = this->m_NumSend[i];
         if (ns > 0) {
             merr = MPI_Isend(&this->m_FourierCoeffSendF[2*os_send],
-                             2*ns, MPIU_REAL, i_send, 0, PETSC_COMM_WORLD,
+                             2*ns, MPIU_REAL, i_send, 0, this->m_Opt->m_Comm,
                              &this->m_SendRequest[i_send]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1432,7 +1432,7 @@ PetscErrorCode Preprocessing::GridChangeCommDataRestrict() {
         nr      = this->m_NumRecv[i];
         if (nr > 0) {
             merr = MPI_Irecv(&this->m_FourierCoeffRecvF[2*os_recv],
-                             2*nr, MPIU_REAL, i_recv, 0, PETSC_COMM_WORLD,
+                             2*nr, MPIU_REAL, i_recv, 0, this->m_Opt->m_Comm,
                              &this->m_RecvRequest[i_recv]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1473,8 +1473,8 @@ PetscErrorCode Preprocessing::GridChangeCommDataProlong() {
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nprocs);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+    MPI_Comm_size(this->m_Opt->m_Comm, &nprocs);
 
     ierr = Assert(this->m_NumSend != NULL, "error in setup"); CHKERRQ(ierr);
     ierr = Assert(this->m_NumRecv != NULL, "error in setup"); CHKERRQ(ierr);
@@ -1565,7 +1565,7 @@ PetscErrorCode Preprocessing::GridChangeCommDataProlong() {
         ns = this->m_NumRecv[i];
         if (ns > 0) {
             merr = MPI_Isend(&this->m_FourierCoeffSendC[2*os_send],
-                             2*ns, MPIU_REAL, i_send, 0, PETSC_COMM_WORLD,
+                             2*ns, MPIU_REAL, i_send, 0, this->m_Opt->m_Comm,
                              &this->m_SendRequest[i_send]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1574,7 +1574,7 @@ PetscErrorCode Preprocessing::GridChangeCommDataProlong() {
         nr      = this->m_NumSend[i];
         if (nr > 0) {
             merr = MPI_Irecv(&this->m_FourierCoeffRecvC[2*os_recv],
-                             2*nr, MPIU_REAL, i_recv, 0, PETSC_COMM_WORLD,
+                             2*nr, MPIU_REAL, i_recv, 0, this->m_Opt->m_Comm,
                              &this->m_RecvRequest[i_recv]);
             ierr = MPIERRQ(merr); CHKERRQ(ierr);
         }
@@ -1645,8 +1645,8 @@ PetscErrorCode Preprocessing::Prolong(Vec* x_f, Vec x_c, IntType* nx_f, IntType*
 
     this->m_Opt->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nprocs);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+    MPI_Comm_size(this->m_Opt->m_Comm, &nprocs);
 
     ierr = Assert(x_c != NULL, "null pointer"); CHKERRQ(ierr);
     ierr = Assert(x_f != NULL, "null pointer"); CHKERRQ(ierr);
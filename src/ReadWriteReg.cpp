@@ -372,7 +372,7 @@ PetscErrorCode ReadWriteReg::Read(Vec* x, std::vector< std::string > filenames)
         ng = this->m_Opt->m_Domain.ng;
 
         if (*x == NULL) {
-            ierr = VecCreate(*x, nc*nl, nc*ng); CHKERRQ(ierr);
+            ierr = VecCreate(*x, nc*nl, nc*ng, nc); CHKERRQ(ierr);
         }
 
         ierr = VecGetArray(*x, &p_x); CHKERRQ(ierr);
@@ -434,6 +434,59 @@ PetscErrorCode ReadWriteReg::Read(Vec* x, std::string filename) {
 
 
 
+/********************************************************************
+ * @brief read grid size from image header (only the header is
+ * read; the data distribution is not set up)
+ * @param[in] filename name of image file
+ * @param[out] nx grid size
+ *******************************************************************/
+PetscErrorCode ReadWriteReg::ReadGridSize(std::string filename, IntType* nx) {
+    PetscErrorCode ierr = 0;
+    std::string file, msg;
+#ifdef REG_HAS_NIFTI
+    nifti_image *image = NULL;
+#endif
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(!filename.empty(), "filename not set"); CHKERRQ(ierr);
+
+    // get file name without path
+    ierr = GetFileName(file, filename); CHKERRQ(ierr);
+
+    // check if file exists
+    msg = "file " + file + " does not exist";
+    ierr = Assert(FileExists(filename), msg); CHKERRQ(ierr);
+
+    if (filename.find(".nii") != std::string::npos
+        || filename.find(".hdr") != std::string::npos) {
+#ifdef REG_HAS_NIFTI
+        image = nifti_image_read(filename.c_str(), false);
+        msg = "could not read image " + file;
+        ierr = Assert(image != NULL, msg); CHKERRQ(ierr);
+
+        // same ordering as in ReadNII
+        nx[2] = static_cast<IntType>(image->nx);
+        nx[1] = static_cast<IntType>(image->ny);
+        nx[0] = static_cast<IntType>(image->nz);
+
+        nifti_image_free(image); image = NULL;
+#else
+        ierr = ThrowError("install nifit library/enable nifti support"); CHKERRQ(ierr);
+#endif
+    } else {
+        ierr = ThrowError("grid size can only be read from nifti header; set grid size with -nx"); CHKERRQ(ierr);
+    }
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief read data from file
  *******************************************************************/
@@ -0,0 +1,259 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _REDISTRIBUTION_CPP_
+#define _REDISTRIBUTION_CPP_
+
+#include <algorithm>
+#include "Redistribution.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief default constructor
+ *******************************************************************/
+Redistribution::Redistribution() {
+    this->m_Comm = MPI_COMM_NULL;
+}
+
+
+
+
+/********************************************************************
+ * @brief default destructor
+ *******************************************************************/
+Redistribution::~Redistribution() {
+    this->ClearMemory();
+}
+
+
+
+
+/********************************************************************
+ * @brief release communication pattern
+ *******************************************************************/
+PetscErrorCode Redistribution::ClearMemory() {
+    PetscFunctionBegin;
+
+    this->m_Comm = MPI_COMM_NULL;
+    this->m_SendCount.clear();
+    this->m_SendOffset.clear();
+    this->m_RecvCount.clear();
+    this->m_RecvOffset.clear();
+    this->m_SendIndex.clear();
+    this->m_RecvIndex.clear();
+    this->m_SendBuffer.clear();
+    this->m_RecvBuffer.clear();
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief compute the communication pattern; the boxes of all tasks
+ * are gathered and every task intersects its source box with the
+ * target boxes of all tasks (values to send) and its target box with
+ * the source boxes of all tasks (values to receive)
+ * @param[in] comm communicator of all tasks that take part (not
+ * owned; has to outlive the redistribution)
+ * @param[in] sbox local box in source layout (istart[3], isize[3])
+ * @param[in] tbox local box in target layout (istart[3], isize[3];
+ * isize is zero if the task holds no values in the target layout)
+ *******************************************************************/
+PetscErrorCode Redistribution::Setup(MPI_Comm comm, const IntType* sbox, const IntType* tbox) {
+    PetscErrorCode ierr = 0;
+    int nprocs, rval, ns, nr;
+    IntType ibox[12], lo[3], hi[3], i[3], *lbox = NULL, *rbox = NULL;
+    std::vector<IntType> box;
+    PetscFunctionBegin;
+
+    ierr = Assert(sbox != NULL && tbox != NULL, "null pointer"); CHKERRQ(ierr);
+
+    this->m_Comm = comm;
+    MPI_Comm_size(this->m_Comm, &nprocs);
+
+    for (int j = 0; j < 6; ++j) {
+        ibox[j]   = sbox[j];
+        ibox[6+j] = tbox[j];
+    }
+
+    box.resize(12*nprocs);
+    rval = MPI_Allgather(ibox, 12, MPIU_INT, box.data(), 12, MPIU_INT, this->m_Comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+    this->m_SendCount.assign(nprocs, 0);
+    this->m_SendOffset.assign(nprocs, 0);
+    this->m_RecvCount.assign(nprocs, 0);
+    this->m_RecvOffset.assign(nprocs, 0);
+    this->m_SendIndex.clear();
+    this->m_RecvIndex.clear();
+
+    ns = 0; nr = 0;
+    for (int p = 0; p < nprocs; ++p) {
+        // send: local box (source layout) and box of task p (target layout)
+        // recv: local box (target layout) and box of task p (source layout)
+        for (int dir = 0; dir < 2; ++dir) {
+            lbox = dir == 0 ? &ibox[0] : &ibox[6];
+            rbox = dir == 0 ? &box[12*p+6] : &box[12*p];
+            bool empty = false;
+            for (int j = 0; j < 3; ++j) {
+                lo[j] = std::max(lbox[j], rbox[j]);
+                hi[j] = std::min(lbox[j] + lbox[3+j], rbox[j] + rbox[3+j]);
+                if (lo[j] >= hi[j]) empty = true;
+            }
+            if (empty) continue;
+
+            for (i[0] = lo[0]; i[0] < hi[0]; ++i[0]) {
+                for (i[1] = lo[1]; i[1] < hi[1]; ++i[1]) {
+                    for (i[2] = lo[2]; i[2] < hi[2]; ++i[2]) {
+                        IntType l = GetLinearIndex(i[0]-lbox[0], i[1]-lbox[1], i[2]-lbox[2], &lbox[3]);
+                        if (dir == 0) {
+                            this->m_SendIndex.push_back(l);
+                        } else {
+                            this->m_RecvIndex.push_back(l);
+                        }
+                    }
+                }
+            }
+        }
+
+        this->m_SendOffset[p] = ns;
+        this->m_RecvOffset[p] = nr;
+        this->m_SendCount[p] = static_cast<int>(this->m_SendIndex.size()) - ns;
+        this->m_RecvCount[p] = static_cast<int>(this->m_RecvIndex.size()) - nr;
+        ns = static_cast<int>(this->m_SendIndex.size());
+        nr = static_cast<int>(this->m_RecvIndex.size());
+    }
+
+    this->m_SendBuffer.resize(ns);
+    this->m_RecvBuffer.resize(nr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief redistribute scalar field from source to target layout;
+ * collective on the communicator of the setup
+ * @param[out] p_out field in target layout (not accessed if the
+ * local target box is empty)
+ * @param[in] p_in fields in source layout (one per task group; the
+ * tasks are split into nfields contiguous groups of equal size and
+ * group k receives p_in[k])
+ * @param[in] nfields number of task groups
+ *******************************************************************/
+PetscErrorCode Redistribution::Scatter(ScalarType* p_out, const ScalarType* const* p_in, int nfields) {
+    PetscErrorCode ierr = 0;
+    int nprocs, rval;
+    IntType nr, i0, n;
+    const ScalarType* p_s = NULL;
+    PetscFunctionBegin;
+
+    ierr = Assert(this->m_Comm != MPI_COMM_NULL, "redistribution not set up"); CHKERRQ(ierr);
+    MPI_Comm_size(this->m_Comm, &nprocs);
+    ierr = Assert(nfields > 0 && nprocs % nfields == 0, "number of fields does not match number of tasks"); CHKERRQ(ierr);
+
+    for (int p = 0; p < nprocs; ++p) {
+        p_s = p_in[p/(nprocs/nfields)];
+        i0 = this->m_SendOffset[p]; n = this->m_SendCount[p];
+#pragma omp parallel for
+        for (IntType j = i0; j < i0 + n; ++j) {
+            this->m_SendBuffer[j] = p_s[this->m_SendIndex[j]];
+        }
+    }
+    rval = MPI_Alltoallv(this->m_SendBuffer.data(), this->m_SendCount.data(),
+                         this->m_SendOffset.data(), MPIU_REAL,
+                         this->m_RecvBuffer.data(), this->m_RecvCount.data(),
+                         this->m_RecvOffset.data(), MPIU_REAL, this->m_Comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+    nr = static_cast<IntType>(this->m_RecvIndex.size());
+#pragma omp parallel for
+    for (IntType j = 0; j < nr; ++j) {
+        p_out[this->m_RecvIndex[j]] = this->m_RecvBuffer[j];
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief redistribute scalar field from target to source layout
+ * (inverse of Scatter); collective on the communicator of the setup
+ * @param[out] p_out fields in source layout (one per task group;
+ * p_out[k] receives the field of group k)
+ * @param[in] p_in field in target layout (not accessed if the local
+ * target box is empty)
+ * @param[in] nfields number of task groups
+ *******************************************************************/
+PetscErrorCode Redistribution::Gather(ScalarType* const* p_out, const ScalarType* p_in, int nfields) {
+    PetscErrorCode ierr = 0;
+    int nprocs, rval;
+    IntType nr, i0, n;
+    ScalarType* p_s = NULL;
+    PetscFunctionBegin;
+
+    ierr = Assert(this->m_Comm != MPI_COMM_NULL, "redistribution not set up"); CHKERRQ(ierr);
+    MPI_Comm_size(this->m_Comm, &nprocs);
+    ierr = Assert(nfields > 0 && nprocs % nfields == 0, "number of fields does not match number of tasks"); CHKERRQ(ierr);
+
+    nr = static_cast<IntType>(this->m_RecvIndex.size());
+#pragma omp parallel for
+    for (IntType j = 0; j < nr; ++j) {
+        this->m_RecvBuffer[j] = p_in[this->m_RecvIndex[j]];
+    }
+    rval = MPI_Alltoallv(this->m_RecvBuffer.data(), this->m_RecvCount.data(),
+                         this->m_RecvOffset.data(), MPIU_REAL,
+                         this->m_SendBuffer.data(), this->m_SendCount.data(),
+                         this->m_SendOffset.data(), MPIU_REAL, this->m_Comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+    for (int p = 0; p < nprocs; ++p) {
+        p_s = p_out[p/(nprocs/nfields)];
+        i0 = this->m_SendOffset[p]; n = this->m_SendCount[p];
+#pragma omp parallel for
+        for (IntType j = i0; j < i0 + n; ++j) {
+            p_s[this->m_SendIndex[j]] = this->m_SendBuffer[j];
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _REDISTRIBUTION_CPP_
@@ -21,6 +21,8 @@
 #define _REGOPT_CPP_
 
 #include "RegOpt.hpp"
+#include "WorkSpace.hpp"
+#include "interp3.hpp"
 
 
 
@@ -67,6 +69,18 @@ RegOpt::RegOpt(const RegOpt& opt) {
  *******************************************************************/
 void RegOpt::Copy(const RegOpt& opt) {
     this->m_SetupDone = false;
+
+    // work fields are drawn from the same pool (e.g., coarse and fine
+    // grid of the two-level preconditioner share memory)
+    if (this->m_WorkSpaceOwner && this->m_WorkSpace != NULL) {
+        delete this->m_WorkSpace;
+    }
+    this->m_WorkSpace = opt.m_WorkSpace;
+    this->m_WorkSpaceOwner = false;
+
+    // the communicator is reset for coarse grid and continuation solves
+    this->m_Comm = opt.m_Comm;
+
     this->m_FFT.plan = NULL;
     this->m_FFT.mpicomm = 0;
     this->m_FFT.mpicommexists = false;
@@ -111,7 +125,14 @@ void RegOpt::Copy(const RegOpt& opt) {
 
     this->m_PDESolver.type = opt.m_PDESolver.type;
     this->m_PDESolver.rkorder = opt.m_PDESolver.rkorder;
-    this->m_PDESolver.iporder = opt.m_PDESolver.iporder;
+    this->m_PDESolver.ipkernel = opt.m_PDESolver.ipkernel;
+    this->m_PDESolver.ipcompress = opt.m_PDESolver.ipcompress;
+    this->m_PDESolver.ipvariant = opt.m_PDESolver.ipvariant;
+    this->m_PDESolver.iptune = opt.m_PDESolver.iptune;
+    this->m_PDESolver.iptuned = opt.m_PDESolver.iptuned;
+    this->m_PDESolver.ipsort = opt.m_PDESolver.ipsort;
+    this->m_PDESolver.histtol = opt.m_PDESolver.histtol;
+    this->m_PDESolver.mixedprecision = opt.m_PDESolver.mixedprecision;
     this->m_PDESolver.cflnumber = opt.m_PDESolver.cflnumber;
     this->m_PDESolver.monitorcflnumber = opt.m_PDESolver.monitorcflnumber;
     this->m_PDESolver.adapttimestep = opt.m_PDESolver.adapttimestep;
@@ -136,6 +157,17 @@ void RegOpt::Copy(const RegOpt& opt) {
     this->m_KrylovMethod.matvectype = opt.m_KrylovMethod.matvectype;
     this->m_KrylovMethod.checkhesssymmetry = opt.m_KrylovMethod.checkhesssymmetry;
     this->m_KrylovMethod.hessshift = opt.m_KrylovMethod.hessshift;
+    this->m_KrylovMethod.nrecycle = opt.m_KrylovMethod.nrecycle;
+    this->m_KrylovMethod.warmstart = opt.m_KrylovMethod.warmstart;
+    this->m_KrylovMethod.pclbfgsmem = opt.m_KrylovMethod.pclbfgsmem;
+    this->m_KrylovMethod.hesscoarsent = opt.m_KrylovMethod.hesscoarsent;
+    this->m_KrylovMethod.hessfidelitytol = opt.m_KrylovMethod.hessfidelitytol;
+    this->m_KrylovMethod.hessblock = opt.m_KrylovMethod.hessblock;
+    this->m_KrylovMethod.pcipkernel = opt.m_KrylovMethod.pcipkernel;
+    this->m_KrylovMethod.pcnprocs = opt.m_KrylovMethod.pcnprocs;
+    this->m_KrylovMethod.pcnlevels = opt.m_KrylovMethod.pcnlevels;
+    this->m_KrylovMethod.pccycle = opt.m_KrylovMethod.pccycle;
+    this->m_KrylovMethod.pcsmooth = opt.m_KrylovMethod.pcsmooth;
 
     this->m_OptPara.maxiter = opt.m_OptPara.maxiter;
     this->m_OptPara.miniter = opt.m_OptPara.miniter;
@@ -154,6 +186,7 @@ void RegOpt::Copy(const RegOpt& opt) {
     this->m_OptPara.usezeroinitialguess = opt.m_OptPara.usezeroinitialguess;
     this->m_OptPara.derivativecheckenabled = opt.m_OptPara.derivativecheckenabled;
     this->m_OptPara.glmethod = opt.m_OptPara.glmethod;
+    this->m_OptPara.nativenewton = opt.m_OptPara.nativenewton;
 
     this->m_SolveType = opt.m_SolveType;
 
@@ -188,8 +221,18 @@ void RegOpt::Copy(const RegOpt& opt) {
     this->m_FileNames.xsc = opt.m_FileNames.xsc;
     this->m_FileNames.extension = opt.m_FileNames.extension;
     this->m_FileNames.xfolder = opt.m_FileNames.xfolder;
+    this->m_FileNames.histdir = opt.m_FileNames.histdir;
+    this->m_FileNames.pceigfile = opt.m_FileNames.pceigfile;
     this->m_FileNames.ifolder = opt.m_FileNames.ifolder;
 
+    this->m_Plan.enabled = opt.m_Plan.enabled;
+    this->m_Plan.nprocs = opt.m_Plan.nprocs;
+    this->m_Plan.memory = opt.m_Plan.memory;
+
+    this->m_MemoryPolicy.firsttouch = opt.m_MemoryPolicy.firsttouch;
+    this->m_MemoryPolicy.hugepages = opt.m_MemoryPolicy.hugepages;
+    this->m_MemoryPolicy.pinthreads = opt.m_MemoryPolicy.pinthreads;
+
     this->m_RegFlags.applysmoothing = opt.m_RegFlags.applysmoothing;
     this->m_RegFlags.applyrescaling = opt.m_RegFlags.applyrescaling;
     this->m_RegFlags.detdefgradfromdeffield = opt.m_RegFlags.detdefgradfromdeffield;
@@ -202,6 +245,7 @@ void RegOpt::Copy(const RegOpt& opt) {
     this->m_ParaCont.enabled = opt.m_ParaCont.enabled;
     this->m_ParaCont.targetbeta = opt.m_ParaCont.targetbeta;
     this->m_ParaCont.beta0 = opt.m_ParaCont.beta0;
+    this->m_ParaCont.ngroups = opt.m_ParaCont.ngroups;
 
     // grid continuation
     this->m_GridCont.nxmin = opt.m_GridCont.nxmin;
@@ -548,6 +592,8 @@ PetscErrorCode RegOpt::ParseArguments(int argc, char** argv) {
                 ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
                 ierr = this->Usage(true); CHKERRQ(ierr);
             }
+        } else if (strcmp(argv[1], "-nativenewton") == 0) {
+            this->m_OptPara.nativenewton = true;
         } else if (strcmp(argv[1], "-jbound") == 0) {
             argc--; argv++;
             this->m_Monitor.detdgradbound = atof(argv[1]);
@@ -576,6 +622,35 @@ PetscErrorCode RegOpt::ParseArguments(int argc, char** argv) {
         } else if (strcmp(argv[1], "-krylovtol") == 0) {
             argc--; argv++;
             this->m_KrylovMethod.tol[0] = atof(argv[1]);
+        } else if (strcmp(argv[1], "-krylovrecycle") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.nrecycle = atoi(argv[1]);
+            if (this->m_KrylovMethod.nrecycle < 0) {
+                msg = "\n\x1b[31m number of recycled vectors is negative: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-krylovwarmstart") == 0) {
+            this->m_KrylovMethod.warmstart = true;
+        } else if (strcmp(argv[1], "-hesscoarsent") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.hesscoarsent = atoi(argv[1]);
+            if (this->m_KrylovMethod.hesscoarsent < 1) {
+                msg = "\n\x1b[31m coarsening factor for time grid has to be positive: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-hessfidelitytol") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.hessfidelitytol = atof(argv[1]);
+        } else if (strcmp(argv[1], "-hessblock") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.hessblock = atoi(argv[1]);
+            if (this->m_KrylovMethod.hessblock < 1) {
+                msg = "\n\x1b[31m block size for hessian matvecs has to be positive: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
         } else if (strcmp(argv[1], "-krylovfseq") == 0) {
             argc--; argv++;
             if (strcmp(argv[1], "none") == 0) {
@@ -604,14 +679,60 @@ PetscErrorCode RegOpt::ParseArguments(int argc, char** argv) {
                 this->m_KrylovMethod.matvectype = PRECONDMATVECSYM;
                 this->m_GridCont.nxmin = 64;
 //                 this->m_KrylovMethod.matvectype = PRECONDMATVEC;
+            } else if (strcmp(argv[1], "lbfgs") == 0) {
+                this->m_KrylovMethod.pctype = INVREGLBFGS;
+                this->m_KrylovMethod.matvectype = DEFAULTMATVEC;
             } else {
                 msg = "\n\x1b[31m preconditioner not defined: %s\x1b[0m\n";
                 ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
                 ierr = this->Usage(); CHKERRQ(ierr);
             }
+        } else if (strcmp(argv[1], "-pclbfgsmem") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.pclbfgsmem = atoi(argv[1]);
+            if (this->m_KrylovMethod.pclbfgsmem < 1) {
+                msg = "\n\x1b[31m number of secant pairs has to be positive: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
         } else if (strcmp(argv[1], "-gridscale") == 0) {
             argc--; argv++;
             this->m_KrylovMethod.pcgridscale = atof(argv[1]);
+        } else if (strcmp(argv[1], "-pcnprocs") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.pcnprocs = atoi(argv[1]);
+            if (this->m_KrylovMethod.pcnprocs < 0) {
+                msg = "\n\x1b[31m number of mpi tasks for coarse grid solve has to be non-negative: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-pcnlevels") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.pcnlevels = atoi(argv[1]);
+            if (this->m_KrylovMethod.pcnlevels < 2) {
+                msg = "\n\x1b[31m number of levels of preconditioner has to be at least 2: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-pccycle") == 0) {
+            argc--; argv++;
+            if (strcmp(argv[1], "v") == 0) {
+                this->m_KrylovMethod.pccycle = 1;
+            } else if (strcmp(argv[1], "w") == 0) {
+                this->m_KrylovMethod.pccycle = 2;
+            } else {
+                msg = "\n\x1b[31m cycle type not defined: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-pcsmooth") == 0) {
+            argc--; argv++;
+            this->m_KrylovMethod.pcsmooth = atoi(argv[1]);
+            if (this->m_KrylovMethod.pcsmooth < 1) {
+                msg = "\n\x1b[31m number of smoothing steps has to be positive: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
         } else if (strcmp(argv[1], "-pcsolver") == 0) {
             argc--; argv++;
             if (strcmp(argv[1], "pcg") == 0) {
@@ -640,6 +761,20 @@ PetscErrorCode RegOpt::ParseArguments(int argc, char** argv) {
                 ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
                 ierr = this->Usage(); CHKERRQ(ierr);
             }
+        } else if (strcmp(argv[1], "-pceigest") == 0) {
+            argc--; argv++;
+            if (strcmp(argv[1], "petsc") == 0) {
+                this->m_KrylovMethod.usepetsceigest = true;
+            } else if (strcmp(argv[1], "lanczos") == 0) {
+                this->m_KrylovMethod.usepetsceigest = false;
+            } else {
+                msg = "\n\x1b[31m eigenvalue estimator not defined: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-pceigfile") == 0) {
+            argc--; argv++;
+            this->m_FileNames.pceigfile = argv[1];
         } else if (strcmp(argv[1], "-monitorpcsolver") == 0) {
             this->m_KrylovMethod.monitorpcsolver = true;
         } else if (strcmp(argv[1], "-pctolscale") == 0) {
@@ -670,7 +805,95 @@ PetscErrorCode RegOpt::ParseArguments(int argc, char** argv) {
             this->m_PDESolver.adapttimestep = true;
         } else if (strcmp(argv[1], "-iporder") == 0) {
             argc--; argv++;
-            this->m_PDESolver.iporder = atoi(argv[1]);
+            if (interp3_kernel_from_order(atoi(argv[1])) < 0) {
+                msg = "\n\x1b[31m no interpolation kernel of order: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+            this->m_PDESolver.ipkernel = static_cast<Interp3_Kernel>(interp3_kernel_from_order(atoi(argv[1])));
+        } else if (strcmp(argv[1], "-ipkernel") == 0) {
+            argc--; argv++;
+            if (interp3_kernel_from_name(argv[1]) < 0) {
+                msg = "\n\x1b[31m interpolation kernel not defined: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+            this->m_PDESolver.ipkernel = static_cast<Interp3_Kernel>(interp3_kernel_from_name(argv[1]));
+        } else if (strcmp(argv[1], "-pcipkernel") == 0) {
+            argc--; argv++;
+            if (interp3_kernel_from_name(argv[1]) < 0) {
+                msg = "\n\x1b[31m interpolation kernel not defined: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+            this->m_KrylovMethod.pcipkernel = static_cast<Interp3_Kernel>(interp3_kernel_from_name(argv[1]));
+        } else if (strcmp(argv[1], "-ipcompress") == 0) {
+            argc--; argv++;
+            this->m_PDESolver.ipcompress = atoi(argv[1]);
+            if (this->m_PDESolver.ipcompress != 16 && this->m_PDESolver.ipcompress != 21) {
+                msg = "\n\x1b[31m compressed scatter supports 16 or 21 bits: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-ipvariant") == 0) {
+            argc--; argv++;
+            this->m_PDESolver.ipvariant = interp3_variant_from_name(argv[1]);
+            if (!interp3_variant_available(this->m_PDESolver.ipvariant)) {
+                msg = "\n\x1b[31m interpolation kernel variant not available: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-iptune") == 0) {
+            this->m_PDESolver.iptune = true;
+        } else if (strcmp(argv[1], "-ipsort") == 0) {
+            argc--; argv++;
+            if (strcmp(argv[1], "auto") == 0) {
+                this->m_PDESolver.ipsort = -1;
+            } else if (strcmp(argv[1], "off") == 0) {
+                this->m_PDESolver.ipsort = 0;
+            } else if (strcmp(argv[1], "on") == 0) {
+                this->m_PDESolver.ipsort = 1;
+            } else {
+                msg = "\n\x1b[31m sorting of query points not defined: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-histtol") == 0) {
+            argc--; argv++;
+            this->m_PDESolver.histtol = atof(argv[1]);
+            if (this->m_PDESolver.histtol < 0.0) {
+                msg = "\n\x1b[31m error bound for compression of time history is negative: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-histdir") == 0) {
+            argc--; argv++;
+            this->m_FileNames.histdir = argv[1];
+        } else if (strcmp(argv[1], "-mixedprecision") == 0) {
+            this->m_PDESolver.mixedprecision = true;
+        } else if (strcmp(argv[1], "-plan") == 0) {
+            argc--; argv++;
+            this->m_Plan.enabled = true;
+            this->m_Plan.nprocs = atoi(argv[1]);
+            if (this->m_Plan.nprocs < 0) {
+                msg = "\n\x1b[31m number of mpi tasks for plan is negative: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-planmem") == 0) {
+            argc--; argv++;
+            this->m_Plan.memory = atof(argv[1]);
+            if (this->m_Plan.memory < 0.0) {
+                msg = "\n\x1b[31m memory per mpi task for plan is negative: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+        } else if (strcmp(argv[1], "-firsttouch") == 0) {
+            this->m_MemoryPolicy.firsttouch = true;
+        } else if (strcmp(argv[1], "-hugepages") == 0) {
+            this->m_MemoryPolicy.hugepages = true;
+        } else if (strcmp(argv[1], "-pinthreads") == 0) {
+            this->m_MemoryPolicy.pinthreads = true;
         } else if (strcmp(argv[1], "-rkorder") == 0) {
             argc--; argv++;
             this->m_PDESolver.rkorder = atoi(argv[1]);
@@ -767,6 +990,14 @@ PetscErrorCode RegOpt::ParseArguments(int argc, char** argv) {
         } else if (strcmp(argv[1], "-betainit") == 0) {
             argc--; argv++;
             this->m_ParaCont.beta0 = atof(argv[1]);
+        } else if (strcmp(argv[1], "-traingroups") == 0) {
+            argc--; argv++;
+            this->m_ParaCont.ngroups = atoi(argv[1]);
+            if (this->m_ParaCont.ngroups < 1) {
+                msg = "\n\x1b[31m number of task groups for training has to be positive: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
         } else if (strcmp(argv[1], "-scalecont") == 0) {
             this->m_ScaleCont.enabled = true;
         } else if (strcmp(argv[1], "-gridcont") == 0) {
@@ -809,9 +1040,13 @@ PetscErrorCode RegOpt::ParseArguments(int argc, char** argv) {
     }
 
     this->m_Timer[FFTSETUP][LOG] = 0.0;
+    // placement of field data (applies to all allocations from here on)
+    ierr = SetMemoryPolicy(this->m_MemoryPolicy.firsttouch,
+                           this->m_MemoryPolicy.hugepages); CHKERRQ(ierr);
     // set number of threads
     ierr = InitializeDataDistribution(this->m_NumThreads, this->m_CartGridDims,
-                                      this->m_FFT.mpicomm, this->m_FFT.mpicommexists); CHKERRQ(ierr);
+                                      this->m_FFT.mpicomm, this->m_FFT.mpicommexists,
+                                      this->m_MemoryPolicy.pinthreads, this->m_Comm); CHKERRQ(ierr);
     PetscFunctionReturn(ierr);
 }
 
@@ -837,6 +1072,11 @@ PetscErrorCode RegOpt::ClearMemory() {
 
     ierr = this->DestroyFFT(); CHKERRQ(ierr);
 
+    if (this->m_WorkSpaceOwner && this->m_WorkSpace != NULL) {
+        delete this->m_WorkSpace;
+    }
+    this->m_WorkSpace = NULL;
+
     // clear vectors
     if (this->m_Log.krylovresidual.size()) {
         this->m_Log.krylovresidual.clear();
@@ -905,7 +1145,7 @@ PetscErrorCode RegOpt::DestroyFFT() {
  *******************************************************************/
 PetscErrorCode RegOpt::InitializeFFT() {
     PetscErrorCode ierr = 0;
-    int nx[3], isize[3], istart[3], osize[3], ostart[3], rank, nalloc, iporder;
+    int nx[3], isize[3], istart[3], osize[3], ostart[3], rank, nalloc, nghost;
     std::stringstream ss;
     ScalarType *u = NULL;
     ScalarType fftsetuptime;
@@ -922,12 +1162,12 @@ PetscErrorCode RegOpt::InitializeFFT() {
     // if communicator is not set up
     if (this->m_FFT.mpicommexists == false) {
         ierr = InitializeDataDistribution(this->m_NumThreads, this->m_CartGridDims,
-                                          this->m_FFT.mpicomm, false); CHKERRQ(ierr);
+                                          this->m_FFT.mpicomm, false,
+                                          this->m_MemoryPolicy.pinthreads, this->m_Comm); CHKERRQ(ierr);
         this->m_FFT.mpicommexists = true;
     }
 
-    //PETSC_COMM_WORLD = this->m_FFT.mpicomm;
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     // parse grid size for setup
     for (int i = 0; i < 3; ++i) {
@@ -940,9 +1180,9 @@ PetscErrorCode RegOpt::InitializeFFT() {
     //ierr = Assert(nalloc > 0 && nalloc < std::numeric_limits<int>::max(), "allocation error"); CHKERRQ(ierr);
     this->m_FFT.nalloc = static_cast<IntType>(nalloc);
 
-    iporder = this->m_PDESolver.iporder;
+    nghost = interp3_kernel_ghost_size(this->m_PDESolver.ipkernel);
     if (this->m_PDESolver.type == SL) {
-        if (isize[0] < iporder+1 || isize[1] < iporder+1) {
+        if (isize[0] < nghost+1 || isize[1] < nghost+1) {
             ss << "\n\x1b[31m local size smaller than padding size (isize=("
                << isize[0] << "," << isize[1] << "," << isize[2]
                << ") < 3) -> reduce number of mpi tasks\x1b[0m\n";
@@ -1035,6 +1275,17 @@ PetscErrorCode RegOpt::Initialize() {
 
     this->m_SetupDone = false;
 
+    // (derived classes call Initialize twice)
+    if (this->m_WorkSpace == NULL) {
+        try {this->m_WorkSpace = new WorkSpace();}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+        this->m_WorkSpaceOwner = true;
+    }
+
+    this->m_Comm = PETSC_COMM_WORLD;
+
     this->m_FFT = {};
     this->m_FFT.plan = NULL;
     this->m_FFT.mpicomm = 0;
@@ -1085,7 +1336,14 @@ PetscErrorCode RegOpt::Initialize() {
     this->m_PDESolver.monitorcflnumber = false;     ///< show CFL number during solve
     this->m_PDESolver.adapttimestep = false;        ///< use adaptive time stepping (based on CFL number)
     this->m_PDESolver.rkorder = 2;                  ///< order of RK method
-    this->m_PDESolver.iporder = 3;                  ///< order of interpolation model
+    this->m_PDESolver.ipkernel = INTERP3_CUBIC;     ///< interpolation kernel (cubic lagrange)
+    this->m_PDESolver.ipcompress = 0;               ///< send query points in full precision
+    this->m_PDESolver.ipvariant = -1;               ///< compiled default implementation of cubic kernel
+    this->m_PDESolver.iptune = false;               ///< do not autotune the implementation of the cubic kernel
+    this->m_PDESolver.iptuned = false;
+    this->m_PDESolver.ipsort = -1;                  ///< sort query points if deformation is large
+    this->m_PDESolver.histtol = 0.0;                ///< store time history of state variable uncompressed
+    this->m_PDESolver.mixedprecision = false;       ///< store time history of state variable in PetscReal
     this->m_PDESolver.pdetype = TRANSPORTEQ;        ///< PDE constraint type (transport or continuity equation)
 
     // smoothing (for image data)
@@ -1122,6 +1380,11 @@ PetscErrorCode RegOpt::Initialize() {
     //this->m_KrylovMethod.pcmaxit = 1000;
     this->m_KrylovMethod.pcmaxit = 10;
     this->m_KrylovMethod.pcgridscale = 2;
+    this->m_KrylovMethod.pcipkernel = INTERP3_NKERNELS; ///< interpolation kernel on coarse grid (not set: same as fine grid)
+    this->m_KrylovMethod.pcnprocs = 0;                  ///< coarse grid solve on all mpi tasks
+    this->m_KrylovMethod.pcnlevels = 2;                 ///< two level preconditioner
+    this->m_KrylovMethod.pccycle = 1;                   ///< v-cycle
+    this->m_KrylovMethod.pcsmooth = 2;                  ///< chebyshev smoothing steps
 //#if defined(PETSC_USE_REAL_SINGLE)
 //    this->m_KrylovMethod.pctol[0] = 1E-9;    ///< relative tolerance
 //    this->m_KrylovMethod.pctol[1] = 1E-9;    ///< absolute tolerance
@@ -1141,6 +1404,12 @@ PetscErrorCode RegOpt::Initialize() {
     this->m_KrylovMethod.eigvalsestimated = false;
     this->m_KrylovMethod.checkhesssymmetry = false;
     this->m_KrylovMethod.hessshift = 0.0;
+    this->m_KrylovMethod.nrecycle = 0;          ///< no recycling of krylov subspace
+    this->m_KrylovMethod.warmstart = false;     ///< hessian solves start from zero
+    this->m_KrylovMethod.pclbfgsmem = 5;        ///< secant pairs of quasi-newton preconditioner
+    this->m_KrylovMethod.hesscoarsent = 1;      ///< hessian matvecs on full time grid
+    this->m_KrylovMethod.hessfidelitytol = 1E-1;  ///< full fidelity once gradient is reduced by one order
+    this->m_KrylovMethod.hessblock = 1;         ///< hessian matvecs are applied one at a time
 
     // tolerances for optimization
     this->m_OptPara = {};
@@ -1164,6 +1433,7 @@ PetscErrorCode RegOpt::Initialize() {
     this->m_OptPara.usezeroinitialguess = true;       ///< use zero initial guess for optimization
     this->m_OptPara.derivativecheckenabled = false;   ///< perform derivative check
     this->m_OptPara.glmethod = ARMIJOLS;              ///< globalization method (default is line search)
+    this->m_OptPara.nativenewton = false;             ///< use tao to drive the newton iterations
     this->m_OptPara.solutionstatus = 0;               ///< flag for status of solution
 
     // tolerances for presolve
@@ -1205,10 +1475,20 @@ PetscErrorCode RegOpt::Initialize() {
     this->m_FileNames.xsc.clear();
     this->m_FileNames.mask.clear();
     this->m_FileNames.xfolder.clear();
+    this->m_FileNames.histdir.clear();
+    this->m_FileNames.pceigfile.clear();
     this->m_FileNames.ifolder.clear();
     this->m_FileNames.extension.clear();
     this->m_FileNames.extension = ".nii.gz";            ///< default file extension for output
 
+    this->m_Plan.enabled = false;       ///< estimate resources and exit
+    this->m_Plan.nprocs = 0;            ///< plan for size of communicator
+    this->m_Plan.memory = 0.0;          ///< use physical memory of node
+
+    this->m_MemoryPolicy.firsttouch = false;    ///< fields are touched by first writer
+    this->m_MemoryPolicy.hugepages = false;     ///< no hint for huge pages
+    this->m_MemoryPolicy.pinthreads = false;    ///< threads are not pinned
+
     this->m_RegFlags = {};
     this->m_RegFlags.applysmoothing = true;             ///< enable/disable image smoothing
     this->m_RegFlags.applyrescaling = true;             ///< enable/disable image rescaling (for output)
@@ -1226,6 +1506,7 @@ PetscErrorCode RegOpt::Initialize() {
     this->m_ParaCont.enabled = false;         ///< flag for parameter continuation
     this->m_ParaCont.targetbeta = 0.0;        ///< has to be set by user
     this->m_ParaCont.beta0 = 1.0;             ///< default initial parameter for parameter continuation
+    this->m_ParaCont.ngroups = 1;             ///< probe one regularization parameter at a time
 
     // grid continuation
     //this->m_GridCont = {};
@@ -1296,7 +1577,7 @@ PetscErrorCode RegOpt::Usage(bool advanced) {
     std::string line;
     PetscFunctionBegin;
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     line = std::string(this->m_LineLength, '-');
 
@@ -1372,6 +1653,9 @@ PetscErrorCode RegOpt::Usage(bool advanced) {
         std::cout << "                                 morethuente  more thuente linesearch" << std::endl;
         std::cout << "                                 gpcg         gradient projection, conjugate gradient method" << std::endl;
         std::cout << "                                 ipm          interior point method" << std::endl;
+        std::cout << " -nativenewton               use native inexact newton-krylov driver instead of tao (the state solve is" << std::endl;
+        std::cout << "                             shared between objective, gradient, and line search; supports -stopcond 0" << std::endl;
+        std::cout << "                             and -globalization none or armijo)" << std::endl;
         std::cout << " -krylovmethod <type>        solver for reduced space hessian system H[vtilde]=-g" << std::endl;
         std::cout << "                             <type> is one of the following" << std::endl;
         std::cout << "                                 pcg          preconditioned conjugate gradient method" << std::endl;
@@ -1386,12 +1670,44 @@ PetscErrorCode RegOpt::Usage(bool advanced) {
         std::cout << "                                 none          exact solve (expensive)" << std::endl;
         std::cout << " -krylovtol <dbl>            relative tolerance for krylov method (default: 1E-12); forcing sequence" << std::endl;
         std::cout << "                             needs to be switched off (i.g., use with '-krylovfseq none')" << std::endl;
+        std::cout << " -krylovrecycle <int>        recycle <int> approximate eigenvectors (ritz vectors) of the preconditioned" << std::endl;
+        std::cout << "                             hessian between newton iterations (deflated pcg; default: 0, i.e., off);" << std::endl;
+        std::cout << "                             costs <int> extra hessian matvecs per newton iteration and 4x<int>" << std::endl;
+        std::cout << "                             vector fields of memory; only for pcg and fpcg" << std::endl;
+        std::cout << " -krylovwarmstart            use the solution of the previous hessian system as initial guess" << std::endl;
+        std::cout << " -hesscoarsent <int>         evaluate hessian matvecs on a time grid that is coarser by a factor" << std::endl;
+        std::cout << "                             of <int> in early newton iterations (default: 1, i.e., off); only for" << std::endl;
+        std::cout << "                             the semi-lagrangian method and the gauss-newton approximation" << std::endl;
+        std::cout << " -hessfidelitytol <dbl>      relative reduction of the gradient norm at which the hessian matvecs" << std::endl;
+        std::cout << "                             switch to the full time grid (default: 1E-1)" << std::endl;
+        std::cout << " -hessblock <int>            apply hessian matvecs to blocks of up to <int> vectors that share the" << std::endl;
+        std::cout << "                             transport of the incremental equations (recycled krylov vectors and" << std::endl;
+        std::cout << "                             symmetry check; default: 1, i.e., off); only for the semi-lagrangian" << std::endl;
+        std::cout << "                             method and the gauss-newton approximation" << std::endl;
         std::cout << " -precond <type>             preconditioner" << std::endl;
         std::cout << "                             <type> is one of the following" << std::endl;
         std::cout << "                                 none         no preconditioner (not recommended)" << std::endl;
         std::cout << "                                 invreg       inverse regularization operator (default)" << std::endl;
         std::cout << "                                 2level       2-level preconditioner" << std::endl;
+        std::cout << "                                 lbfgs        inverse regularization operator with limited-memory" << std::endl;
+        std::cout << "                                              bfgs update (secant pairs from previous hessian solves)" << std::endl;
+        std::cout << " -pclbfgsmem <int>           number of secant pairs for lbfgs preconditioner (default: 5);" << std::endl;
+        std::cout << "                             costs 4x<int> vector fields of memory" << std::endl;
         std::cout << " -gridscale <dbl>            grid scale for 2-level preconditioner (default: 2)" << std::endl;
+        std::cout << " -pcnprocs <int>             number of mpi tasks used for the coarse grid solve of the 2-level" << std::endl;
+        std::cout << "                             preconditioner (default: 0, i.e., all tasks); the restricted data" << std::endl;
+        std::cout << "                             is redistributed to the first <int> tasks" << std::endl;
+        std::cout << " -pcnlevels <int>            number of levels of the 2-level preconditioner (default: 2); for" << std::endl;
+        std::cout << "                             more than 2 levels, the coarse grid solve is replaced by a cycle" << std::endl;
+        std::cout << "                             over grids coarsened by the grid scale; the hessian on every" << std::endl;
+        std::cout << "                             level uses the restricted state and adjoint variables, and the" << std::endl;
+        std::cout << "                             solver set by -pcsolver is only used on the coarsest level" << std::endl;
+        std::cout << " -pccycle <type>             cycle of multilevel preconditioner (-pcnlevels > 2)" << std::endl;
+        std::cout << "                             <type> is one of the following" << std::endl;
+        std::cout << "                                 v            v-cycle (default)" << std::endl;
+        std::cout << "                                 w            w-cycle" << std::endl;
+        std::cout << " -pcsmooth <int>             number of chebyshev smoothing steps on intermediate levels of" << std::endl;
+        std::cout << "                             multilevel preconditioner (default: 2)" << std::endl;
         std::cout << " -pcsolver <type>            solver for inversion of preconditioner (in case" << std::endl;
         std::cout << "                             the 2-level preconditioner is used)" << std::endl;
         std::cout << "                             <type> is one of the following" << std::endl;
@@ -1408,6 +1724,16 @@ PetscErrorCode RegOpt::Usage(bool advanced) {
         std::cout << "                             <flag> is one of the following" << std::endl;
         std::cout << "                                 newton       every newton iteration" << std::endl;
         std::cout << "                                 krylov       every krylov iteration" << std::endl;
+        std::cout << " -pceigest <type>            eigenvalue estimator for chebyshev method (2-level preconditioner)" << std::endl;
+        std::cout << "                             <type> is one of the following" << std::endl;
+        std::cout << "                                 petsc        estimator of petsc (default)" << std::endl;
+        std::cout << "                                 lanczos      lanczos method; estimates are kept with the grid," << std::endl;
+        std::cout << "                                              regularization and image statistics and are reused" << std::endl;
+        std::cout << "                                              (e.g., for parameter continuation); if only the" << std::endl;
+        std::cout << "                                              weights, the images or the iterate changed, they" << std::endl;
+        std::cout << "                                              are updated by a few power iterations" << std::endl;
+        std::cout << " -pceigfile <file>           read and append eigenvalue estimates of the lanczos estimator" << std::endl;
+        std::cout << "                             from/to <file> (reuse across runs, e.g., similar subjects)" << std::endl;
         std::cout << " -hessshift <dbl>            add perturbation to hessian" << std::endl;
         std::cout << " -pctolscale <dbl>           scale for tolerance (preconditioner needs to be inverted more" << std::endl;
         std::cout << "                             accurately then hessian; used for gmres and pcg; default: 1E-1)" << std::endl;
@@ -1463,6 +1789,9 @@ PetscErrorCode RegOpt::Usage(bool advanced) {
         std::cout << "                                 binary       perform binary search (recommended)" << std::endl;
         std::cout << "                                 reduce       reduce parameter by one order until bound is" << std::endl;
         std::cout << "                                              reached (faster than binary search, but less accurate)" << std::endl;
+        std::cout << " -traingroups <int>          number of groups of mpi tasks for binary search (default: 1); each" << std::endl;
+        std::cout << "                             group solves the registration problem for a different regularization" << std::endl;
+        std::cout << "                             parameter (the number of mpi tasks must be a multiple of <int>)" << std::endl;
         std::cout << " -jbound <dbl>               lower bound on determinant of deformation gradient / jacobian" << std::endl;
         std::cout << "                             (default: 2E-1); the upper bound is one over lower bound (1/<dbl>);" << std::endl;
         std::cout << " -betacont <dbl>             do parameter continuation in regularization parameter for velocity" << std::endl;
@@ -1485,7 +1814,40 @@ PetscErrorCode RegOpt::Usage(bool advanced) {
         std::cout << "                                              via the '-rkorder' option (see below)" << std::endl;
         std::cout << "                                 rk2          rk2 time integrator (conditionally stable)" << std::endl;
         std::cout << " -nt <int>                   number of time points (for time integration; default: 4)" << std::endl;
-//        std::cout << " -iporder <int>              order of interpolation model (default is 3)" << std::endl;
+        std::cout << " -ipkernel <type>            interpolation kernel for semi-lagrangian method" << std::endl;
+        std::cout << "                             <type> is one of the following" << std::endl;
+        std::cout << "                                 linear       trilinear interpolation (cheap; inaccurate)" << std::endl;
+        std::cout << "                                 cubic        cubic lagrange interpolation (default)" << std::endl;
+        std::cout << "                                 bspline      cubic b-spline interpolation (spectrally prefiltered;" << std::endl;
+        std::cout << "                                              smooth; same stencil as cubic)" << std::endl;
+        std::cout << "                                 quintic      quintic lagrange interpolation (expensive)" << std::endl;
+        std::cout << " -ipcompress <int>           send off-rank query points of the semi-lagrangian method as" << std::endl;
+        std::cout << "                             fixed point offsets with 16 or 21 bits per coordinate (reduces" << std::endl;
+        std::cout << "                             communication volume; default is full precision)" << std::endl;
+        std::cout << " -ipvariant <type>           implementation of the cubic kernel (optimized, gold, v1, v3, v4," << std::endl;
+        std::cout << "                             batched, generic, vectorized; default is set at compile time)" << std::endl;
+        std::cout << " -iptune                     time the implementations of the cubic kernel at the first" << std::endl;
+        std::cout << "                             interpolation and use the fastest one; the choice is cached" << std::endl;
+        std::cout << "                             per cpu/grid/precision in the output folder" << std::endl;
+        std::cout << " -ipsort <type>              evaluate query points in morton order (cache locality of the" << std::endl;
+        std::cout << "                             stencils); <type> is auto (default; only for large deformations)," << std::endl;
+        std::cout << "                             on or off" << std::endl;
+        std::cout << " -histtol <dbl>              store the time history of the state variable with lossy compression;" << std::endl;
+        std::cout << "                             <dbl> is the absolute error bound of the stored values (e.g., 1e-3" << std::endl;
+        std::cout << "                             for images in [0,1]; default: 0, i.e., no compression); only" << std::endl;
+        std::cout << "                             available for the semi-lagrangian gauss-newton solver" << std::endl;
+        std::cout << " -histdir <path>             store the time history of the state variable out-of-core in <path>" << std::endl;
+        std::cout << "                             (node-local scratch space; every rank writes its own file); reads" << std::endl;
+        std::cout << "                             are prefetched; can be combined with -histtol; only available for" << std::endl;
+        std::cout << "                             the semi-lagrangian gauss-newton solver" << std::endl;
+        std::cout << " -mixedprecision             store the time history of the state variable in single precision" << std::endl;
+        std::cout << "                             (halves its memory in double precision builds; fields, transport" << std::endl;
+        std::cout << "                             and optimizer stay in the precision of petsc); can be combined" << std::endl;
+        std::cout << "                             with -histtol and -histdir; only available for the semi-lagrangian" << std::endl;
+        std::cout << "                             gauss-newton solver" << std::endl;
+        std::cout << " -pcipkernel <type>          interpolation kernel used on the coarse grid of the 2-level" << std::endl;
+        std::cout << "                             preconditioner (same options as for '-ipkernel'; default is" << std::endl;
+        std::cout << "                             the kernel used on the fine grid)" << std::endl;
         std::cout << " -rkorder <int>              order of rk time integration used to compute the characteristic (default is 2)" << std::endl;
         std::cout << line << std::endl;
         std::cout << " memory distribution and parallelism" << std::endl;
@@ -1493,6 +1855,17 @@ PetscErrorCode RegOpt::Usage(bool advanced) {
         std::cout << " -nthreads <int>             number of threads (default: 1)" << std::endl;
         std::cout << " -np <int>x<int>             distribution of mpi tasks (cartesian grid) (example: -np 2x4 results" << std::endl;
         std::cout << "                             results in MPI distribution of size (nx1/2,nx2/4,nx3) for each mpi task)" << std::endl;
+        std::cout << " -plan <int>                 estimate the memory footprint (per mpi task) and the runtime for <int>" << std::endl;
+        std::cout << "                             mpi tasks without running the registration (0: current number of tasks);" << std::endl;
+        std::cout << "                             recommends a process grid (-np) and a storage mode for the time history;" << std::endl;
+        std::cout << "                             the grid size is read from the image header or set by '-nx'" << std::endl;
+        std::cout << " -planmem <dbl>              memory per mpi task in GB for '-plan' (default: physical memory of the" << std::endl;
+        std::cout << "                             node divided by the number of mpi tasks on the node)" << std::endl;
+        std::cout << " -firsttouch                 first touch field data with the static openmp schedule of the compute" << std::endl;
+        std::cout << "                             loops (places pages on the numa node of the thread that uses them)" << std::endl;
+        std::cout << " -hugepages                  back the time histories and the ghost buffers by transparent huge pages" << std::endl;
+        std::cout << " -pinthreads                 pin openmp threads to cores (cores of the node are split between the" << std::endl;
+        std::cout << "                             mpi tasks on the node, unless the tasks are bound by the mpi launcher)" << std::endl;
         std::cout << line << std::endl;
         std::cout << " logging" << std::endl;
         std::cout << line << std::endl;
@@ -1573,7 +1946,7 @@ PetscErrorCode RegOpt::CheckArguments() {
         ierr = this->Usage(); CHKERRQ(ierr);
     } else if ( (readmT == false) && (readmR == false) ) {
         this->m_ReadWriteFlags.readfiles = false;
-        if (this->m_RegFlags.runsynprob == false) {
+        if (this->m_RegFlags.runsynprob == false && this->m_Plan.enabled == false) {
             msg = "\n\x1b[31m either define input images or specify synthetic test problem\x1b[0m\n";
             ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
             ierr = this->Usage(true); CHKERRQ(ierr);
@@ -1647,6 +2020,12 @@ PetscErrorCode RegOpt::CheckArguments() {
         }
     }
 
+    if (this->m_ParaCont.ngroups > 1 && this->m_ParaCont.strategy != PCONTBINSEARCH) {
+        msg = "\n\x1b[31m task groups (-traingroups) require binary search (-train binary) \x1b[0m\n";
+        ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+        ierr = this->Usage(true); CHKERRQ(ierr);
+    }
+
     if (this->m_ScaleCont.enabled && this->m_ParaCont.enabled) {
         msg = "\n\x1b[31m combined parameter and scale continuation not available \x1b[0m\n";
         ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
@@ -1693,6 +2072,70 @@ PetscErrorCode RegOpt::CheckArguments() {
         ierr = this->Usage(true); CHKERRQ(ierr);
     }
 
+    // coarse grid of preconditioner inherits the kernel of the fine grid if not set
+    if (this->m_KrylovMethod.pcipkernel == INTERP3_NKERNELS) {
+        this->m_KrylovMethod.pcipkernel = this->m_PDESolver.ipkernel;
+    }
+
+    // deflation assumes a symmetric operator (conjugate gradient methods)
+    if (this->m_KrylovMethod.nrecycle > 0) {
+        if (this->m_KrylovMethod.solver != PCG && this->m_KrylovMethod.solver != FCG) {
+            msg = "\x1b[31m recycling of krylov subspace (-krylovrecycle) requires pcg or fpcg\x1b[0m\n";
+            ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+            ierr = this->Usage(true); CHKERRQ(ierr);
+        }
+    }
+
+    // the coarse time grid is only implemented for the semi-lagrangian gauss-newton matvecs
+    if (this->m_KrylovMethod.hesscoarsent > 1) {
+        if (this->m_PDESolver.type != SL || this->m_OptPara.method != GAUSSNEWTON) {
+            msg = "\x1b[31m coarse time grid for hessian matvecs (-hesscoarsent) requires\n"
+                  " the semi-lagrangian method and the gauss-newton approximation\x1b[0m\n";
+            ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+            ierr = this->Usage(true); CHKERRQ(ierr);
+        }
+        if (this->m_KrylovMethod.hessfidelitytol <= 0.0 || this->m_KrylovMethod.hessfidelitytol >= 1.0) {
+            msg = "\x1b[31m tolerance for hessian fidelity out of bounds; not in (0,1)\x1b[0m\n";
+            ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+            ierr = this->Usage(true); CHKERRQ(ierr);
+        }
+    }
+
+    // the levels below the coarse grid of the two level preconditioner
+    if (this->m_KrylovMethod.pcnlevels > 2 && this->m_KrylovMethod.pctype != TWOLEVEL) {
+        msg = "\x1b[31m multilevel preconditioner (-pcnlevels) requires -precond 2level\x1b[0m\n";
+        ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+        ierr = this->Usage(true); CHKERRQ(ierr);
+    }
+
+    // the compressed, out-of-core or single precision time history is only read by the semi-lagrangian
+    // gauss-newton solver (the other solvers index the full time history)
+    if (this->m_PDESolver.histtol > 0.0 || !this->m_FileNames.histdir.empty()
+        || this->m_PDESolver.mixedprecision) {
+        if (this->m_PDESolver.type != SL
+            || this->m_OptPara.method == FULLNEWTON
+            || this->m_KrylovMethod.pctype == TWOLEVEL) {
+            msg = "\x1b[31m compression (-histtol), out-of-core storage (-histdir) or single precision\n"
+                  " storage (-mixedprecision) of time history\n"
+                  " requires the semi-lagrangian method,\n"
+                  " the gauss-newton approximation, and a single-level preconditioner\x1b[0m\n";
+            ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+            ierr = this->Usage(true); CHKERRQ(ierr);
+        }
+    }
+
+    // the native newton-krylov driver implements the gradient based stopping
+    // conditions and a backtracking line search only
+    if (this->m_OptPara.nativenewton) {
+        if (this->m_OptPara.stopcond != GRAD
+            || (this->m_OptPara.glmethod != NOGM && this->m_OptPara.glmethod != ARMIJOLS)) {
+            msg = "\x1b[31m native newton-krylov driver (-nativenewton) requires -stopcond 0\n"
+                  " and -globalization none or armijo\x1b[0m\n";
+            ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str()); CHKERRQ(ierr);
+            ierr = this->Usage(true); CHKERRQ(ierr);
+        }
+    }
+
     if (this->m_KrylovMethod.pctolscale < 0.0
         || this->m_KrylovMethod.pctolscale >= 1.0) {
         msg = "\x1b[31m tolerance for precond solver out of bounds; not in (0,1)\x1b[0m\n";
@@ -1974,7 +2417,7 @@ PetscErrorCode RegOpt::DisplayOptions() {
 
     this->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     indent = 40;
     align = 30;
@@ -2019,7 +2462,17 @@ PetscErrorCode RegOpt::DisplayOptions() {
                   << this->m_CartGridDims[0] << "x"
                   << this->m_CartGridDims[1] << std::endl;
         std::cout << std::left << std::setw(indent) << " threads"
-                  << omp_get_max_threads() << std::endl;
+                  << omp_get_max_threads();
+        if (this->m_MemoryPolicy.pinthreads) {
+            std::cout << " (pinned)";
+        }
+        std::cout << std::endl;
+        if (this->m_MemoryPolicy.firsttouch || this->m_MemoryPolicy.hugepages) {
+            std::cout << std::left << std::setw(indent) << " memory policy";
+            if (this->m_MemoryPolicy.firsttouch) std::cout << "first touch ";
+            if (this->m_MemoryPolicy.hugepages) std::cout << "huge pages";
+            std::cout << std::endl;
+        }
         std::cout << std::left << std::setw(indent) << " (ng,nl)"
                   << "(" << this->m_Domain.ng
                   << "," << this->m_Domain.nl << ")" << std::endl;
@@ -2107,6 +2560,11 @@ PetscErrorCode RegOpt::DisplayOptions() {
             } else if (this->m_ParaCont.strategy == PCONTREDUCESEARCH) {
                 std::cout << "search by reduction" << std::endl;
             }
+            if (this->m_ParaCont.ngroups > 1) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "task groups"
+                          << this->m_ParaCont.ngroups << std::endl;
+            }
             std::cout << std::left << std::setw(indent) << " "
                       << std::setw(align) << "bound det(grad(y))"
                       << this->m_Monitor.detdgradbound << std::endl;
@@ -2207,6 +2665,42 @@ PetscErrorCode RegOpt::DisplayOptions() {
                 break;
             }
         }
+        if (this->m_PDESolver.type == SL) {
+            std::cout << std::left << std::setw(indent) << " "
+                      << std::setw(align) << "interpolation kernel"
+                      << interp3_kernel_name(this->m_PDESolver.ipkernel) << std::endl;
+            if (this->m_PDESolver.ipcompress != 0) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "compressed scatter"
+                          << this->m_PDESolver.ipcompress << " bits per coordinate" << std::endl;
+            }
+            if (this->m_PDESolver.iptune || this->m_PDESolver.ipvariant >= 0) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "kernel variant"
+                          << (this->m_PDESolver.iptune ? "autotuned" :
+                              interp3_variant_name(this->m_PDESolver.ipvariant)) << std::endl;
+            }
+            if (this->m_PDESolver.ipsort >= 0) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "morton order of queries"
+                          << (this->m_PDESolver.ipsort ? "on" : "off") << std::endl;
+            }
+            if (this->m_PDESolver.histtol > 0.0) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "compressed time history"
+                          << std::scientific << this->m_PDESolver.histtol << " (error bound)" << std::endl;
+            }
+            if (!this->m_FileNames.histdir.empty()) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "out-of-core time history"
+                          << this->m_FileNames.histdir << std::endl;
+            }
+            if (this->m_PDESolver.mixedprecision) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "time history precision"
+                          << "single" << std::endl;
+            }
+        }
 
         // display type of optimization method
         newtontype = false;
@@ -2263,6 +2757,12 @@ PetscErrorCode RegOpt::DisplayOptions() {
                   << std::setw(align) << "max newton iterations"
                   << this->m_OptPara.maxiter << std::endl;
 
+        if (this->m_OptPara.nativenewton) {
+            std::cout << std::left << std::setw(indent) << " "
+                      << std::setw(align) << "newton driver"
+                      << "native" << std::endl;
+        }
+
         std::cout << std::left << std::setw(indent) << " linesearch";
         switch (this->m_OptPara.glmethod) {
             case NOGM:
@@ -2349,6 +2849,28 @@ PetscErrorCode RegOpt::DisplayOptions() {
                       << std::setw(align) << "max krylov iterations"
                       << this->m_KrylovMethod.maxiter << std::endl;
 
+            if (this->m_KrylovMethod.nrecycle > 0) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "recycled vectors"
+                          << this->m_KrylovMethod.nrecycle << std::endl;
+            }
+            if (this->m_KrylovMethod.warmstart) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "initial guess"
+                          << "previous solution" << std::endl;
+            }
+            if (this->m_KrylovMethod.hesscoarsent > 1) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "hessian time grid"
+                          << "nt/" << this->m_KrylovMethod.hesscoarsent << " until ||g||/||g0|| < "
+                          << std::scientific << this->m_KrylovMethod.hessfidelitytol << std::endl;
+            }
+            if (this->m_KrylovMethod.hessblock > 1) {
+                std::cout << std::left << std::setw(indent) << " "
+                          << std::setw(align) << "hessian block size"
+                          << this->m_KrylovMethod.hessblock << std::endl;
+            }
+
             bool twolevel = false;
             std::cout << std::left << std::setw(indent) << " "
                       << std::setw(align) << "preconditioner";
@@ -2359,6 +2881,12 @@ PetscErrorCode RegOpt::DisplayOptions() {
                     std::cout << "regularization operator" << std::endl;
                     break;
                 }
+                case INVREGLBFGS:
+                {
+                    std::cout << "regularization operator (lbfgs update, "
+                              << this->m_KrylovMethod.pclbfgsmem << " pairs)" << std::endl;
+                    break;
+                }
                 case TWOLEVEL:
                 {
                     std::cout << "2-level multigrid" << std::endl;
@@ -2414,6 +2942,32 @@ PetscErrorCode RegOpt::DisplayOptions() {
                     }
                 }
                 std::cout << this->m_KrylovMethod.pcname << std::endl;
+                if (this->m_PDESolver.type == SL
+                    && this->m_KrylovMethod.pcipkernel != INTERP3_NKERNELS) {
+                    std::cout << std::left << std::setw(indent) << " "
+                              << std::setw(align) << "interpolation kernel"
+                              << interp3_kernel_name(this->m_KrylovMethod.pcipkernel) << std::endl;
+                }
+                if (this->m_KrylovMethod.pcnprocs > 0) {
+                    std::cout << std::left << std::setw(indent) << " "
+                              << std::setw(align) << "mpi tasks (coarse grid)"
+                              << this->m_KrylovMethod.pcnprocs << std::endl;
+                }
+                if (this->m_KrylovMethod.pcnlevels > 2) {
+                    std::cout << std::left << std::setw(indent) << " "
+                              << std::setw(align) << "levels"
+                              << this->m_KrylovMethod.pcnlevels
+                              << (this->m_KrylovMethod.pccycle == 2 ? " (w-cycle" : " (v-cycle")
+                              << ", " << this->m_KrylovMethod.pcsmooth
+                              << " chebyshev smoothing steps)" << std::endl;
+                }
+                if (this->m_KrylovMethod.pcsolver == CHEB && !this->m_KrylovMethod.usepetsceigest) {
+                    std::cout << std::left << std::setw(indent) << " "
+                              << std::setw(align) << "eigenvalue estimates"
+                              << "lanczos (cached"
+                              << (this->m_FileNames.pceigfile.empty() ? "" : "; " + this->m_FileNames.pceigfile)
+                              << ")" << std::endl;
+                }
             }
 /*          std::cout << std::left << std::setw(indent) <<" "
                       << std::setw(align) <<"divergence"
@@ -2539,7 +3093,7 @@ PetscErrorCode RegOpt::ResetTimers() {
     }
     this->m_FFTAccumTime = 0.0;
 
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < NINTERPTIMERS; ++i) {
         for (int j = 0; j < NVALTYPES; ++j) {
             this->m_InterpTimers[i][j] = 0.0;
         }
@@ -2646,25 +3200,25 @@ PetscErrorCode RegOpt::ProcessTimers() {
 
     this->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nproc);
+    MPI_Comm_rank(this->m_Comm, &rank);
+    MPI_Comm_size(this->m_Comm, &nproc);
 
     for (int id = 0; id < NTIMERS; ++id) {
         // remember input value
         ival = this->m_Timer[id][LOG];
 
         // get maximal execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MIN, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MIN, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_Timer[id][MIN] = xval;
 
         // get maximal execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_Timer[id][MAX] = xval;
 
         // get mean execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_SUM, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_Timer[id][AVG] = xval;
 
@@ -2684,17 +3238,17 @@ PetscErrorCode RegOpt::ProcessTimers() {
         }
 
         // get maximal execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MIN, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MIN, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_FFTTimers[i][MIN] = xval;
 
         // get maximal execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_FFTTimers[i][MAX] = xval;
 
         // get mean execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_SUM, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_FFTTimers[i][AVG] = xval;
 
@@ -2704,29 +3258,31 @@ PetscErrorCode RegOpt::ProcessTimers() {
     }
 
     // get max of accumulated time accross all procs
-    rval = MPI_Reduce(&ivalsum, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD);
+    rval = MPI_Reduce(&ivalsum, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, this->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
     this->m_FFTAccumTime = xval;
 
 
     ivalsum = 0.0;
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < NINTERPTIMERS; ++i) {
         // remember input value
         ival = this->m_InterpTimers[i][LOG];
-        ivalsum += ival;
+
+        // only accumulate times (not the load counters)
+        if (i < INTERP3_NQUERIES) ivalsum += ival;
 
         // get maximal execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MIN, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MIN, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_InterpTimers[i][MIN] = xval;
 
         // get maximal execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_InterpTimers[i][MAX] = xval;
 
         // get mean execution time
-        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+        rval = MPI_Reduce(&ival, &xval, 1, MPI_DOUBLE, MPI_SUM, 0, this->m_Comm);
         ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
         this->m_InterpTimers[i][AVG] = xval;
 
@@ -2752,15 +3308,15 @@ PetscErrorCode RegOpt::ProcessTimers() {
     }
 
     ival = this->m_Timer[FFTSELFEXEC][LOG];
-    rval = MPI_Gather(&ival, 1, MPI_DOUBLE, fftall, 1, MPI_DOUBLE, 0, PETSC_COMM_WORLD);
+    rval = MPI_Gather(&ival, 1, MPI_DOUBLE, fftall, 1, MPI_DOUBLE, 0, this->m_Comm);
     ierr = MPIERRQ(rval); CHKERRQ(ierr);
 
     ival = this->m_Timer[IPSELFEXEC][LOG];
-    rval = MPI_Gather(&ival, 1, MPI_DOUBLE, interpall, 1, MPI_DOUBLE, 0, PETSC_COMM_WORLD);
+    rval = MPI_Gather(&ival, 1, MPI_DOUBLE, interpall, 1, MPI_DOUBLE, 0, this->m_Comm);
     ierr = MPIERRQ(rval); CHKERRQ(ierr);
 
     ival = this->m_Timer[T2SEXEC][LOG];
-    rval = MPI_Gather(&ival, 1, MPI_DOUBLE, ttsall, 1, MPI_DOUBLE, 0, PETSC_COMM_WORLD);
+    rval = MPI_Gather(&ival, 1, MPI_DOUBLE, ttsall, 1, MPI_DOUBLE, 0, this->m_Comm);
     ierr = MPIERRQ(rval); CHKERRQ(ierr);
 
     this->m_TTSSlowest = 0.0;
@@ -2777,7 +3333,7 @@ PetscErrorCode RegOpt::ProcessTimers() {
 
 
     // get max of accumulated time accross all procs
-    rval = MPI_Reduce(&ivalsum, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD);
+    rval = MPI_Reduce(&ivalsum, &xval, 1, MPI_DOUBLE, MPI_MAX, 0, this->m_Comm);
     ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
     this->m_IPAccumTime = xval;
 
@@ -2837,6 +3393,41 @@ PetscErrorCode RegOpt::ResetCounter(CounterType id) {
 
 
 
+/********************************************************************
+ * @brief add the (local) timers and counters of another set of
+ * options (e.g., of a solver that ran on a subset of the tasks) to
+ * the timers and counters of this set of options
+ * @param opt options to take timers and counters from
+ *******************************************************************/
+PetscErrorCode RegOpt::AddTimersAndCounters(RegOpt* opt) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    this->Enter(__func__);
+
+    ierr = Assert(opt != NULL, "null pointer"); CHKERRQ(ierr);
+
+    for (int i = 0; i < NTIMERS; ++i) {
+        this->m_Timer[i][LOG] += opt->m_Timer[i][LOG];
+    }
+    for (int i = 0; i < NFFTTIMERS; ++i) {
+        this->m_FFTTimers[i][LOG] += opt->m_FFTTimers[i][LOG];
+    }
+    for (int i = 0; i < NINTERPTIMERS; ++i) {
+        this->m_InterpTimers[i][LOG] += opt->m_InterpTimers[i][LOG];
+    }
+    for (int i = 0; i < NCOUNTERS; ++i) {
+        this->m_Counter[i] += opt->m_Counter[i];
+    }
+
+    this->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief write log results to file
  *******************************************************************/
@@ -2880,7 +3471,7 @@ PetscErrorCode RegOpt::WriteWorkLoadLog() {
     this->Enter(__func__);
 
     // get rank
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     path = this->m_FileNames.xfolder;
 
@@ -2914,8 +3505,8 @@ PetscErrorCode RegOpt::WriteWorkLoadLog(std::ostream& logwriter) {
     this->Enter(__func__);
 
     // get rank
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nproc);
+    MPI_Comm_rank(this->m_Comm, &rank);
+    MPI_Comm_size(this->m_Comm, &nproc);
 
     line = std::string(this->m_LineLength, '-');
     path = this->m_FileNames.xfolder;
@@ -2940,6 +3531,11 @@ PetscErrorCode RegOpt::WriteWorkLoadLog(std::ostream& logwriter) {
         logwriter << "# processors " << nproc
                   << " " << this->m_CartGridDims[0]
                   << "x" << this->m_CartGridDims[1] << std::endl;
+        if (this->m_PDESolver.type == SL) {
+            logwriter << "# interpolation kernel " << interp3_kernel_name(this->m_PDESolver.ipkernel)
+                      << " variant " << interp3_variant_name(this->m_PDESolver.ipvariant)
+                      << (this->m_PDESolver.iptuned ? " (autotuned)" : "") << std::endl;
+        }
         logwriter << "# eventname count minp maxp avgp maxp_by_count" << std::endl;
 
         count = 1;
@@ -3135,6 +3731,31 @@ PetscErrorCode RegOpt::WriteWorkLoadLog(std::ostream& logwriter) {
                   << " " << this->m_InterpTimers[3][MAX] / static_cast<double>(count)
                   << std::endl;
 
+        // load counters (per rank); the last column is the imbalance max/avg
+        logwriter << "\"interp queries\""
+                  << " " << count << std::scientific
+                  << " " << this->m_InterpTimers[INTERP3_NQUERIES][MIN]
+                  << " " << this->m_InterpTimers[INTERP3_NQUERIES][MAX]
+                  << " " << this->m_InterpTimers[INTERP3_NQUERIES][AVG]
+                  << " " << this->GetInterpImbalance(INTERP3_NQUERIES)
+                  << std::endl;
+
+        logwriter << "\"interp bytes\""
+                  << " " << count << std::scientific
+                  << " " << this->m_InterpTimers[INTERP3_NBYTES][MIN]
+                  << " " << this->m_InterpTimers[INTERP3_NBYTES][MAX]
+                  << " " << this->m_InterpTimers[INTERP3_NBYTES][AVG]
+                  << " " << this->GetInterpImbalance(INTERP3_NBYTES)
+                  << std::endl;
+
+        logwriter << "\"interp exec imbalance\""
+                  << " " << count << std::scientific
+                  << " " << this->m_InterpTimers[INTERP3_EXEC][MIN]
+                  << " " << this->m_InterpTimers[INTERP3_EXEC][MAX]
+                  << " " << this->m_InterpTimers[INTERP3_EXEC][AVG]
+                  << " " << this->GetInterpImbalance(INTERP3_EXEC)
+                  << std::endl;
+
         logwriter << "\"slowest proc tts\""
                   << " " << 0 << std::scientific
                   << " " << 0
@@ -3191,7 +3812,7 @@ PetscErrorCode RegOpt::WriteWorkLoadLogReadable() {
     this->Enter(__func__);
 
     // get rank
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     path = this->m_FileNames.xfolder;
 
@@ -3229,8 +3850,8 @@ PetscErrorCode RegOpt::WriteWorkLoadLogReadable(std::ostream& logwriter) {
     this->Enter(__func__);
 
     // get rank
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
-    MPI_Comm_size(PETSC_COMM_WORLD, &nproc);
+    MPI_Comm_rank(this->m_Comm, &rank);
+    MPI_Comm_size(this->m_Comm, &nproc);
 
     // write out logfile
     if (rank == 0) {
@@ -3282,6 +3903,15 @@ PetscErrorCode RegOpt::WriteWorkLoadLogReadable(std::ostream& logwriter) {
                   << std::setw(nstr) << " num threads" << std::right
                   << omp_get_max_threads() << std::endl;
 
+        if (this->m_PDESolver.type == SL) {
+            ss << interp3_variant_name(this->m_PDESolver.ipvariant)
+               << (this->m_PDESolver.iptuned ? " (autotuned)" : "");
+            logwriter << std::left
+                      << std::setw(nstr) << " interp variant" << std::right
+                      << std::setw(nnum) << ss.str() << std::endl;
+            ss.clear(); ss.str(std::string());
+        }
+
         logwriter << std::endl;
         logwriter << line << std::endl;
         logwriter << "# timers" << std::endl;
@@ -3546,6 +4176,27 @@ PetscErrorCode RegOpt::WriteWorkLoadLogReadable(std::ostream& logwriter) {
             ss.clear(); ss.str(std::string());
         }
 
+        // load counters per rank; last column is the imbalance (max/avg)
+        if (this->m_InterpTimers[INTERP3_NQUERIES][LOG] > 0.0) {
+            ss  << std::scientific << std::left
+                << std::setw(nstr) << " interp queries" << std::right
+                << std::setw(nnum) << this->m_InterpTimers[INTERP3_NQUERIES][MIN]
+                << std::setw(nnum) << this->m_InterpTimers[INTERP3_NQUERIES][MAX]
+                << std::setw(nnum) << this->m_InterpTimers[INTERP3_NQUERIES][AVG]
+                << std::setw(nnum) << this->GetInterpImbalance(INTERP3_NQUERIES);
+            logwriter << ss.str() << std::endl;
+            ss.clear(); ss.str(std::string());
+
+            ss  << std::scientific << std::left
+                << std::setw(nstr) << " interp bytes" << std::right
+                << std::setw(nnum) << this->m_InterpTimers[INTERP3_NBYTES][MIN]
+                << std::setw(nnum) << this->m_InterpTimers[INTERP3_NBYTES][MAX]
+                << std::setw(nnum) << this->m_InterpTimers[INTERP3_NBYTES][AVG]
+                << std::setw(nnum) << this->GetInterpImbalance(INTERP3_NBYTES);
+            logwriter << ss.str() << std::endl;
+            ss.clear(); ss.str(std::string());
+        }
+
         logwriter << std::endl;
         logwriter << line << std::endl;
         logwriter << "# counters" << std::endl;
@@ -3637,7 +4288,7 @@ PetscErrorCode RegOpt::WriteFinalResidualLog() {
 
     this->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     nnum = 20;
     path = this->m_FileNames.xfolder;
@@ -3712,7 +4363,7 @@ PetscErrorCode RegOpt::WriteConvergenceLog() {
 
     this->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     path = this->m_FileNames.xfolder;
 
@@ -3819,7 +4470,7 @@ PetscErrorCode RegOpt::WriteKSPLog() {
 
     this->Enter(__func__);
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     path = this->m_FileNames.xfolder;
 
@@ -3875,11 +4526,11 @@ PetscErrorCode RegOpt::DisplayTimeToSolution() {
     seconds  = (minutes - floor(minutes)) *   60.0;
     millisec = (seconds - floor(seconds)) * 1000.0;
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
 
     line = std::string(this->m_LineLength, '-');
 
-    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_rank(this->m_Comm, &rank);
     ierr = PetscPrintf(PETSC_COMM_WORLD, "%s\n", line.c_str()); CHKERRQ(ierr);
 
     ss  << "computation finished (elapsed cpu time "
@@ -3892,6 +4543,11 @@ PetscErrorCode RegOpt::DisplayTimeToSolution() {
     ierr = Msg(ss.str()); CHKERRQ(ierr);
     ierr = PetscPrintf(PETSC_COMM_WORLD, "%s\n", line.c_str()); CHKERRQ(ierr);
 
+    if (this->m_Verbosity > 1 && this->m_WorkSpace != NULL) {
+        ierr = this->m_WorkSpace->Report(this->m_Comm); CHKERRQ(ierr);
+        ierr = PetscPrintf(PETSC_COMM_WORLD, "%s\n", line.c_str()); CHKERRQ(ierr);
+    }
+
     this->Exit(__func__);
 
     PetscFunctionReturn(ierr);
@@ -166,7 +166,12 @@ PetscErrorCode RegToolsOpt::ParseArguments(int argc, char** argv) {
             this->m_PDESolver.monitorcflnumber = true;
         } else if (strcmp(argv[1], "-iporder") == 0) {
             argc--; argv++;
-            this->m_PDESolver.iporder = atoi(argv[1]);
+            if (interp3_kernel_from_order(atoi(argv[1])) < 0) {
+                msg = "\n\x1b[31m no interpolation kernel of order: %s\x1b[0m\n";
+                ierr = PetscPrintf(PETSC_COMM_WORLD, msg.c_str(), argv[1]); CHKERRQ(ierr);
+                ierr = this->Usage(true); CHKERRQ(ierr);
+            }
+            this->m_PDESolver.ipkernel = static_cast<Interp3_Kernel>(interp3_kernel_from_order(atoi(argv[1])));
         } else if (strcmp(argv[1], "-sigma") == 0) {
             argc--; argv++;
             const std::string sigmainput = argv[1];
@@ -102,9 +102,9 @@ PetscErrorCode RegularizationH1::EvaluateFunctional(ScalarType* R, VecField* v)
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
         // compute inner products
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); CHKERRQ(ierr); H1v +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); CHKERRQ(ierr); H1v +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); CHKERRQ(ierr); H1v +=value;
 
 
         // X2 gradient
@@ -116,9 +116,9 @@ PetscErrorCode RegularizationH1::EvaluateFunctional(ScalarType* R, VecField* v)
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
         // compute inner products
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); CHKERRQ(ierr); H1v +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); CHKERRQ(ierr); H1v +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); CHKERRQ(ierr); H1v +=value;
 
 
         // X3 gradient
@@ -130,17 +130,17 @@ PetscErrorCode RegularizationH1::EvaluateFunctional(ScalarType* R, VecField* v)
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
         // compute inner products
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); CHKERRQ(ierr); H1v +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); CHKERRQ(ierr); H1v +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); CHKERRQ(ierr); H1v +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); CHKERRQ(ierr); H1v +=value;
 
         // restore arrays for velocity field
         ierr = v->RestoreArrays(p_v1, p_v2, p_v3); CHKERRQ(ierr);
 
         L2v = 0.0;
-        ierr = VecTDot(v->m_X1, v->m_X1, &value); CHKERRQ(ierr); L2v +=value;
-        ierr = VecTDot(v->m_X2, v->m_X2, &value); CHKERRQ(ierr); L2v +=value;
-        ierr = VecTDot(v->m_X3, v->m_X3, &value); CHKERRQ(ierr); L2v +=value;
+        ierr = VecInnerProduct(v->m_X1, v->m_X1, &value); CHKERRQ(ierr); L2v +=value;
+        ierr = VecInnerProduct(v->m_X2, v->m_X2, &value); CHKERRQ(ierr); L2v +=value;
+        ierr = VecInnerProduct(v->m_X3, v->m_X3, &value); CHKERRQ(ierr); L2v +=value;
 
         // add up contributions
         //*R = 0.5*(beta[0]*H1v + beta[1]*L2v);
@@ -99,9 +99,9 @@ PetscErrorCode RegularizationH1SN::EvaluateFunctional(ScalarType* R, VecField* v
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
         // compute inner products
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); *R +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); *R +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); *R +=value;
 
 
         // X2 gradient
@@ -113,9 +113,9 @@ PetscErrorCode RegularizationH1SN::EvaluateFunctional(ScalarType* R, VecField* v
         this->m_Opt->IncrementCounter(FFT, FFTGRAD);
 
         // compute inner products
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); *R +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); *R +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); *R +=value;
 
 
         // X3 gradient
@@ -131,9 +131,9 @@ PetscErrorCode RegularizationH1SN::EvaluateFunctional(ScalarType* R, VecField* v
         ierr = VecRestoreArray(this->m_WorkVecField->m_X3, &p_gv33); CHKERRQ(ierr);
 
         // compute inner products
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); *R +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); *R +=value;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &value); *R +=value;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &value); *R +=value;
 
         ierr = v->RestoreArrays(p_v1, p_v2, p_v3); CHKERRQ(ierr);
 
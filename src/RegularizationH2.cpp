@@ -153,9 +153,9 @@ PetscErrorCode RegularizationH2::EvaluateFunctional(ScalarType* R, VecField* v)
         this->m_Opt->IncrementCounter(FFT, 3);
 
         // compute inner product
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &ipxi); CHKERRQ(ierr); *R += ipxi;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &ipxi); CHKERRQ(ierr); *R += ipxi;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &ipxi); CHKERRQ(ierr); *R += ipxi;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &ipxi); CHKERRQ(ierr); *R += ipxi;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &ipxi); CHKERRQ(ierr); *R += ipxi;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &ipxi); CHKERRQ(ierr); *R += ipxi;
 
         // increment fft timer
         this->m_Opt->IncreaseFFTTimers(timer);
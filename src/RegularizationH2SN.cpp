@@ -155,9 +155,9 @@ PetscErrorCode RegularizationH2SN::EvaluateFunctional(ScalarType* R, VecField* v
         this->m_Opt->IncrementCounter(FFT, 3);
 
         // compute inner product
-        ierr = VecTDot(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &ipxi); CHKERRQ(ierr); value += ipxi;
-        ierr = VecTDot(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &ipxi); CHKERRQ(ierr); value += ipxi;
-        ierr = VecTDot(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &ipxi); CHKERRQ(ierr); value += ipxi;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X1, this->m_WorkVecField->m_X1, &ipxi); CHKERRQ(ierr); value += ipxi;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X2, this->m_WorkVecField->m_X2, &ipxi); CHKERRQ(ierr); value += ipxi;
+        ierr = VecInnerProduct(this->m_WorkVecField->m_X3, this->m_WorkVecField->m_X3, &ipxi); CHKERRQ(ierr); value += ipxi;
 
         // multiply with regularization weight
         *R = static_cast<ScalarType>(0.5*beta*hd*value);
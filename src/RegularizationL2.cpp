@@ -79,9 +79,9 @@ PetscErrorCode RegularizationL2
 
     // if regularization weight is zero, do noting
     if (beta != 0.0) {
-        ierr = VecTDot(v->m_X1, v->m_X1, &ipxi); CHKERRQ(ierr); *R += ipxi;
-        ierr = VecTDot(v->m_X2, v->m_X2, &ipxi); CHKERRQ(ierr); *R += ipxi;
-        ierr = VecTDot(v->m_X3, v->m_X3, &ipxi); CHKERRQ(ierr); *R += ipxi;
+        ierr = VecInnerProduct(v->m_X1, v->m_X1, &ipxi); CHKERRQ(ierr); *R += ipxi;
+        ierr = VecInnerProduct(v->m_X2, v->m_X2, &ipxi); CHKERRQ(ierr); *R += ipxi;
+        ierr = VecInnerProduct(v->m_X3, v->m_X3, &ipxi); CHKERRQ(ierr); *R += ipxi;
         *R *= 0.5*hd*beta;
     }
 
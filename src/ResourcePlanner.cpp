@@ -0,0 +1,873 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _RESOURCEPLANNER_CPP_
+#define _RESOURCEPLANNER_CPP_
+
+#include <cmath>
+#include <algorithm>
+#include <unistd.h>
+#include "ResourcePlanner.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief default constructor
+ *******************************************************************/
+ResourcePlanner::ResourcePlanner() {
+    this->Initialize();
+}
+
+
+
+
+/********************************************************************
+ * @brief constructor
+ *******************************************************************/
+ResourcePlanner::ResourcePlanner(RegOpt* opt) {
+    this->Initialize();
+    this->m_Opt = opt;
+}
+
+
+
+
+/********************************************************************
+ * @brief default destructor
+ *******************************************************************/
+ResourcePlanner::~ResourcePlanner() {
+    this->ClearMemory();
+}
+
+
+
+
+/********************************************************************
+ * @brief init variables
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::Initialize() {
+    PetscFunctionBegin;
+
+    this->m_Opt = NULL;
+    this->m_NumProcs = 0;
+    this->m_AvailableMemory = 0.0;
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief clean up
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::ClearMemory() {
+    PetscFunctionBegin;
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief compute data distribution of a grid for a process grid
+ * (mirrors the pencil decomposition of accfft; the fft buffer has
+ * to hold the largest of the three pencils of the r2c transform;
+ * the ghost layers are added in all three directions)
+ * @param[out] layout data distribution
+ * @param[in] nx grid size
+ * @param[in] cgrid process grid
+ * @param[in] kernel interpolation kernel (defines ghost width)
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::ComputeLayout(Layout& layout, const IntType* nx,
+                                              const int* cgrid, Interp3_Kernel kernel) {
+    double nxc, stage[3], nghost;
+    PetscFunctionBegin;
+
+    layout.nl = 1.0;
+    layout.ng = 1.0;
+    for (int i = 0; i < 3; ++i) {
+        layout.nx[i] = nx[i];
+        layout.ng *= static_cast<double>(nx[i]);
+    }
+    layout.isize[0] = (nx[0] + cgrid[0] - 1)/cgrid[0];
+    layout.isize[1] = (nx[1] + cgrid[1] - 1)/cgrid[1];
+    layout.isize[2] = nx[2];
+    for (int i = 0; i < 3; ++i) {
+        layout.nl *= static_cast<double>(layout.isize[i]);
+    }
+    layout.cgrid[0] = cgrid[0];
+    layout.cgrid[1] = cgrid[1];
+
+    // number of complex coefficients along x3
+    nxc = static_cast<double>(nx[2]/2 + 1);
+
+    // pencils of r2c transform (x3, x2, and x1 contiguous)
+    stage[0] = static_cast<double>(layout.isize[0]*layout.isize[1])*nxc;
+    stage[1] = static_cast<double>(layout.isize[0]*nx[1])*std::ceil(nxc/cgrid[1]);
+    stage[2] = static_cast<double>(nx[0]*((nx[1] + cgrid[0] - 1)/cgrid[0]))*std::ceil(nxc/cgrid[1]);
+    layout.nalloc = 2.0*sizeof(ScalarType)*std::max(stage[0], std::max(stage[1], stage[2]));
+
+    nghost = static_cast<double>(interp3_kernel_ghost_size(kernel));
+    layout.nghost = sizeof(ScalarType);
+    for (int i = 0; i < 3; ++i) {
+        layout.nghost *= static_cast<double>(layout.isize[i]) + 2.0*nghost;
+    }
+    layout.order = interp3_kernel_order(kernel);
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief grid size on a level of the two-level (or multilevel)
+ * preconditioner (same as in Preconditioner::SetupCoarseGrid; level
+ * 1 is the coarse grid, every level is coarsened by the grid scale)
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::GetCoarseGridSize(IntType* nxc, int level) {
+    ScalarType scale, value;
+    PetscFunctionBegin;
+
+    scale = this->m_Opt->m_KrylovMethod.pcgridscale;
+    for (int i = 0; i < 3; ++i) {
+        nxc[i] = this->m_Opt->m_Domain.nx[i];
+        for (int l = 0; l < level; ++l) {
+            value = static_cast<ScalarType>(nxc[i])/scale;
+            nxc[i] = static_cast<IntType>(std::ceil(value));
+        }
+    }
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief process grid of the coarse grid solve of the two-level
+ * preconditioner (same as in Preconditioner::SetupCoarseGridComm;
+ * the coarse grid solve may run on a subset of the tasks)
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::GetCoarseProcessGrid(int* cgridc, const int* cgrid) {
+    int np;
+    PetscFunctionBegin;
+
+    cgridc[0] = cgrid[0];
+    cgridc[1] = cgrid[1];
+
+    np = this->m_Opt->m_KrylovMethod.pcnprocs;
+    if (np > 0 && np < cgrid[0]*cgrid[1]) {
+        cgridc[0] = 0; cgridc[1] = 0;
+        MPI_Dims_create(np, 2, cgridc);
+    }
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief check if process grid can be used (the semi-lagrangian
+ * method requires the local size to be larger than the ghost width)
+ *******************************************************************/
+bool ResourcePlanner::IsFeasible(const int* cgrid) {
+    IntType nxc[3], isize[2];
+    int nghost, cgridc[2];
+
+    if (cgrid[0] > this->m_Opt->m_Domain.nx[0] || cgrid[1] > this->m_Opt->m_Domain.nx[1]) {
+        return false;
+    }
+    if (this->m_Opt->m_PDESolver.type != SL) return true;
+
+    nghost = interp3_kernel_ghost_size(this->m_Opt->m_PDESolver.ipkernel);
+    for (int i = 0; i < 2; ++i) {
+        isize[i] = this->m_Opt->m_Domain.nx[i]/cgrid[i];
+        if (isize[i] < nghost + 1) return false;
+    }
+
+    // the coarsest grid of the preconditioner has the smallest local size
+    if (this->m_Opt->m_KrylovMethod.pctype == TWOLEVEL) {
+        this->GetCoarseGridSize(nxc, this->m_Opt->m_KrylovMethod.pcnlevels - 1);
+        this->GetCoarseProcessGrid(cgridc, cgrid);
+        nghost = interp3_kernel_ghost_size(this->m_Opt->m_KrylovMethod.pcipkernel);
+        for (int i = 0; i < 2; ++i) {
+            isize[i] = nxc[i]/cgridc[i];
+            if (isize[i] < nghost + 1) return false;
+        }
+    }
+
+    return true;
+}
+
+
+
+
+/********************************************************************
+ * @brief check if storage mode can be used with the current options
+ * (see CheckArguments in RegOpt)
+ *******************************************************************/
+bool ResourcePlanner::IsAvailable(StorageMode mode) {
+    if (mode == INMEMORY) return true;
+    return this->m_Opt->m_RegFlags.runinversion
+        && this->m_Opt->m_PDESolver.type == SL
+        && this->m_Opt->m_OptPara.method == GAUSSNEWTON
+        && this->m_Opt->m_KrylovMethod.pctype != TWOLEVEL;
+}
+
+
+
+
+/********************************************************************
+ * @brief number of vector fields allocated by krylov method
+ * (petsc defaults; restart/truncation of 30 directions)
+ *******************************************************************/
+int ResourcePlanner::GetNumKrylovVectors(KrylovMethodType solver) {
+    switch (solver) {
+        case PCG:    return 5;
+        case FCG:    return 64;
+        case CHEB:   return 4;
+        case GMRES:  return 35;
+        case FGMRES: return 65;
+        default:     return 5;
+    }
+}
+
+
+
+
+/********************************************************************
+ * @brief add persistent buffers of forward/adjoint solver on one
+ * grid (counts follow the allocations in CLAIRE, CLAIREBase,
+ * SemiLagrangian, and Interp3_Plan)
+ * @param[in,out] buffers list of buffers
+ * @param[in] layout data distribution
+ * @param[in] mode storage of time history
+ * @param[in] prefix prefix for name of buffers
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::AddSolverBuffers(std::vector<Buffer>& buffers,
+                                                 const Layout& layout,
+                                                 StorageMode mode, std::string prefix) {
+    double f, nt, nc, nb, bpv, ntp;
+    int dofs;
+    bool runinversion;
+    PetscFunctionBegin;
+
+    f  = layout.nl*sizeof(ScalarType);
+    nt = static_cast<double>(this->m_Opt->m_Domain.nt);
+    nc = static_cast<double>(this->m_Opt->m_Domain.nc);
+    nb = static_cast<double>(this->m_Opt->m_KrylovMethod.hessblock);
+    runinversion = this->m_Opt->m_RegFlags.runinversion;
+
+    // state variable (the time history is only stored for the inversion)
+    if (mode == INMEMORY && runinversion && this->m_Opt->m_PDESolver.mixedprecision) {
+        buffers.push_back({prefix + "state variable", nc*f});
+        buffers.push_back({prefix + "time history (single precision)", (nt + 1.0)*nc*layout.nl*sizeof(float) + f});
+    } else if (mode == INMEMORY) {
+        buffers.push_back({prefix + "state variable", (runinversion ? nt + 1.0 : 1.0)*nc*f});
+    } else {
+        // 16 bit per value for smooth images; full width for
+        // lossless out-of-core storage (float in mixed precision)
+        bpv = this->m_Opt->m_PDESolver.mixedprecision ? sizeof(float) : sizeof(ScalarType);
+        if (mode == COMPRESSED || this->m_Opt->m_PDESolver.histtol > 0.0) bpv = 2.0;
+        ntp = mode == COMPRESSED ? nt + 1.0 : static_cast<double>(NUMSTAGED);
+        buffers.push_back({prefix + "state variable", nc*f});
+        buffers.push_back({prefix + (mode == COMPRESSED ? "time history (compressed)" : "time history (staged)"),
+                           ntp*nc*layout.nl*bpv + f});
+    }
+
+    if (runinversion) {
+        ntp = this->m_Opt->m_OptPara.method == FULLNEWTON ? nt + 1.0 : 1.0;
+        buffers.push_back({prefix + "adjoint variable", ntp*nc*f});
+        buffers.push_back({prefix + "incremental state variable", ntp*nc*f});
+        buffers.push_back({prefix + "incremental adjoint variable", ntp*nc*f});
+        buffers.push_back({prefix + "incremental velocity", 3.0*f});
+        // incremental velocities, body forces and state variables of a block of hessian matvecs
+        if (nb > 1.0 && this->m_Opt->m_PDESolver.type == SL && this->m_Opt->m_OptPara.method == GAUSSNEWTON) {
+            buffers.push_back({prefix + "hessian block", (6.0 + nc)*nb*f});
+        }
+    }
+    buffers.push_back({prefix + "velocity", 3.0*f});
+
+    // five vector fields, five scalar fields, and one multi-component field
+    buffers.push_back({prefix + "work fields", (15.0 + 5.0 + nc)*f});
+
+    // spectral operators (three complex fields) and transpose buffers of plan
+    buffers.push_back({prefix + "spectral operators", 3.0*layout.nalloc});
+    buffers.push_back({prefix + "fft plan", 2.0*layout.nalloc});
+
+    if (this->m_Opt->m_PDESolver.type == SL) {
+        // trajectory and two work vector fields
+        buffers.push_back({prefix + "trajectory", 9.0*f});
+
+        // state and adjoint plan: local and received query points and values
+        // (the plans hold the values of the largest block of fields)
+        dofs = std::max(3, static_cast<int>(nc));
+        if (nb > 1.0) dofs *= static_cast<int>(nb);
+
+        // scalar, vector, and multi-component field with ghost layers
+        buffers.push_back({prefix + "ghost layers", (4.0 + (nb > 1.0 ? dofs : nc))*layout.nghost
+                           + (interp3_kernel_prefilter(this->m_Opt->m_PDESolver.ipkernel) ? layout.nalloc : 0.0)});
+        buffers.push_back({prefix + "interpolation plans", 2.0*2.0*(3.0 + dofs)*f});
+    }
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief estimate persistent buffers (per mpi task)
+ * @param[out] buffers list of buffers
+ * @param[in] cgrid process grid
+ * @param[in] mode storage of time history
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::EstimateMemory(std::vector<Buffer>& buffers,
+                                               const int* cgrid, StorageMode mode) {
+    PetscErrorCode ierr = 0;
+    Layout fine, coarse, coarsef;
+    IntType nxc[3], nxl;
+    double f, fc, nc, pyramid;
+    int level, nlevels, cgridc[2];
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    buffers.clear();
+
+    ierr = this->ComputeLayout(fine, this->m_Opt->m_Domain.nx, cgrid,
+                               this->m_Opt->m_PDESolver.ipkernel); CHKERRQ(ierr);
+    f  = fine.nl*sizeof(ScalarType);
+    nc = static_cast<double>(this->m_Opt->m_Domain.nc);
+
+    buffers.push_back({"images (template, reference)", 2.0*nc*f});
+    if (!this->m_Opt->m_FileNames.mask.empty()) {
+        buffers.push_back({"mask", f});
+    }
+
+    // each level of the pyramid has an eighth of the points of the finer level
+    if (this->m_Opt->m_GridCont.enabled) {
+        pyramid = 0.0; level = 1;
+        nxl = std::min(this->m_Opt->m_Domain.nx[0], std::min(this->m_Opt->m_Domain.nx[1], this->m_Opt->m_Domain.nx[2]));
+        while ((nxl >> level) >= this->m_Opt->m_GridCont.nxmin) {
+            pyramid += 2.0*nc*f/std::pow(8.0, level);
+            ++level;
+        }
+        buffers.push_back({"image pyramid", pyramid});
+    }
+
+    ierr = this->AddSolverBuffers(buffers, fine, mode, ""); CHKERRQ(ierr);
+
+    if (this->m_Opt->m_RegFlags.runinversion) {
+        buffers.push_back({"optimizer (iterate, gradient, step)", 15.0*f});
+        buffers.push_back({"krylov method", 3.0*f*this->GetNumKrylovVectors(this->m_Opt->m_KrylovMethod.solver)});
+        if (this->m_Opt->m_KrylovMethod.pctype == INVREGLBFGS) {
+            // active and staged secant pairs, work vector
+            buffers.push_back({"lbfgs preconditioner", 3.0*f*(4.0*this->m_Opt->m_KrylovMethod.pclbfgsmem + 1.0)});
+        }
+
+        if (this->m_Opt->m_KrylovMethod.pctype == TWOLEVEL) {
+            // the coarse grid problem lives on the tasks of the coarse grid solve
+            // (the tasks that hold the largest share are the ones we plan for)
+            ierr = this->GetCoarseGridSize(nxc, 1); CHKERRQ(ierr);
+            ierr = this->GetCoarseProcessGrid(cgridc, cgrid); CHKERRQ(ierr);
+            ierr = this->ComputeLayout(coarse, nxc, cgridc,
+                                       this->m_Opt->m_KrylovMethod.pcipkernel); CHKERRQ(ierr);
+            ierr = this->ComputeLayout(coarsef, nxc, cgrid,
+                                       this->m_Opt->m_KrylovMethod.pcipkernel); CHKERRQ(ierr);
+            fc = coarse.nl*sizeof(ScalarType);
+
+            buffers.push_back({"coarse grid: images", 2.0*nc*fc});
+            ierr = this->AddSolverBuffers(buffers, coarse, INMEMORY, "coarse grid: "); CHKERRQ(ierr);
+            buffers.push_back({"coarse grid: krylov method", 3.0*fc*this->GetNumKrylovVectors(this->m_Opt->m_KrylovMethod.pcsolver)});
+            buffers.push_back({"coarse grid: restriction", f + coarsef.nl*sizeof(ScalarType)});
+            if (cgridc[0]*cgridc[1] != cgrid[0]*cgrid[1]) {
+                // packed values and indices (both data layouts)
+                buffers.push_back({"coarse grid: redistribution", (coarse.nl + coarsef.nl)*(sizeof(ScalarType) + sizeof(IntType))});
+            }
+
+            // coarser levels of multilevel preconditioner (on the tasks of
+            // the coarse grid solve)
+            nlevels = this->m_Opt->m_KrylovMethod.pcnlevels;
+            for (level = 2; level < nlevels; ++level) {
+                ierr = this->GetCoarseGridSize(nxc, level); CHKERRQ(ierr);
+                ierr = this->ComputeLayout(coarsef, nxc, cgridc,
+                                           this->m_Opt->m_KrylovMethod.pcipkernel); CHKERRQ(ierr);
+                ss << "level " << level << ": ";
+                buffers.push_back({ss.str() + "images", 2.0*nc*coarsef.nl*sizeof(ScalarType)});
+                ierr = this->AddSolverBuffers(buffers, coarsef, INMEMORY, ss.str()); CHKERRQ(ierr);
+                // smoother, residual, restriction and prolongation (level above)
+                buffers.push_back({ss.str() + "cycle", 3.0*fc*(this->GetNumKrylovVectors(CHEB) + 4.0) + coarsef.nl*sizeof(ScalarType)});
+                fc = coarsef.nl*sizeof(ScalarType);
+                ss.str(std::string()); ss.clear();
+            }
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief estimate peak memory (per mpi task; we assume all
+ * persistent buffers are live at the same time)
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::GetPeakMemory(double& peak, const int* cgrid, StorageMode mode) {
+    PetscErrorCode ierr = 0;
+    std::vector<Buffer> buffers;
+    PetscFunctionBegin;
+
+    ierr = this->EstimateMemory(buffers, cgrid, mode); CHKERRQ(ierr);
+    peak = 0.0;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        peak += buffers[i].bytes;
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief estimate runtime of forward solve, gradient, and hessian
+ * matvec on one grid (without preconditioner); an fft costs
+ * 2.5 N log2(N) flop and two all-to-all exchanges of the fft buffer;
+ * an interpolation costs 2(p+1)^3 flop per point for a kernel of
+ * order p plus the ghost exchange and the scatter of the values of
+ * off-rank query points (we assume a displacement of about one cell
+ * per time step)
+ * @param[out] t runtimes (FWDSOLVE, GRADIENT, HESSMATVEC)
+ * @param[out] treg runtime of applying the regularization operator
+ * @param[in] layout data distribution
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::EstimateSolverCosts(double* t, double& treg, const Layout& layout) {
+    double nt, nc, np, nthreads, tfft, tip, ttraj, tgrad, frac[2], offrank,
+           fwd, adj, incfwd, incadj;
+    PetscFunctionBegin;
+
+    nt = static_cast<double>(this->m_Opt->m_Domain.nt);
+    nc = static_cast<double>(this->m_Opt->m_Domain.nc);
+    np = static_cast<double>(layout.cgrid[0]*layout.cgrid[1]);
+    nthreads = static_cast<double>(this->m_Opt->m_NumThreads);
+
+    tfft = 2.5*layout.ng*std::log2(layout.ng)/np/(FFTRATE*nthreads)
+         + 2.0*layout.nalloc/NETRATE;
+
+    // fraction of query points that leave the pencil
+    for (int i = 0; i < 2; ++i) {
+        frac[i] = layout.cgrid[i] > 1 ? std::min(1.0, 2.0/static_cast<double>(layout.isize[i])) : 0.0;
+    }
+    offrank = 1.0 - (1.0 - frac[0])*(1.0 - frac[1]);
+
+    tip = layout.nl*(2.0*std::pow(layout.order + 1.0, 3) + 30.0)/(IPRATE*nthreads)
+        + (layout.nghost - layout.nl*sizeof(ScalarType) + offrank*layout.nl*sizeof(ScalarType))/NETRATE;
+    ttraj = 3.0*tip + 3.0*offrank*layout.nl*sizeof(ScalarType)/NETRATE;
+
+    // gradient (one forward and three inverse ffts); regularization
+    // operator (three forward and three inverse ffts)
+    tgrad = 4.0*tfft;
+    treg  = 6.0*tfft;
+
+    if (this->m_Opt->m_PDESolver.type == SL) {
+        fwd    = ttraj + nt*nc*tip;
+        adj    = ttraj + nt*nc*tip + (nt + 1.0)*nc*tgrad + treg;
+        incfwd = nt*nc*(2.0*tip + tgrad);
+        incadj = nt*nc*tip + (nt + 1.0)*nc*tgrad + treg;
+    } else {
+        // two stages per time step
+        fwd    = 2.0*nt*nc*tgrad;
+        adj    = 2.0*nt*nc*tgrad + (nt + 1.0)*nc*tgrad + treg;
+        incfwd = 3.0*nt*nc*tgrad;
+        incadj = adj;
+    }
+
+    t[FWDSOLVE]   = fwd;
+    t[GRADIENT]   = fwd + adj;
+    t[HESSMATVEC] = incfwd + incadj;
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief estimate runtime (per newton iteration we assume one
+ * gradient, NUMMATVECS hessian matvecs, and one forward solve
+ * for the line search)
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::EstimateRuntime(double* t, const int* cgrid) {
+    PetscErrorCode ierr = 0;
+    Layout fine, coarse;
+    IntType nxc[3];
+    double treg, tc[NRUNTIMES], tregc, npc, tcycle;
+    int cgridc[2], nlevels, ncycle, nsmooth;
+    PetscFunctionBegin;
+
+    ierr = this->ComputeLayout(fine, this->m_Opt->m_Domain.nx, cgrid,
+                               this->m_Opt->m_PDESolver.ipkernel); CHKERRQ(ierr);
+    ierr = this->EstimateSolverCosts(t, treg, fine); CHKERRQ(ierr);
+
+    // cost of preconditioner per matvec
+    if (this->m_Opt->m_KrylovMethod.pctype == INVREG
+        || this->m_Opt->m_KrylovMethod.pctype == INVREGLBFGS) {
+        t[HESSMATVEC] += treg;
+    } else if (this->m_Opt->m_KrylovMethod.pctype == TWOLEVEL) {
+        // krylov method on the coarsest grid; every coarser level of the
+        // multilevel preconditioner is entered ncycle times per cycle
+        // (smoothing steps and residual on the levels in between)
+        nlevels = this->m_Opt->m_KrylovMethod.pcnlevels;
+        ncycle  = this->m_Opt->m_KrylovMethod.pccycle;
+        nsmooth = this->m_Opt->m_KrylovMethod.pcsmooth;
+        ierr = this->GetCoarseProcessGrid(cgridc, cgrid); CHKERRQ(ierr);
+        ierr = this->GetCoarseGridSize(nxc, nlevels - 1); CHKERRQ(ierr);
+        ierr = this->ComputeLayout(coarse, nxc, cgridc,
+                                   this->m_Opt->m_KrylovMethod.pcipkernel); CHKERRQ(ierr);
+        ierr = this->EstimateSolverCosts(tc, tregc, coarse); CHKERRQ(ierr);
+        npc = static_cast<double>(std::min(static_cast<int>(this->m_Opt->m_KrylovMethod.pcmaxit), static_cast<int>(NUMMATVECS)));
+        tcycle = npc*(tc[HESSMATVEC] + tregc);
+        for (int level = nlevels - 2; level >= 1; --level) {
+            ierr = this->GetCoarseGridSize(nxc, level); CHKERRQ(ierr);
+            ierr = this->ComputeLayout(coarse, nxc, cgridc,
+                                       this->m_Opt->m_KrylovMethod.pcipkernel); CHKERRQ(ierr);
+            ierr = this->EstimateSolverCosts(tc, tregc, coarse); CHKERRQ(ierr);
+            tcycle = (2.0*nsmooth + ncycle)*tc[HESSMATVEC] + ncycle*tcycle;
+        }
+        t[HESSMATVEC] += tcycle + 2.0*treg;
+        if (cgridc[0]*cgridc[1] != cgrid[0]*cgrid[1]) {
+            // redistribution of input and output (three components each)
+            t[HESSMATVEC] += 6.0*coarse.nl*sizeof(ScalarType)/NETRATE;
+        }
+    }
+
+    t[NEWTONITER] = t[GRADIENT] + NUMMATVECS*t[HESSMATVEC] + t[FWDSOLVE];
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief determine memory available per mpi task (user defined or
+ * physical memory of the node divided by the number of tasks on
+ * the node; minimum across nodes)
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::GetAvailableMemory() {
+    PetscErrorCode ierr = 0;
+    MPI_Comm nodecomm;
+    int ntasks, rval;
+    double memory;
+    PetscFunctionBegin;
+
+    if (this->m_Opt->m_Plan.memory > 0.0) {
+        this->m_AvailableMemory = this->m_Opt->m_Plan.memory*1073741824.0;
+        PetscFunctionReturn(ierr);
+    }
+
+    rval = MPI_Comm_split_type(PETSC_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodecomm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+    MPI_Comm_size(nodecomm, &ntasks);
+    MPI_Comm_free(&nodecomm);
+
+    memory = static_cast<double>(sysconf(_SC_PHYS_PAGES))*static_cast<double>(sysconf(_SC_PAGE_SIZE));
+    memory /= static_cast<double>(ntasks);
+
+    rval = MPI_Allreduce(&memory, &this->m_AvailableMemory, 1, MPI_DOUBLE, MPI_MIN, PETSC_COMM_WORLD);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief select process grid and storage mode for np mpi tasks; we
+ * prefer the fastest storage mode that fits into memory (in memory,
+ * compressed, out-of-core) and, for this mode, the process grid with
+ * the smallest estimated runtime; if nothing fits, we return the
+ * process grid with the smallest memory footprint
+ * @param[out] cgrid process grid (0x0 if there is no feasible grid)
+ * @param[out] mode storage mode
+ * @param[out] fits flag: estimate fits into available memory
+ * @param[in] np number of mpi tasks
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::SelectProcessGrid(int* cgrid, StorageMode& mode,
+                                                  bool& fits, int np) {
+    PetscErrorCode ierr = 0;
+    int grid[2], m;
+    double peak, runtime, best, minpeak, t[NRUNTIMES];
+    StorageMode smode;
+    PetscFunctionBegin;
+
+    cgrid[0] = 0; cgrid[1] = 0;
+    mode = INMEMORY; fits = false;
+    best = 0.0; minpeak = 0.0;
+
+    for (grid[0] = 1; grid[0] <= np; ++grid[0]) {
+        if (np % grid[0] != 0) continue;
+        grid[1] = np/grid[0];
+        if (!this->IsFeasible(grid)) continue;
+
+        for (m = 0; m < NSTORAGEMODES; ++m) {
+            smode = static_cast<StorageMode>(m);
+            if (!this->IsAvailable(smode)) continue;
+            ierr = this->GetPeakMemory(peak, grid, smode); CHKERRQ(ierr);
+
+            if (peak <= MEMFRACTION*this->m_AvailableMemory) {
+                ierr = this->EstimateRuntime(t, grid); CHKERRQ(ierr);
+                runtime = t[NEWTONITER];
+                if (!fits || smode < mode || (smode == mode && runtime < best)) {
+                    cgrid[0] = grid[0]; cgrid[1] = grid[1];
+                    mode = smode; best = runtime; fits = true;
+                }
+                break;
+            } else if (!fits && (cgrid[0] == 0 || peak < minpeak)) {
+                cgrid[0] = grid[0]; cgrid[1] = grid[1];
+                mode = smode; minpeak = peak;
+            }
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief smallest number of mpi tasks (power of two) for which the
+ * estimate fits into memory
+ * @param[out] np number of mpi tasks (0 if there is none)
+ * @param[in] inmemory flag: only consider in memory storage
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::GetMinNumProcs(int& np, bool inmemory) {
+    PetscErrorCode ierr = 0;
+    int cgrid[2], n;
+    IntType npmax;
+    StorageMode mode;
+    bool fits;
+    PetscFunctionBegin;
+
+    np = 0;
+    npmax = this->m_Opt->m_Domain.nx[0]*this->m_Opt->m_Domain.nx[1];
+    for (n = 1; n <= npmax; n *= 2) {
+        ierr = this->SelectProcessGrid(cgrid, mode, fits, n); CHKERRQ(ierr);
+        if (fits && (!inmemory || mode == INMEMORY)) {
+            np = n;
+            break;
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief estimate resources and display plan
+ *******************************************************************/
+PetscErrorCode ResourcePlanner::Run() {
+    PetscErrorCode ierr = 0;
+    std::stringstream ss;
+    std::vector<Buffer> buffers;
+    std::string line, modename[NSTORAGEMODES];
+    int cgrid[2], npmin;
+    double peak, t[NRUNTIMES], scratch;
+    StorageMode mode;
+    bool fits;
+    const double GB = 1073741824.0;
+    PetscFunctionBegin;
+
+    ierr = Assert(this->m_Opt != NULL, "null pointer"); CHKERRQ(ierr);
+
+    this->m_Opt->Enter(__func__);
+
+    modename[INMEMORY]   = "in memory";
+    modename[COMPRESSED] = "compressed (-histtol)";
+    modename[OUTOFCORE]  = "out-of-core (-histdir)";
+
+    if (this->m_Opt->m_Plan.nprocs > 0) {
+        this->m_NumProcs = this->m_Opt->m_Plan.nprocs;
+    } else {
+        MPI_Comm_size(PETSC_COMM_WORLD, &this->m_NumProcs);
+    }
+    ierr = this->GetAvailableMemory(); CHKERRQ(ierr);
+
+    line = std::string(this->m_Opt->m_LineLength, '-');
+    ierr = Msg(line); CHKERRQ(ierr);
+    ss << "resource plan: nx=(" << this->m_Opt->m_Domain.nx[0] << ","
+       << this->m_Opt->m_Domain.nx[1] << "," << this->m_Opt->m_Domain.nx[2]
+       << "), nc=" << this->m_Opt->m_Domain.nc << ", nt=" << this->m_Opt->m_Domain.nt
+       << ", " << this->m_NumProcs << " mpi tasks x " << this->m_Opt->m_NumThreads << " threads, "
+       << std::fixed << std::setprecision(2) << this->m_AvailableMemory/GB << " GB per task";
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    ierr = Msg(line); CHKERRQ(ierr);
+
+    ierr = this->SelectProcessGrid(cgrid, mode, fits, this->m_NumProcs); CHKERRQ(ierr);
+    if (cgrid[0] == 0) {
+        ss << "no feasible process grid for " << this->m_NumProcs
+           << " mpi tasks (local size smaller than ghost width); reduce number of mpi tasks";
+        ierr = WrngMsg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
+    // memory footprint per buffer
+    ierr = this->EstimateMemory(buffers, cgrid, mode); CHKERRQ(ierr);
+    ss << std::left << std::setw(50) << "memory per mpi task"
+       << std::right << std::setw(14) << "size (MB)";
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    peak = 0.0;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        ss << std::left << std::setw(50) << ("  " + buffers[i].name)
+           << std::right << std::fixed << std::setprecision(2)
+           << std::setw(14) << buffers[i].bytes/1048576.0;
+        ierr = Msg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+        peak += buffers[i].bytes;
+    }
+    ss << std::left << std::setw(50) << "  total" << std::right << std::fixed
+       << std::setprecision(2) << std::setw(14) << peak/1048576.0;
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    ierr = Msg(line); CHKERRQ(ierr);
+
+    // peak memory for all storage modes
+    for (int m = 0; m < NSTORAGEMODES; ++m) {
+        ss << std::left << std::setw(50) << ("peak memory, " + modename[m]);
+        if (this->IsAvailable(static_cast<StorageMode>(m))) {
+            ierr = this->GetPeakMemory(peak, cgrid, static_cast<StorageMode>(m)); CHKERRQ(ierr);
+            ss << std::right << std::fixed << std::setprecision(2) << std::setw(11) << peak/GB << " GB";
+        } else {
+            ss << std::right << std::setw(14) << "n/a";
+        }
+        ierr = Msg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+    }
+    ierr = Msg(line); CHKERRQ(ierr);
+
+    // runtime
+    ierr = this->EstimateRuntime(t, cgrid); CHKERRQ(ierr);
+    ss << std::left << std::setw(50) << "runtime estimate (nominal rates)"
+       << std::right << std::setw(14) << "time (s)";
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    ss << std::left << std::setw(50) << "  forward solve" << std::right << std::scientific
+       << std::setprecision(2) << std::setw(14) << t[FWDSOLVE];
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    ss << std::left << std::setw(50) << "  gradient" << std::right << std::scientific
+       << std::setprecision(2) << std::setw(14) << t[GRADIENT];
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    ss << std::left << std::setw(50) << "  hessian matvec (incl. preconditioner)" << std::right
+       << std::scientific << std::setprecision(2) << std::setw(14) << t[HESSMATVEC];
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    ss << std::left << std::setw(50) << ("  newton iteration (" + std::to_string(NUMMATVECS) + " matvecs)")
+       << std::right << std::scientific << std::setprecision(2) << std::setw(14) << t[NEWTONITER];
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    ss << std::left << std::setw(50) << ("  " + std::to_string(this->m_Opt->m_OptPara.maxiter) + " newton iterations (upper bound)")
+       << std::right << std::scientific << std::setprecision(2) << std::setw(14)
+       << this->m_Opt->m_OptPara.maxiter*t[NEWTONITER];
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    if (mode == OUTOFCORE) {
+        // every newton iteration writes the history once per forward solve
+        // (gradient and line search) and reads it once per adjoint solve
+        // and hessian matvec
+        scratch = (this->m_Opt->m_PDESolver.histtol > 0.0 ? 2.0
+                   : (this->m_Opt->m_PDESolver.mixedprecision ? sizeof(float) : sizeof(ScalarType)))
+                * (this->m_Opt->m_Domain.nt + 1)*this->m_Opt->m_Domain.nc
+                * static_cast<double>((this->m_Opt->m_Domain.nx[0] + cgrid[0] - 1)/cgrid[0])
+                * static_cast<double>((this->m_Opt->m_Domain.nx[1] + cgrid[1] - 1)/cgrid[1])
+                * static_cast<double>(this->m_Opt->m_Domain.nx[2]);
+        ss << std::left << std::setw(50) << "  scratch i/o per task and newton iteration"
+           << std::right << std::fixed << std::setprecision(2) << std::setw(11)
+           << (3.0 + NUMMATVECS)*scratch/GB << " GB";
+        ierr = Msg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+    }
+    ierr = Msg(line); CHKERRQ(ierr);
+
+    // recommendation
+    ss << "recommended: -np " << cgrid[0] << "x" << cgrid[1];
+    if (mode == COMPRESSED) {
+        ss << " -histtol <dbl> (e.g., 1e-3 for images in [0,1])";
+    } else if (mode == OUTOFCORE) {
+        ss << " -histdir <node-local path>";
+    }
+    ss << "; time history " << modename[mode];
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+
+    if (!fits) {
+        ss << "estimate exceeds " << std::fixed << std::setprecision(0) << 100.0*MEMFRACTION
+           << "% of the memory per task for " << this->m_NumProcs << " mpi tasks";
+        ierr = WrngMsg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+    }
+
+    // smallest number of tasks (same memory per task)
+    ierr = this->GetMinNumProcs(npmin, true); CHKERRQ(ierr);
+    ss << std::left << std::setw(50) << "min mpi tasks (power of two), in memory";
+    if (npmin > 0) ss << npmin; else ss << "n/a";
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+    if (this->IsAvailable(OUTOFCORE)) {
+        ierr = this->GetMinNumProcs(npmin, false); CHKERRQ(ierr);
+        ss << std::left << std::setw(50) << "min mpi tasks (power of two), any storage mode";
+        if (npmin > 0) ss << npmin; else ss << "n/a";
+        ierr = Msg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+    }
+    ierr = Msg(line); CHKERRQ(ierr);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _RESOURCEPLANNER_CPP_
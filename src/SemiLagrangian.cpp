@@ -77,10 +77,18 @@ PetscErrorCode SemiLagrangian::Initialize() {
 
     this->m_ScaFieldGhost = NULL;
     this->m_VecFieldGhost = NULL;
+    this->m_MultiFieldGhost = NULL;
+    this->m_ScaFieldCoeff = NULL;
+    this->m_xhat = NULL;
 
     this->m_Opt = NULL;
     this->m_Dofs[0] = 1;
     this->m_Dofs[1] = 3;
+    this->m_Dofs[2] = 1;
+    this->m_Dofs[3] = 1;
+    this->m_Dofs[4] = 3;
+    this->m_NumPlanVersions = 3;
+    this->m_TimeStepSize = 0.0;
 
     PetscFunctionReturn(ierr);
 }
@@ -119,6 +127,21 @@ PetscErrorCode SemiLagrangian::ClearMemory() {
         this->m_VecFieldGhost = NULL;
     }
 
+    if (this->m_MultiFieldGhost != NULL) {
+        accfft_free(this->m_MultiFieldGhost);
+        this->m_MultiFieldGhost = NULL;
+    }
+
+    if (this->m_ScaFieldCoeff != NULL) {
+        accfft_free(this->m_ScaFieldCoeff);
+        this->m_ScaFieldCoeff = NULL;
+    }
+
+    if (this->m_xhat != NULL) {
+        accfft_free(this->m_xhat);
+        this->m_xhat = NULL;
+    }
+
     if (this->m_WorkVecField2 != NULL) {
         delete this->m_WorkVecField2;
         this->m_WorkVecField2 = NULL;
@@ -146,6 +169,24 @@ PetscErrorCode SemiLagrangian::SetWorkVecField(VecField* x) {
 
 
 
+/********************************************************************
+ * @brief set the time step size used to compute the trajectory
+ * (the hessian matvecs can be evaluated on a coarser time grid than
+ * the state equation; 0 resets to the time step size of the options)
+ *******************************************************************/
+PetscErrorCode SemiLagrangian::SetTimeStepSize(ScalarType ht) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = Assert(ht >= 0.0, "time step size < 0"); CHKERRQ(ierr);
+    this->m_TimeStepSize = ht;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief compute the trajectory from the velocity field based
  * on an rk2 scheme (todo: make the velocity field a const vector)
@@ -203,7 +244,7 @@ PetscErrorCode SemiLagrangian::ComputeTrajectoryRK2(VecField* v, std::string fla
 
     ierr = Assert(this->m_WorkVecField1 != NULL, "null pointer"); CHKERRQ(ierr);
 
-    ht = this->m_Opt->GetTimeStepSize();
+    ht = this->m_TimeStepSize > 0.0 ? this->m_TimeStepSize : this->m_Opt->GetTimeStepSize();
     hthalf = 0.5*ht;
     
     if (this->m_Opt->m_Verbosity > 2) {
@@ -315,7 +356,7 @@ PetscErrorCode SemiLagrangian::ComputeTrajectoryRK4(VecField* v, std::string fla
         }
     }
 
-    ht = this->m_Opt->GetTimeStepSize();
+    ht = this->m_TimeStepSize > 0.0 ? this->m_TimeStepSize : this->m_Opt->GetTimeStepSize();
     hthalf = 0.5*ht;
 
     // switch between state and adjoint variable
@@ -535,10 +576,10 @@ PetscErrorCode SemiLagrangian::Interpolate(Vec* xo, Vec xi, std::string flag) {
  *******************************************************************/
 PetscErrorCode SemiLagrangian::Interpolate(ScalarType* xo, ScalarType* xi, std::string flag) {
     PetscErrorCode ierr = 0;
-    int nx[3], isize_g[3], isize[3], istart_g[3], istart[3], c_dims[2], neval, order, nghost;
+    int nx[3], isize_g[3], isize[3], istart_g[3], istart[3], c_dims[2], neval, nghost;
     IntType nl, nalloc;
     std::stringstream ss;
-    double timers[4] = {0, 0, 0, 0};
+    double timers[NINTERPTIMERS] = {0};
 
     PetscFunctionBegin;
 
@@ -550,8 +591,7 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* xo, ScalarType* xi, std::
     ierr = this->m_Opt->StartTimer(IPSELFEXEC); CHKERRQ(ierr);
 
     nl     = this->m_Opt->m_Domain.nl;
-    order  = this->m_Opt->m_PDESolver.iporder;
-    nghost = order;
+    nghost = interp3_kernel_ghost_size(this->m_Opt->m_PDESolver.ipkernel);
     neval  = static_cast<int>(nl);
 
     for (int i = 0; i < 3; ++i) {
@@ -569,11 +609,31 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* xo, ScalarType* xi, std::
     // if scalar field with ghost points has not been allocated
     if (this->m_ScaFieldGhost == NULL) {
         this->m_ScaFieldGhost = reinterpret_cast<ScalarType*>(accfft_alloc(nalloc));
+        ierr = AdviseHugePages(this->m_ScaFieldGhost, nalloc); CHKERRQ(ierr);
+        ierr = FirstTouch(this->m_ScaFieldGhost, nalloc/sizeof(ScalarType)); CHKERRQ(ierr);
+    }
+
+    // the b-spline kernel interpolates spline coefficients instead of grid values
+    if (interp3_kernel_prefilter(this->m_Opt->m_PDESolver.ipkernel)) {
+        if (this->m_ScaFieldCoeff == NULL) {
+            this->m_ScaFieldCoeff = reinterpret_cast<ScalarType*>(accfft_alloc(this->m_Opt->m_FFT.nalloc));
+        }
+        ierr = this->ApplyBSplinePrefilter(this->m_ScaFieldCoeff, xi); CHKERRQ(ierr);
+        xi = this->m_ScaFieldCoeff;
     }
 
     // assign ghost points based on input scalar field
     accfft_get_ghost_xyz(this->m_Opt->m_FFT.plan, nghost, isize_g, xi, this->m_ScaFieldGhost);
 
+    // pick the implementation of the cubic kernel (first interpolation only)
+    if (this->m_Opt->m_PDESolver.iptune && this->m_Opt->m_PDESolver.ipkernel == INTERP3_CUBIC) {
+        if (strcmp(flag.c_str(), "state") == 0) {
+            ierr = this->TuneInterpolation(this->m_StatePlan, this->m_ScaFieldGhost); CHKERRQ(ierr);
+        } else if (strcmp(flag.c_str(), "adjoint") == 0) {
+            ierr = this->TuneInterpolation(this->m_AdjointPlan, this->m_ScaFieldGhost); CHKERRQ(ierr);
+        }
+    }
+
     // compute interpolation for all components of the input scalar field
     if (strcmp(flag.c_str(), "state") == 0) {
         this->m_StatePlan->interpolate(this->m_ScaFieldGhost, nx, isize, istart,
@@ -596,6 +656,124 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* xo, ScalarType* xi, std::
 
 
 
+/********************************************************************
+ * @brief interpolate a stack of nc scalar fields (stored one after
+ * the other with stride nl; e.g., all components of a multi-component
+ * image or a block of incremental variables); the fields are split
+ * into batches that match the dofs of the plan versions; each batch
+ * uses a single interpolation sweep (stencil weights are shared
+ * across fields) and a single exchange of the interpolated values
+ *******************************************************************/
+PetscErrorCode SemiLagrangian::Interpolate(ScalarType* xo, ScalarType* xi, IntType nc, std::string flag) {
+    PetscErrorCode ierr = 0;
+    int nx[3], isize_g[3], isize[3], istart_g[3], istart[3], c_dims[2], nghost, version, ndofmax;
+    IntType nl, nlghost, nalloc, nb;
+    double timers[NINTERPTIMERS] = {0};
+    ScalarType* p_xk = NULL;
+    Interp3_Plan* plan = NULL;
+
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(xi != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(xo != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(nc > 0, "number of fields has to be positive"); CHKERRQ(ierr);
+
+    // nothing to batch
+    if (nc == 1) {
+        ierr = this->Interpolate(xo, xi, flag); CHKERRQ(ierr);
+        this->m_Opt->Exit(__func__);
+        PetscFunctionReturn(ierr);
+    }
+
+    if (strcmp(flag.c_str(), "state") == 0) {
+        plan = this->m_StatePlan;
+    } else if (strcmp(flag.c_str(), "adjoint") == 0) {
+        plan = this->m_AdjointPlan;
+    } else {
+        ierr = ThrowError("flag wrong"); CHKERRQ(ierr);
+    }
+    ierr = Assert(plan != NULL, "null pointer"); CHKERRQ(ierr);
+
+    ierr = this->m_Opt->StartTimer(IPSELFEXEC); CHKERRQ(ierr);
+
+    nl     = this->m_Opt->m_Domain.nl;
+    nghost = interp3_kernel_ghost_size(this->m_Opt->m_PDESolver.ipkernel);
+
+    for (int i = 0; i < 3; ++i) {
+        nx[i]     = static_cast<int>(this->m_Opt->m_Domain.nx[i]);
+        isize[i]  = static_cast<int>(this->m_Opt->m_Domain.isize[i]);
+        istart[i] = static_cast<int>(this->m_Opt->m_Domain.istart[i]);
+    }
+
+    c_dims[0] = this->m_Opt->m_CartGridDims[0];
+    c_dims[1] = this->m_Opt->m_CartGridDims[1];
+
+    // get ghost sizes
+    nalloc = accfft_ghost_xyz_local_size_dft_r2c(this->m_Opt->m_FFT.plan, nghost, isize_g, istart_g);
+
+    nlghost = 1;
+    for (int i = 0; i < 3; ++i) {
+        nlghost *= static_cast<IntType>(isize_g[i]);
+    }
+
+    // ghost buffer holds the largest batch
+    if (this->m_MultiFieldGhost == NULL) {
+        ndofmax = 1;
+        for (int v = 0; v < this->m_NumPlanVersions; ++v) {
+            ndofmax = std::max(ndofmax, this->m_Dofs[v]);
+        }
+        this->m_MultiFieldGhost = reinterpret_cast<ScalarType*>(accfft_alloc(ndofmax*nalloc));
+        ierr = AdviseHugePages(this->m_MultiFieldGhost, ndofmax*nalloc); CHKERRQ(ierr);
+        ierr = FirstTouch(this->m_MultiFieldGhost, ndofmax*nlghost, ndofmax); CHKERRQ(ierr);
+    }
+
+    if (interp3_kernel_prefilter(this->m_Opt->m_PDESolver.ipkernel)) {
+        if (this->m_ScaFieldCoeff == NULL) {
+            this->m_ScaFieldCoeff = reinterpret_cast<ScalarType*>(accfft_alloc(this->m_Opt->m_FFT.nalloc));
+        }
+    }
+
+    for (IntType l = 0; l < nc; l += nb) {
+        // largest plan version that fits into the remaining fields
+        // (version 0 is a single scalar field, so there always is one)
+        version = 0;
+        for (int v = 1; v < this->m_NumPlanVersions; ++v) {
+            if (this->m_Dofs[v] <= nc - l && this->m_Dofs[v] > this->m_Dofs[version]) {
+                version = v;
+            }
+        }
+        nb = static_cast<IntType>(this->m_Dofs[version]);
+
+        // assign ghost points for all fields of the batch (all ghost layers
+        // are set before we write the output, so xo and xi can be the same)
+        for (IntType k = 0; k < nb; ++k) {
+            p_xk = xi + (l + k)*nl;
+            if (interp3_kernel_prefilter(this->m_Opt->m_PDESolver.ipkernel)) {
+                ierr = this->ApplyBSplinePrefilter(this->m_ScaFieldCoeff, p_xk); CHKERRQ(ierr);
+                p_xk = this->m_ScaFieldCoeff;
+            }
+            accfft_get_ghost_xyz(this->m_Opt->m_FFT.plan, nghost, isize_g, p_xk,
+                                 &this->m_MultiFieldGhost[k*nlghost]);
+        }
+
+        plan->interpolate(this->m_MultiFieldGhost, nx, isize, istart,
+                          nl, nghost, xo + l*nl, c_dims, this->m_Opt->m_FFT.mpicomm, timers, version);
+    }
+
+    ierr = this->m_Opt->StopTimer(IPSELFEXEC); CHKERRQ(ierr);
+    this->m_Opt->IncreaseInterpTimers(timers);
+    this->m_Opt->IncrementCounter(IP, nc);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /********************************************************************
  * @brief interpolate vector field
  *******************************************************************/
@@ -632,8 +810,8 @@ PetscErrorCode SemiLagrangian::Interpolate(VecField* vo, VecField* vi, std::stri
 PetscErrorCode SemiLagrangian::Interpolate(ScalarType* wx1, ScalarType* wx2, ScalarType* wx3,
                                            ScalarType* vx1, ScalarType* vx2, ScalarType* vx3, std::string flag) {
     PetscErrorCode ierr = 0;
-    int nx[3], isize_g[3], isize[3], istart_g[3], istart[3], c_dims[2], nghost, order;
-    double timers[4] = {0, 0, 0, 0};
+    int nx[3], isize_g[3], isize[3], istart_g[3], istart[3], c_dims[2], nghost;
+    double timers[NINTERPTIMERS] = {0};
     std::stringstream ss;
     IntType nl, nlghost, nalloc;
 
@@ -649,8 +827,7 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* wx1, ScalarType* wx2, Sca
     ierr = Assert(wx3 != NULL, "null pointer"); CHKERRQ(ierr);
 
     nl = this->m_Opt->m_Domain.nl;
-    order = this->m_Opt->m_PDESolver.iporder;
-    nghost = order;
+    nghost = interp3_kernel_ghost_size(this->m_Opt->m_PDESolver.ipkernel);
 
     for (int i = 0; i < 3; ++i) {
         nx[i] = static_cast<int>(this->m_Opt->m_Domain.nx[i]);
@@ -669,7 +846,9 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* wx1, ScalarType* wx2, Sca
         }
     }
 
-    // copy data to a flat vector
+    // copy data to a flat vector (same static schedule as the
+    // compute loops; this is also the first touch of m_X)
+#pragma omp parallel for schedule(static)
     for (IntType i = 0; i < nl; ++i) {
         this->m_X[0*nl+i] = vx1[i];
         this->m_X[1*nl+i] = vx2[i];
@@ -690,9 +869,19 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* wx1, ScalarType* wx2, Sca
     // deal with ghost points
     if (this->m_VecFieldGhost == NULL) {
         this->m_VecFieldGhost = reinterpret_cast<ScalarType*>(accfft_alloc(3*nalloc));
+        ierr = AdviseHugePages(this->m_VecFieldGhost, 3*nalloc); CHKERRQ(ierr);
+        ierr = FirstTouch(this->m_VecFieldGhost, 3*nlghost, 3); CHKERRQ(ierr);
     }
 
 
+    // the b-spline kernel interpolates spline coefficients instead of grid values
+    // (m_X holds a copy of the input, so we can overwrite it)
+    if (interp3_kernel_prefilter(this->m_Opt->m_PDESolver.ipkernel)) {
+        for (int i = 0; i < 3; i++) {
+            ierr = this->ApplyBSplinePrefilter(&this->m_X[i*nl], &this->m_X[i*nl]); CHKERRQ(ierr);
+        }
+    }
+
     // do the communication for the ghost points
     for (int i = 0; i < 3; i++) {
         accfft_get_ghost_xyz(this->m_Opt->m_FFT.plan, nghost, isize_g, &this->m_X[i*nl],
@@ -713,6 +902,7 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* wx1, ScalarType* wx2, Sca
 
     ierr = this->m_Opt->StopTimer(IPSELFEXEC); CHKERRQ(ierr);
 
+#pragma omp parallel for schedule(static)
     for (IntType i = 0; i < nl; ++i) {
         wx1[i] = this->m_X[0*nl+i];
         wx2[i] = this->m_X[1*nl+i];
@@ -730,6 +920,225 @@ PetscErrorCode SemiLagrangian::Interpolate(ScalarType* wx1, ScalarType* wx2, Sca
 
 
 
+/********************************************************************
+ * @brief compute the coefficients of the cubic b-spline interpolant
+ * of a scalar field; the interpolation condition sum_k c_k B(x_j - k) = f_j
+ * is a periodic convolution with the sampled b-spline (1/6,2/3,1/6) along
+ * each axis, so we invert it in the spectral domain (one fft pair)
+ * @param c b-spline coefficients (output; can be the same as f)
+ * @param f grid values (input)
+ *******************************************************************/
+PetscErrorCode SemiLagrangian::ApplyBSplinePrefilter(ScalarType* c, ScalarType* f) {
+    PetscErrorCode ierr = 0;
+    IntType osize[3], ostart[3];
+    int nx[3];
+    ScalarType scale;
+    std::vector<ScalarType> symbol[3];
+    double timer[NFFTTIMERS] = {0};
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(c != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(f != NULL, "null pointer"); CHKERRQ(ierr);
+
+    if (this->m_xhat == NULL) {
+        this->m_xhat = reinterpret_cast<ComplexType*>(accfft_alloc(this->m_Opt->m_FFT.nalloc));
+    }
+
+    // inverse of the symbol of the sampled b-spline along each axis:
+    // (1/6 e^{-iw} + 2/3 + 1/6 e^{iw})^{-1} = 3/(2 + cos(w)); it is
+    // bounded by 3, so the deconvolution is well posed
+    for (int i = 0; i < 3; ++i) {
+        nx[i]     = static_cast<int>(this->m_Opt->m_Domain.nx[i]);
+        osize[i]  = this->m_Opt->m_FFT.osize[i];
+        ostart[i] = this->m_Opt->m_FFT.ostart[i];
+        symbol[i].resize(osize[i]);
+        for (IntType j = 0; j < osize[i]; ++j) {
+            ScalarType w = 2.0*PETSC_PI*static_cast<ScalarType>(j + ostart[i])/static_cast<ScalarType>(nx[i]);
+            symbol[i][j] = 3.0/(2.0 + std::cos(w));
+        }
+    }
+    scale = this->m_Opt->ComputeFFTScale();
+
+    accfft_execute_r2c(this->m_Opt->m_FFT.plan, f, this->m_xhat, timer);
+
+#pragma omp parallel
+{
+    IntType li, i1, i2, i3;
+    ScalarType s;
+#pragma omp for
+    for (i1 = 0; i1 < osize[0]; ++i1) {  // x1
+        for (i2 = 0; i2 < osize[1]; ++i2) {  // x2
+            for (i3 = 0; i3 < osize[2]; ++i3) {  // x3
+                li = GetLinearIndex(i1, i2, i3, osize);
+                s = scale*symbol[0][i1]*symbol[1][i2]*symbol[2][i3];
+                this->m_xhat[li][0] *= s;
+                this->m_xhat[li][1] *= s;
+            } // i3
+        } // i2
+    } // i1
+} // pragma omp parallel
+
+    accfft_execute_c2r(this->m_Opt->m_FFT.plan, this->m_xhat, c, timer);
+
+    // increment fft timer and counter
+    this->m_Opt->IncreaseFFTTimers(timer);
+    this->m_Opt->IncrementCounter(FFT, 2);
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief select the implementation of the cubic interpolation kernel;
+ * the candidates are timed on the query points of the last scatter of
+ * the plan (the ghosted field is the input of the interpolation); the
+ * choice is cached per hardware signature (cpu, threads, procs,
+ * precision, local grid) in the output folder, so that subsequent runs
+ * with the same setup skip the timing; the variant is timed on plan
+ * version 0 (scalar fields) and only applied to that version, the
+ * vector and block versions keep the compiled default
+ * @param plan interpolation plan (scatter has been done)
+ * @param xghost scalar field with ghost points
+ *******************************************************************/
+PetscErrorCode SemiLagrangian::TuneInterpolation(Interp3_Plan* plan, ScalarType* xghost) {
+    PetscErrorCode ierr = 0;
+    int nx[3], isize[3], istart[3], nghost, rank, nproc, variant = -1, found = 0;
+    double timings[INTERP3_NVARIANTS];
+    std::string fn, signature, cpu, key, name;
+    std::ifstream cachereader;
+    std::ofstream cachewriter;
+    std::stringstream ss;
+    PetscFunctionBegin;
+
+    this->m_Opt->Enter(__func__);
+
+    ierr = Assert(plan != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(xghost != NULL, "null pointer"); CHKERRQ(ierr);
+
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+    MPI_Comm_size(this->m_Opt->m_Comm, &nproc);
+
+    // we only tune once per run
+    this->m_Opt->m_PDESolver.iptune = false;
+
+    nghost = interp3_kernel_ghost_size(this->m_Opt->m_PDESolver.ipkernel);
+    for (int i = 0; i < 3; ++i) {
+        nx[i]     = static_cast<int>(this->m_Opt->m_Domain.nx[i]);
+        isize[i]  = static_cast<int>(this->m_Opt->m_Domain.isize[i]);
+        istart[i] = static_cast<int>(this->m_Opt->m_Domain.istart[i]);
+    }
+
+    fn = this->m_Opt->m_FileNames.xfolder + "interp-variant.cache";
+
+    // look up the hardware signature (the decision of rank 0 is used by all ranks)
+    if (rank == 0) {
+        cpu = "unknown";
+        cachereader.open("/proc/cpuinfo");
+        while (cachereader.is_open() && std::getline(cachereader, key)) {
+            if (key.compare(0, 10, "model name") == 0 && key.find(':') != std::string::npos) {
+                cpu = key.substr(key.find(':') + 1);
+                break;
+            }
+        }
+        cachereader.close();
+        cachereader.clear();
+        for (size_t i = 0; i < cpu.size(); ++i) {
+            if (cpu[i] == ' ' || cpu[i] == '\t') cpu[i] = '_';
+        }
+        ss << cpu << "/nt" << omp_get_max_threads() << "/np" << nproc
+           << "/fp" << 8*sizeof(ScalarType)
+           << "/nl" << isize[0] << "x" << isize[1] << "x" << isize[2];
+        signature = ss.str();
+        ss.clear(); ss.str(std::string());
+
+        cachereader.open(fn.c_str());
+        while (cachereader.is_open() && (cachereader >> key >> name)) {
+            if (key == signature && interp3_variant_available(interp3_variant_from_name(name.c_str()))) {
+                variant = interp3_variant_from_name(name.c_str());
+                found = 1;
+            }
+        }
+        cachereader.close();
+    }
+    MPI_Bcast(&found, 1, MPI_INT, 0, this->m_Opt->m_Comm);
+    MPI_Bcast(&variant, 1, MPI_INT, 0, this->m_Opt->m_Comm);
+
+    if (!found) {
+        variant = plan->autotune(xghost, nx, isize, istart, nghost,
+                                 this->m_Opt->m_FFT.mpicomm, timings, 0);
+        if (this->m_Opt->m_Verbosity > 1) {
+            for (int i = 0; i < INTERP3_NVARIANTS; ++i) {
+                ss << "kernel variant " << std::left << std::setw(12) << interp3_variant_name(i);
+                if (timings[i] < 0.0) {
+                    ss << "n/a";
+                } else {
+                    ss << std::scientific << timings[i] << "s";
+                }
+                ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+                ss.clear(); ss.str(std::string());
+            }
+        }
+        // append to the cache (failure to write is not an error)
+        if (rank == 0 && variant >= 0) {
+            cachewriter.open(fn.c_str(), std::ios::app);
+            if (cachewriter.is_open()) {
+                cachewriter << signature << " " << interp3_variant_name(variant) << std::endl;
+                cachewriter.close();
+            }
+        }
+    }
+
+    if (this->m_Opt->m_Verbosity > 1) {
+        ss << "interpolation kernel variant: " << interp3_variant_name(variant)
+           << (found ? " (cached)" : " (autotuned)");
+        ierr = DbgMsg(ss.str()); CHKERRQ(ierr);
+        ss.clear(); ss.str(std::string());
+    }
+
+    this->m_Opt->m_PDESolver.ipvariant = variant;
+    this->m_Opt->m_PDESolver.iptuned = variant >= 0;
+    plan->variant = variant;
+    plan->variant_version = 0;
+
+    this->m_Opt->Exit(__func__);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set the dofs of the plan versions; the block versions are
+ * only added if hessian matvecs are applied to blocks of vectors
+ * (they set the size of the interpolation and ghost buffers)
+ *******************************************************************/
+PetscErrorCode SemiLagrangian::SetPlanDofs() {
+    PetscErrorCode ierr = 0;
+    int nb, nc;
+    PetscFunctionBegin;
+
+    nc = static_cast<int>(this->m_Opt->m_Domain.nc);
+    nb = this->m_Opt->m_KrylovMethod.hessblock;
+
+    this->m_Dofs[0] = 1;
+    this->m_Dofs[1] = 3;
+    this->m_Dofs[2] = nc;
+    this->m_Dofs[3] = nb*nc;
+    this->m_Dofs[4] = nb*3;
+    this->m_NumPlanVersions = nb > 1 ? 5 : 3;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
 /********************************************************************
  * @brief communicate the coordinate vector (query points)
  * @param flag to switch between forward and adjoint solves
@@ -738,7 +1147,7 @@ PetscErrorCode SemiLagrangian::CommunicateCoord(std::string flag) {
     PetscErrorCode ierr;
     int nx[3], nl, isize[3], istart[3], nghost;
     int c_dims[2];
-    double timers[4] = {0, 0, 0, 0};
+    double timers[NINTERPTIMERS] = {0};
     std::stringstream ss;
     PetscFunctionBegin;
 
@@ -748,7 +1157,7 @@ PetscErrorCode SemiLagrangian::CommunicateCoord(std::string flag) {
 
     // get sizes
     nl     = static_cast<int>(this->m_Opt->m_Domain.nl);
-    nghost = this->m_Opt->m_PDESolver.iporder;
+    nghost = interp3_kernel_ghost_size(this->m_Opt->m_PDESolver.ipkernel);
     for (int i = 0; i < 3; ++i) {
         nx[i] = static_cast<int>(this->m_Opt->m_Domain.nx[i]);
         isize[i] = static_cast<int>(this->m_Opt->m_Domain.isize[i]);
@@ -773,8 +1182,14 @@ PetscErrorCode SemiLagrangian::CommunicateCoord(std::string flag) {
             catch (std::bad_alloc& err) {
                 ierr = reg::ThrowError(err); CHKERRQ(ierr);
             }
-            this->m_StatePlan->allocate(nl, this->m_Dofs, 2);
+            ierr = this->SetPlanDofs(); CHKERRQ(ierr);
+            this->m_StatePlan->allocate(nl, this->m_Dofs, this->m_NumPlanVersions);
         }
+        this->m_StatePlan->kernel = this->m_Opt->m_PDESolver.ipkernel;
+        this->m_StatePlan->compress_bits = this->m_Opt->m_PDESolver.ipcompress;
+        this->m_StatePlan->variant = this->m_Opt->m_PDESolver.ipvariant;
+        this->m_StatePlan->variant_version = this->m_Opt->m_PDESolver.iptuned ? 0 : -1;
+        this->m_StatePlan->query_sort = this->m_Opt->m_PDESolver.ipsort;
 
         // scatter
         this->m_StatePlan->scatter(nx, isize, istart, nl, nghost, this->m_X,
@@ -791,8 +1206,14 @@ PetscErrorCode SemiLagrangian::CommunicateCoord(std::string flag) {
             catch (std::bad_alloc& err) {
                 ierr = reg::ThrowError(err); CHKERRQ(ierr);
             }
-            this->m_AdjointPlan->allocate(nl, this->m_Dofs, 2);
+            ierr = this->SetPlanDofs(); CHKERRQ(ierr);
+            this->m_AdjointPlan->allocate(nl, this->m_Dofs, this->m_NumPlanVersions);
         }
+        this->m_AdjointPlan->kernel = this->m_Opt->m_PDESolver.ipkernel;
+        this->m_AdjointPlan->compress_bits = this->m_Opt->m_PDESolver.ipcompress;
+        this->m_AdjointPlan->variant = this->m_Opt->m_PDESolver.ipvariant;
+        this->m_AdjointPlan->variant_version = this->m_Opt->m_PDESolver.iptuned ? 0 : -1;
+        this->m_AdjointPlan->query_sort = this->m_Opt->m_PDESolver.ipsort;
 
         // communicate coordinates
         this->m_AdjointPlan->scatter(nx, isize, istart, nl, nghost, this->m_X,
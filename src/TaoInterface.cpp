@@ -384,22 +384,30 @@ PetscErrorCode CheckConvergenceGradObj(Tao tao, void* ptr) {
 
 
 /****************************************************************************
- * @brief convergence test for optimization
- * @param tao pointer to tao solver
+ * @brief gradient based stopping conditions (shared by the convergence
+ * test for tao and the native newton-krylov driver)
  * @param optprob pointer to optimziation problem
+ * @param iter current iteration
+ * @param maxiter max number of iterations
+ * @param J current objective value
+ * @param gnorm norm of current gradient
+ * @param step step size of last line search
+ * @param gatol absolute tolerance for gradient
+ * @param gttol relative tolerance for gradient
+ * @param reason termination reason (TAO_CONTINUE_ITERATING if none applies)
  ****************************************************************************/
-PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
+PetscErrorCode CheckConvergenceGrad(OptimizationProblem* optprob, IntType iter, IntType maxiter,
+                                    ScalarType J, ScalarType gnorm, ScalarType step,
+                                    ScalarType gatol, ScalarType gttol, TaoConvergedReason& reason) {
     PetscErrorCode ierr = 0;
-    IntType iter, maxiter, miniter;
-    OptimizationProblem* optprob = NULL;
-    ScalarType J, gnorm, step, gatol, grtol, gttol, g0norm, minstep;
+    IntType miniter;
+    ScalarType g0norm, minstep;
     bool stop[3];
     int verbosity;
     std::stringstream ss, sc;
 
     PetscFunctionBegin;
 
-    optprob = reinterpret_cast<OptimizationProblem*>(ptr);
     ierr = Assert(optprob != NULL, "null pointer"); CHKERRQ(ierr);
 
     verbosity = optprob->GetOptions()->m_Verbosity;
@@ -412,26 +420,19 @@ PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
     g0norm = optprob->GetOptions()->m_Monitor.gradnorm0;
     g0norm = (g0norm > 0.0) ? g0norm : 1.0;
 
-#if (PETSC_VERSION_MAJOR >= 3) && (PETSC_VERSION_MINOR >= 7)
-    ierr = TaoGetTolerances(tao, &gatol, &grtol, &gttol); CHKERRQ(ierr);
-#else
-    ierr = TaoGetTolerances(tao, NULL, NULL, &gatol, &grtol, &gttol); CHKERRQ(ierr);
-#endif
-
-    ierr = TaoGetMaximumIterations(tao, &maxiter); CHKERRQ(ierr);
-    ierr = TaoGetSolutionStatus(tao, &iter, &J, &gnorm, NULL, &step, NULL); CHKERRQ(ierr);
+    reason = TAO_CONTINUE_ITERATING;
 
     // check for NaN value
     if (PetscIsInfOrNanReal(J)) {
         ierr = WrngMsg("objective is NaN"); CHKERRQ(ierr);
-        ierr = TaoSetConvergedReason(tao, TAO_DIVERGED_NAN); CHKERRQ(ierr);
+        reason = TAO_DIVERGED_NAN;
         PetscFunctionReturn(ierr);
     }
 
     // check for NaN value
     if (PetscIsInfOrNanReal(gnorm)) {
         ierr = WrngMsg("||g|| is NaN"); CHKERRQ(ierr);
-        ierr = TaoSetConvergedReason(tao, TAO_DIVERGED_NAN); CHKERRQ(ierr);
+        reason = TAO_DIVERGED_NAN;
         PetscFunctionReturn(ierr);
     }
 
@@ -448,13 +449,13 @@ PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
             ss << "step  = " << std::scientific << step << " < " << minstep << " = " << "bound";
             ierr = WrngMsg(ss.str()); CHKERRQ(ierr);
             ss.str(std::string()); ss.clear();
-            ierr = TaoSetConvergedReason(tao, TAO_CONVERGED_STEPTOL); CHKERRQ(ierr);
+            reason = TAO_CONVERGED_STEPTOL;
             PetscFunctionReturn(ierr);
         }
 
         // ||g_k||_2 < tol*||g_0||
         if (gnorm < gttol*g0norm) {
-            ierr = TaoSetConvergedReason(tao, TAO_CONVERGED_GTTOL); CHKERRQ(ierr);
+            reason = TAO_CONVERGED_GTTOL;
             stop[0] = true;
         }
         ss << "[  " << stop[0] << "    ||g|| = " << std::setw(14)
@@ -465,7 +466,7 @@ PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
 
         // ||g_k||_2 < tol
         if (gnorm < gatol) {
-            ierr = TaoSetConvergedReason(tao, TAO_CONVERGED_GATOL); CHKERRQ(ierr);
+            reason = TAO_CONVERGED_GATOL;
             stop[1] = true;
         }
         ss  << "[  " << stop[1] << "    ||g|| = " << std::setw(14)
@@ -476,7 +477,7 @@ PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
 
         // iteration number exceeds limit
         if (iter > maxiter) {
-            ierr = TaoSetConvergedReason(tao, TAO_DIVERGED_MAXITS); CHKERRQ(ierr);
+            reason = TAO_DIVERGED_MAXITS;
             stop[2] = true;
         }
         ss  << "[  " << stop[2] << "     iter = " << std::setw(14)
@@ -499,7 +500,7 @@ PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
             ss << "||g|| = " << std::scientific << 0.0 << " < " << gatol  << " = " << "bound";
             ierr = WrngMsg(ss.str()); CHKERRQ(ierr);
             ss.str(std::string()); ss.clear();
-            ierr = TaoSetConvergedReason(tao, TAO_CONVERGED_GATOL); CHKERRQ(ierr);
+            reason = TAO_CONVERGED_GATOL;
             PetscFunctionReturn(ierr);
         }
     }
@@ -511,9 +512,6 @@ PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
 //        ierr = optprob->DerivativeCheckHessianFD(); CHKERRQ(ierr);
     }
 
-    // if we're here, we're good to go
-    ierr = TaoSetConvergedReason(tao, TAO_CONTINUE_ITERATING); CHKERRQ(ierr);
-
     // go home
     PetscFunctionReturn(ierr);
 }
@@ -522,46 +520,77 @@ PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
 
 
 /****************************************************************************
- * @brief monitor the optimization process
+ * @brief convergence test for optimization
  * @param tao pointer to tao solver
- * @param ptr pointer to optimziation problem (has to be implemented by user)
+ * @param optprob pointer to optimziation problem
  ****************************************************************************/
-PetscErrorCode OptimizationMonitor(Tao tao, void* ptr) {
+PetscErrorCode CheckConvergenceGrad(Tao tao, void* ptr) {
+    PetscErrorCode ierr = 0;
+    IntType iter, maxiter;
+    OptimizationProblem* optprob = NULL;
+    ScalarType J, gnorm, step, gatol, grtol, gttol;
+    TaoConvergedReason reason;
+
+    PetscFunctionBegin;
+
+    optprob = reinterpret_cast<OptimizationProblem*>(ptr);
+    ierr = Assert(optprob != NULL, "null pointer"); CHKERRQ(ierr);
+
+#if (PETSC_VERSION_MAJOR >= 3) && (PETSC_VERSION_MINOR >= 7)
+    ierr = TaoGetTolerances(tao, &gatol, &grtol, &gttol); CHKERRQ(ierr);
+#else
+    ierr = TaoGetTolerances(tao, NULL, NULL, &gatol, &grtol, &gttol); CHKERRQ(ierr);
+#endif
+
+    ierr = TaoGetMaximumIterations(tao, &maxiter); CHKERRQ(ierr);
+    ierr = TaoGetSolutionStatus(tao, &iter, &J, &gnorm, NULL, &step, NULL); CHKERRQ(ierr);
+
+    ierr = CheckConvergenceGrad(optprob, iter, maxiter, J, gnorm, step, gatol, gttol, reason); CHKERRQ(ierr);
+    ierr = TaoSetConvergedReason(tao, reason); CHKERRQ(ierr);
+
+    // go home
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/****************************************************************************
+ * @brief display progress of the optimization (shared by the monitor
+ * for tao and the native newton-krylov driver)
+ * @param optprob pointer to optimziation problem
+ * @param x current iterate
+ * @param iter current iteration
+ * @param J current objective value
+ * @param gnorm norm of current gradient
+ * @param step step size of last line search
+ * @param reason current termination reason
+ ****************************************************************************/
+PetscErrorCode OptimizationMonitor(OptimizationProblem* optprob, Vec x, IntType iter,
+                                   ScalarType J, ScalarType gnorm, ScalarType step,
+                                   TaoConvergedReason reason) {
     PetscErrorCode ierr = 0;
-    IntType iter;
     int iterdisp;
     char msg[256];
     std::string statusmsg;
-    ScalarType J, gnorm, step, D, J0, D0, gnorm0;
-    OptimizationProblem* optprob = NULL;
-    Vec x = NULL;
-    TaoConvergedReason convreason;
+    ScalarType D, J0, D0, gnorm0;
 
     PetscFunctionBegin;
 
-    optprob = reinterpret_cast<OptimizationProblem*>(ptr);
     ierr = Assert(optprob != NULL, "null pointer"); CHKERRQ(ierr);
 
     // reinit the initialization of the preconditioner
     optprob->GetOptions()->m_KrylovMethod.pcsetupdone = false;
 
-    if (optprob->GetOptions()->m_Verbosity > 1) {
-        ierr = GetLineSearchStatus(tao, optprob); CHKERRQ(ierr);
-    }
-
-    // get current iteration, objective value, norm of gradient, norm of
-    // contraint, step length / trust region radius and termination reason
-    ierr = TaoGetSolutionStatus(tao, &iter, &J, &gnorm, NULL, &step, &convreason); CHKERRQ(ierr);
-
     // save gradient norm
     optprob->GetOptions()->m_Monitor.gradnorm = gnorm;
 
     // remember current iterate
     optprob->IncrementIterations();
 
-    // tao: display convergence reason
+    // display convergence reason
     if (optprob->GetOptions()->m_Verbosity > 0) {
-        ierr = GetSolverStatus(convreason, statusmsg); CHKERRQ(ierr);
+        ierr = GetSolverStatus(reason, statusmsg); CHKERRQ(ierr);
         optprob->GetOptions()->m_Monitor.solverstatus = statusmsg;
     }
 
@@ -580,8 +609,7 @@ PetscErrorCode OptimizationMonitor(Tao tao, void* ptr) {
     J0 = optprob->GetOptions()->m_Monitor.jval0;
     J0 = (J0 > 0.0) ? J0 : 1.0;
 
-    // get the solution vector and finalize the iteration
-    ierr = TaoGetSolutionVector(tao, &x); CHKERRQ(ierr);
+    // finalize the iteration
     ierr = optprob->FinalizeIteration(x); CHKERRQ(ierr);
 
     // display progress to user
@@ -602,6 +630,43 @@ PetscErrorCode OptimizationMonitor(Tao tao, void* ptr) {
 
 
 
+/****************************************************************************
+ * @brief monitor the optimization process
+ * @param tao pointer to tao solver
+ * @param ptr pointer to optimziation problem (has to be implemented by user)
+ ****************************************************************************/
+PetscErrorCode OptimizationMonitor(Tao tao, void* ptr) {
+    PetscErrorCode ierr = 0;
+    IntType iter;
+    ScalarType J, gnorm, step;
+    OptimizationProblem* optprob = NULL;
+    Vec x = NULL;
+    TaoConvergedReason convreason;
+
+    PetscFunctionBegin;
+
+    optprob = reinterpret_cast<OptimizationProblem*>(ptr);
+    ierr = Assert(optprob != NULL, "null pointer"); CHKERRQ(ierr);
+
+    if (optprob->GetOptions()->m_Verbosity > 1) {
+        ierr = GetLineSearchStatus(tao, optprob); CHKERRQ(ierr);
+    }
+
+    // get current iteration, objective value, norm of gradient, norm of
+    // contraint, step length / trust region radius and termination reason
+    ierr = TaoGetSolutionStatus(tao, &iter, &J, &gnorm, NULL, &step, &convreason); CHKERRQ(ierr);
+
+    // get the solution vector and display progress
+    ierr = TaoGetSolutionVector(tao, &x); CHKERRQ(ierr);
+    ierr = OptimizationMonitor(optprob, x, iter, J, gnorm, step, convreason); CHKERRQ(ierr);
+
+    // go home
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
 /****************************************************************************
  * @brief display the convergence reason of the KSP method
  ****************************************************************************/
@@ -609,6 +674,7 @@ PetscErrorCode GetLineSearchStatus(Tao tao, void* ptr) {
     PetscErrorCode ierr = 0;
     std::string msg;
     IntType nl, ng;
+    MPI_Comm comm;
     ScalarType J, step;
     TaoLineSearchConvergedReason flag;
     OptimizationProblem* optprob = NULL;
@@ -622,10 +688,11 @@ PetscErrorCode GetLineSearchStatus(Tao tao, void* ptr) {
 
     nl = optprob->GetOptions()->m_Domain.nl;
     ng = optprob->GetOptions()->m_Domain.ng;
+    comm = optprob->GetOptions()->m_Comm;
 
     ierr = TaoGetLineSearch(tao, &ls); CHKERRQ(ierr);
-    ierr = VecCreate(x, nl, ng); CHKERRQ(ierr);
-    ierr = VecCreate(g, 3*nl, 3*ng); CHKERRQ(ierr);
+    ierr = VecCreate(comm, x, nl, ng); CHKERRQ(ierr);
+    ierr = VecCreate(comm, g, 3*nl, 3*ng, 3); CHKERRQ(ierr);
     ierr = TaoLineSearchGetSolution(ls, x, &J, g, &step, &flag); CHKERRQ(ierr);
 
     switch(flag) {
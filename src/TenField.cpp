@@ -201,49 +201,53 @@ PetscErrorCode TenField::Allocate(int level) {
  *******************************************************************/
 PetscErrorCode TenField::Allocate(IntType nl, IntType ng) {
     PetscErrorCode ierr;
+    MPI_Comm comm;
     PetscFunctionBegin;
 
     // make sure, that all pointers are deallocated
     ierr = this->ClearMemory(); CHKERRQ(ierr);
 
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X11); CHKERRQ(ierr);
+    // fields without options live on all tasks
+    comm = this->m_Opt != NULL ? this->m_Opt->m_Comm : PETSC_COMM_WORLD;
+
+    ierr = VecCreate(comm, &this->m_X11); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X11, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X11); CHKERRQ(ierr);
 
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X12); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X12); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X12, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X12); CHKERRQ(ierr);
 
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X13); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X13); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X13, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X13); CHKERRQ(ierr);
 
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X21); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X21); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X21, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X21); CHKERRQ(ierr);
 
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X22); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X22); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X22, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X22); CHKERRQ(ierr);
 
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X23); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X23); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X23, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X23); CHKERRQ(ierr);
 
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X31); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X31); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X31, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X31); CHKERRQ(ierr);
 
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X32); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X32); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X32, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X32); CHKERRQ(ierr);
 
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X33); CHKERRQ(ierr);
+    ierr = VecCreate(comm, &this->m_X33); CHKERRQ(ierr);
     ierr = VecSetSizes(this->m_X33, nl, ng); CHKERRQ(ierr);
     ierr = VecSetFromOptions(this->m_X33); CHKERRQ(ierr);
 
@@ -0,0 +1,737 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+
+#ifndef _TIMEHISTORY_CPP_
+#define _TIMEHISTORY_CPP_
+
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include "TimeHistory.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief write n bytes to file at given offset (executed
+ * asynchronously); returns number of bytes written or -1
+ *******************************************************************/
+static long WriteBytes(int fd, const unsigned char* data, size_t n, off_t offset) {
+    size_t done = 0;
+    while (done < n) {
+        ssize_t rval = pwrite(fd, data + done, n - done, offset + done);
+        if (rval < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        done += rval;
+    }
+    return static_cast<long>(done);
+}
+
+
+
+
+/********************************************************************
+ * @brief read n bytes from file at given offset (executed
+ * asynchronously); returns number of bytes read or -1
+ *******************************************************************/
+static long ReadBytes(int fd, unsigned char* data, size_t n, off_t offset) {
+    size_t done = 0;
+    while (done < n) {
+        ssize_t rval = pread(fd, data + done, n - done, offset + done);
+        if (rval < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (rval == 0) break;
+        done += rval;
+    }
+    return static_cast<long>(done);
+}
+
+
+
+
+/********************************************************************
+ * @brief default constructor
+ *******************************************************************/
+TimeHistory::TimeHistory() {
+    this->Initialize();
+}
+
+
+
+
+/********************************************************************
+ * @brief constructor
+ *******************************************************************/
+TimeHistory::TimeHistory(RegOpt* opt) {
+    this->Initialize();
+    this->m_Opt = opt;
+}
+
+
+
+
+/********************************************************************
+ * @brief default destructor
+ *******************************************************************/
+TimeHistory::~TimeHistory() {
+    this->ClearMemory();
+}
+
+
+
+
+/********************************************************************
+ * @brief init variables
+ *******************************************************************/
+PetscErrorCode TimeHistory::Initialize() {
+    PetscFunctionBegin;
+
+    this->m_Opt = NULL;
+
+    this->m_NumTimePoints = 0;
+    this->m_NumComponents = 0;
+    this->m_NumValues = 0;
+    this->m_NumBlocks = 0;
+
+    this->m_Tolerance = 0.0;
+    this->m_SinglePrecision = false;
+
+    this->m_Buffer = NULL;
+
+    this->m_FileDescriptor = -1;
+    this->m_SliceCapacity = 0;
+    this->m_WriteSlot = 0;
+    for (int i = 0; i < NSLOTS; ++i) {
+        this->m_Slot[i].timepoint = -1;
+    }
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief clean up
+ *******************************************************************/
+PetscErrorCode TimeHistory::ClearMemory() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    // wait for pending i/o before we release the buffers
+    for (int i = 0; i < 2; ++i) {
+        if (this->m_WriteRequest[i].valid()) this->m_WriteRequest[i].wait();
+        this->m_WriteBuffer[i].clear();
+    }
+    for (int i = 0; i < NSLOTS; ++i) {
+        if (this->m_Slot[i].request.valid()) this->m_Slot[i].request.wait();
+        this->m_Slot[i].data.clear();
+        this->m_Slot[i].timepoint = -1;
+    }
+
+    if (this->m_FileDescriptor >= 0) {
+        close(this->m_FileDescriptor);
+        this->m_FileDescriptor = -1;
+    }
+
+    if (this->m_Buffer != NULL) {
+        accfft_free(this->m_Buffer);
+        this->m_Buffer = NULL;
+    }
+
+    this->m_Data.clear();
+    this->m_Offset.clear();
+    this->m_Width.clear();
+    this->m_SliceBytes.clear();
+    this->m_Start.clear();
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief allocate storage for the time history
+ * @param[in] nt number of time steps (we store nt+1 time points)
+ * @param[in] nc number of components
+ * @param[in] nl number of (local) values per component
+ *******************************************************************/
+PetscErrorCode TimeHistory::SetSizes(IntType nt, IntType nc, IntType nl) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = Assert(nt > 0, "nt <= 0"); CHKERRQ(ierr);
+    ierr = Assert(nc > 0, "nc <= 0"); CHKERRQ(ierr);
+
+    if (this->m_NumTimePoints == nt+1 && this->m_NumComponents == nc
+        && this->m_NumValues == nl) {
+        PetscFunctionReturn(ierr);
+    }
+
+    ierr = this->ClearMemory(); CHKERRQ(ierr);
+
+    this->m_NumTimePoints = nt+1;
+    this->m_NumComponents = nc;
+    this->m_NumValues = nl;
+    this->m_NumBlocks = (nl + BLOCKSIZE - 1)/BLOCKSIZE;
+
+    // upper bound for size of a compressed time point (all blocks
+    // stored in full precision)
+    this->m_SliceCapacity = nc*(this->m_NumBlocks*(1 + sizeof(ScalarType)) + nl*sizeof(ScalarType));
+
+    try {
+        this->m_Data.resize(this->m_NumTimePoints*nc);
+        this->m_Offset.resize(this->m_NumTimePoints*nc);
+        this->m_Width.resize(this->m_NumBlocks);
+        this->m_SliceBytes.resize(this->m_NumTimePoints, 0);
+        this->m_Start.resize(this->m_NumTimePoints*nc, 0);
+    } catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+
+    // the buffer is passed to the spectral operators (same alignment as fft data)
+    this->m_Buffer = reinterpret_cast<ScalarType*>(accfft_alloc(nl*sizeof(ScalarType)));
+    ierr = Assert(this->m_Buffer != NULL, "allocation failed"); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief set absolute error bound for compression; for a tolerance
+ * of zero, the values are stored in full precision (only useful for
+ * out-of-core storage)
+ *******************************************************************/
+PetscErrorCode TimeHistory::SetTolerance(ScalarType tol) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = Assert(tol >= 0.0, "tolerance < 0"); CHKERRQ(ierr);
+    this->m_Tolerance = tol;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief store the blocks that are not quantized in single instead
+ * of full precision (halves the size of the uncompressed time
+ * history in double precision builds; no effect in single precision
+ * builds); the error of these blocks is the rounding error of float
+ *******************************************************************/
+PetscErrorCode TimeHistory::SetSinglePrecision(bool flag) {
+    PetscFunctionBegin;
+
+    this->m_SinglePrecision = flag;
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief store the time history out-of-core; every rank writes
+ * its time points to a file in the given folder (should be on
+ * node-local storage); the file is removed when it is closed
+ *******************************************************************/
+PetscErrorCode TimeHistory::SetScratchFolder(std::string folder) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = Assert(!folder.empty(), "empty folder name"); CHKERRQ(ierr);
+    ierr = Assert(this->m_FileDescriptor < 0, "scratch file already open"); CHKERRQ(ierr);
+    this->m_ScratchFolder = folder;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief open scratch file for out-of-core storage
+ *******************************************************************/
+PetscErrorCode TimeHistory::OpenScratchFile() {
+    PetscErrorCode ierr = 0;
+    std::stringstream ss;
+    int rank;
+    PetscFunctionBegin;
+
+    ierr = Assert(this->m_Opt != NULL, "null pointer"); CHKERRQ(ierr);
+    MPI_Comm_rank(this->m_Opt->m_Comm, &rank);
+
+    ss << this->m_ScratchFolder << "/claire-history-" << getpid() << "-" << rank << ".bin";
+    this->m_FileDescriptor = open(ss.str().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (this->m_FileDescriptor < 0) {
+        ierr = ThrowError("could not open " + ss.str() + ": " + strerror(errno)); CHKERRQ(ierr);
+    }
+    // the file is deleted as soon as we close it (or the process dies)
+    unlink(ss.str().c_str());
+
+    if (this->m_Opt->m_Verbosity > 1) {
+        ierr = DbgMsg("time history stored in " + this->m_ScratchFolder); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief wait until all pending writes are done
+ *******************************************************************/
+PetscErrorCode TimeHistory::WaitForWrites() {
+    PetscErrorCode ierr = 0;
+    long nbytes;
+    PetscFunctionBegin;
+
+    for (int i = 0; i < 2; ++i) {
+        if (this->m_WriteRequest[i].valid()) {
+            nbytes = this->m_WriteRequest[i].get();
+            ierr = Assert(nbytes >= 0, "writing time history failed"); CHKERRQ(ierr);
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief compress a component; the blocks are stored in data,
+ * starting at the given position
+ * @param[in] x component (nl values)
+ * @param[in,out] data compressed data (resized)
+ * @param[in] start position of first block in data
+ * @param[out] offset offset of blocks (relative to start)
+ *******************************************************************/
+PetscErrorCode TimeHistory::EncodeComponent(const ScalarType* x, std::vector<unsigned char>& data,
+                                            IntType start, std::vector<IntType>& offset) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nb, nbytes;
+    ScalarType step;
+    unsigned char fullwidth;
+    PetscFunctionBegin;
+
+    nl = this->m_NumValues;
+    nb = this->m_NumBlocks;
+
+    // step size of quantization (rounding error is at most half a step)
+    step = 2.0*this->m_Tolerance;
+
+    // bits per value of blocks that are not quantized
+    fullwidth = this->m_SinglePrecision ? 8*sizeof(float) : 8*sizeof(ScalarType);
+
+    // determine number of bits per value for all blocks
+#pragma omp parallel for
+    for (IntType b = 0; b < nb; ++b) {
+        IntType i0 = b*BLOCKSIZE, i1 = std::min(i0 + BLOCKSIZE, nl);
+        ScalarType minval = x[i0], maxval = x[i0], nlevels;
+        if (step == 0.0) {
+            this->m_Width[b] = fullwidth;
+            continue;
+        }
+        for (IntType i = i0; i < i1; ++i) {
+            minval = std::min(minval, x[i]);
+            maxval = std::max(maxval, x[i]);
+        }
+        nlevels = std::ceil((maxval - minval)/step);
+        if (maxval - minval <= step) {
+            this->m_Width[b] = 0;
+        } else if (nlevels < 256) {
+            this->m_Width[b] = 8;
+        } else if (nlevels < 65536) {
+            this->m_Width[b] = 16;
+        } else {
+            this->m_Width[b] = fullwidth;
+        }
+    }
+
+    // every block stores the bits per value and the minimum
+    // of the block, followed by the quantized values
+    nbytes = 0;
+    offset.resize(nb+1);
+    for (IntType b = 0; b < nb; ++b) {
+        IntType n = std::min((b+1)*BLOCKSIZE, nl) - b*BLOCKSIZE;
+        offset[b] = nbytes;
+        nbytes += 1 + sizeof(ScalarType) + n*this->m_Width[b]/8;
+    }
+    offset[nb] = nbytes;
+
+    // we keep the capacity of the stream (same compression rate
+    // for the next forward solve is likely)
+    try {data.resize(start + nbytes);}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+
+    // encode blocks
+#pragma omp parallel for
+    for (IntType b = 0; b < nb; ++b) {
+        IntType i0 = b*BLOCKSIZE, i1 = std::min(i0 + BLOCKSIZE, nl);
+        unsigned char width = this->m_Width[b];
+        unsigned char* p = &data[start + offset[b]];
+        ScalarType minval = x[i0], maxval = x[i0], value;
+
+        for (IntType i = i0; i < i1; ++i) {
+            minval = std::min(minval, x[i]);
+            maxval = std::max(maxval, x[i]);
+        }
+
+        *p++ = width;
+        if (width == 0) {
+            // constant block: store center of range
+            value = 0.5*(minval + maxval);
+            memcpy(p, &value, sizeof(ScalarType));
+        } else if (width == 8) {
+            memcpy(p, &minval, sizeof(ScalarType)); p += sizeof(ScalarType);
+            for (IntType i = i0; i < i1; ++i) {
+                *p++ = static_cast<unsigned char>((x[i] - minval)/step + 0.5);
+            }
+        } else if (width == 16) {
+            memcpy(p, &minval, sizeof(ScalarType)); p += sizeof(ScalarType);
+            for (IntType i = i0; i < i1; ++i) {
+                unsigned short q = static_cast<unsigned short>((x[i] - minval)/step + 0.5);
+                memcpy(p, &q, sizeof(unsigned short)); p += sizeof(unsigned short);
+            }
+        } else if (width == 8*sizeof(ScalarType)) {
+            memcpy(p, &minval, sizeof(ScalarType)); p += sizeof(ScalarType);
+            memcpy(p, x + i0, (i1 - i0)*sizeof(ScalarType));
+        } else {
+            // single precision (double precision builds only)
+            memcpy(p, &minval, sizeof(ScalarType)); p += sizeof(ScalarType);
+            for (IntType i = i0; i < i1; ++i) {
+                float v = static_cast<float>(x[i]);
+                memcpy(p, &v, sizeof(float)); p += sizeof(float);
+            }
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief decompress a component
+ * @param[out] x component (nl values)
+ * @param[in] data compressed blocks
+ * @param[in] offset offset of blocks in data
+ *******************************************************************/
+PetscErrorCode TimeHistory::DecodeComponent(ScalarType* x, const unsigned char* data,
+                                            const std::vector<IntType>& offset) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nb;
+    ScalarType step;
+    PetscFunctionBegin;
+
+    nl = this->m_NumValues;
+    nb = this->m_NumBlocks;
+    step = 2.0*this->m_Tolerance;
+
+#pragma omp parallel for
+    for (IntType b = 0; b < nb; ++b) {
+        IntType i0 = b*BLOCKSIZE, i1 = std::min(i0 + BLOCKSIZE, nl);
+        const unsigned char* p = data + offset[b];
+        unsigned char width = *p++;
+        ScalarType minval;
+
+        memcpy(&minval, p, sizeof(ScalarType)); p += sizeof(ScalarType);
+        if (width == 0) {
+            std::fill(x + i0, x + i1, minval);
+        } else if (width == 8) {
+            for (IntType i = i0; i < i1; ++i) {
+                x[i] = minval + step*static_cast<ScalarType>(*p++);
+            }
+        } else if (width == 16) {
+            for (IntType i = i0; i < i1; ++i) {
+                unsigned short q;
+                memcpy(&q, p, sizeof(unsigned short)); p += sizeof(unsigned short);
+                x[i] = minval + step*static_cast<ScalarType>(q);
+            }
+        } else if (width == 8*sizeof(ScalarType)) {
+            memcpy(x + i0, p, (i1 - i0)*sizeof(ScalarType));
+        } else {
+            for (IntType i = i0; i < i1; ++i) {
+                float v;
+                memcpy(&v, p, sizeof(float)); p += sizeof(float);
+                x[i] = static_cast<ScalarType>(v);
+            }
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief compress and store all components at time point j; for
+ * out-of-core storage, the time point is written asynchronously
+ * (the data is copied into one of two write buffers)
+ * @param[in] x field at time point j (nc components)
+ * @param[in] j index of time point
+ *******************************************************************/
+PetscErrorCode TimeHistory::SetTimePoint(const ScalarType* x, IntType j) {
+    PetscErrorCode ierr = 0;
+    IntType nl, nc, nbytes;
+    long rval;
+    int w;
+    PetscFunctionBegin;
+
+    ierr = Assert(x != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(j >= 0 && j < this->m_NumTimePoints, "time point out of range"); CHKERRQ(ierr);
+
+    nl = this->m_NumValues;
+    nc = this->m_NumComponents;
+
+    if (this->m_ScratchFolder.empty()) {
+        ierr = Assert(this->m_Tolerance > 0.0 || this->m_SinglePrecision, "tolerance not set"); CHKERRQ(ierr);
+        for (IntType k = 0; k < nc; ++k) {
+            ierr = this->EncodeComponent(x + k*nl, this->m_Data[j*nc + k], 0, this->m_Offset[j*nc + k]); CHKERRQ(ierr);
+        }
+        PetscFunctionReturn(ierr);
+    }
+
+    if (this->m_FileDescriptor < 0) {
+        ierr = this->OpenScratchFile(); CHKERRQ(ierr);
+    }
+
+    // wait until the buffer is available (write before last)
+    w = this->m_WriteSlot;
+    this->m_WriteSlot = 1 - w;
+    if (this->m_WriteRequest[w].valid()) {
+        rval = this->m_WriteRequest[w].get();
+        ierr = Assert(rval >= 0, "writing time history failed"); CHKERRQ(ierr);
+    }
+
+    // compress all components into write buffer
+    nbytes = 0;
+    this->m_WriteBuffer[w].reserve(this->m_SliceCapacity);
+    for (IntType k = 0; k < nc; ++k) {
+        this->m_Start[j*nc + k] = nbytes;
+        ierr = this->EncodeComponent(x + k*nl, this->m_WriteBuffer[w], nbytes, this->m_Offset[j*nc + k]); CHKERRQ(ierr);
+        nbytes += this->m_Offset[j*nc + k].back();
+    }
+    this->m_SliceBytes[j] = nbytes;
+
+    // a staged copy of this time point is outdated
+    for (int i = 0; i < NSLOTS; ++i) {
+        if (this->m_Slot[i].timepoint == j) {
+            if (this->m_Slot[i].request.valid()) this->m_Slot[i].request.wait();
+            this->m_Slot[i].timepoint = -1;
+        }
+    }
+
+    this->m_WriteRequest[w] = std::async(std::launch::async, WriteBytes, this->m_FileDescriptor,
+                                         this->m_WriteBuffer[w].data(), static_cast<size_t>(nbytes),
+                                         static_cast<off_t>(j)*static_cast<off_t>(this->m_SliceCapacity));
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief start to load time point j from the scratch file into a
+ * staging slot; we replace the staged time point that is farthest
+ * from j (the solvers traverse the time history monotonically)
+ * @param[in] j index of time point
+ *******************************************************************/
+PetscErrorCode TimeHistory::Prefetch(IntType j) {
+    PetscErrorCode ierr = 0;
+    IntType dist, maxdist;
+    int islot;
+    PetscFunctionBegin;
+
+    if (this->m_FileDescriptor < 0) PetscFunctionReturn(ierr);
+    if (j < 0 || j >= this->m_NumTimePoints) PetscFunctionReturn(ierr);
+    if (this->m_SliceBytes[j] == 0) PetscFunctionReturn(ierr);
+
+    islot = 0; maxdist = -1;
+    for (int i = 0; i < NSLOTS; ++i) {
+        if (this->m_Slot[i].timepoint == j) PetscFunctionReturn(ierr);
+        if (this->m_Slot[i].timepoint < 0) {
+            dist = this->m_NumTimePoints;
+        } else {
+            dist = std::abs(this->m_Slot[i].timepoint - j);
+        }
+        if (dist > maxdist) {
+            maxdist = dist; islot = i;
+        }
+    }
+
+    // time point has to be on disk
+    ierr = this->WaitForWrites(); CHKERRQ(ierr);
+
+    Slot& slot = this->m_Slot[islot];
+    if (slot.request.valid()) slot.request.wait();
+    try {slot.data.resize(this->m_SliceCapacity);}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    slot.timepoint = j;
+    slot.request = std::async(std::launch::async, ReadBytes, this->m_FileDescriptor,
+                              slot.data.data(), static_cast<size_t>(this->m_SliceBytes[j]),
+                              static_cast<off_t>(j)*static_cast<off_t>(this->m_SliceCapacity));
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief get staging slot that holds time point j (we wait for
+ * pending reads; if j has not been prefetched, it is loaded now)
+ *******************************************************************/
+PetscErrorCode TimeHistory::GetSlot(int& islot, IntType j) {
+    PetscErrorCode ierr = 0;
+    long nbytes;
+    PetscFunctionBegin;
+
+    islot = -1;
+    for (int i = 0; i < NSLOTS && islot < 0; ++i) {
+        if (this->m_Slot[i].timepoint == j) islot = i;
+    }
+    if (islot < 0) {
+        ierr = this->Prefetch(j); CHKERRQ(ierr);
+        for (int i = 0; i < NSLOTS && islot < 0; ++i) {
+            if (this->m_Slot[i].timepoint == j) islot = i;
+        }
+    }
+    ierr = Assert(islot >= 0, "time point not staged"); CHKERRQ(ierr);
+
+    if (this->m_Slot[islot].request.valid()) {
+        nbytes = this->m_Slot[islot].request.get();
+        ierr = Assert(nbytes == this->m_SliceBytes[j], "reading time history failed"); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief decompress component k at time point j; the data is
+ * decompressed into an internal buffer (valid until the next call)
+ * @param[out] x pointer to decompressed component
+ * @param[in] j index of time point
+ * @param[in] k index of component
+ *******************************************************************/
+PetscErrorCode TimeHistory::GetTimePoint(ScalarType*& x, IntType j, IntType k) {
+    PetscErrorCode ierr = 0;
+    IntType nc;
+    int islot;
+    PetscFunctionBegin;
+
+    ierr = Assert(j >= 0 && j < this->m_NumTimePoints, "time point out of range"); CHKERRQ(ierr);
+    ierr = Assert(k >= 0 && k < this->m_NumComponents, "component out of range"); CHKERRQ(ierr);
+
+    nc = this->m_NumComponents;
+    x = this->m_Buffer;
+
+    if (this->m_ScratchFolder.empty()) {
+        const std::vector<unsigned char>& data = this->m_Data[j*nc + k];
+        if (data.empty()) {
+            // time point has not been set
+            std::fill(x, x + this->m_NumValues, 0.0);
+        } else {
+            ierr = this->DecodeComponent(x, &data[0], this->m_Offset[j*nc + k]); CHKERRQ(ierr);
+        }
+    } else {
+        if (this->m_SliceBytes.empty() || this->m_SliceBytes[j] == 0) {
+            // time point has not been set
+            std::fill(x, x + this->m_NumValues, 0.0);
+        } else {
+            ierr = this->GetSlot(islot, j); CHKERRQ(ierr);
+            ierr = this->DecodeComponent(x, &this->m_Slot[islot].data[this->m_Start[j*nc + k]],
+                                         this->m_Offset[j*nc + k]); CHKERRQ(ierr);
+        }
+    }
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief compute ratio between the size of the uncompressed and
+ * the compressed time history (accumulated over all ranks)
+ *******************************************************************/
+PetscErrorCode TimeHistory::GetCompressionRatio(ScalarType& ratio) {
+    PetscErrorCode ierr = 0;
+    double nbytes[2] = {0, 0}, nbytesall[2] = {0, 0};
+    int rval;
+    PetscFunctionBegin;
+
+    nbytes[0] = static_cast<double>(this->m_NumTimePoints*this->m_NumComponents)
+              * static_cast<double>(this->m_NumValues*sizeof(ScalarType));
+    for (size_t i = 0; i < this->m_Data.size(); ++i) {
+        nbytes[1] += static_cast<double>(this->m_Data[i].size());
+        nbytes[1] += static_cast<double>(this->m_Offset[i].size()*sizeof(IntType));
+    }
+    for (size_t i = 0; i < this->m_SliceBytes.size(); ++i) {
+        nbytes[1] += static_cast<double>(this->m_SliceBytes[i]);
+    }
+
+    rval = MPI_Allreduce(nbytes, nbytesall, 2, MPI_DOUBLE, MPI_SUM, this->m_Opt->m_Comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+    ratio = nbytesall[1] > 0.0 ? static_cast<ScalarType>(nbytesall[0]/nbytesall[1]) : 0.0;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _TIMEHISTORY_CPP_
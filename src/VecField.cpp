@@ -215,38 +215,24 @@ PetscErrorCode VecField::Allocate(int level) {
 PetscErrorCode VecField::Allocate(IntType nl, IntType ng) {
     PetscErrorCode ierr = 0;
     std::stringstream ss;
+    MPI_Comm comm;
     PetscFunctionBegin;
 
     // make sure, that all pointers are deallocated
     ierr = this->ClearMemory(); CHKERRQ(ierr);
 
+    // fields without options live on all tasks
+    comm = this->m_Opt != NULL ? this->m_Opt->m_Comm : PETSC_COMM_WORLD;
+
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X1); CHKERRQ(ierr);
-    ierr = VecSetSizes(this->m_X1, nl, ng); CHKERRQ(ierr);
-    #ifdef REG_HAS_CUDA
-        ierr = VecSetType(this->m_X1, VECCUDA); CHKERRQ(ierr);
-    #else
-        ierr = VecSetFromOptions(this->m_X1); CHKERRQ(ierr);
-    #endif
+    ierr = VecCreate(comm, this->m_X1, nl, ng); CHKERRQ(ierr);
 
 
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X2); CHKERRQ(ierr);
-    ierr = VecSetSizes(this->m_X2, nl, ng); CHKERRQ(ierr);
-    #ifdef REG_HAS_CUDA
-        ierr = VecSetType(this->m_X2, VECCUDA); CHKERRQ(ierr);
-    #else
-        ierr = VecSetFromOptions(this->m_X2); CHKERRQ(ierr);
-    #endif
+    ierr = VecCreate(comm, this->m_X2, nl, ng); CHKERRQ(ierr);
 
     // allocate vector field
-    ierr = VecCreate(PETSC_COMM_WORLD, &this->m_X3); CHKERRQ(ierr);
-    ierr = VecSetSizes(this->m_X3, nl, ng); CHKERRQ(ierr);
-    #ifdef REG_HAS_CUDA
-        ierr = VecSetType(this->m_X3, VECCUDA); CHKERRQ(ierr);
-    #else
-        ierr = VecSetFromOptions(this->m_X3); CHKERRQ(ierr);
-    #endif
+    ierr = VecCreate(comm, this->m_X3, nl, ng); CHKERRQ(ierr);
 
     PetscFunctionReturn(ierr);
 }
@@ -663,7 +649,7 @@ PetscErrorCode VecField::Norm(ScalarType& value) {
     }
     ierr = this->RestoreArrays(p_x1, p_x2, p_x3); CHKERRQ(ierr);
 
-    rval = MPI_Allreduce(&vnorm, &value, 1, MPIU_REAL, MPI_SUM, PETSC_COMM_WORLD);
+    rval = MPI_Allreduce(&vnorm, &value, 1, MPIU_REAL, MPI_SUM, PetscObjectComm((PetscObject)this->m_X1));
     ierr = Assert(rval == MPI_SUCCESS, "mpi reduce returned error"); CHKERRQ(ierr);
 
     value = PetscSqrtReal(value);
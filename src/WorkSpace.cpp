@@ -0,0 +1,481 @@
+/*************************************************************************
+ *  Copyright (c) 2017.
+ *  All rights reserved.
+ *  This file is part of the CLAIRE library.
+ *
+ *  CLAIRE is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  CLAIRE is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with CLAIRE.  If not, see <http://www.gnu.org/licenses/>.
+ ************************************************************************/
+
+#ifndef _WORKSPACE_CPP_
+#define _WORKSPACE_CPP_
+
+#include <algorithm>
+#include <set>
+#include "WorkSpace.hpp"
+
+
+
+
+namespace reg {
+
+
+
+
+/********************************************************************
+ * @brief default constructor
+ *******************************************************************/
+WorkSpace::ScaFieldLease::ScaFieldLease() {
+    this->m_X = NULL;
+    this->m_WorkSpace = NULL;
+}
+
+
+
+
+/********************************************************************
+ * @brief default destructor (returns field to pool)
+ *******************************************************************/
+WorkSpace::ScaFieldLease::~ScaFieldLease() {
+    this->Release();
+}
+
+
+
+
+/********************************************************************
+ * @brief get field from pool
+ * @param[in] ws pool
+ * @param[in] comm communicator of the field
+ * @param[in] nl local size
+ * @param[in] ng global size
+ * @param[in] owner subsystem that holds the lease (for bookkeeping)
+ *******************************************************************/
+PetscErrorCode WorkSpace::ScaFieldLease::Acquire(WorkSpace* ws, MPI_Comm comm, IntType nl, IntType ng, std::string owner) {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    ierr = Assert(ws != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = this->Release(); CHKERRQ(ierr);
+
+    ierr = ws->GetScaField(this->m_X, comm, nl, ng, owner); CHKERRQ(ierr);
+    this->m_WorkSpace = ws;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief return field to pool
+ *******************************************************************/
+PetscErrorCode WorkSpace::ScaFieldLease::Release() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    if (this->m_WorkSpace != NULL && this->m_X != NULL) {
+        ierr = this->m_WorkSpace->ReturnScaField(this->m_X); CHKERRQ(ierr);
+    }
+    this->m_X = NULL;
+    this->m_WorkSpace = NULL;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief default constructor
+ *******************************************************************/
+WorkSpace::VecFieldLease::VecFieldLease() {
+    this->m_X = NULL;
+    this->m_WorkSpace = NULL;
+}
+
+
+
+
+/********************************************************************
+ * @brief default destructor (returns field to pool)
+ *******************************************************************/
+WorkSpace::VecFieldLease::~VecFieldLease() {
+    this->Release();
+}
+
+
+
+
+/********************************************************************
+ * @brief get vector field from pool
+ * @param[in] ws pool
+ * @param[in] opt options (define grid and communicator)
+ * @param[in] owner subsystem that holds the lease (for bookkeeping)
+ *******************************************************************/
+PetscErrorCode WorkSpace::VecFieldLease::Acquire(WorkSpace* ws, RegOpt* opt, std::string owner) {
+    PetscErrorCode ierr = 0;
+    IntType nl, ng;
+    PetscFunctionBegin;
+
+    ierr = Assert(ws != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = Assert(opt != NULL, "null pointer"); CHKERRQ(ierr);
+    ierr = this->Release(); CHKERRQ(ierr);
+
+    nl = opt->m_Domain.nl;
+    ng = opt->m_Domain.ng;
+
+    try {this->m_X = new VecField();}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+    this->m_WorkSpace = ws;
+    ierr = this->m_X->SetOpt(opt); CHKERRQ(ierr);
+    ierr = ws->GetScaField(this->m_X->m_X1, opt->m_Comm, nl, ng, owner); CHKERRQ(ierr);
+    ierr = ws->GetScaField(this->m_X->m_X2, opt->m_Comm, nl, ng, owner); CHKERRQ(ierr);
+    ierr = ws->GetScaField(this->m_X->m_X3, opt->m_Comm, nl, ng, owner); CHKERRQ(ierr);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief return vector field to pool
+ *******************************************************************/
+PetscErrorCode WorkSpace::VecFieldLease::Release() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    if (this->m_X != NULL) {
+        if (this->m_WorkSpace != NULL) {
+            // the components are destroyed by the pool (set to NULL)
+            if (this->m_X->m_X1 != NULL) {
+                ierr = this->m_WorkSpace->ReturnScaField(this->m_X->m_X1); CHKERRQ(ierr);
+            }
+            if (this->m_X->m_X2 != NULL) {
+                ierr = this->m_WorkSpace->ReturnScaField(this->m_X->m_X2); CHKERRQ(ierr);
+            }
+            if (this->m_X->m_X3 != NULL) {
+                ierr = this->m_WorkSpace->ReturnScaField(this->m_X->m_X3); CHKERRQ(ierr);
+            }
+        }
+        delete this->m_X;
+    }
+    this->m_X = NULL;
+    this->m_WorkSpace = NULL;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief default constructor
+ *******************************************************************/
+WorkSpace::WorkSpace() {
+    this->Initialize();
+}
+
+
+
+
+/********************************************************************
+ * @brief default destructor
+ *******************************************************************/
+WorkSpace::~WorkSpace() {
+    this->ClearMemory();
+}
+
+
+
+
+/********************************************************************
+ * @brief init variables
+ *******************************************************************/
+PetscErrorCode WorkSpace::Initialize() {
+    PetscFunctionBegin;
+
+    this->m_LiveBytes = 0.0;
+    this->m_PeakBytes = 0.0;
+    this->m_PoolBytes = 0.0;
+
+    PetscFunctionReturn(0);
+}
+
+
+
+
+/********************************************************************
+ * @brief clean up (all leases have to be returned)
+ *******************************************************************/
+PetscErrorCode WorkSpace::ClearMemory() {
+    PetscErrorCode ierr = 0;
+    PetscFunctionBegin;
+
+    for (size_t i = 0; i < this->m_Lease.size(); ++i) {
+        if (this->m_Lease[i].x != NULL) {
+            ierr = VecDestroy(&this->m_Lease[i].x); CHKERRQ(ierr);
+        }
+    }
+    this->m_Lease.clear();
+
+    for (size_t i = 0; i < this->m_Buffer.size(); ++i) {
+        if (this->m_Buffer[i].data != NULL) {
+            accfft_free(this->m_Buffer[i].data);
+        }
+    }
+    this->m_Buffer.clear();
+    this->m_PoolBytes = 0.0;
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief get scalar field from pool; we use the smallest free
+ * buffer that is large enough (allocate a new one if there is none)
+ * @param[out] x field (wraps pooled buffer)
+ * @param[in] comm communicator of the field (fields of all grid
+ * levels are drawn from the same pool)
+ * @param[in] nl local size
+ * @param[in] ng global size
+ * @param[in] owner subsystem that holds the lease (for bookkeeping)
+ *******************************************************************/
+PetscErrorCode WorkSpace::GetScaField(Vec& x, MPI_Comm comm, IntType nl, IntType ng, std::string owner) {
+    PetscErrorCode ierr = 0;
+    Lease lease;
+    double nbytes;
+    int ib = -1;
+    PetscFunctionBegin;
+
+    ierr = Assert(x == NULL, "field already allocated"); CHKERRQ(ierr);
+    ierr = Assert(nl > 0, "local size <= 0"); CHKERRQ(ierr);
+
+    nbytes = static_cast<double>(nl)*sizeof(ScalarType);
+
+#ifdef REG_HAS_CUDA
+    // data lives on the device; we only keep track of the usage
+    ierr = VecCreate(comm, x, nl, ng); CHKERRQ(ierr);
+#else
+    for (size_t i = 0; i < this->m_Buffer.size(); ++i) {
+        const Buffer& b = this->m_Buffer[i];
+        if (!b.inuse && b.capacity >= nl) {
+            if (ib < 0 || b.capacity < this->m_Buffer[ib].capacity) ib = static_cast<int>(i);
+        }
+    }
+    if (ib < 0) {
+        Buffer b;
+        // fields are passed to the spectral operators (same alignment as fft data)
+        b.data = reinterpret_cast<ScalarType*>(accfft_alloc(nl*sizeof(ScalarType)));
+        ierr = Assert(b.data != NULL, "allocation failed"); CHKERRQ(ierr);
+        b.capacity = nl;
+        b.inuse = false;
+        try {this->m_Buffer.push_back(b);}
+        catch (std::bad_alloc& err) {
+            ierr = reg::ThrowError(err); CHKERRQ(ierr);
+        }
+        ib = static_cast<int>(this->m_Buffer.size()) - 1;
+        this->m_PoolBytes += nbytes;
+    }
+    this->m_Buffer[ib].inuse = true;
+    ierr = VecCreateMPIWithArray(comm, 1, nl, ng, this->m_Buffer[ib].data, &x); CHKERRQ(ierr);
+#endif
+
+    lease.x = x;
+    lease.buffer = ib;
+    lease.nl = nl;
+    lease.owner = owner;
+    try {this->m_Lease.push_back(lease);}
+    catch (std::bad_alloc& err) {
+        ierr = reg::ThrowError(err); CHKERRQ(ierr);
+    }
+
+    // bookkeeping
+    Usage& usage = this->m_Usage[owner];
+    usage.live += nbytes;
+    usage.peak = std::max(usage.peak, usage.live);
+    usage.count++;
+    this->m_LiveBytes += nbytes;
+    this->m_PeakBytes = std::max(this->m_PeakBytes, this->m_LiveBytes);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief return field to pool (the vector is destroyed; the
+ * buffer is kept for the next lease)
+ *******************************************************************/
+PetscErrorCode WorkSpace::ReturnScaField(Vec& x) {
+    PetscErrorCode ierr = 0;
+    double nbytes;
+    size_t il;
+    PetscFunctionBegin;
+
+    if (x == NULL) PetscFunctionReturn(ierr);
+
+    for (il = 0; il < this->m_Lease.size(); ++il) {
+        if (this->m_Lease[il].x == x) break;
+    }
+    ierr = Assert(il < this->m_Lease.size(), "field not leased from pool"); CHKERRQ(ierr);
+
+    const Lease& lease = this->m_Lease[il];
+    nbytes = static_cast<double>(lease.nl)*sizeof(ScalarType);
+    this->m_Usage[lease.owner].live -= nbytes;
+    this->m_LiveBytes -= nbytes;
+    if (lease.buffer >= 0) {
+        this->m_Buffer[lease.buffer].inuse = false;
+    }
+
+    ierr = VecDestroy(&x); CHKERRQ(ierr);
+    x = NULL;
+
+    this->m_Lease.erase(this->m_Lease.begin() + il);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief release buffers that are currently not leased
+ *******************************************************************/
+PetscErrorCode WorkSpace::Shrink() {
+    PetscErrorCode ierr = 0;
+    std::vector<int> index(this->m_Buffer.size(), -1);
+    std::vector<Buffer> buffer;
+    PetscFunctionBegin;
+
+    for (size_t i = 0; i < this->m_Buffer.size(); ++i) {
+        if (this->m_Buffer[i].inuse) {
+            index[i] = static_cast<int>(buffer.size());
+            buffer.push_back(this->m_Buffer[i]);
+        } else {
+            accfft_free(this->m_Buffer[i].data);
+            this->m_PoolBytes -= static_cast<double>(this->m_Buffer[i].capacity)*sizeof(ScalarType);
+        }
+    }
+    for (size_t i = 0; i < this->m_Lease.size(); ++i) {
+        if (this->m_Lease[i].buffer >= 0) {
+            this->m_Lease[i].buffer = index[this->m_Lease[i].buffer];
+        }
+    }
+    this->m_Buffer.swap(buffer);
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+/********************************************************************
+ * @brief display live and peak usage per subsystem (in MB; max
+ * over all ranks)
+ * @param[in] comm communicator of the ranks that share the report
+ *******************************************************************/
+PetscErrorCode WorkSpace::Report(MPI_Comm comm) {
+    PetscErrorCode ierr = 0;
+    std::map<std::string, Usage>::const_iterator it;
+    std::set<std::string> owners;
+    std::set<std::string>::const_iterator ot;
+    std::vector<double> usage, usagemax;
+    std::vector<int> nchar, offset;
+    std::string names, allnames;
+    std::stringstream ss;
+    int rval, nprocs, n;
+    PetscFunctionBegin;
+
+    // the ranks may have registered different subsystems (e.g., idle
+    // ranks of a reduced coarse grid solve); gather the names of all
+    // subsystems (separated by '\0') and reduce over their union
+    for (it = this->m_Usage.begin(); it != this->m_Usage.end(); ++it) {
+        names += it->first;
+        names.push_back('\0');
+    }
+    MPI_Comm_size(comm, &nprocs);
+    n = static_cast<int>(names.size());
+    nchar.resize(nprocs);
+    offset.assign(nprocs, 0);
+    rval = MPI_Allgather(&n, 1, MPI_INT, &nchar[0], 1, MPI_INT, comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+    for (int p = 1; p < nprocs; ++p) offset[p] = offset[p-1] + nchar[p-1];
+    allnames.resize(offset[nprocs-1] + nchar[nprocs-1]);
+    rval = MPI_Allgatherv(names.data(), n, MPI_CHAR, &allnames[0], &nchar[0], &offset[0], MPI_CHAR, comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+    for (size_t i0 = 0, i1; i0 < allnames.size(); i0 = i1 + 1) {
+        i1 = allnames.find('\0', i0);
+        owners.insert(allnames.substr(i0, i1 - i0));
+    }
+
+    for (ot = owners.begin(); ot != owners.end(); ++ot) {
+        it = this->m_Usage.find(*ot);
+        usage.push_back(it != this->m_Usage.end() ? it->second.live : 0.0);
+        usage.push_back(it != this->m_Usage.end() ? it->second.peak : 0.0);
+    }
+    usage.push_back(this->m_LiveBytes);
+    usage.push_back(this->m_PeakBytes);
+    usage.push_back(this->m_PoolBytes);
+    usagemax.resize(usage.size());
+
+    rval = MPI_Allreduce(&usage[0], &usagemax[0], static_cast<int>(usage.size()),
+                         MPI_DOUBLE, MPI_MAX, comm);
+    ierr = Assert(rval == MPI_SUCCESS, "mpi error"); CHKERRQ(ierr);
+
+    ss << std::left << std::setw(30) << "work space (max over ranks)"
+       << std::right << std::setw(14) << "live (MB)"
+       << std::setw(14) << "peak (MB)";
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+
+    size_t i = 0;
+    for (ot = owners.begin(); ot != owners.end(); ++ot, i += 2) {
+        ss << std::left << std::setw(30) << ("  " + *ot)
+           << std::right << std::fixed << std::setprecision(2)
+           << std::setw(14) << usagemax[i]/1048576.0
+           << std::setw(14) << usagemax[i+1]/1048576.0;
+        ierr = Msg(ss.str()); CHKERRQ(ierr);
+        ss.str(std::string()); ss.clear();
+    }
+    ss << std::left << std::setw(30) << "  total"
+       << std::right << std::fixed << std::setprecision(2)
+       << std::setw(14) << usagemax[i]/1048576.0
+       << std::setw(14) << usagemax[i+1]/1048576.0;
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+
+    ss << std::left << std::setw(30) << "  allocated by pool"
+       << std::right << std::fixed << std::setprecision(2)
+       << std::setw(28) << usagemax[i+2]/1048576.0;
+    ierr = Msg(ss.str()); CHKERRQ(ierr);
+    ss.str(std::string()); ss.clear();
+
+    PetscFunctionReturn(ierr);
+}
+
+
+
+
+}  // namespace reg
+
+
+
+
+#endif  // _WORKSPACE_CPP_
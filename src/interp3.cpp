@@ -4089,6 +4089,356 @@ void interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
 
 }  // end of interp3_ghost_xyz_p
 
+/*
+ * Performs a 3D linear interpolation for a row major periodic input (x \in [0,1) )
+ * This function assumes that the input grid values have been padded on all sides
+ * by g_size grids (see interp3_kernel_ghost_size).
+ * @param[in] reg_grid_vals The function value at the regular grid
+ * @param[in] data_dof The degrees of freedom of the input function. In general
+ * you can input a vector to be interpolated. In that case, each dimension of the
+ * vector should be stored in a linearized contiguous order. That is the first dimension
+ * should be stored in reg_grid_vals and then the second dimension, ...
+ *
+ * @param[in] N_reg An integer pointer that specifies the size of the grid in each dimension.
+ *
+ * @param[in] N_pts The number of query points
+ *
+ * @param[in] g_size The number of ghost points padded around the input array
+ *
+ * @param[in] query_points The coordinates of the query points where the interpolated values are sought.
+ * If query_values_already_scaled is true, the coordinates are given in grid index units of the
+ * padded local array (output of rescale_xyz).
+ *
+ * @param[out] query_values The interpolated values
+ *
+ */
+
+void linear_interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
+		int* N_reg_g, int * isize_g, int* istart, const int N_pts,
+		const int g_size, Real* query_points_in, Real* query_values,
+		bool query_values_already_scaled) {
+	Real* query_points;
+
+	if (query_values_already_scaled == false) {
+		// First we need to rescale the query points to the new padded dimensions
+		// To avoid changing the user's input we first copy the query points to a
+		// new array
+		query_points = (Real*) malloc(N_pts * COORD_DIM * sizeof(Real));
+		memcpy(query_points, query_points_in, N_pts * COORD_DIM * sizeof(Real));
+		rescale_xyz(g_size, N_reg, N_reg_g, istart, N_pts, query_points);
+		for (int i = 0; i < N_pts * COORD_DIM; i++)
+			query_points[i] *= N_reg_g[i % COORD_DIM];
+	} else {
+		query_points = query_points_in;
+	}
+
+	const int N_reg3 = isize_g[0] * isize_g[1] * isize_g[2];
+	const int stride0 = isize_g[1] * isize_g[2];
+	const int stride1 = isize_g[2];
+
+#pragma omp parallel for
+	for (int i = 0; i < N_pts; i++) {
+		Real point[COORD_DIM];
+		int grid_indx[COORD_DIM];
+
+		for (int j = 0; j < COORD_DIM; j++) {
+			point[j] = query_points[COORD_DIM * i + j];
+			grid_indx[j] = floor(point[j]);
+			point[j] -= grid_indx[j];
+		}
+
+		// bilinear weights in the (x2,x3) plane; x1 is blended last
+		const Real w00 = (1.0 - point[1]) * (1.0 - point[2]);
+		const Real w01 = (1.0 - point[1]) * point[2];
+		const Real w10 = point[1] * (1.0 - point[2]);
+		const Real w11 = point[1] * point[2];
+		const int indxx = stride0 * grid_indx[0] + stride1 * grid_indx[1] + grid_indx[2];
+
+		for (int k = 0; k < data_dof; k++) {
+			const Real* ptr0 = &reg_grid_vals[indxx + k * N_reg3];
+			const Real* ptr1 = ptr0 + stride0;
+			const Real val0 = w00 * ptr0[0] + w01 * ptr0[1]
+							+ w10 * ptr0[stride1] + w11 * ptr0[stride1 + 1];
+			const Real val1 = w00 * ptr1[0] + w01 * ptr1[1]
+							+ w10 * ptr1[stride1] + w11 * ptr1[stride1 + 1];
+			query_values[i + k * N_pts] = (1.0 - point[0]) * val0 + point[0] * val1;
+		}
+	}
+
+	if (query_values_already_scaled == false) {
+		free(query_points);
+	}
+	return;
+
+}  // end of linear_interp3_ghost_xyz_p
+
+/*
+ * Performs a 3D cubic b-spline interpolation for a row major periodic input (x \in [0,1) )
+ * This function assumes that the input grid values have been padded on all sides
+ * by g_size grids (see interp3_kernel_ghost_size). The input are the b-spline
+ * coefficients of the function, i.e., the grid values have to be prefiltered
+ * (deconvolved with the sampled b-spline) before calling this function;
+ * otherwise the result is a smoothed approximation and not an interpolant.
+ * The stencil is the same 4x4x4 stencil as for the cubic lagrange kernel.
+ * @param[in] reg_grid_vals The b-spline coefficients at the regular grid
+ * @param[in] data_dof The degrees of freedom of the input function. In general
+ * you can input a vector to be interpolated. In that case, each dimension of the
+ * vector should be stored in a linearized contiguous order. That is the first dimension
+ * should be stored in reg_grid_vals and then the second dimension, ...
+ *
+ * @param[in] N_reg An integer pointer that specifies the size of the grid in each dimension.
+ *
+ * @param[in] N_pts The number of query points
+ *
+ * @param[in] g_size The number of ghost points padded around the input array
+ *
+ * @param[in] query_points The coordinates of the query points where the interpolated values are sought.
+ * If query_values_already_scaled is true, the coordinates are given in grid index units of the
+ * padded local array (output of rescale_xyz).
+ *
+ * @param[out] query_values The interpolated values
+ *
+ */
+
+void bspline_interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
+		int* N_reg_g, int * isize_g, int* istart, const int N_pts,
+		const int g_size, Real* query_points_in, Real* query_values,
+		bool query_values_already_scaled) {
+	Real* query_points;
+
+	if (query_values_already_scaled == false) {
+		// First we need to rescale the query points to the new padded dimensions
+		// To avoid changing the user's input we first copy the query points to a
+		// new array
+		query_points = (Real*) malloc(N_pts * COORD_DIM * sizeof(Real));
+		memcpy(query_points, query_points_in, N_pts * COORD_DIM * sizeof(Real));
+		rescale_xyz(g_size, N_reg, N_reg_g, istart, N_pts, query_points);
+		for (int i = 0; i < N_pts * COORD_DIM; i++)
+			query_points[i] *= N_reg_g[i % COORD_DIM];
+	} else {
+		query_points = query_points_in;
+	}
+
+	const int N_reg3 = isize_g[0] * isize_g[1] * isize_g[2];
+	const int stride0 = isize_g[1] * isize_g[2];
+	const int stride1 = isize_g[2];
+	const Real sixth = 1.0 / 6.0;
+
+#pragma omp parallel for
+	for (int i = 0; i < N_pts; i++) {
+		int grid_indx[COORD_DIM];
+		Real M[3][4];
+
+		for (int j = 0; j < COORD_DIM; j++) {
+			const Real point = query_points[COORD_DIM * i + j];
+			grid_indx[j] = (floor(point)) - 1;
+			// local coordinate within the cell [grid_indx+1, grid_indx+2)
+			const Real t = point - grid_indx[j] - 1;
+			const Real t2 = t * t;
+			const Real t3 = t2 * t;
+			M[j][0] = sixth * (1.0 - t) * (1.0 - t) * (1.0 - t);
+			M[j][1] = sixth * (3.0 * t3 - 6.0 * t2 + 4.0);
+			M[j][2] = sixth * (-3.0 * t3 + 3.0 * t2 + 3.0 * t + 1.0);
+			M[j][3] = sixth * t3;
+		}
+
+		const int indxx = stride0 * grid_indx[0] + stride1 * grid_indx[1] + grid_indx[2];
+
+		for (int k = 0; k < data_dof; k++) {
+			const Real* ptr = &reg_grid_vals[indxx + k * N_reg3];
+			Real val = 0;
+			for (int j0 = 0; j0 < 4; j0++) {
+				Real val1 = 0;
+				for (int j1 = 0; j1 < 4; j1++) {
+					const Real* row = ptr + j0 * stride0 + j1 * stride1;
+					const Real val2 = M[2][0] * row[0] + M[2][1] * row[1]
+									+ M[2][2] * row[2] + M[2][3] * row[3];
+					val1 += M[1][j1] * val2;
+				}
+				val += M[0][j0] * val1;
+			}
+			query_values[i + k * N_pts] = val;
+		}
+	}
+
+	if (query_values_already_scaled == false) {
+		free(query_points);
+	}
+	return;
+
+}  // end of bspline_interp3_ghost_xyz_p
+
+/*
+ * Performs a 3D cubic (lagrange) interpolation of several fields at the same
+ * query points. Same as interp3_ghost_xyz_p, but the stencil weights of a query
+ * point are computed once and reused for all data_dof fields, and the stencil
+ * is addressed without modulo operations (the ghost layers guarantee that the
+ * stencil lies inside the padded array). This is the kernel used to transport
+ * all components of a multi-component image in one sweep.
+ * @param[in] reg_grid_vals The function values at the regular grid; the fields
+ * are stored one after the other (stride isize_g[0]*isize_g[1]*isize_g[2])
+ *
+ * @param[in] data_dof The number of fields
+ *
+ * @param[in] query_points The coordinates of the query points. If
+ * query_values_already_scaled is true, the coordinates are given in grid index
+ * units of the padded local array (output of rescale_xyz).
+ *
+ * @param[out] query_values The interpolated values (stride N_pts per field)
+ *
+ */
+void batched_interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
+		int* N_reg_g, int * isize_g, int* istart, const int N_pts,
+		const int g_size, Real* query_points_in, Real* query_values,
+		bool query_values_already_scaled) {
+	Real* query_points;
+
+	if (query_values_already_scaled == false) {
+		// First we need to rescale the query points to the new padded dimensions
+		// To avoid changing the user's input we first copy the query points to a
+		// new array
+		query_points = (Real*) malloc(N_pts * COORD_DIM * sizeof(Real));
+		memcpy(query_points, query_points_in, N_pts * COORD_DIM * sizeof(Real));
+		rescale_xyz(g_size, N_reg, N_reg_g, istart, N_pts, query_points);
+		for (int i = 0; i < N_pts * COORD_DIM; i++)
+			query_points[i] *= N_reg_g[i % COORD_DIM];
+	} else {
+		query_points = query_points_in;
+	}
+
+	const int N_reg3 = isize_g[0] * isize_g[1] * isize_g[2];
+	const int stride0 = isize_g[1] * isize_g[2];
+	const int stride1 = isize_g[2];
+	Real lagr_denom[4];
+	lagr_denom[0] = -1.0/6.0;
+	lagr_denom[1] = 0.5;
+	lagr_denom[2] = -0.5;
+	lagr_denom[3] = 1.0/6.0;
+
+#pragma omp parallel for
+	for (int i = 0; i < N_pts; i++) {
+		int grid_indx[COORD_DIM];
+		Real M[3][4];
+
+		for (int j = 0; j < COORD_DIM; j++) {
+			const Real point = query_points[COORD_DIM * i + j];
+			grid_indx[j] = (floor(point)) - 1;
+			const Real x = point - grid_indx[j];
+			for (int k = 0; k < 4; k++) {
+				M[j][k] = lagr_denom[k];
+				for (int l = 0; l < 4; l++) {
+					if (k != l)
+						M[j][k] *= (x - l);
+				}
+			}
+		}
+
+		const int indxx = stride0 * grid_indx[0] + stride1 * grid_indx[1] + grid_indx[2];
+
+		for (int k = 0; k < data_dof; k++) {
+			const Real* ptr = &reg_grid_vals[indxx + k * N_reg3];
+			Real val = 0;
+			for (int j0 = 0; j0 < 4; j0++) {
+				Real val1 = 0;
+				for (int j1 = 0; j1 < 4; j1++) {
+					const Real* row = ptr + j0 * stride0 + j1 * stride1;
+					const Real val2 = M[2][0] * row[0] + M[2][1] * row[1]
+									+ M[2][2] * row[2] + M[2][3] * row[3];
+					val1 += M[1][j1] * val2;
+				}
+				val += M[0][j0] * val1;
+			}
+			query_values[i + k * N_pts] = val;
+		}
+	}
+
+	if (query_values_already_scaled == false) {
+		free(query_points);
+	}
+	return;
+
+}  // end of batched_interp3_ghost_xyz_p
+
+/*
+ * Returns true if the implementation of the cubic kernel is compiled in and
+ * can be used with the layout of the query points produced by
+ * Interp3_Plan::scatter.
+ */
+bool interp3_variant_available(int variant) {
+	if (variant < 0 || variant >= INTERP3_NVARIANTS)
+		return false;
+#ifdef INTERP_USE_MORE_MEM_L1
+	// the scatter bakes the grid index into the coordinates for the simd kernel
+	return variant == INTERP3_VAR_VECTORIZED;
+#else
+#ifdef FAST_INTERPV
+	return true;
+#else
+	return variant != INTERP3_VAR_VECTORIZED;
+#endif
+#endif
+}
+
+/*
+ * Performs a 3D cubic (lagrange) interpolation with the implementation given
+ * by variant (see Interp3_Variant). The variants that interpolate one field at
+ * a time are called once per field. Arguments are the same as for
+ * batched_interp3_ghost_xyz_p.
+ */
+void interp3_variant_ghost_xyz_p(int variant, Real* reg_grid_vals, int data_dof, int* N_reg,
+		int* N_reg_g, int * isize_g, int* istart, const int N_pts,
+		const int g_size, Real* query_points, Real* query_values,
+		bool query_values_already_scaled) {
+	const int N_reg3 = isize_g[0] * isize_g[1] * isize_g[2];
+
+	if (variant == INTERP3_VAR_BATCHED) {
+		batched_interp3_ghost_xyz_p(reg_grid_vals, data_dof, N_reg, N_reg_g, isize_g,
+				istart, N_pts, g_size, query_points, query_values,
+				query_values_already_scaled);
+		return;
+	}
+	if (variant == INTERP3_VAR_GENERIC) {
+		interp3_ghost_xyz_p(reg_grid_vals, data_dof, N_reg, N_reg_g, isize_g,
+				istart, N_pts, g_size, query_points, query_values,
+				query_values_already_scaled);
+		return;
+	}
+
+	for (int k = 0; k < data_dof; ++k) {
+		Real* f = &reg_grid_vals[k * N_reg3];
+		Real* q = &query_values[k * N_pts];
+		switch (variant) {
+		case INTERP3_VAR_GOLD:
+			gold_optimized_interp3_ghost_xyz_p(f, 1, N_reg, N_reg_g, isize_g, istart,
+					N_pts, g_size, query_points, q, query_values_already_scaled);
+			break;
+		case INTERP3_VAR_V1:
+			_optimized_interp3_ghost_xyz_p(f, 1, N_reg, N_reg_g, isize_g, istart,
+					N_pts, g_size, query_points, q, query_values_already_scaled);
+			break;
+		case INTERP3_VAR_V3:
+			___optimized_interp3_ghost_xyz_p(f, 1, N_reg, N_reg_g, isize_g, istart,
+					N_pts, g_size, query_points, q, query_values_already_scaled);
+			break;
+		case INTERP3_VAR_V4:
+			_v4_optimized_interp3_ghost_xyz_p(f, 1, N_reg, N_reg_g, isize_g, istart,
+					N_pts, g_size, query_points, q, query_values_already_scaled);
+			break;
+#ifdef FAST_INTERPV
+		case INTERP3_VAR_VECTORIZED:
+			vectorized_interp3_ghost_xyz_p(f, 1, N_reg, N_reg_g, isize_g, istart,
+					N_pts, g_size, query_points, q, query_values_already_scaled);
+			break;
+#endif
+		default:
+			optimized_interp3_ghost_xyz_p(f, 1, N_reg, N_reg_g, isize_g, istart,
+					N_pts, g_size, query_points, q, query_values_already_scaled);
+			break;
+		}
+	}
+	return;
+}  // end of interp3_variant_ghost_xyz_p
+
 /*
  * Performs a 3D cubic interpolation for a row major periodic input (x \in [0,1) )
  * This function assumes that the input grid values have been padded on all sides
@@ -4140,8 +4490,12 @@ void interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
 		}
 	}
 
+	// the stencil is centered around the cell that contains the point
+	// (e.g., [-1,2] for cubic and [-2,3] for quintic interpolation)
+	const int stencil_shift = (interp_order - 1) / 2;
 	int N_reg3 = isize_g[0] * isize_g[1] * isize_g[2];
 
+#pragma omp parallel for
 	for (int i = 0; i < N_pts; i++) {
 #ifdef VERBOSE2
 		std::cout<<"q[0]="<<query_points[i*3+0]<<std::endl;
@@ -4152,8 +4506,12 @@ void interp3_ghost_xyz_p(Real* reg_grid_vals, int data_dof, int* N_reg,
 		int grid_indx[COORD_DIM];
 
 		for (int j = 0; j < COORD_DIM; j++) {
-			point[j] = query_points[COORD_DIM * i + j] * N_reg_g[j];
-			grid_indx[j] = (floor(point[j])) - 1;
+			// rescale_xyz (plan) already maps the points to grid index units;
+			// the local rescale maps them to [0,1) of the padded grid
+			point[j] = query_points[COORD_DIM * i + j];
+			if (query_values_already_scaled == false)
+				point[j] *= N_reg_g[j];
+			grid_indx[j] = (floor(point[j])) - stencil_shift;
 			point[j] -= grid_indx[j];
 			while (grid_indx[j] < 0)
 				grid_indx[j] += N_reg_g[j];